@@ -17,7 +17,7 @@ CREATE TABLE Admin (
     AdminName VARCHAR(50) NOT NULL,
     PhoneNumber VARCHAR(20) NOT NULL UNIQUE,
     Email VARCHAR(30) NOT NULL UNIQUE,
-    Password VARCHAR(20) NOT NULL,
+    Password VARCHAR(255) NOT NULL,
     CreatedAt TIMESTAMP DEFAULT CURRENT_TIMESTAMP
 ) ENGINE=InnoDB;
 
@@ -31,7 +31,7 @@ CREATE TABLE Doctors (
     PhoneNumber VARCHAR(20) NOT NULL UNIQUE,
     Email VARCHAR(30) NOT NULL UNIQUE,
     RoomNo VARCHAR(10) NOT NULL,
-    Password VARCHAR(50) NOT NULL DEFAULT 'doc123',
+    Password VARCHAR(255) NOT NULL DEFAULT 'doc123',
     IsAvailable BOOLEAN DEFAULT TRUE,
     CreatedAt TIMESTAMP DEFAULT CURRENT_TIMESTAMP
 ) ENGINE=InnoDB;
@@ -45,7 +45,7 @@ CREATE TABLE Staff (
     PhoneNumber VARCHAR(20) NOT NULL UNIQUE,
     Email VARCHAR(30) NOT NULL UNIQUE,
     Department VARCHAR(50) NOT NULL,
-    Password VARCHAR(50) NOT NULL DEFAULT 'staff123',
+    Password VARCHAR(255) NOT NULL DEFAULT 'staff123',
     AdminID INT,
     IsApproved BOOLEAN DEFAULT FALSE,
     CreatedAt TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
@@ -63,8 +63,10 @@ CREATE TABLE Patient (
     Address VARCHAR(100) NOT NULL,
     DOB DATE NOT NULL,
     Gender VARCHAR(10) NOT NULL CHECK (Gender IN ('Male', 'Female')),
-    Password VARCHAR(50) NOT NULL,
-    CreatedAt TIMESTAMP DEFAULT CURRENT_TIMESTAMP
+    Password VARCHAR(255) NOT NULL,
+    CreatedAt TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
+    -- Name-ordered listing and keyset pages (InnoDB appends PatientID)
+    INDEX idx_patient_name (PatientName)
 ) ENGINE=InnoDB;
 
 -- ========================================
@@ -72,7 +74,8 @@ CREATE TABLE Patient (
 -- ========================================
 CREATE TABLE Appointment (
     AppointmentID INT PRIMARY KEY AUTO_INCREMENT,
-    Status VARCHAR(20) NOT NULL DEFAULT 'Pending',
+    -- Read and filtered by position (1 Pending .. 4 Cancelled) by the application
+    Status ENUM('Pending', 'Confirmed', 'Completed', 'Cancelled') NOT NULL DEFAULT 'Pending',
     AppointmentTime TIME NOT NULL,
     AppointmentDate DATE NOT NULL,
     Reason VARCHAR(100),
@@ -84,9 +87,25 @@ CREATE TABLE Appointment (
     DoctorID INT NOT NULL,
     StaffID INT,
     CreatedAt TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
+    -- 1 while the appointment holds its doctor slot / patient-day, NULL otherwise
+    -- (UNIQUE keys ignore NULLs, so cancelled rows never block a new booking)
+    ActiveSlot TINYINT AS (IF(Status IN ('Pending', 'Confirmed'), 1, NULL)) STORED,
+    ActiveDay TINYINT AS (IF(Status <> 'Cancelled', 1, NULL)) STORED,
     FOREIGN KEY (PatientID) REFERENCES Patient(PatientID) ON DELETE CASCADE,
     FOREIGN KEY (DoctorID) REFERENCES Doctors(DoctorID) ON DELETE CASCADE,
-    FOREIGN KEY (StaffID) REFERENCES Staff(StaffID) ON DELETE SET NULL
+    FOREIGN KEY (StaffID) REFERENCES Staff(StaffID) ON DELETE SET NULL,
+    -- Overlap check in checkDoctorAvailability (covering: answered from the index alone)
+    INDEX idx_appt_doctor_slot (DoctorID, AppointmentDate, AppointmentTime, Status, Duration),
+    -- One-per-day rule in checkPatientDailyLimit (covering)
+    INDEX idx_appt_patient_doctor_date (PatientID, DoctorID, AppointmentDate, Status),
+    -- Date-window listings (today / weekly / monthly / date range), already in display order
+    INDEX idx_appt_date_time (AppointmentDate, AppointmentTime),
+    -- Per-day status counts (getDailyStatistics, vw_DailyAppointmentSummary)
+    INDEX idx_appt_date_status (AppointmentDate, Status),
+    -- Booking rules enforced atomically: one active booking per doctor slot,
+    -- one non-cancelled booking per patient, doctor and day
+    UNIQUE KEY uq_appt_active_slot (DoctorID, AppointmentDate, AppointmentTime, ActiveSlot),
+    UNIQUE KEY uq_appt_patient_day (PatientID, DoctorID, AppointmentDate, ActiveDay)
 ) ENGINE=InnoDB;
 
 -- ========================================
@@ -98,11 +117,38 @@ CREATE TABLE ActivityLog (
     UserID INT NOT NULL,
     Action VARCHAR(100) NOT NULL,
     Details VARCHAR(255),
-    LogTime TIMESTAMP DEFAULT CURRENT_TIMESTAMP
+    LogTime TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
+    -- Most-recent-first listing in getActivityLogs
+    INDEX idx_activitylog_logtime (LogTime)
+) ENGINE=InnoDB;
+
+-- ========================================
+-- Table: DoctorDailyStats
+-- Per-doctor, per-day rollup of Appointment, maintained by the
+-- trg_appointment_stats_* triggers below
+-- ========================================
+CREATE TABLE DoctorDailyStats (
+    DoctorID INT NOT NULL,
+    StatDate DATE NOT NULL,
+    Pending INT NOT NULL DEFAULT 0,
+    Confirmed INT NOT NULL DEFAULT 0,
+    Completed INT NOT NULL DEFAULT 0,
+    Cancelled INT NOT NULL DEFAULT 0,
+    CompletedConsultation DECIMAL(14,2) NOT NULL DEFAULT 0.00,
+    CompletedMedicine DECIMAL(14,2) NOT NULL DEFAULT 0.00,
+    CompletedRevenue DECIMAL(14,2) NOT NULL DEFAULT 0.00,
+    -- TotalCost of Pending + Confirmed appointments
+    OpenRevenue DECIMAL(14,2) NOT NULL DEFAULT 0.00,
+    PRIMARY KEY (DoctorID, StatDate),
+    -- Date-window reads (daily, weekly, monthly, report summaries)
+    INDEX idx_dds_date (StatDate),
+    FOREIGN KEY (DoctorID) REFERENCES Doctors(DoctorID) ON DELETE CASCADE
 ) ENGINE=InnoDB;
 
 -- ========================================
 -- Insert Sample Data (IDs start from 1)
+-- Passwords are plaintext here for readability; each is replaced by an
+-- scrypt hash on its first successful login (or --migrate-passwords)
 -- ========================================
 
 -- Insert Admin
@@ -147,6 +193,167 @@ INSERT INTO ActivityLog (UserType, UserID, Action, Details) VALUES
 ('Staff', 1, 'Login', 'Successful login'),
 ('Staff', 1, 'Approve Appointment', 'ID: 1');
 
+-- ========================================
+-- Stored Procedures
+-- ========================================
+
+DELIMITER //
+-- Book and return the new ID in a single round trip. The doctor's row is
+-- locked first, so bookings (and imports) for one doctor take turns; with
+-- it held, a request overlapping an active appointment's duration is
+-- refused with an error whose text contains "slot overlap". A clash on
+-- the start time or the patient-day fails the INSERT with a duplicate-key
+-- error naming uq_appt_active_slot or uq_appt_patient_day. Nothing is
+-- written in either case.
+CREATE PROCEDURE sp_BookAppointment(
+    IN pPatientID INT, IN pDoctorID INT, IN pDate DATE, IN pTime TIME,
+    IN pReason VARCHAR(100), IN pDuration INT,
+    IN pConsultationFee DECIMAL(10,2), IN pMedicineFee DECIMAL(10,2))
+BEGIN
+    DECLARE vDoctorID INT;
+    DECLARE vOverlaps INT DEFAULT 0;
+    DECLARE EXIT HANDLER FOR SQLEXCEPTION
+    BEGIN
+        ROLLBACK;
+        RESIGNAL;
+    END;
+
+    START TRANSACTION;
+    SELECT DoctorID INTO vDoctorID FROM Doctors WHERE DoctorID = pDoctorID FOR UPDATE;
+    SELECT COUNT(*) INTO vOverlaps FROM Appointment
+    WHERE DoctorID = pDoctorID AND AppointmentDate = pDate
+      AND Status IN ('Pending', 'Confirmed')
+      AND AppointmentTime < ADDTIME(pTime, SEC_TO_TIME(pDuration * 60))
+      AND ADDTIME(AppointmentTime, SEC_TO_TIME(Duration * 60)) > pTime
+    FOR UPDATE;
+    IF vOverlaps > 0 THEN
+        SIGNAL SQLSTATE '45000' SET MESSAGE_TEXT = 'Doctor already has an appointment at this time (slot overlap)';
+    END IF;
+
+    INSERT INTO Appointment (PatientID, DoctorID, AppointmentDate, AppointmentTime, Reason,
+                             Duration, ConsultationFee, MedicineFee, TotalCost, Status)
+    VALUES (pPatientID, pDoctorID, pDate, pTime, pReason,
+            pDuration, pConsultationFee, pMedicineFee, pConsultationFee + pMedicineFee, 'Pending');
+    COMMIT;
+    SELECT LAST_INSERT_ID() AS AppointmentID;
+END //
+
+-- Insert-and-return-ID procedures: the row and its generated key come back
+-- from one CALL, so callers never need a follow-up SELECT LAST_INSERT_ID()
+CREATE PROCEDURE sp_RegisterPatient(
+    IN pName VARCHAR(50), IN pPhone VARCHAR(20), IN pEmail VARCHAR(30),
+    IN pAddress VARCHAR(100), IN pDOB DATE, IN pGender VARCHAR(10), IN pPassword VARCHAR(255))
+BEGIN
+    INSERT INTO Patient (PatientName, PhoneNumber, Email, Address, DOB, Gender, Password)
+    VALUES (pName, pPhone, pEmail, pAddress, pDOB, pGender, pPassword);
+    SELECT LAST_INSERT_ID() AS PatientID;
+END //
+
+CREATE PROCEDURE sp_AddDoctor(
+    IN pName VARCHAR(50), IN pSpecialty VARCHAR(20), IN pRoom VARCHAR(10),
+    IN pPhone VARCHAR(20), IN pEmail VARCHAR(30), IN pPassword VARCHAR(255))
+BEGIN
+    INSERT INTO Doctors (DoctorName, Specialty, RoomNo, PhoneNumber, Email, Password, IsAvailable)
+    VALUES (pName, pSpecialty, pRoom, pPhone, pEmail, pPassword, TRUE);
+    SELECT LAST_INSERT_ID() AS DoctorID;
+END //
+
+CREATE PROCEDURE sp_AddStaff(
+    IN pName VARCHAR(50), IN pDepartment VARCHAR(50), IN pPhone VARCHAR(20),
+    IN pEmail VARCHAR(30), IN pPassword VARCHAR(255))
+BEGIN
+    INSERT INTO Staff (StaffName, Department, PhoneNumber, Email, Password)
+    VALUES (pName, pDepartment, pPhone, pEmail, pPassword);
+    SELECT LAST_INSERT_ID() AS StaffID;
+END //
+
+-- Add (pSign = 1) or remove (pSign = -1) one appointment's contribution
+CREATE PROCEDURE sp_ApplyDoctorDailyStats(
+    IN pDoctorID INT, IN pDate DATE, IN pStatus VARCHAR(20),
+    IN pConsultationFee DECIMAL(10,2), IN pMedicineFee DECIMAL(10,2),
+    IN pTotalCost DECIMAL(10,2), IN pSign INT)
+BEGIN
+    INSERT INTO DoctorDailyStats (DoctorID, StatDate, Pending, Confirmed, Completed, Cancelled,
+                                  CompletedConsultation, CompletedMedicine, CompletedRevenue, OpenRevenue)
+    VALUES (pDoctorID, pDate,
+            pSign * (pStatus = 'Pending'), pSign * (pStatus = 'Confirmed'),
+            pSign * (pStatus = 'Completed'), pSign * (pStatus = 'Cancelled'),
+            IF(pStatus = 'Completed', pSign * pConsultationFee, 0),
+            IF(pStatus = 'Completed', pSign * pMedicineFee, 0),
+            IF(pStatus = 'Completed', pSign * pTotalCost, 0),
+            IF(pStatus IN ('Pending', 'Confirmed'), pSign * pTotalCost, 0))
+    ON DUPLICATE KEY UPDATE
+        Pending = Pending + VALUES(Pending),
+        Confirmed = Confirmed + VALUES(Confirmed),
+        Completed = Completed + VALUES(Completed),
+        Cancelled = Cancelled + VALUES(Cancelled),
+        CompletedConsultation = CompletedConsultation + VALUES(CompletedConsultation),
+        CompletedMedicine = CompletedMedicine + VALUES(CompletedMedicine),
+        CompletedRevenue = CompletedRevenue + VALUES(CompletedRevenue),
+        OpenRevenue = OpenRevenue + VALUES(OpenRevenue);
+END //
+
+-- Recount every doctor-day from Appointment in one transaction
+CREATE PROCEDURE sp_RebuildDoctorDailyStats()
+BEGIN
+    DECLARE EXIT HANDLER FOR SQLEXCEPTION
+    BEGIN
+        ROLLBACK;
+        RESIGNAL;
+    END;
+    START TRANSACTION;
+    DELETE FROM DoctorDailyStats;
+    INSERT INTO DoctorDailyStats (DoctorID, StatDate, Pending, Confirmed, Completed, Cancelled,
+                                  CompletedConsultation, CompletedMedicine, CompletedRevenue, OpenRevenue)
+    SELECT DoctorID, AppointmentDate,
+           SUM(Status = 'Pending'), SUM(Status = 'Confirmed'),
+           SUM(Status = 'Completed'), SUM(Status = 'Cancelled'),
+           SUM(IF(Status = 'Completed', ConsultationFee, 0)),
+           SUM(IF(Status = 'Completed', MedicineFee, 0)),
+           SUM(IF(Status = 'Completed', TotalCost, 0)),
+           SUM(IF(Status IN ('Pending', 'Confirmed'), TotalCost, 0))
+    FROM Appointment
+    GROUP BY DoctorID, AppointmentDate;
+    COMMIT;
+END //
+DELIMITER ;
+
+-- ========================================
+-- Triggers
+-- ========================================
+
+DELIMITER //
+CREATE TRIGGER trg_appointment_stats_insert AFTER INSERT ON Appointment
+FOR EACH ROW
+BEGIN
+    CALL sp_ApplyDoctorDailyStats(NEW.DoctorID, NEW.AppointmentDate, NEW.Status,
+                                  NEW.ConsultationFee, NEW.MedicineFee, NEW.TotalCost, 1);
+END //
+
+CREATE TRIGGER trg_appointment_stats_update AFTER UPDATE ON Appointment
+FOR EACH ROW
+BEGIN
+    -- Only changes that move a count or a fee sum touch the rollup
+    IF NOT (OLD.Status <=> NEW.Status AND OLD.DoctorID <=> NEW.DoctorID
+            AND OLD.AppointmentDate <=> NEW.AppointmentDate
+            AND OLD.ConsultationFee <=> NEW.ConsultationFee
+            AND OLD.MedicineFee <=> NEW.MedicineFee
+            AND OLD.TotalCost <=> NEW.TotalCost) THEN
+        CALL sp_ApplyDoctorDailyStats(OLD.DoctorID, OLD.AppointmentDate, OLD.Status,
+                                      OLD.ConsultationFee, OLD.MedicineFee, OLD.TotalCost, -1);
+        CALL sp_ApplyDoctorDailyStats(NEW.DoctorID, NEW.AppointmentDate, NEW.Status,
+                                      NEW.ConsultationFee, NEW.MedicineFee, NEW.TotalCost, 1);
+    END IF;
+END //
+
+CREATE TRIGGER trg_appointment_stats_delete AFTER DELETE ON Appointment
+FOR EACH ROW
+BEGIN
+    CALL sp_ApplyDoctorDailyStats(OLD.DoctorID, OLD.AppointmentDate, OLD.Status,
+                                  OLD.ConsultationFee, OLD.MedicineFee, OLD.TotalCost, -1);
+END //
+DELIMITER ;
+
 -- ========================================
 -- Views for Grade A Requirements
 -- ========================================
@@ -202,4 +409,7 @@ SELECT
 FROM Appointment
 GROUP BY YEAR(AppointmentDate), MONTH(AppointmentDate);
 
+-- Seed the statistics rollup from the sample appointments above
+CALL sp_RebuildDoctorDailyStats();
+
 SELECT 'Database setup completed successfully! All IDs start from 1.' AS Message;
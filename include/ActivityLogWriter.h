@@ -0,0 +1,92 @@
+// ============================================================
+// ActivityLogWriter.h - Background, Batched Activity Log Writer
+// Hospital Appointment Booking System
+// ============================================================
+
+#ifndef ACTIVITY_LOG_WRITER_H
+#define ACTIVITY_LOG_WRITER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Moves ActivityLog INSERTs off the caller's path. Any thread may enqueue
+// (multi-producer); a single background thread drains the queue and hands
+// batches to the sink, which writes them as multi-row INSERTs.
+class ActivityLogWriter {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry {
+        std::string userType;
+        int userID = 0;
+        std::string action;
+        std::string details;
+        Clock::time_point queuedAt; // Used to back-date LogTime to when the action happened
+    };
+
+    struct Config {
+        size_t queueCapacity = 4096;                 // Producers block only when this many entries are waiting
+        size_t maxBatch = 64;                        // Rows per flush
+        std::chrono::milliseconds flushInterval{250}; // Max time an entry waits for its batch to fill
+    };
+
+    struct Stats {
+        unsigned long long enqueued = 0;
+        unsigned long long written = 0;
+        unsigned long long batches = 0;
+        unsigned long long failed = 0;          // Entries dropped because the sink threw
+        unsigned long long blockedProducers = 0; // enqueue() calls that found the queue full
+        size_t queueDepth = 0;
+        size_t maxQueueDepth = 0;
+        Stats() {}
+    };
+
+    // Writes one batch; throws on failure (the batch is then dropped and counted)
+    using BatchSink = std::function<void(const std::vector<Entry>&)>;
+    using ThreadHook = std::function<void()>;
+
+    ActivityLogWriter(BatchSink sink, const Config& config,
+                      ThreadHook onThreadStart = ThreadHook(), ThreadHook onThreadEnd = ThreadHook());
+    ~ActivityLogWriter();
+
+    ActivityLogWriter(const ActivityLogWriter&) = delete;
+    ActivityLogWriter& operator=(const ActivityLogWriter&) = delete;
+
+    // Queue an entry; blocks only while the queue is full. False once stopped.
+    bool enqueue(Entry entry);
+
+    // Block until everything queued so far has been written
+    void flush();
+
+    // Flush remaining entries and join the writer thread
+    void stop();
+
+    Stats getStats() const;
+
+private:
+    BatchSink sink;
+    Config config;
+    ThreadHook onThreadStart;
+    ThreadHook onThreadEnd;
+
+    mutable std::mutex mtx;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+    std::condition_variable drained;
+    std::deque<Entry> queue;
+    bool stopping;
+    bool inFlight;
+    int flushRequests;
+    Stats stats;
+    std::thread worker;
+
+    void run();
+};
+
+#endif // ACTIVITY_LOG_WRITER_H
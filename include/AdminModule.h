@@ -34,9 +34,10 @@ private:
     void viewSystemLogs();
     void systemStatistics();
     void generateReport();
+    void exportAppointments();
     
 public:
-    AdminModule(ConsoleUtils& c, DatabaseManager& d, UserSession& s);
+    AdminModule(ConsoleUtils& c, StorageEngine& d, UserSession& s);
     void showDashboard() override; // Polymorphism - override base class method
 };
 
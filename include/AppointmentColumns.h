@@ -0,0 +1,86 @@
+// ============================================================
+// AppointmentColumns.h - Columnar Appointment Batch and Kernels
+// Hospital Appointment Booking System
+// ============================================================
+
+#ifndef APPOINTMENT_COLUMNS_H
+#define APPOINTMENT_COLUMNS_H
+
+#include <array>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "AppointmentStatus.h"
+
+// Appointments stored column by column: one contiguous array per field the
+// statistics read (status code, day number, doctor, fees in cents) and no
+// text at all. Counting or summing by status streams a byte and an int or
+// two per row instead of a whole Appointment with its strings, and the
+// kernels below do 8 (counts) or 4 (sums) rows per instruction with AVX2
+// when the CPU has it, falling back to plain loops otherwise.
+//
+// Rows are unordered; removing one moves the last row into its place, so
+// callers that keep a row number per appointment must follow the move.
+class AppointmentColumns {
+public:
+    static const int STATUS_COUNT = AppointmentStatus::COUNT;
+    typedef std::array<long long, STATUS_COUNT> PerStatus; // Indexed by AppointmentStatus::index()
+
+    enum Fee { Consultation, Medicine, Total };
+
+    enum Kernel {
+        Auto,   // AVX2 when the CPU supports it
+        Scalar  // Plain loops (also what Auto runs without AVX2)
+    };
+
+    struct DoctorCounts {
+        int doctorID;
+        PerStatus appointments;
+        DoctorCounts() : doctorID(0), appointments() {}
+    };
+
+    static bool hasAvx2(); // Checked once
+
+    size_t size() const { return appointmentIDs.size(); }
+    void reserve(size_t rows);
+    void clear();
+
+    // day is a Date::dayNumber(); fees are rounded to whole cents
+    // (RM 21,474,836.47 at most). Returns the new row
+    size_t append(int appointmentID, int doctorID, int day, AppointmentStatus status,
+                  double consultationFee, double medicineFee, double totalCost);
+    void setStatus(size_t row, AppointmentStatus status) { statuses[row] = status.code(); }
+    // The appointment whose row is now `row`, or 0 if row was the last one
+    int erase(size_t row);
+
+    int appointmentIDAt(size_t row) const { return appointmentIDs[row]; }
+    AppointmentStatus statusAt(size_t row) const { return static_cast<AppointmentStatus::Code>(statuses[row]); }
+    int dayAt(size_t row) const { return days[row]; }
+
+    // Rows dated firstDay..lastDay (day numbers, inclusive)
+    PerStatus countByStatus(int firstDay = INT_MIN, int lastDay = INT_MAX, Kernel kernel = Auto) const;
+    PerStatus sumByStatus(Fee fee, int firstDay = INT_MIN, int lastDay = INT_MAX, Kernel kernel = Auto) const; // Cents
+    // Every doctor that has a row, in the order first seen. The group key
+    // (doctor * STATUS_COUNT + status) is computed 8 rows at a time; the
+    // increments themselves are scalar, as AVX2 has no scatter
+    std::vector<DoctorCounts> countByDoctor(int firstDay = INT_MIN, int lastDay = INT_MAX,
+                                            Kernel kernel = Auto) const;
+
+private:
+    std::vector<int32_t> appointmentIDs;
+    std::vector<uint8_t> statuses;
+    std::vector<int32_t> days;
+    std::vector<int32_t> doctorSlots;        // Dense index into doctorIDs
+    std::vector<int32_t> consultationCents;
+    std::vector<int32_t> medicineCents;
+    std::vector<int32_t> totalCents;
+
+    std::vector<int> doctorIDs;              // Slot -> DoctorID
+    std::unordered_map<int, int32_t> slotOfDoctor;
+
+    const std::vector<int32_t>& column(Fee fee) const;
+};
+
+#endif // APPOINTMENT_COLUMNS_H
@@ -0,0 +1,59 @@
+// ============================================================
+// AppointmentExporter.h - Streaming CSV / NDJSON Appointment Export
+// Hospital Appointment Booking System
+// ============================================================
+
+#ifndef APPOINTMENT_EXPORTER_H
+#define APPOINTMENT_EXPORTER_H
+
+#include <string>
+#include "StorageEngine.h"
+
+// Writes every appointment in a date range to a file as CSV (with a header
+// row) or NDJSON (one JSON object per line). Rows come straight off
+// StorageEngine::streamAppointmentsByDateRange and are formatted into one
+// large block-aligned buffer that goes to disk in a single WriteFile each
+// time it fills, so memory use is the buffer and one row whatever the range.
+//
+// Options::direct opens the file unbuffered and write-through (the Windows
+// counterpart of O_DIRECT), which keeps a month-end export from evicting
+// the rest of the file cache; Options::sync flushes the file to the disk
+// before the export is reported as done.
+class AppointmentExporter {
+public:
+    enum Format { Csv, Ndjson };
+
+    struct Options {
+        Format format = Csv;
+        size_t bufferBytes = 4 << 20; // Rounded up to whole 4 KiB blocks
+        bool direct = false;
+        bool sync = false;
+    };
+
+    struct Result {
+        bool ok = false;
+        long long rows = 0;
+        unsigned long long bytes = 0;
+        unsigned long long writes = 0; // WriteFile calls
+        double seconds = 0.0;
+        std::string error;             // Set when !ok
+        Result() {}
+    };
+
+    AppointmentExporter(StorageEngine& db, const Options& options);
+
+    // Export appointments dated fromDate..toDate (inclusive) to path,
+    // replacing any existing file
+    Result exportRange(const Date& fromDate, const Date& toDate, const std::string& path);
+
+    // One newline-terminated record appended to out
+    static void appendCsv(std::string& out, const Appointment& appointment);
+    static void appendJson(std::string& out, const Appointment& appointment);
+    static const char* csvHeader();
+
+private:
+    StorageEngine& db;
+    Options options;
+};
+
+#endif // APPOINTMENT_EXPORTER_H
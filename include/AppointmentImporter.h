@@ -0,0 +1,74 @@
+// ============================================================
+// AppointmentImporter.h - Bulk CSV Appointment Import
+// Hospital Appointment Booking System
+// ============================================================
+
+#ifndef APPOINTMENT_IMPORTER_H
+#define APPOINTMENT_IMPORTER_H
+
+#include <istream>
+#include <ostream>
+#include <map>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+#include "DateTime.h"
+#include "StorageEngine.h"
+
+// Loads appointments from CSV, one record per appointment:
+//
+//     PatientID,DoctorID,Date,Time,Duration,Reason
+//     1042,7,2026-03-02,09:30,30,"Follow-up, blood pressure"
+//
+// A header row is skipped, and fields may be quoted ("" for a quote). Each
+// record is held to the rules of a booking made from the patient menu:
+// YYYY-MM-DD dates and HH:MM times, no past dates, a quarter-hour start
+// within clinic hours, a 15/30/45/60 minute duration, an available doctor,
+// and no overlap with the doctor's active appointments or with earlier
+// records in the file. Fees come from the storage engine's fee rules.
+//
+// Valid records are buffered and written a chunk at a time through
+// StorageEngine::importAppointments (one transaction per chunk), so memory
+// stays bounded however long the input is. Rejected records are reported as
+// "line N: reason" and do not stop the import.
+class AppointmentImporter {
+public:
+    struct Config {
+        size_t chunkRows = 5000; // Rows per transaction
+    };
+
+    struct Summary {
+        size_t records = 0;  // Data records read (header excluded)
+        size_t imported = 0;
+        size_t rejected = 0; // By validation or by the database
+        double seconds = 0.0;
+        double rowsPerSecond() const { return seconds > 0.0 ? records / seconds : 0.0; }
+        Summary() {}
+    };
+
+    AppointmentImporter(StorageEngine& db, const Config& config);
+
+    // Import everything in csv, writing one line per rejected record to errors
+    Summary run(std::istream& csv, std::ostream& errors);
+
+private:
+    StorageEngine& db;
+    Config config;
+
+    std::unordered_map<int, bool> doctorAvailable; // DoctorID -> isAvailable
+    Date today;
+    // Records accepted so far, with their lines: the quarters each took per
+    // doctor-day, and each patient/doctor/day
+    std::unordered_map<uint64_t, std::vector<std::pair<DoctorSlotIndex::DayMask, size_t>>> booked;
+    std::map<std::tuple<int, int, int>, size_t> patientDays;
+
+    std::vector<StorageEngine::ImportRow> chunk;
+    std::vector<size_t> chunkLines;
+
+    // Why the record cannot be imported, or empty when row is filled in
+    std::string validate(const std::vector<std::string>& fields, size_t line, StorageEngine::ImportRow& row);
+    void flush(Summary& summary, std::ostream& errors);
+};
+
+#endif // APPOINTMENT_IMPORTER_H
@@ -0,0 +1,90 @@
+// ============================================================
+// AppointmentList.h - Compact Appointment Results with Interned Text
+// Hospital Appointment Booking System
+// ============================================================
+
+#ifndef APPOINTMENT_LIST_H
+#define APPOINTMENT_LIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Models.h"
+
+// A large appointment result held as fixed-size records. Each distinct
+// patient name, doctor name and reason is stored once in the list's own
+// arena and the records refer to it by number, so a million rows over a
+// handful of doctors hold a handful of doctor names rather than a million
+// copies. Fees are whole cents (DECIMAL(10,2) never has more), the date,
+// time and status are already compact.
+//
+// Text is read back as std::string_view, valid while the list lives;
+// at() expands a row into an ordinary Appointment when a screen needs one.
+class AppointmentList {
+public:
+    struct Record {
+        int32_t appointmentID;
+        int32_t patientID;
+        int32_t doctorID;
+        int32_t staffID;
+        Date appointmentDate;
+        TimeOfDay appointmentTime;
+        int32_t consultationCents;
+        int32_t medicineCents;
+        int32_t totalCents;
+        uint32_t patientName;  // Interned text numbers, see text()
+        uint32_t doctorName;
+        uint32_t reason;
+        int16_t duration;
+        AppointmentStatus status;
+        Record() : appointmentID(0), patientID(0), doctorID(0), staffID(0), consultationCents(0),
+                   medicineCents(0), totalCents(0), patientName(0), doctorName(0), reason(0),
+                   duration(0) {}
+
+        double consultationFee() const { return consultationCents / 100.0; }
+        double medicineFee() const { return medicineCents / 100.0; }
+        double totalCost() const { return totalCents / 100.0; }
+    };
+
+    AppointmentList();
+    // The text views point into the arena, so a list is moved, never copied
+    AppointmentList(AppointmentList&&) = default;
+    AppointmentList& operator=(AppointmentList&&) = default;
+    AppointmentList(const AppointmentList&) = delete;
+    AppointmentList& operator=(const AppointmentList&) = delete;
+
+    size_t size() const { return records.size(); }
+    bool empty() const { return records.empty(); }
+    void reserve(size_t rows) { records.reserve(rows); }
+    void push_back(const Appointment& appointment);
+
+    const Record& operator[](size_t row) const { return records[row]; }
+    std::vector<Record>::const_iterator begin() const { return records.begin(); }
+    std::vector<Record>::const_iterator end() const { return records.end(); }
+
+    std::string_view text(uint32_t id) const { return texts[id]; }
+    Appointment at(size_t row) const;
+
+    size_t distinctTexts() const { return texts.size(); }
+    // Bytes held: records, arena blocks and the intern table's entries
+    // (allocator bookkeeping not counted)
+    size_t memoryBytes() const;
+
+private:
+    static const size_t BLOCK_BYTES = 64 * 1024;
+
+    std::vector<Record> records;
+    std::vector<std::unique_ptr<char[]>> blocks;    // Arena; blocks never move
+    std::vector<size_t> blockSizes;
+    size_t blockUsed;                               // Bytes taken in the last block
+    std::vector<std::string_view> texts;           // Number -> text in the arena
+    std::unordered_map<std::string_view, uint32_t> numbers;
+
+    uint32_t intern(const std::string& value);
+};
+
+#endif // APPOINTMENT_LIST_H
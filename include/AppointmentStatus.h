@@ -0,0 +1,59 @@
+// ============================================================
+// AppointmentStatus.h - Appointment Status and Its Transitions
+// Hospital Appointment Booking System
+// ============================================================
+
+#ifndef APPOINTMENT_STATUS_H
+#define APPOINTMENT_STATUS_H
+
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <string>
+
+// An appointment's status in one byte. The codes double as array indexes
+// (per-status counters) and, plus one, as the positions in the MySQL
+// ENUM('Pending', 'Confirmed', 'Completed', 'Cancelled') column, so status
+// filters compare small integers on both sides.
+//
+// An appointment moves Pending -> Confirmed -> Completed and can be
+// Cancelled from any other status; nothing leaves Cancelled or goes back.
+class AppointmentStatus {
+public:
+    enum Code : uint8_t { Pending, Confirmed, Completed, Cancelled };
+    static const int COUNT = 4;
+
+    AppointmentStatus() : value(Pending) {}
+    AppointmentStatus(Code code) : value(code) {}
+
+    // Exact name; nothing for anything else
+    static std::optional<AppointmentStatus> parse(const std::string& name);
+    // From an ENUM position as read by `Status + 0`. Anything else (0 is
+    // MySQL's invalid-value entry) reads as Cancelled, which holds nothing
+    static AppointmentStatus fromColumn(int position) {
+        return position >= 1 && position <= COUNT ? AppointmentStatus(static_cast<Code>(position - 1))
+                                                  : AppointmentStatus(Cancelled);
+    }
+
+    Code code() const { return value; }
+    int index() const { return value; }
+    int column() const { return value + 1; } // ENUM position, for binding
+    const char* name() const;
+
+    // Pending and Confirmed appointments hold their doctor slot
+    bool holdsSlot() const { return value == Pending || value == Confirmed; }
+    bool canBecome(AppointmentStatus next) const;
+
+    bool operator==(AppointmentStatus other) const { return value == other.value; }
+    bool operator!=(AppointmentStatus other) const { return value != other.value; }
+    bool operator==(Code other) const { return value == other; }
+    bool operator!=(Code other) const { return value != other; }
+
+private:
+    Code value;
+};
+
+// Written as name(), so std::setw applies as for text
+std::ostream& operator<<(std::ostream& out, AppointmentStatus status);
+
+#endif // APPOINTMENT_STATUS_H
@@ -8,20 +8,20 @@
 
 #include "Models.h"
 #include "ConsoleUtils.h"
-#include "DatabaseManager.h"
+#include "StorageEngine.h"
 
 // OOP: Encapsulation - Private members, public interface
 class AuthModule {
 private:
     ConsoleUtils& console;
-    DatabaseManager& db;
+    StorageEngine& db;
     UserSession& session;
     
     // Private helper methods (Encapsulation)
     bool authenticateUser(const std::string& email, const std::string& password);
     
 public:
-    AuthModule(ConsoleUtils& c, DatabaseManager& d, UserSession& s);
+    AuthModule(ConsoleUtils& c, StorageEngine& d, UserSession& s);
     bool login();
     bool loginAsPatient();
     bool loginAsDoctor();
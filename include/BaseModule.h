@@ -8,17 +8,19 @@
 
 #include "Models.h"
 #include "ConsoleUtils.h"
-#include "DatabaseManager.h"
+#include "StorageEngine.h"
+#include <iomanip>
+#include <sstream>
 
 // Base class for all modules (OOP Inheritance)
 class BaseModule {
 protected:
     ConsoleUtils& console;
-    DatabaseManager& db;
+    StorageEngine& db;
     UserSession& session;
     
 public:
-    BaseModule(ConsoleUtils& c, DatabaseManager& d, UserSession& s)
+    BaseModule(ConsoleUtils& c, StorageEngine& d, UserSession& s)
         : console(c), db(d), session(s) {}
     
     virtual ~BaseModule() {}
@@ -38,6 +40,20 @@ public:
     void logActivity(const std::string& action, const std::string& details = "") {
         db.logActivity(session.userType, session.userID, action, details);
     }
+    
+    // Patient search prompt that lists name/phone prefix matches while typing
+    std::string getPatientSearchInput(const std::string& prompt) {
+        return console.getTypeaheadInput(prompt, [this](const std::string& typed) {
+            std::vector<std::string> lines;
+            for (const Patient& p : db.suggestPatients(typed, 8)) {
+                std::ostringstream line;
+                line << "    > " << std::left << std::setw(6) << p.patientID
+                     << std::setw(25) << p.patientName << p.phoneNumber;
+                lines.push_back(line.str());
+            }
+            return lines;
+        });
+    }
 };
 
 #endif // BASE_MODULE_H
@@ -0,0 +1,34 @@
+// ============================================================
+// CommandLineTools.h - Headless Maintenance and Benchmark Commands
+// Hospital Appointment Booking System
+// ============================================================
+
+#ifndef COMMAND_LINE_TOOLS_H
+#define COMMAND_LINE_TOOLS_H
+
+#include "DatabaseManager.h"
+#include "InMemoryStorage.h"
+#include "StorageEngine.h"
+
+// The commands main() runs instead of the menu; each returns the process
+// exit code (0 success, 1 check failed, 2 could not run). The option each
+// one serves is described with its definition in CommandLineTools.cpp.
+
+// Maintenance, on whichever engine the program runs on
+int runIndexCheck(StorageEngine& storage);
+int runRollupCheck(StorageEngine& storage, bool rebuild);
+int runPasswordMigration(StorageEngine& storage);
+int runAppointmentImport(StorageEngine& storage, const char* path, int chunkRows);
+int runAppointmentExport(StorageEngine& storage, int argc, char* argv[]);
+
+// Benchmarks
+int runRowMappingBenchmark(StorageEngine& storage, int rows);
+int runStorageBenchmark(DatabaseManager& mysqlStorage, InMemoryStorage& memoryStorage, int calls);
+int runPasswordBenchmark(int logins);          // No database needed from here down
+int runMedicineFeeBenchmark(int count);
+int runPatientSearchBenchmark(int patients);
+int runFreeSlotBenchmark(int doctors);
+int runColumnBenchmark(long long rows);
+int runRecordBenchmark(int rows);
+
+#endif // COMMAND_LINE_TOOLS_H
@@ -0,0 +1,123 @@
+// ============================================================
+// ConnectionPool.h - Bounded, Thread-Safe MySQL Connection Pool
+// Hospital Appointment Booking System
+// ============================================================
+
+#ifndef CONNECTION_POOL_H
+#define CONNECTION_POOL_H
+
+#pragma warning(disable: 4251)
+
+#include "mysql_connection.h"
+#include "cppconn/exception.h"
+#include "StatementCache.h"
+#include "ConnectionPoolStats.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class ConnectionPool {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Factory = std::function<sql::Connection*()>;
+
+    struct Config {
+        size_t minSize = 1;                                  // Connections kept open while idle
+        size_t maxSize = 8;                                  // Hard upper bound on open connections
+        std::chrono::milliseconds acquireTimeout{5000};      // Max wait for a free connection
+        std::chrono::seconds idleTimeout{300};               // Idle connections above minSize are closed after this
+        std::chrono::seconds validateAfter{30};              // Idle time after which a connection is pinged before reuse
+        size_t statementCacheSize = 64;                      // Prepared statements kept per connection
+    };
+
+    using Stats = ConnectionPoolStats;
+
+private:
+    struct PooledConnection {
+        std::unique_ptr<sql::Connection> connection;
+        std::unique_ptr<StatementCache> statements;
+        Clock::time_point lastUsed;
+        bool suspect = false; // Last lease ended in an exception: ping before reuse
+    };
+
+public:
+    // RAII handle: returns the connection to the pool when it goes out of scope
+    class Lease {
+    private:
+        ConnectionPool* pool;
+        std::unique_ptr<PooledConnection> entry;
+        bool broken;
+        int unwinding; // std::uncaught_exceptions() when the lease was taken
+
+    public:
+        Lease() : pool(nullptr), broken(false), unwinding(0) {}
+        Lease(ConnectionPool* p, std::unique_ptr<PooledConnection> e)
+            : pool(p), entry(std::move(e)), broken(false), unwinding(std::uncaught_exceptions()) {}
+        Lease(Lease&& other) noexcept
+            : pool(other.pool), entry(std::move(other.entry)), broken(other.broken), unwinding(other.unwinding) {
+            other.pool = nullptr;
+        }
+        Lease& operator=(Lease&& other) noexcept;
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        ~Lease() { release(); }
+
+        sql::Connection* get() const { return entry ? entry->connection.get() : nullptr; }
+        sql::Connection* operator->() const { return get(); }
+        explicit operator bool() const { return get() != nullptr; }
+
+        // Cached prepared statement for sql on this connection (owned by the cache)
+        sql::PreparedStatement* prepare(const std::string& sql) {
+            return entry->statements->prepare(*entry->connection, sql);
+        }
+
+        // Mark the connection as unusable so it is closed instead of reused
+        void invalidate() { broken = true; }
+        // Returns the connection; one released while an exception unwinds
+        // the caller (a lost server, a failed statement) is pinged before
+        // its next lease however recently it was used
+        void release();
+    };
+
+    ConnectionPool(Factory factory, const Config& config);
+    ~ConnectionPool();
+
+    ConnectionPool(const ConnectionPool&) = delete;
+    ConnectionPool& operator=(const ConnectionPool&) = delete;
+
+    // Borrow a connection; throws sql::SQLException on timeout or connect failure
+    Lease acquire();
+
+    // Ping idle connections, drop dead ones and refill up to minSize
+    bool healthCheck();
+
+    // Close every idle connection and refuse new leases
+    void shutdown();
+
+    Stats getStats() const;
+    const Config& getConfig() const { return config; }
+
+private:
+    Factory factory;
+    Config config;
+
+    mutable std::mutex mtx;
+    std::condition_variable available;
+    std::vector<std::unique_ptr<PooledConnection>> idle;
+    size_t total;
+    bool closed;
+    Stats stats;
+    StatementCache::Counters statementCounters;
+
+    std::unique_ptr<PooledConnection> openConnection();
+    bool isHealthy(PooledConnection& entry);
+    void evictIdleLocked(Clock::time_point now);
+    void giveBack(std::unique_ptr<PooledConnection> entry, bool broken, bool suspect);
+};
+
+#endif // CONNECTION_POOL_H
@@ -0,0 +1,33 @@
+// ============================================================
+// ConnectionPoolStats.h - Connection Pool Counters
+// Hospital Appointment Booking System
+// ============================================================
+
+#ifndef CONNECTION_POOL_STATS_H
+#define CONNECTION_POOL_STATS_H
+
+#include <cstddef>
+
+// ConnectionPool counters for sizing the pool (all values since pool
+// creation). Kept apart from ConnectionPool.h so StorageEngine and the
+// code written against it build without the MySQL connector headers.
+struct ConnectionPoolStats {
+    unsigned long long acquisitions = 0;    // Successful acquire() calls
+    unsigned long long waits = 0;           // acquire() calls that had to block
+    unsigned long long timeouts = 0;        // acquire() calls that gave up
+    unsigned long long saturations = 0;     // acquire() calls that found every connection in use at maxSize
+    unsigned long long created = 0;         // Connections opened
+    unsigned long long evicted = 0;         // Idle connections closed by eviction
+    unsigned long long failedHealthChecks = 0;
+    unsigned long long statementHits = 0;   // Prepared statement cache hits (all connections)
+    unsigned long long statementMisses = 0;
+    unsigned long long statementEvictions = 0;
+    double totalWaitMs = 0.0;
+    double maxWaitMs = 0.0;
+    size_t inUse = 0;
+    size_t idle = 0;
+    size_t peakInUse = 0;
+    ConnectionPoolStats() {}
+};
+
+#endif // CONNECTION_POOL_STATS_H
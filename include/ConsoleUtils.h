@@ -14,6 +14,9 @@
 #include <cctype>
 #include <stdexcept>
 #include <conio.h>
+#include <algorithm>
+#include <functional>
+#include <vector>
 
 // Console color codes for Windows
 enum ConsoleColor {
@@ -311,6 +314,87 @@ public:
         }
     }
     
+    // Get input key by key, listing suggest(text) under the prompt after
+    // every change (at most maxLines lines). Esc clears the text; Enter
+    // returns it trimmed, and is ignored while the text is empty.
+    std::string getTypeaheadInput(const std::string& prompt,
+                                  const std::function<std::vector<std::string>(const std::string&)>& suggest,
+                                  size_t maxLines = 8, size_t maxLength = 100) {
+        setColor(CYAN);
+        std::cout << prompt << std::flush;
+        resetColor();
+        
+        // Reserve the suggestion area first so drawing it never scrolls the
+        // buffer out from under the saved input position
+        CONSOLE_SCREEN_BUFFER_INFO info;
+        GetConsoleScreenBufferInfo(hConsole, &info);
+        SHORT inputX = info.dwCursorPosition.X;
+        std::cout << std::string(maxLines, '\n') << std::flush;
+        GetConsoleScreenBufferInfo(hConsole, &info);
+        COORD inputAt = { inputX, static_cast<SHORT>(info.dwCursorPosition.Y - maxLines) };
+        size_t width = info.dwSize.X > 1 ? static_cast<size_t>(info.dwSize.X - 1) : 79;
+        SetConsoleCursorPosition(hConsole, inputAt);
+        
+        std::string input;
+        size_t drawnLength = 0;
+        size_t drawnLines = 0;
+        while (true) {
+            int ch = _getch();
+            if (ch == '\r') {
+                if (input.find_first_not_of(' ') == std::string::npos) continue;
+                break;
+            }
+            if (ch == 0 || ch == 224) { // Arrow/function keys arrive as two codes
+                (void)_getch();
+                continue;
+            }
+            if (ch == '\b') {
+                if (input.empty()) continue;
+                input.pop_back();
+            } else if (ch == 27) { // Esc
+                input.clear();
+            } else if (ch >= 32 && ch < 127 && input.length() < maxLength) {
+                input += static_cast<char>(ch);
+            } else {
+                continue;
+            }
+            
+            std::vector<std::string> lines;
+            if (input.find_first_not_of(' ') != std::string::npos) lines = suggest(input);
+            if (lines.size() > maxLines) lines.resize(maxLines);
+            
+            SetConsoleCursorPosition(hConsole, inputAt);
+            std::cout << input;
+            if (drawnLength > input.length()) std::cout << std::string(drawnLength - input.length(), ' ');
+            drawnLength = input.length();
+            setColor(GRAY);
+            for (size_t i = 0; i < (std::max)(lines.size(), drawnLines); i++) {
+                COORD lineAt = { 0, static_cast<SHORT>(inputAt.Y + 1 + i) };
+                SetConsoleCursorPosition(hConsole, lineAt);
+                std::string line = i < lines.size() ? lines[i].substr(0, width) : "";
+                std::cout << line << std::string(width - line.length(), ' ');
+            }
+            resetColor();
+            drawnLines = lines.size();
+            COORD caret = { static_cast<SHORT>(inputAt.X + input.length()), inputAt.Y };
+            SetConsoleCursorPosition(hConsole, caret);
+            std::cout << std::flush;
+        }
+        
+        // Clear the suggestions and continue output below the input line
+        for (size_t i = 0; i < drawnLines; i++) {
+            COORD lineAt = { 0, static_cast<SHORT>(inputAt.Y + 1 + i) };
+            SetConsoleCursorPosition(hConsole, lineAt);
+            std::cout << std::string(width, ' ');
+        }
+        COORD below = { 0, static_cast<SHORT>(inputAt.Y + 1) };
+        SetConsoleCursorPosition(hConsole, below);
+        
+        input.erase(0, input.find_first_not_of(' '));
+        input.erase(input.find_last_not_of(' ') + 1);
+        return input;
+    }
+    
     // Validate email format
     bool isValidEmail(const std::string& email) {
         size_t atPos = email.find('@');
@@ -21,137 +21,189 @@
 #include <string>
 #include <vector>
 #include <memory>
-#include "Models.h"
+#include "ConnectionPool.h"
+#include "StorageEngine.h"
 
-class DatabaseManager {
+// StorageEngine on MySQL: the schema in database_setup.sql (plus
+// migrations/) holds the data and enforces the booking rules; doctorCache,
+// patientIndex and slotIndex keep hot reads off the server.
+class DatabaseManager : public StorageEngine {
 private:
     sql::Driver* driver;
-    std::unique_ptr<sql::Connection> connection;
+    std::unique_ptr<ConnectionPool> pool;
+    std::unique_ptr<ActivityLogWriter> logWriter;
+    std::unique_ptr<PasswordVerifier> passwordVerifier;
     bool isConnected;
     
     std::string host = "tcp://127.0.0.1:3306";
     std::string user = "root";
     std::string password = "";
     std::string database = "hospital_appointment_db";
+    size_t poolMinSize = 1;
+    size_t poolMaxSize = 8;
+    std::chrono::seconds doctorCacheTtl{60}; // Bounds staleness from writes by other processes
+    DoctorCache doctorCache;                 // Declared after doctorCacheTtl, which configures it
+    PatientSearchIndex patientIndex;         // Serves searchPatients; kept current by the patient writes
+    DoctorSlotIndex slotIndex;               // Serves availability checks; kept current by booking/status writes
+    PasswordHasher::Cost passwordCost;       // For new hashes; older ones are upgraded on login
+    PasswordVerifier::Config passwordConfig;
+    
+    // Borrow a pooled connection for the duration of one call
+    ConnectionPool::Lease acquireConnection();
+    void writeActivityBatch(const std::vector<ActivityLogWriter::Entry>& batch);
+    std::vector<Doctor> loadDoctors(); // DoctorCache loader
+    std::vector<PatientSearchIndex::Entry> loadPatientSearchEntries(); // PatientSearchIndex loader
+    DoctorSlotIndex::Load loadActiveBookings(); // DoctorSlotIndex loader
+    std::string hashPassword(const std::string& password); // Blocks on the password workers
+    template <typename Model>
+    PendingLogin<Model> beginLogin(const char* table, const char* idColumn,
+                                   const std::string& email, const std::string& password);
+    
+protected:
+    bool finishLogin(const char* table, const char* idColumn, int id, const std::string& password,
+                     const std::string& stored, std::future<bool>& verdict) override;
     
 public:
     DatabaseManager();
     ~DatabaseManager();
     
     // Connection
-    bool connect();
-    void disconnect();
-    bool checkConnection();
-    int getLastInsertId();
+    bool connect() override;
+    void disconnect() override;
+    bool checkConnection() override;
+    ConnectionPool::Stats getPoolStats() const override;
     
-    // Authentication
-    int loginPatient(const std::string& email, const std::string& password);
-    int loginDoctor(const std::string& email, const std::string& password);
-    int loginStaff(const std::string& email, const std::string& password);
-    int loginAdmin(const std::string& email, const std::string& password);
+    // Authentication: one profile + stored-hash query, KDF on the password workers
+    PendingLogin<Patient> beginLoginPatient(const std::string& email, const std::string& password) override;
+    PendingLogin<Doctor> beginLoginDoctor(const std::string& email, const std::string& password) override;
+    PendingLogin<Staff> beginLoginStaff(const std::string& email, const std::string& password) override;
+    PendingLogin<Admin> beginLoginAdmin(const std::string& email, const std::string& password) override;
+    std::optional<Patient> loginPatient(const std::string& email, const std::string& password) override;
+    std::optional<Doctor> loginDoctor(const std::string& email, const std::string& password) override;
+    std::optional<Staff> loginStaff(const std::string& email, const std::string& password) override;
+    std::optional<Admin> loginAdmin(const std::string& email, const std::string& password) override;
+    int migratePlaintextPasswords() override;
+    PasswordVerifier::Stats getPasswordStats() const override;
     
     // Patient operations
-    bool registerPatient(const std::string& name, const std::string& phone,
-                        const std::string& email, const std::string& address,
-                        const std::string& dob, const std::string& gender,
-                        const std::string& password);
-    Patient getPatientById(int patientID);
+    std::optional<int> registerPatient(const std::string& name, const std::string& phone,
+                                       const std::string& email, const std::string& address,
+                                       const std::string& dob, const std::string& gender,
+                                       const std::string& password) override;
+    Patient getPatientById(int patientID) override;
     bool updatePatient(int patientID, const std::string& name, const std::string& phone,
-                      const std::string& email, const std::string& address);
-    bool deletePatient(int patientID);
-    std::vector<Patient> searchPatients(const std::string& search);
+                      const std::string& email, const std::string& address) override;
+    bool deletePatient(int patientID) override;
+    // Candidates come from patientIndex; only the matching rows are read from MySQL
+    std::vector<Patient> searchPatients(const std::string& search) override;
+    std::vector<Patient> suggestPatients(const std::string& prefix, size_t limit) override;
+    PatientSearchIndex::Stats getPatientSearchStats() const override;
+    PatientPage getPatientsPage(const PatientCursor& after, int pageSize) override;
     
-    // Doctor operations
-    Doctor getDoctorById(int doctorID);
-    std::vector<Doctor> getAllDoctors(bool availableOnly = false);
-    bool addDoctor(const std::string& name, const std::string& specialty,
-                  const std::string& room, const std::string& phone,
-                  const std::string& email, const std::string& password);
+    // Doctor operations (reads are served from doctorCache; writes invalidate it)
+    Doctor getDoctorById(int doctorID) override;
+    std::vector<Doctor> getAllDoctors(bool availableOnly = false) override;
+    std::optional<int> addDoctor(const std::string& name, const std::string& specialty,
+                                 const std::string& room, const std::string& phone,
+                                 const std::string& email, const std::string& password) override;
     bool updateDoctor(int doctorID, const std::string& name, const std::string& specialty,
-                     const std::string& room, const std::string& phone);
-    bool updateDoctorAvailability(int doctorID, bool isAvailable);
-    bool deleteDoctor(int doctorID);
+                     const std::string& room, const std::string& phone) override;
+    bool updateDoctorAvailability(int doctorID, bool isAvailable) override;
+    bool deleteDoctor(int doctorID) override;
+    DoctorCache::Stats getDoctorCacheStats() const override;
     
     // Staff operations
-    Staff getStaffById(int staffID);
-    std::vector<Staff> getAllStaff();
-    bool addStaff(const std::string& name, const std::string& department,
-                 const std::string& phone, const std::string& email,
-                 const std::string& password);
-    bool deleteStaff(int staffID);
+    Staff getStaffById(int staffID) override;
+    std::vector<Staff> getAllStaff() override;
+    std::optional<int> addStaff(const std::string& name, const std::string& department,
+                                const std::string& phone, const std::string& email,
+                                const std::string& password) override;
+    bool deleteStaff(int staffID) override;
     
     // Admin operations
-    Admin getAdminById(int adminID);
+    Admin getAdminById(int adminID) override;
     
     // Appointment operations
-    bool createAppointment(int patientID, int doctorID, const std::string& date,
-                          const std::string& time, const std::string& reason, 
-                          int duration, double consultationFee, double medicineFee);
-    std::vector<Appointment> getPatientAppointments(int patientID);
-    std::vector<Appointment> getDoctorAppointments(int doctorID, const std::string& date = "");
-    std::vector<Appointment> getDoctorAllAppointments(int doctorID);
-    std::vector<Appointment> getAllAppointments();
-    std::vector<Appointment> getAppointmentsByDateRange(const std::string& startDate, const std::string& endDate);
-    std::vector<Appointment> getTodayAppointments();
-    std::vector<Appointment> getWeeklyAppointments();
-    std::vector<Appointment> getMonthlyAppointments();
-    std::vector<Appointment> getPendingAppointments();
-    Appointment getAppointmentById(int appointmentID);
-    bool updateAppointmentStatus(int appointmentID, const std::string& status);
-    bool cancelAppointment(int appointmentID);
-    bool checkDoctorAvailability(int doctorID, const std::string& date, const std::string& time);
-    bool checkPatientDailyLimit(int patientID, int doctorID, const std::string& date);
-    double calculateConsultationFee(int duration); // RM1 per minute
-    double calculateMedicineFee(const std::string& reason); // Calculate medicine fee based on reason
+    std::optional<int> createAppointment(int patientID, int doctorID, const Date& date,
+                                         const TimeOfDay& time, const std::string& reason,
+                                         int duration, double consultationFee, double medicineFee) override;
+    // One CALL to sp_BookAppointment, which locks the doctor's row, refuses
+    // a request overlapping an active appointment's duration (SlotTaken)
+    // and inserts; the daily limit is a unique key. Concurrent bookings
+    // that overlap cannot both succeed. slotIndex is only updated here, not
+    // consulted.
+    BookingResult bookAppointmentAtomic(int patientID, int doctorID, const Date& date,
+                                        const TimeOfDay& time, const std::string& reason,
+                                        int duration, double consultationFee, double medicineFee) override;
+    // Multi-row INSERTs in one transaction, holding the same doctor locks as
+    // sp_BookAppointment while rows overlapping an active appointment are
+    // refused; a statement the database rejects is retried row by row so
+    // only the offending rows are dropped
+    std::vector<ImportFailure> importAppointments(const std::vector<ImportRow>& rows) override;
+    std::vector<Appointment> getPatientAppointments(int patientID) override;
+    std::vector<Appointment> getDoctorAppointments(int doctorID, const Date& date = Date()) override;
+    std::vector<Appointment> getDoctorAllAppointments(int doctorID) override;
+    std::vector<Appointment> getAllAppointments() override;
+    AppointmentList getAllAppointmentsCompact() override;
+    std::vector<Appointment> getAppointmentsByDateRange(const Date& startDate, const Date& endDate) override;
+    // Rows arrive from the server as an unbuffered, forward-only result; the
+    // export holds one pooled connection until it finishes
+    long long streamAppointmentsByDateRange(const Date& startDate, const Date& endDate,
+                                            const std::function<bool(const Appointment&)>& onRow) override;
+    std::vector<Appointment> getTodayAppointments() override;
+    std::vector<Appointment> getWeeklyAppointments() override;
+    std::vector<Appointment> getMonthlyAppointments() override;
+    std::vector<Appointment> getPendingAppointments() override;
+    // Each page costs one index range read however deep it is
+    AppointmentPage getAppointmentsPage(const AppointmentCursor& after, int pageSize) override;
+    AppointmentPage getDoctorAppointmentsPage(int doctorID, const AppointmentCursor& after, int pageSize) override;
+    Appointment getAppointmentById(int appointmentID) override;
+    bool updateAppointmentStatus(int appointmentID, AppointmentStatus from, AppointmentStatus to) override;
+    bool cancelAppointment(int appointmentID) override;
+    // Answered from slotIndex's bitmaps for today onwards, by an overlap
+    // query for earlier days
+    bool checkDoctorAvailability(int doctorID, const Date& date, const TimeOfDay& time,
+                                 int duration = DoctorSlotIndex::SLOT_MINUTES) override;
+    // Computed from slotIndex without queries
+    std::vector<DoctorSlotIndex::FreeSlot> findFreeSlots(const std::vector<int>& doctorIDs, const Date& fromDate,
+                                                         const TimeOfDay& notBefore, int duration, int days,
+                                                         size_t count) override;
+    std::vector<DoctorSlotIndex::FreeSlot> findFreeSlotsInSpecialty(const std::string& specialty, const Date& fromDate,
+                                                                    const TimeOfDay& notBefore, int duration, int days,
+                                                                    size_t count) override;
+    DoctorSlotIndex::Stats getSlotIndexStats() const override;
+    bool checkPatientDailyLimit(int patientID, int doctorID, const Date& date) override;
+    double calculateConsultationFee(int duration) override; // RM1 per minute
+    double calculateMedicineFee(const std::string& reason) override; // Calculate medicine fee based on reason
     
-    // Activity logging
+    // Activity logging (queued and written in batches by a background thread)
     bool logActivity(const std::string& userType, int userID, 
-                    const std::string& action, const std::string& details = "");
-    std::vector<ActivityLog> getActivityLogs(int limit = 50);
+                    const std::string& action, const std::string& details = "") override;
+    ActivityLogWriter::Stats getActivityLogStats() const override;
+    std::vector<ActivityLog> getActivityLogs(int limit = 50) override;
     
     // Grade A: Complex Calculations (Aggregations)
-    struct DoctorStats {
-        int doctorID;
-        std::string doctorName;
-        int totalAppointments;
-        int confirmedCount;
-        double completionRate;
-        DoctorStats() : doctorID(0), totalAppointments(0), confirmedCount(0), completionRate(0.0) {}
-    };
-    std::vector<DoctorStats> getDoctorStatistics(); // GROUP BY with aggregation
-    
-    struct MonthlyStats {
-        int year;
-        int month;
-        int totalAppointments;
-        int completed;
-        double completionPercentage;
-        MonthlyStats() : year(0), month(0), totalAppointments(0), completed(0), completionPercentage(0.0) {}
-    };
-    std::vector<MonthlyStats> getMonthlyStatistics(); // GROUP BY with date functions
+    // Read from the DoctorDailyStats rollup: cost grows with doctors x days,
+    // not with the number of appointments
+    std::vector<DoctorStats> getDoctorStatistics() override; // LEFT JOIN rollup, GROUP BY doctor
+    std::vector<MonthlyStats> getMonthlyStatistics() override; // GROUP BY month over the rollup
+    std::vector<DailyStats> getDailyStatistics() override; // Last 30 days
+    std::vector<DailyStats> getWeeklyDailyStatistics() override; // Last 7 days
+    RevenueStats getRevenueStatistics() override;
+    // Summed from the rollup (one row crosses the wire whatever the table size)
+    AppointmentSummary getAppointmentSummary(int lastDays = -1) override;
+    AppointmentSummary getDoctorAppointmentSummary(int doctorID) override;
+    SystemCounts getSystemCounts() override;
     
-    struct DailyStats {
-        std::string date;
-        int total;
-        int confirmed;
-        int pending;
-        int completed;
-        int cancelled;
-        DailyStats() : total(0), confirmed(0), pending(0), completed(0), cancelled(0) {}
-    };
-    std::vector<DailyStats> getDailyStatistics(); // GROUP BY with aggregation (last 30 days)
-    std::vector<DailyStats> getWeeklyDailyStatistics(); // GROUP BY for last 7 days
+    // Rollup maintenance. Triggers keep DoctorDailyStats current; verify
+    // recounts Appointment and lists every doctor-day that disagrees,
+    // rebuild replaces the rollup with a fresh recount.
+    bool verifyStatisticsRollup(std::vector<RollupDrift>& drift) override;
+    bool rebuildStatisticsRollup() override;
     
-    struct RevenueStats {
-        double totalRevenue;
-        double potentialRevenue;
-        double averageCost;
-        double totalConsultation;
-        double totalMedicine;
-        RevenueStats() : totalRevenue(0.0), potentialRevenue(0.0), averageCost(0.0), 
-                        totalConsultation(0.0), totalMedicine(0.0) {}
-    };
-    RevenueStats getRevenueStatistics();
+    // EXPLAIN of each hot query as the application issues it
+    std::vector<QueryPlan> explainHotQueries() override;
+    RowMappingBenchmark benchmarkRowMapping(int rowLimit = 100000) override;
 };
 
 #endif // DATABASE_MANAGER_H
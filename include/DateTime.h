@@ -0,0 +1,99 @@
+// ============================================================
+// DateTime.h - Compact Date and Time-of-Day Values
+// Hospital Appointment Booking System
+// ============================================================
+
+#ifndef DATE_TIME_H
+#define DATE_TIME_H
+
+#include <climits>
+#include <ostream>
+#include <string>
+
+// A calendar date held as one int: days since 1970-01-01 (proleptic
+// Gregorian). Comparing, sorting and stepping by days are integer
+// operations; text is only produced when a date is shown or written out.
+// Default-constructed dates are invalid, as is anything parse() rejects.
+//
+// Appointment dates are read from MySQL as TO_DAYS() numbers and bound
+// as FROM_DAYS(?), so they cross the connection as integers. Dates of
+// birth and the statistics reports' dates are still plain text.
+class Date {
+public:
+    static const int TO_DAYS_1970 = 719528; // MySQL TO_DAYS('1970-01-01')
+
+    Date() : number(INVALID) {}
+
+    static Date fromDayNumber(int day) { return Date(day); }
+    static Date fromToDays(int toDays) { return Date(toDays - TO_DAYS_1970); }
+    static Date fromCivil(int year, int month, int day); // Not range-checked
+    // YYYY-MM-DD (anything may follow, e.g. a time), years 1000-9999 like
+    // MySQL DATE, the day checked against its month
+    static Date parse(const std::string& text);
+    // The local date; the clock is read again only after midnight
+    static Date today();
+
+    bool isValid() const { return number != INVALID; }
+    int dayNumber() const { return number; }
+    int toDays() const { return number + TO_DAYS_1970; }
+    int year() const;
+    int month() const;
+    int day() const;
+
+    Date plusDays(int days) const { return isValid() ? Date(number + days) : Date(); }
+    std::string toString() const; // YYYY-MM-DD, empty when invalid
+
+    bool operator==(const Date& other) const { return number == other.number; }
+    bool operator!=(const Date& other) const { return number != other.number; }
+    bool operator<(const Date& other) const { return number < other.number; }
+    bool operator<=(const Date& other) const { return number <= other.number; }
+    bool operator>(const Date& other) const { return number > other.number; }
+    bool operator>=(const Date& other) const { return number >= other.number; }
+
+private:
+    static const int INVALID = INT_MIN;
+    int number;
+
+    explicit Date(int day) : number(day) {}
+    void civil(int& year, int& month, int& day) const;
+};
+
+// A time of day to the minute, held as minutes since midnight (appointments
+// never carry seconds). Invalid when default-constructed or unparsable.
+// MySQL reads it as TIME_TO_SEC(...) DIV 60 and binds it as SEC_TO_TIME(?)
+// with toSeconds().
+class TimeOfDay {
+public:
+    TimeOfDay() : minutes(-1) {}
+
+    static TimeOfDay fromMinutes(int minuteOfDay) {
+        return minuteOfDay >= 0 && minuteOfDay < 24 * 60 ? TimeOfDay(minuteOfDay) : TimeOfDay();
+    }
+    // HH:MM or HH:MM:SS (the seconds are dropped)
+    static TimeOfDay parse(const std::string& text);
+
+    bool isValid() const { return minutes >= 0; }
+    int minuteOfDay() const { return minutes; }
+    int toSeconds() const { return minutes * 60; }
+
+    std::string toString() const;   // HH:MM:SS, as MySQL shows TIME; empty when invalid
+    std::string shortString() const; // HH:MM
+
+    bool operator==(const TimeOfDay& other) const { return minutes == other.minutes; }
+    bool operator!=(const TimeOfDay& other) const { return minutes != other.minutes; }
+    bool operator<(const TimeOfDay& other) const { return minutes < other.minutes; }
+    bool operator<=(const TimeOfDay& other) const { return minutes <= other.minutes; }
+    bool operator>(const TimeOfDay& other) const { return minutes > other.minutes; }
+    bool operator>=(const TimeOfDay& other) const { return minutes >= other.minutes; }
+
+private:
+    int minutes;
+
+    explicit TimeOfDay(int minuteOfDay) : minutes(minuteOfDay) {}
+};
+
+// Written as toString(), so std::setw and the like apply as for text
+std::ostream& operator<<(std::ostream& out, const Date& date);
+std::ostream& operator<<(std::ostream& out, const TimeOfDay& time);
+
+#endif // DATE_TIME_H
@@ -0,0 +1,87 @@
+// ============================================================
+// DoctorCache.h - Read-Through Doctor Directory Cache
+// Hospital Appointment Booking System
+// ============================================================
+
+#ifndef DOCTOR_CACHE_H
+#define DOCTOR_CACHE_H
+
+#include "Models.h"
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// Keeps the whole Doctors table in memory (the roster is small and changes a
+// few times a day) so booking screens and doctor lookups skip the database.
+//
+// Every write through DatabaseManager calls invalidate(), which bumps a
+// version; a load only installs its result if no invalidation happened while
+// it was running, so a slow load can never resurrect pre-write data. Writes
+// made by other processes are picked up once the snapshot's TTL expires.
+class DoctorCache {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Full roster ordered by DoctorName; throws on failure
+    using Loader = std::function<std::vector<Doctor>()>;
+
+    struct Config {
+        std::chrono::seconds ttl{60}; // Max age of a snapshot before it is reloaded
+    };
+
+    struct Stats {
+        unsigned long long hits = 0;           // Lookups served from a fresh snapshot
+        unsigned long long misses = 0;         // Lookups that had to load (cold, invalidated or expired)
+        unsigned long long loads = 0;          // Roster reloads that completed
+        unsigned long long invalidations = 0;  // Local writes that dropped the snapshot
+        unsigned long long expirations = 0;    // Snapshots dropped by TTL
+        unsigned long long discardedLoads = 0; // Loads that raced an invalidation and were not installed
+        double maxServedAgeMs = 0.0;           // Oldest snapshot ever served (worst-case staleness)
+        double snapshotAgeMs = 0.0;            // Age of the current snapshot, 0 when none
+        double lastLoadMs = 0.0;
+        size_t doctors = 0;                    // Rows in the current snapshot
+        unsigned long long version = 0;
+        Stats() {}
+    };
+
+    using Roster = std::shared_ptr<const std::vector<Doctor>>;
+
+    DoctorCache(Loader loader, const Config& config);
+
+    DoctorCache(const DoctorCache&) = delete;
+    DoctorCache& operator=(const DoctorCache&) = delete;
+
+    // Current roster, loading it first if absent or expired
+    Roster roster();
+
+    // Copy of one doctor from the roster; false if the roster has no such ID
+    bool find(int doctorID, Doctor& doctor);
+
+    // Drop the snapshot after a write; the next lookup reloads
+    void invalidate();
+
+    Stats getStats() const;
+
+private:
+    struct Snapshot {
+        Roster doctors;
+        std::unordered_map<int, size_t> byID;
+        Clock::time_point loadedAt;
+    };
+
+    Loader loader;
+    Config config;
+
+    mutable std::mutex mtx;
+    std::shared_ptr<const Snapshot> current;
+    unsigned long long version;
+    Stats stats;
+
+    std::shared_ptr<const Snapshot> acquire();
+};
+
+#endif // DOCTOR_CACHE_H
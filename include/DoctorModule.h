@@ -18,7 +18,7 @@ private:
     void updateAvailability();
     
 public:
-    DoctorModule(ConsoleUtils& c, DatabaseManager& d, UserSession& s);
+    DoctorModule(ConsoleUtils& c, StorageEngine& d, UserSession& s);
     void showDashboard() override; // Polymorphism - override base class method
 };
 
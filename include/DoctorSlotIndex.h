@@ -0,0 +1,155 @@
+// ============================================================
+// DoctorSlotIndex.h - In-Memory Doctor Slot Availability Bitmaps
+// Hospital Appointment Booking System
+// ============================================================
+
+#ifndef DOCTOR_SLOT_INDEX_H
+#define DOCTOR_SLOT_INDEX_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "DateTime.h"
+
+// One 96-bit mask per doctor and day, a bit per 15-minute quarter, set while
+// an active (Pending or Confirmed) appointment covers any part of it. "Is
+// 10:30 for 45 minutes free" is then an AND of the request's mask with the
+// day's two words - no query, and unlike an exact start-time comparison it
+// sees a 10:00 hour-long appointment overlapping a 10:30 request.
+//
+// Times off the quarter grid are rounded outwards (09:10 for 15 minutes
+// occupies 09:00-09:30), so the answer errs towards busy, never towards a
+// double booking.
+//
+// Only days from the load date onwards are held; isFree() returns nullopt
+// for earlier days so the caller can ask the database. Writes through
+// DatabaseManager are applied in place and bump a version that makes a
+// concurrent load discard its result; other processes' writes are picked
+// up when the TTL expires.
+class DoctorSlotIndex {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static const int SLOT_MINUTES = 15;
+    static const int SLOTS_PER_DAY = 24 * 60 / SLOT_MINUTES;
+
+    // Busy quarters of one doctor-day: bit q of words[q / 64] is quarter q
+    struct DayMask {
+        uint64_t words[2];
+        DayMask() : words{ 0, 0 } {}
+        bool empty() const { return (words[0] | words[1]) == 0; }
+        bool overlaps(const DayMask& other) const {
+            return ((words[0] & other.words[0]) | (words[1] & other.words[1])) != 0;
+        }
+        bool test(int slot) const { return (words[slot >> 6] >> (slot & 63)) & 1; }
+    };
+
+    struct Booking {
+        int appointmentID;
+        int doctorID;
+        Date date;
+        TimeOfDay time;
+        int duration;     // Minutes
+        Booking() : appointmentID(0), doctorID(0), duration(0) {}
+    };
+
+    // Active appointments dated fromDate or later; throws on failure
+    struct Load {
+        Date fromDate;
+        std::vector<Booking> bookings;
+    };
+    using Loader = std::function<Load()>;
+
+    struct SlotSearch {
+        std::vector<int> doctorIDs;    // Ties at the same time go to the earlier doctor here
+        Date fromDate;                 // First day searched
+        int notBeforeMinute;           // Earliest start on fromDate, e.g. the current time
+        int days;                      // Days searched, fromDate included
+        int duration;                  // Minutes the appointment needs
+        size_t count;                  // Slots wanted
+        int openMinute;                // Starts no earlier than this...
+        int closeMinute;               // ...and ends no later than this
+        SlotSearch() : notBeforeMinute(0), days(7), duration(30), count(5),
+                       openMinute(8 * 60), closeMinute(17 * 60) {}
+    };
+
+    struct FreeSlot {
+        int doctorID;
+        Date date;
+        TimeOfDay time;
+        FreeSlot() : doctorID(0) {}
+    };
+
+    struct Config {
+        std::chrono::seconds ttl{60}; // Max age before a full reload
+    };
+
+    struct Stats {
+        unsigned long long checks = 0;         // isFree() calls answered from the masks
+        unsigned long long outsideWindow = 0;  // ...left to the caller (day before the load date)
+        unsigned long long conflicts = 0;      // ...that found the interval taken
+        unsigned long long searches = 0;       // findFree() calls
+        unsigned long long loads = 0;
+        unsigned long long discardedLoads = 0; // Loads that raced a write and were not installed
+        unsigned long long expirations = 0;
+        unsigned long long adds = 0;
+        unsigned long long removals = 0;
+        double lastLoadMs = 0.0;
+        size_t doctorDays = 0;                 // Masks held
+        size_t bookings = 0;                   // Active appointments held
+        Stats() {}
+    };
+
+    DoctorSlotIndex(Loader loader, const Config& config);
+    ~DoctorSlotIndex();
+
+    DoctorSlotIndex(const DoctorSlotIndex&) = delete;
+    DoctorSlotIndex& operator=(const DoctorSlotIndex&) = delete;
+
+    // Whether [time, time + duration) is clear of the doctor's active
+    // appointments; nullopt when the day is outside the loaded window or
+    // the date/time are invalid
+    std::optional<bool> isFree(int doctorID, const Date& date, const TimeOfDay& time, int duration);
+
+    // The earliest search.count quarter-aligned starts, by date, then time,
+    // then doctor, where the whole appointment fits in a free stretch of the
+    // doctor's day. Each doctor-day costs a handful of word operations, so
+    // this is never a loop of availability queries. nullopt when fromDate
+    // is before the loaded window.
+    std::optional<std::vector<FreeSlot>> findFree(const SlotSearch& search);
+
+    // An appointment became active (booked) / stopped holding its slot
+    // (cancelled, completed, deleted)
+    void add(const Booking& booking);
+    void remove(int appointmentID);
+
+    // Drop everything; the next check reloads
+    void invalidate();
+
+    Stats getStats() const;
+
+    // Quarters touched by [minute, minute + duration), clipped to the day
+    static DayMask intervalMask(int minute, int duration);
+
+private:
+    struct Table;
+
+    Loader loader;
+    Config config;
+
+    mutable std::mutex mtx;
+    std::unique_ptr<Table> table; // Null until loaded
+    Clock::time_point loadedAt;
+    unsigned long long version;
+    Stats stats;
+
+    void ensureLoaded();
+};
+
+#endif // DOCTOR_SLOT_INDEX_H
@@ -0,0 +1,246 @@
+// ============================================================
+// InMemoryStorage.h - In-Process Storage Engine (No Database)
+// Hospital Appointment Booking System
+// ============================================================
+
+#ifndef IN_MEMORY_STORAGE_H
+#define IN_MEMORY_STORAGE_H
+
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "AppointmentColumns.h"
+#include "StorageEngine.h"
+
+// StorageEngine held entirely in this process: every table is a hash map by
+// ID, appointments are also kept in sets sorted by (date, time, ID) - one
+// overall and one per doctor and per patient - and patients in a set
+// sorted by name. Lookups by ID are a hash probe, date windows and keyset
+// pages are a range of a sorted set, and nothing crosses a network.
+//
+// The MySQL schema's rules are enforced here too: unique emails and phone
+// numbers per account table, appointments only for existing patients and
+// doctors, no overlapping active appointments for a doctor, one
+// non-cancelled appointment per patient, doctor and day, and the cascades
+// when a patient or doctor is deleted. Passwords go through the same
+// PasswordVerifier, and searches and slot checks through the same
+// PatientSearchIndex and DoctorSlotIndex, as in DatabaseManager, so timing
+// a call here measures this program's share of it.
+//
+// Statistics are counted on demand from a columnar copy of the appointments
+// (AppointmentColumns), so there is no rollup to drift. Nothing is persisted: the data lives as long as the object.
+class InMemoryStorage : public StorageEngine {
+public:
+    InMemoryStorage();
+    ~InMemoryStorage();
+
+    InMemoryStorage(const InMemoryStorage&) = delete;
+    InMemoryStorage& operator=(const InMemoryStorage&) = delete;
+
+    // Replace the contents with the sample rows of database_setup.sql (the
+    // same accounts and plaintext passwords, appointments dated around today)
+    void seedDemoData();
+
+    // Replace the contents with a copy of source's doctors, staff, patients
+    // and appointments, IDs included. Passwords and admins are not part of
+    // the interface, so the copied accounts cannot log in. False if source
+    // could not be read.
+    bool copyFrom(StorageEngine& source);
+
+    // Connection: starts / stops the password workers; the data is kept
+    bool connect() override;
+    void disconnect() override;
+    bool checkConnection() override;
+    ConnectionPoolStats getPoolStats() const override; // No pool: all zero
+
+    PendingLogin<Patient> beginLoginPatient(const std::string& email, const std::string& password) override;
+    PendingLogin<Doctor> beginLoginDoctor(const std::string& email, const std::string& password) override;
+    PendingLogin<Staff> beginLoginStaff(const std::string& email, const std::string& password) override;
+    PendingLogin<Admin> beginLoginAdmin(const std::string& email, const std::string& password) override;
+    std::optional<Patient> loginPatient(const std::string& email, const std::string& password) override;
+    std::optional<Doctor> loginDoctor(const std::string& email, const std::string& password) override;
+    std::optional<Staff> loginStaff(const std::string& email, const std::string& password) override;
+    std::optional<Admin> loginAdmin(const std::string& email, const std::string& password) override;
+    int migratePlaintextPasswords() override;
+    PasswordVerifier::Stats getPasswordStats() const override;
+
+    std::optional<int> registerPatient(const std::string& name, const std::string& phone,
+                                       const std::string& email, const std::string& address,
+                                       const std::string& dob, const std::string& gender,
+                                       const std::string& password) override;
+    Patient getPatientById(int patientID) override;
+    bool updatePatient(int patientID, const std::string& name, const std::string& phone,
+                       const std::string& email, const std::string& address) override;
+    bool deletePatient(int patientID) override;
+    std::vector<Patient> searchPatients(const std::string& search) override;
+    std::vector<Patient> suggestPatients(const std::string& prefix, size_t limit) override;
+    PatientSearchIndex::Stats getPatientSearchStats() const override;
+    PatientPage getPatientsPage(const PatientCursor& after, int pageSize) override;
+
+    Doctor getDoctorById(int doctorID) override;
+    std::vector<Doctor> getAllDoctors(bool availableOnly = false) override;
+    std::optional<int> addDoctor(const std::string& name, const std::string& specialty,
+                                 const std::string& room, const std::string& phone,
+                                 const std::string& email, const std::string& password) override;
+    bool updateDoctor(int doctorID, const std::string& name, const std::string& specialty,
+                      const std::string& room, const std::string& phone) override;
+    bool updateDoctorAvailability(int doctorID, bool isAvailable) override;
+    bool deleteDoctor(int doctorID) override;
+    DoctorCache::Stats getDoctorCacheStats() const override; // No cache: all zero
+
+    Staff getStaffById(int staffID) override;
+    std::vector<Staff> getAllStaff() override;
+    std::optional<int> addStaff(const std::string& name, const std::string& department,
+                                const std::string& phone, const std::string& email,
+                                const std::string& password) override;
+    bool deleteStaff(int staffID) override;
+
+    Admin getAdminById(int adminID) override;
+
+    std::optional<int> createAppointment(int patientID, int doctorID, const Date& date,
+                                         const TimeOfDay& time, const std::string& reason,
+                                         int duration, double consultationFee, double medicineFee) override;
+    BookingResult bookAppointmentAtomic(int patientID, int doctorID, const Date& date,
+                                        const TimeOfDay& time, const std::string& reason,
+                                        int duration, double consultationFee, double medicineFee) override;
+    std::vector<ImportFailure> importAppointments(const std::vector<ImportRow>& rows) override;
+    std::vector<Appointment> getPatientAppointments(int patientID) override;
+    std::vector<Appointment> getDoctorAppointments(int doctorID, const Date& date = Date()) override;
+    std::vector<Appointment> getDoctorAllAppointments(int doctorID) override;
+    std::vector<Appointment> getAllAppointments() override;
+    AppointmentList getAllAppointmentsCompact() override;
+    std::vector<Appointment> getAppointmentsByDateRange(const Date& startDate, const Date& endDate) override;
+    // Copies a batch of rows at a time, so onRow runs without the lock held
+    long long streamAppointmentsByDateRange(const Date& startDate, const Date& endDate,
+                                            const std::function<bool(const Appointment&)>& onRow) override;
+    std::vector<Appointment> getTodayAppointments() override;
+    std::vector<Appointment> getWeeklyAppointments() override;
+    std::vector<Appointment> getMonthlyAppointments() override;
+    std::vector<Appointment> getPendingAppointments() override;
+    AppointmentPage getAppointmentsPage(const AppointmentCursor& after, int pageSize) override;
+    AppointmentPage getDoctorAppointmentsPage(int doctorID, const AppointmentCursor& after, int pageSize) override;
+    Appointment getAppointmentById(int appointmentID) override;
+    bool updateAppointmentStatus(int appointmentID, AppointmentStatus from, AppointmentStatus to) override;
+    bool cancelAppointment(int appointmentID) override;
+    bool checkDoctorAvailability(int doctorID, const Date& date, const TimeOfDay& time,
+                                 int duration = DoctorSlotIndex::SLOT_MINUTES) override;
+    std::vector<DoctorSlotIndex::FreeSlot> findFreeSlots(const std::vector<int>& doctorIDs, const Date& fromDate,
+                                                         const TimeOfDay& notBefore, int duration, int days,
+                                                         size_t count) override;
+    std::vector<DoctorSlotIndex::FreeSlot> findFreeSlotsInSpecialty(const std::string& specialty, const Date& fromDate,
+                                                                    const TimeOfDay& notBefore, int duration, int days,
+                                                                    size_t count) override;
+    DoctorSlotIndex::Stats getSlotIndexStats() const override;
+    bool checkPatientDailyLimit(int patientID, int doctorID, const Date& date) override;
+    double calculateConsultationFee(int duration) override;
+    double calculateMedicineFee(const std::string& reason) override;
+
+    // Kept in a list in memory, written as they arrive
+    bool logActivity(const std::string& userType, int userID,
+                     const std::string& action, const std::string& details = "") override;
+    ActivityLogWriter::Stats getActivityLogStats() const override;
+    std::vector<ActivityLog> getActivityLogs(int limit = 50) override;
+
+    std::vector<DoctorStats> getDoctorStatistics() override;
+    std::vector<MonthlyStats> getMonthlyStatistics() override;
+    std::vector<DailyStats> getDailyStatistics() override;
+    std::vector<DailyStats> getWeeklyDailyStatistics() override;
+    RevenueStats getRevenueStatistics() override;
+    AppointmentSummary getAppointmentSummary(int lastDays = -1) override;
+    AppointmentSummary getDoctorAppointmentSummary(int doctorID) override;
+    SystemCounts getSystemCounts() override;
+
+    bool verifyStatisticsRollup(std::vector<RollupDrift>& drift) override; // Always in sync
+    bool rebuildStatisticsRollup() override;
+
+    std::vector<QueryPlan> explainHotQueries() override; // Empty: no query planner
+    RowMappingBenchmark benchmarkRowMapping(int rowLimit = 100000) override; // rows == 0: no result sets
+
+protected:
+    bool finishLogin(const char* table, const char* idColumn, int id, const std::string& password,
+                     const std::string& stored, std::future<bool>& verdict) override;
+
+private:
+    // One account table (Patient, Doctors, Staff or Admin); emails are keyed
+    // lowercased, as the case-insensitive UNIQUE key compares them
+    template <typename Model>
+    struct AccountTable {
+        std::unordered_map<int, Model> rows;
+        std::unordered_map<int, std::string> passwords; // Stored hash or legacy plaintext; empty: cannot log in
+        std::unordered_map<std::string, int> emails;
+        std::unordered_map<std::string, int> phones;
+        int lastID = 0;
+    };
+
+    // Position of an appointment in the sorted indexes
+    struct AppointmentKey {
+        int day;            // Date::dayNumber() of the date
+        int minute;         // Minutes since midnight
+        int appointmentID;
+        bool operator<(const AppointmentKey& other) const {
+            if (day != other.day) return day < other.day;
+            if (minute != other.minute) return minute < other.minute;
+            return appointmentID < other.appointmentID;
+        }
+    };
+    typedef std::set<AppointmentKey> AppointmentIndex;
+
+    // (PatientName, PatientID), names compared case-insensitively like the collation
+    struct PatientNameOrder {
+        bool operator()(const std::pair<std::string, int>& a, const std::pair<std::string, int>& b) const;
+    };
+
+    // Guards everything below except the two indexes, which have their own
+    // locks and call back into this object to load; it is never held while
+    // calling them
+    mutable std::mutex mutex;
+    AccountTable<Patient> patients;
+    AccountTable<Doctor> doctors;
+    AccountTable<Staff> staff;
+    AccountTable<Admin> admins;
+    std::set<std::pair<std::string, int>, PatientNameOrder> patientsByName;
+    std::unordered_map<int, Appointment> appointments; // Without the joined names
+    AppointmentIndex appointmentsByDate;
+    std::unordered_map<int, AppointmentIndex> appointmentsByDoctor;
+    std::unordered_map<int, AppointmentIndex> appointmentsByPatient;
+    AppointmentColumns appointmentColumns;          // Status, day, doctor and fees for the statistics
+    std::unordered_map<int, size_t> columnRows;     // AppointmentID -> row of appointmentColumns
+    int lastAppointmentID;
+    std::vector<ActivityLog> activityLog; // Oldest first
+    bool isConnected;
+
+    std::unique_ptr<PasswordVerifier> passwordVerifier;
+    PasswordHasher::Cost passwordCost;
+    PasswordVerifier::Config passwordConfig;
+    PatientSearchIndex patientIndex;
+    DoctorSlotIndex slotIndex;
+
+    std::vector<PatientSearchIndex::Entry> loadPatientSearchEntries(); // PatientSearchIndex loader
+    DoctorSlotIndex::Load loadActiveBookings(); // DoctorSlotIndex loader
+    std::string hashPassword(const std::string& password); // Blocks on the password workers
+    template <typename Model>
+    PendingLogin<Model> beginLogin(AccountTable<Model>& table, const char* tableName, const char* idColumn,
+                                   const std::string& email, const std::string& password);
+
+    static AppointmentKey keyOf(const Appointment& appointment);
+
+    // The rest expect mutex to be held
+    void clear();
+    Appointment joined(const Appointment& appointment) const; // With patient and doctor names
+    std::vector<Appointment> joinedRange(AppointmentIndex::const_iterator first,
+                                         AppointmentIndex::const_iterator last) const;
+    // The rule a new appointment would break; empty when none
+    std::string rejection(const Appointment& appointment, BookingResult::Outcome& outcome) const;
+    bool overlapsActive(int doctorID, int day, int minute, int duration) const;
+    int storeAppointment(Appointment appointment); // Returns the ID, assigning one if it is 0
+    void eraseAppointment(int appointmentID);
+    // Rows of index strictly before the cursor, newest first
+    AppointmentPage pageBefore(const AppointmentIndex& index, const AppointmentCursor& after, int pageSize) const;
+    AppointmentSummary summarize(int firstDay, int lastDay) const;
+    std::vector<DailyStats> dailyStatistics(int days) const;
+};
+
+#endif // IN_MEMORY_STORAGE_H
@@ -0,0 +1,43 @@
+// ============================================================
+// MedicineFeeMatcher.h - Keyword Automaton for Medicine Fees
+// Hospital Appointment Booking System
+// ============================================================
+
+#ifndef MEDICINE_FEE_MATCHER_H
+#define MEDICINE_FEE_MATCHER_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Prices an appointment reason by the keywords it mentions ("fever",
+// "blood pressure", "follow-up", ...). The keyword table lives in
+// MedicineFeeMatcher.cpp as categories in priority order: a reason that
+// mentions keywords from several categories gets the fee of the first.
+//
+// All keywords are compiled once into one Aho-Corasick automaton with every
+// transition precomputed, so fee() reads the reason a single time, one
+// table step per character, case-insensitively and without copying it.
+class MedicineFeeMatcher {
+public:
+    static const MedicineFeeMatcher& instance();
+
+    double fee(const std::string& reason) const;
+
+    MedicineFeeMatcher(const MedicineFeeMatcher&) = delete;
+    MedicineFeeMatcher& operator=(const MedicineFeeMatcher&) = delete;
+
+private:
+    // Characters a keyword can contain get their own column; every other
+    // byte shares column 0
+    static const int COLUMNS = 29; // other, a-z, space, '-'
+
+    std::array<uint8_t, 256> columnOf;
+    std::vector<uint16_t> next;   // state * COLUMNS + column -> state
+    std::vector<uint32_t> found;  // Categories (bit = priority) matched on reaching a state
+
+    MedicineFeeMatcher();
+};
+
+#endif // MEDICINE_FEE_MATCHER_H
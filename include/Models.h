@@ -7,6 +7,8 @@
 #define MODELS_H
 
 #include <string>
+#include "AppointmentStatus.h"
+#include "DateTime.h"
 
 // ============================================================
 // User Session Structure
@@ -71,9 +73,9 @@ struct Admin {
 // ============================================================
 struct Appointment {
     int appointmentID = 0;
-    std::string status;
-    std::string appointmentTime;
-    std::string appointmentDate;
+    AppointmentStatus status;
+    TimeOfDay appointmentTime;
+    Date appointmentDate;
     std::string reason;
     int duration = 30; // Duration in minutes (default 30 minutes)
     double consultationFee = 30.0; // Consultation fee (RM1 per minute)
@@ -98,4 +100,133 @@ struct ActivityLog {
     std::string timestamp;
 };
 
+// ============================================================
+// Row Mappers
+// ============================================================
+// One specialization per model: `columns` is the explicit SELECT list and
+// read() copies a row using fixed column positions, so mapping a row never
+// looks a column up by name. Queries select RowMapper<T>::columns and must
+// not reorder them. Templated on the result set type to keep this header
+// free of database includes.
+template <typename Model>
+struct RowMapper;
+
+template <>
+struct RowMapper<Doctor> {
+    static constexpr const char* columns =
+        "DoctorID, DoctorName, Specialty, PhoneNumber, Email, RoomNo, IsAvailable";
+
+    template <typename ResultSet>
+    static Doctor read(const ResultSet& res) {
+        Doctor d;
+        d.doctorID = res.getInt(1);
+        d.doctorName = res.getString(2);
+        d.specialty = res.getString(3);
+        d.phoneNumber = res.getString(4);
+        d.email = res.getString(5);
+        d.roomNo = res.getString(6);
+        d.isAvailable = res.getBoolean(7);
+        return d;
+    }
+};
+
+template <>
+struct RowMapper<Patient> {
+    static constexpr const char* columns =
+        "PatientID, PatientName, PhoneNumber, Email, Address, DOB, Gender";
+
+    template <typename ResultSet>
+    static Patient read(const ResultSet& res) {
+        Patient p;
+        p.patientID = res.getInt(1);
+        p.patientName = res.getString(2);
+        p.phoneNumber = res.getString(3);
+        p.email = res.getString(4);
+        p.address = res.getString(5);
+        p.dateOfBirth = res.getString(6);
+        p.gender = res.getString(7);
+        return p;
+    }
+};
+
+template <>
+struct RowMapper<Staff> {
+    static constexpr const char* columns =
+        "StaffID, StaffName, Department, PhoneNumber, Email";
+
+    template <typename ResultSet>
+    static Staff read(const ResultSet& res) {
+        Staff s;
+        s.staffID = res.getInt(1);
+        s.staffName = res.getString(2);
+        s.department = res.getString(3);
+        s.phoneNumber = res.getString(4);
+        s.email = res.getString(5);
+        return s;
+    }
+};
+
+template <>
+struct RowMapper<Admin> {
+    static constexpr const char* columns = "AdminID, AdminName, PhoneNumber, Email";
+
+    template <typename ResultSet>
+    static Admin read(const ResultSet& res) {
+        Admin a;
+        a.adminID = res.getInt(1);
+        a.adminName = res.getString(2);
+        a.phoneNumber = res.getString(3);
+        a.email = res.getString(4);
+        return a;
+    }
+};
+
+// Appointment rows always come from Appointment a JOIN Patient p JOIN Doctors d.
+// The status, date and time arrive as numbers, so no row carries or parses their text
+template <>
+struct RowMapper<Appointment> {
+    static constexpr const char* columns =
+        "a.AppointmentID, a.Status + 0, TIME_TO_SEC(a.AppointmentTime) DIV 60, TO_DAYS(a.AppointmentDate), "
+        "a.Reason, a.Duration, "
+        "a.ConsultationFee, a.MedicineFee, a.TotalCost, a.PatientID, a.DoctorID, a.StaffID, "
+        "p.PatientName, d.DoctorName";
+
+    template <typename ResultSet>
+    static Appointment read(const ResultSet& res) {
+        Appointment a;
+        a.appointmentID = res.getInt(1);
+        a.status = AppointmentStatus::fromColumn(res.getInt(2));
+        a.appointmentTime = TimeOfDay::fromMinutes(res.getInt(3));
+        a.appointmentDate = Date::fromToDays(res.getInt(4));
+        a.reason = res.getString(5);
+        a.duration = res.getInt(6);
+        a.consultationFee = res.getDouble(7);
+        a.medicineFee = res.getDouble(8);
+        a.totalCost = res.getDouble(9);
+        a.patientID = res.getInt(10);
+        a.doctorID = res.getInt(11);
+        a.staffID = res.getInt(12); // NULL reads as 0
+        a.patientName = res.getString(13);
+        a.doctorName = res.getString(14);
+        return a;
+    }
+};
+
+template <>
+struct RowMapper<ActivityLog> {
+    static constexpr const char* columns = "LogID, UserType, UserID, Action, Details, LogTime";
+
+    template <typename ResultSet>
+    static ActivityLog read(const ResultSet& res) {
+        ActivityLog log;
+        log.logID = res.getInt(1);
+        log.userType = res.getString(2);
+        log.userID = res.getInt(3);
+        log.action = res.getString(4);
+        log.details = res.getString(5);
+        log.timestamp = res.getString(6);
+        return log;
+    }
+};
+
 #endif // MODELS_H
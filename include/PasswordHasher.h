@@ -0,0 +1,50 @@
+// ============================================================
+// PasswordHasher.h - Salted scrypt Password Hashing
+// Hospital Appointment Booking System
+// ============================================================
+
+#ifndef PASSWORD_HASHER_H
+#define PASSWORD_HASHER_H
+
+#include <cstdint>
+#include <string>
+
+// scrypt (RFC 7914) with a random per-password salt. The cost parameters
+// are stored with each hash, so raising the cost later only affects new
+// hashes and old ones keep verifying:
+//
+//   $scrypt$ln=14,r=8,p=1$<base64 salt>$<base64 key>
+//
+// Memory per hash is 128 * r * 2^ln bytes (16 MiB at the default cost),
+// which is what makes large-scale guessing on GPUs expensive.
+class PasswordHasher {
+public:
+    struct Cost {
+        int logN = 14; // CPU/memory cost, N = 2^logN
+        int r = 8;     // Block size
+        int p = 1;     // Parallelism
+        size_t memoryBytes() const { return size_t(128) * r * (size_t(1) << logN); }
+    };
+
+    // Hash with a fresh random salt
+    static std::string hash(const std::string& password, const Cost& cost);
+
+    // Check a password against a stored value. Values that are not scrypt
+    // hashes are legacy plaintext and compared directly (constant time).
+    static bool verify(const std::string& password, const std::string& stored);
+
+    // True when stored is an scrypt hash (false for legacy plaintext)
+    static bool isHash(const std::string& stored);
+
+    // True when stored is plaintext or was hashed at a different cost
+    static bool needsRehash(const std::string& stored, const Cost& cost);
+
+    // HMAC-SHA256(key, message) as 32 raw bytes
+    static std::string keyedDigest(const std::string& key, const std::string& message);
+
+    // Raw scrypt; exposed for the known-answer check
+    static void deriveKey(const std::string& password, const uint8_t* salt, size_t saltLen,
+                          const Cost& cost, uint8_t* out, size_t outLen);
+};
+
+#endif // PASSWORD_HASHER_H
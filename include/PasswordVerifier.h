@@ -0,0 +1,98 @@
+// ============================================================
+// PasswordVerifier.h - Password KDF Worker Pool + Verification Cache
+// Hospital Appointment Booking System
+// ============================================================
+
+#ifndef PASSWORD_VERIFIER_H
+#define PASSWORD_VERIFIER_H
+
+#include "PasswordHasher.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Runs scrypt on a small fixed set of threads so callers get a future back
+// immediately. The worker count also caps KDF memory at
+// workers * Cost::memoryBytes() however many logins arrive at once.
+//
+// Successful verifications of real hashes are remembered for cacheTtl, keyed
+// by HMAC(process secret, stored hash || password), so a user logging in
+// again within the window skips the KDF. Nothing reversible is kept, and a
+// password change produces a new stored hash, so old entries never match.
+class PasswordVerifier {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Config {
+        size_t workers = 2;                  // Concurrent KDF runs
+        size_t cacheCapacity = 1024;         // Remembered verifications (0 disables the cache)
+        std::chrono::seconds cacheTtl{900};
+    };
+
+    struct Stats {
+        unsigned long long verifications = 0; // verify() calls
+        unsigned long long cacheHits = 0;     // ...answered without running the KDF
+        unsigned long long rejected = 0;      // ...that did not match
+        unsigned long long hashes = 0;        // hash() calls
+        double totalKdfMs = 0.0;              // Time spent in the KDF across workers
+        double maxKdfMs = 0.0;
+        unsigned long long kdfRuns = 0;
+        size_t queueDepth = 0;
+        size_t maxQueueDepth = 0;
+        size_t cached = 0;
+        Stats() {}
+    };
+
+    explicit PasswordVerifier(const Config& config);
+    ~PasswordVerifier();
+
+    PasswordVerifier(const PasswordVerifier&) = delete;
+    PasswordVerifier& operator=(const PasswordVerifier&) = delete;
+
+    // True when password matches stored (an scrypt hash or legacy plaintext)
+    std::future<bool> verify(const std::string& password, const std::string& stored);
+
+    // New salted hash at the given cost
+    std::future<std::string> hash(const std::string& password, const PasswordHasher::Cost& cost);
+
+    // Finish queued work and join the workers
+    void stop();
+
+    Stats getStats() const;
+
+private:
+    struct CacheEntry {
+        std::string key;
+        Clock::time_point expires;
+    };
+
+    Config config;
+    std::string secret; // Random per process; keys the cache digests
+
+    mutable std::mutex mtx;
+    std::condition_variable ready;
+    std::deque<std::function<void()>> jobs;
+    std::vector<std::thread> workers;
+    bool stopping;
+
+    std::list<CacheEntry> cache; // Most recently used first
+    std::unordered_map<std::string, std::list<CacheEntry>::iterator> cacheIndex;
+    Stats stats;
+
+    void submit(std::function<void()> job);
+    void run();
+    bool cacheLookup(const std::string& key);
+    void cacheInsert(const std::string& key);
+    void recordKdf(Clock::time_point start);
+};
+
+#endif // PASSWORD_VERIFIER_H
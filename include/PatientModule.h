@@ -17,7 +17,7 @@ private:
     void updateDetails();
     
 public:
-    PatientModule(ConsoleUtils& c, DatabaseManager& d, UserSession& s);
+    PatientModule(ConsoleUtils& c, StorageEngine& d, UserSession& s);
     void showDashboard() override; // Polymorphism - override base class method
     void registerPatient();
 };
@@ -0,0 +1,135 @@
+// ============================================================
+// PatientSearchIndex.h - In-Memory Trigram Index for Patient Search
+// Hospital Appointment Booking System
+// ============================================================
+
+#ifndef PATIENT_SEARCH_INDEX_H
+#define PATIENT_SEARCH_INDEX_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Answers "name, email or phone contains X" without the full table scan a
+// LIKE '%X%' forces on MySQL. Each patient's three fields are lowercased and
+// split into overlapping 3-character grams; every gram maps to the ascending
+// list of slots containing it. A query intersects the lists of its own grams
+// (shortest first) and confirms each survivor with a real substring check,
+// so matches are exact, not approximate. Queries under three characters, and
+// ones whose rarest gram is in over a quarter of all patients, scan the
+// lowercased text instead: that is cheaper than merging lists that long.
+//
+// For typeahead, the same slots also feed a sorted array of prefix keys: the
+// name from each word onwards ("siti khadijah", "khadijah") and the phone
+// number's digits. A prefix is one binary search plus a short forward walk,
+// so complete() costs the same on every keystroke whatever the table size.
+//
+// Slots only ever grow, which keeps every posting list append-only: an update
+// retires the old slot and appends a new one, and the lists are rebuilt once
+// retired slots outnumber live ones.
+//
+// Writes through DatabaseManager are applied incrementally (upsert/remove),
+// including ones that land while a load is running. Writes made by other
+// processes are picked up when the index expires after its TTL.
+class PatientSearchIndex {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry {
+        int patientID;
+        std::string name;
+        std::string email;
+        std::string phone;
+        Entry() : patientID(0) {}
+    };
+
+    // Every patient's searchable fields; throws on failure
+    using Loader = std::function<std::vector<Entry>()>;
+
+    struct Config {
+        std::chrono::seconds ttl{900};  // Max age before a full reload
+        size_t compactMinRetired = 4096; // Retired slots tolerated before compaction is considered
+    };
+
+    struct Stats {
+        unsigned long long searches = 0;
+        unsigned long long scans = 0;           // ...answered by scanning (short or unselective query)
+        double totalSearchUs = 0.0;
+        double maxSearchUs = 0.0;
+        unsigned long long completions = 0;     // complete() calls
+        double totalCompleteUs = 0.0;
+        unsigned long long loads = 0;
+        unsigned long long expirations = 0;
+        unsigned long long invalidations = 0;
+        unsigned long long upserts = 0;
+        unsigned long long removals = 0;
+        unsigned long long replayed = 0;        // Writes applied to a load that raced them
+        unsigned long long compactions = 0;
+        double lastLoadMs = 0.0;
+        size_t patients = 0;                    // Live slots
+        size_t retired = 0;                     // Slots waiting for compaction
+        size_t trigrams = 0;                    // Distinct grams
+        size_t postings = 0;                    // Slot entries across all posting lists
+        size_t prefixKeys = 0;
+        size_t memoryBytes = 0;                 // Approximate heap held by the index
+        Stats() {}
+    };
+
+    PatientSearchIndex(Loader loader, const Config& config);
+    ~PatientSearchIndex();
+
+    PatientSearchIndex(const PatientSearchIndex&) = delete;
+    PatientSearchIndex& operator=(const PatientSearchIndex&) = delete;
+
+    // IDs of patients whose name, email or phone contains query (ASCII
+    // case-insensitive), loading the index first if absent or expired.
+    // An empty query matches everyone. Order is unspecified.
+    std::vector<int> search(const std::string& query);
+
+    // Up to limit patients with a name word starting with prefix, ordered by
+    // the matched text. A prefix without letters is read as a phone number:
+    // only its digits count, compared with the leading phone digits.
+    std::vector<int> complete(const std::string& prefix, size_t limit);
+
+    // Same test search() applies, for re-checking rows fetched afterwards
+    static bool matches(const std::string& query, const std::string& name,
+                        const std::string& email, const std::string& phone);
+
+    // Apply a committed write; a no-op while nothing is loaded
+    void upsert(const Entry& entry);
+    void remove(int patientID);
+
+    // Drop everything (e.g. after reconnecting); the next search reloads
+    void invalidate();
+
+    Stats getStats() const;
+
+private:
+    struct Table;
+    struct Change {
+        Entry entry;
+        bool removed;
+    };
+
+    Loader loader;
+    Config config;
+
+    mutable std::mutex mtx;
+    std::mutex loadMtx;           // One load at a time; held without mtx
+    std::unique_ptr<Table> table; // Null until loaded
+    Clock::time_point loadedAt;
+    bool loading;
+    std::vector<Change> pending;  // Writes seen while loading, replayed onto the result
+    unsigned long long version;
+    Stats stats;
+
+    void ensureLoaded();
+    void apply(Table& target, const Change& change);
+};
+
+#endif // PATIENT_SEARCH_INDEX_H
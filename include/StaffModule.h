@@ -17,7 +17,7 @@ private:
     void viewDoctors();
     
 public:
-    StaffModule(ConsoleUtils& c, DatabaseManager& d, UserSession& s);
+    StaffModule(ConsoleUtils& c, StorageEngine& d, UserSession& s);
     void showDashboard() override; // Polymorphism - override base class method
 };
 
@@ -0,0 +1,59 @@
+// ============================================================
+// StatementCache.h - Per-Connection Prepared Statement LRU Cache
+// Hospital Appointment Booking System
+// ============================================================
+
+#ifndef STATEMENT_CACHE_H
+#define STATEMENT_CACHE_H
+
+#pragma warning(disable: 4251)
+
+#include "mysql_connection.h"
+#include "cppconn/prepared_statement.h"
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+// Keeps server-side prepared statements alive across calls so the same SQL
+// text is parsed and planned once per connection instead of once per call.
+// A cache belongs to exactly one connection and is only touched by the
+// thread currently holding that connection, so it needs no locking.
+class StatementCache {
+public:
+    // Shared by every cache in a pool so hit rates can be reported in one place
+    struct Counters {
+        std::atomic<unsigned long long> hits{0};
+        std::atomic<unsigned long long> misses{0};
+        std::atomic<unsigned long long> evictions{0};
+    };
+
+    StatementCache(size_t capacity, Counters* counters);
+
+    StatementCache(const StatementCache&) = delete;
+    StatementCache& operator=(const StatementCache&) = delete;
+
+    // Return a ready-to-bind statement for sql (parameters cleared).
+    // The cache keeps ownership; do not delete the returned pointer.
+    sql::PreparedStatement* prepare(sql::Connection& connection, const std::string& sql);
+
+    // Drop every cached statement (the connection is being closed or replaced)
+    void clear();
+
+    size_t size() const { return entries.size(); }
+
+private:
+    struct Entry {
+        std::string sql;
+        std::unique_ptr<sql::PreparedStatement> statement;
+    };
+
+    size_t capacity;
+    Counters* counters;
+    std::list<Entry> entries; // Most recently used first
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+};
+
+#endif // STATEMENT_CACHE_H
@@ -0,0 +1,390 @@
+// ============================================================
+// StorageEngine.h - Storage Interface for the Application
+// Hospital Appointment Booking System
+// ============================================================
+
+#ifndef STORAGE_ENGINE_H
+#define STORAGE_ENGINE_H
+
+#include <string>
+#include <vector>
+#include <optional>
+#include <functional>
+#include <future>
+#include "Models.h"
+#include "AppointmentList.h"
+#include "ConnectionPoolStats.h"
+#include "ActivityLogWriter.h"
+#include "DoctorCache.h"
+#include "PatientSearchIndex.h"
+#include "DoctorSlotIndex.h"
+#include "PasswordVerifier.h"
+
+// Everything the modules, tools and benchmarks ask of storage. Two engines
+// implement it:
+//   DatabaseManager  - MySQL through Connector/C++ (the application default)
+//   InMemoryStorage  - hash and sorted indexes in this process, no server
+// Both enforce the same booking rules and return the same shapes, so code
+// written against StorageEngine runs unchanged on either, and timing the
+// same calls on both separates our own cost from the database's.
+class StorageEngine {
+public:
+    virtual ~StorageEngine() {}
+
+    // Connection
+    virtual bool connect() = 0;
+    virtual void disconnect() = 0;
+    virtual bool checkConnection() = 0;
+    virtual ConnectionPoolStats getPoolStats() const = 0;
+
+    // Authentication. Passwords are stored as salted scrypt hashes (see
+    // PasswordHasher); legacy plaintext rows still log in and are rehashed
+    // on their first successful login.
+    //
+    // begin* runs the single profile + stored-hash lookup and queues the KDF
+    // on the password workers, so the console can keep animating; get()
+    // waits for the verdict. login* is begin* followed by get().
+    template <typename Model>
+    class PendingLogin {
+    public:
+        PendingLogin() : owner(nullptr), table(nullptr), idColumn(nullptr), id(0) {}
+        std::optional<Model> get() {
+            if (!owner || !owner->finishLogin(table, idColumn, id, password, stored, verdict)) {
+                return std::nullopt;
+            }
+            return model;
+        }
+    private:
+        friend class StorageEngine;
+        StorageEngine* owner; // Null when no account has this email
+        const char* table;
+        const char* idColumn;
+        int id;
+        Model model;
+        std::string password;
+        std::string stored;
+        std::future<bool> verdict;
+    };
+    virtual PendingLogin<Patient> beginLoginPatient(const std::string& email, const std::string& password) = 0;
+    virtual PendingLogin<Doctor> beginLoginDoctor(const std::string& email, const std::string& password) = 0;
+    virtual PendingLogin<Staff> beginLoginStaff(const std::string& email, const std::string& password) = 0;
+    virtual PendingLogin<Admin> beginLoginAdmin(const std::string& email, const std::string& password) = 0;
+    virtual std::optional<Patient> loginPatient(const std::string& email, const std::string& password) = 0;
+    virtual std::optional<Doctor> loginDoctor(const std::string& email, const std::string& password) = 0;
+    virtual std::optional<Staff> loginStaff(const std::string& email, const std::string& password) = 0;
+    virtual std::optional<Admin> loginAdmin(const std::string& email, const std::string& password) = 0;
+
+    // Hash every remaining plaintext password; returns rows updated, -1 on error
+    virtual int migratePlaintextPasswords() = 0;
+    virtual PasswordVerifier::Stats getPasswordStats() const = 0;
+
+    // Patient operations
+    // Insert methods return the generated ID, or nullopt on failure
+    virtual std::optional<int> registerPatient(const std::string& name, const std::string& phone,
+                                               const std::string& email, const std::string& address,
+                                               const std::string& dob, const std::string& gender,
+                                               const std::string& password) = 0;
+    virtual Patient getPatientById(int patientID) = 0;
+    virtual bool updatePatient(int patientID, const std::string& name, const std::string& phone,
+                               const std::string& email, const std::string& address) = 0;
+    virtual bool deletePatient(int patientID) = 0;
+    // Substring match on name, email or phone, ordered by name
+    virtual std::vector<Patient> searchPatients(const std::string& search) = 0;
+    // Typeahead: up to limit (max 100) patients whose name has a word
+    // starting with prefix, or whose phone starts with its digits
+    virtual std::vector<Patient> suggestPatients(const std::string& prefix, size_t limit) = 0;
+    virtual PatientSearchIndex::Stats getPatientSearchStats() const = 0;
+
+    // Keyset pagination over patients in (PatientName, PatientID) order.
+    // A default cursor starts at the first patient.
+    struct PatientCursor {
+        std::string patientName;
+        int patientID;
+        PatientCursor() : patientID(0) {}
+    };
+    struct PatientPage {
+        std::vector<Patient> patients;
+        PatientCursor next; // Cursor for the following page
+        bool hasMore;
+        PatientPage() : hasMore(false) {}
+    };
+    virtual PatientPage getPatientsPage(const PatientCursor& after, int pageSize) = 0;
+
+    // Doctor operations
+    virtual Doctor getDoctorById(int doctorID) = 0;
+    virtual std::vector<Doctor> getAllDoctors(bool availableOnly = false) = 0;
+    virtual std::optional<int> addDoctor(const std::string& name, const std::string& specialty,
+                                         const std::string& room, const std::string& phone,
+                                         const std::string& email, const std::string& password) = 0;
+    virtual bool updateDoctor(int doctorID, const std::string& name, const std::string& specialty,
+                              const std::string& room, const std::string& phone) = 0;
+    virtual bool updateDoctorAvailability(int doctorID, bool isAvailable) = 0;
+    virtual bool deleteDoctor(int doctorID) = 0;
+    virtual DoctorCache::Stats getDoctorCacheStats() const = 0;
+
+    // Staff operations
+    virtual Staff getStaffById(int staffID) = 0;
+    virtual std::vector<Staff> getAllStaff() = 0;
+    virtual std::optional<int> addStaff(const std::string& name, const std::string& department,
+                                        const std::string& phone, const std::string& email,
+                                        const std::string& password) = 0;
+    virtual bool deleteStaff(int staffID) = 0;
+
+    // Admin operations
+    virtual Admin getAdminById(int adminID) = 0;
+
+    // Appointment operations
+    virtual std::optional<int> createAppointment(int patientID, int doctorID, const Date& date,
+                                                 const TimeOfDay& time, const std::string& reason,
+                                                 int duration, double consultationFee, double medicineFee) = 0;
+
+    // Check-and-insert as one atomic step: a doctor's active appointments
+    // may not overlap (SlotTaken), and a patient holds at most one
+    // non-cancelled appointment per doctor per day (DailyLimitReached)
+    struct BookingResult {
+        enum Outcome { Booked, SlotTaken, DailyLimitReached, Failed };
+        Outcome outcome;
+        int appointmentID; // Set when outcome == Booked
+        BookingResult() : outcome(Failed), appointmentID(0) {}
+    };
+    virtual BookingResult bookAppointmentAtomic(int patientID, int doctorID, const Date& date,
+                                                const TimeOfDay& time, const std::string& reason,
+                                                int duration, double consultationFee, double medicineFee) = 0;
+    // Bulk import (see AppointmentImporter): rows are inserted in a single
+    // transaction. A row the booking rules reject (unknown patient, slot or
+    // patient-day already taken) is dropped and reported with its position
+    // in rows; if the transaction itself fails, every row is.
+    struct ImportRow {
+        int patientID;
+        int doctorID;
+        Date date;
+        TimeOfDay time;
+        std::string reason;
+        int duration;
+        double consultationFee;
+        double medicineFee;
+        ImportRow() : patientID(0), doctorID(0), duration(0), consultationFee(0.0), medicineFee(0.0) {}
+    };
+    struct ImportFailure {
+        size_t row;
+        std::string reason;
+    };
+    virtual std::vector<ImportFailure> importAppointments(const std::vector<ImportRow>& rows) = 0;
+    virtual std::vector<Appointment> getPatientAppointments(int patientID) = 0;
+    // Every date when date is left invalid
+    virtual std::vector<Appointment> getDoctorAppointments(int doctorID, const Date& date = Date()) = 0;
+    virtual std::vector<Appointment> getDoctorAllAppointments(int doctorID) = 0;
+    virtual std::vector<Appointment> getAllAppointments() = 0;
+    // The same rows in the same order as fixed-size records sharing one
+    // copy of each name and reason; for results too large to hold as
+    // Appointment objects
+    virtual AppointmentList getAllAppointmentsCompact() = 0;
+    virtual std::vector<Appointment> getAppointmentsByDateRange(const Date& startDate, const Date& endDate) = 0;
+    // Every appointment dated startDate..endDate, in date/time/ID order,
+    // handed to onRow one at a time so memory stays flat however many rows
+    // match. onRow returns false to stop early. Returns the rows delivered,
+    // or -1 on error.
+    virtual long long streamAppointmentsByDateRange(const Date& startDate, const Date& endDate,
+                                                    const std::function<bool(const Appointment&)>& onRow) = 0;
+    virtual std::vector<Appointment> getTodayAppointments() = 0;
+    virtual std::vector<Appointment> getWeeklyAppointments() = 0;
+    virtual std::vector<Appointment> getMonthlyAppointments() = 0;
+    virtual std::vector<Appointment> getPendingAppointments() = 0;
+
+    // Keyset pagination over appointments, newest first by
+    // (AppointmentDate, AppointmentTime, AppointmentID). A default cursor
+    // starts at the newest.
+    struct AppointmentCursor {
+        Date appointmentDate;
+        TimeOfDay appointmentTime;
+        int appointmentID;
+        AppointmentCursor() : appointmentDate(Date::fromCivil(9999, 12, 31)),
+                              appointmentTime(TimeOfDay::fromMinutes(23 * 60 + 59)), appointmentID(2147483647) {}
+    };
+    struct AppointmentPage {
+        std::vector<Appointment> appointments;
+        AppointmentCursor next; // Cursor for the following page
+        bool hasMore;
+        AppointmentPage() : hasMore(false) {}
+    };
+    virtual AppointmentPage getAppointmentsPage(const AppointmentCursor& after, int pageSize) = 0;
+    virtual AppointmentPage getDoctorAppointmentsPage(int doctorID, const AppointmentCursor& after, int pageSize) = 0;
+    virtual Appointment getAppointmentById(int appointmentID) = 0;
+    // Moves an appointment that is still in status from to status to.
+    // Transitions AppointmentStatus::canBecome() forbids are refused
+    // without touching storage; false too if the appointment has moved on
+    virtual bool updateAppointmentStatus(int appointmentID, AppointmentStatus from, AppointmentStatus to) = 0;
+    virtual bool cancelAppointment(int appointmentID) = 0; // From whatever status it is in
+    // True when [time, time + duration) overlaps none of the doctor's
+    // Pending/Confirmed appointments
+    virtual bool checkDoctorAvailability(int doctorID, const Date& date, const TimeOfDay& time,
+                                         int duration = DoctorSlotIndex::SLOT_MINUTES) = 0;
+    // Earliest free starts (by date, then time) over days days from fromDate
+    // for the given doctors, or for every available doctor in a specialty.
+    // notBefore limits starts on fromDate itself unless left invalid.
+    // Empty when nothing fits or fromDate is in the past.
+    virtual std::vector<DoctorSlotIndex::FreeSlot> findFreeSlots(const std::vector<int>& doctorIDs,
+                                                                 const Date& fromDate,
+                                                                 const TimeOfDay& notBefore, int duration,
+                                                                 int days, size_t count) = 0;
+    virtual std::vector<DoctorSlotIndex::FreeSlot> findFreeSlotsInSpecialty(const std::string& specialty,
+                                                                            const Date& fromDate,
+                                                                            const TimeOfDay& notBefore,
+                                                                            int duration, int days, size_t count) = 0;
+    virtual DoctorSlotIndex::Stats getSlotIndexStats() const = 0;
+    virtual bool checkPatientDailyLimit(int patientID, int doctorID, const Date& date) = 0;
+    virtual double calculateConsultationFee(int duration) = 0; // RM1 per minute
+    virtual double calculateMedicineFee(const std::string& reason) = 0; // Calculate medicine fee based on reason
+
+    // Activity logging
+    virtual bool logActivity(const std::string& userType, int userID,
+                             const std::string& action, const std::string& details = "") = 0;
+    virtual ActivityLogWriter::Stats getActivityLogStats() const = 0;
+    virtual std::vector<ActivityLog> getActivityLogs(int limit = 50) = 0;
+
+    // Grade A: Complex Calculations (Aggregations)
+    struct DoctorStats {
+        int doctorID;
+        std::string doctorName;
+        int totalAppointments;
+        int confirmedCount;
+        double completionRate;
+        DoctorStats() : doctorID(0), totalAppointments(0), confirmedCount(0), completionRate(0.0) {}
+    };
+    virtual std::vector<DoctorStats> getDoctorStatistics() = 0; // Every doctor, busiest first
+
+    struct MonthlyStats {
+        int year;
+        int month;
+        int totalAppointments;
+        int completed;
+        double completionPercentage;
+        MonthlyStats() : year(0), month(0), totalAppointments(0), completed(0), completionPercentage(0.0) {}
+    };
+    virtual std::vector<MonthlyStats> getMonthlyStatistics() = 0; // Newest month first
+
+    struct DailyStats {
+        std::string date;
+        int total;
+        int confirmed;
+        int pending;
+        int completed;
+        int cancelled;
+        DailyStats() : total(0), confirmed(0), pending(0), completed(0), cancelled(0) {}
+    };
+    virtual std::vector<DailyStats> getDailyStatistics() = 0; // Last 30 days
+    virtual std::vector<DailyStats> getWeeklyDailyStatistics() = 0; // Last 7 days
+
+    struct RevenueStats {
+        double totalRevenue;
+        double potentialRevenue;
+        double averageCost;
+        double totalConsultation;
+        double totalMedicine;
+        RevenueStats() : totalRevenue(0.0), potentialRevenue(0.0), averageCost(0.0),
+                        totalConsultation(0.0), totalMedicine(0.0) {}
+    };
+    virtual RevenueStats getRevenueStatistics() = 0;
+
+    // Status counts and fee sums for a date window
+    struct AppointmentSummary {
+        int total;
+        int pending;
+        int confirmed;
+        int completed;
+        int cancelled;
+        double completedRevenue;      // TotalCost of completed appointments
+        double completedConsultation;
+        double completedMedicine;
+        double potentialRevenue;      // TotalCost of pending + confirmed appointments
+        AppointmentSummary() : total(0), pending(0), confirmed(0), completed(0), cancelled(0),
+                               completedRevenue(0.0), completedConsultation(0.0),
+                               completedMedicine(0.0), potentialRevenue(0.0) {}
+    };
+    // lastDays < 0: all appointments; 0: today; N: the last N days up to today
+    virtual AppointmentSummary getAppointmentSummary(int lastDays = -1) = 0;
+    // The same totals over one doctor's appointments, every date
+    virtual AppointmentSummary getDoctorAppointmentSummary(int doctorID) = 0;
+
+    struct SystemCounts {
+        int patients;
+        int doctors;
+        int availableDoctors;
+        int staff;
+        SystemCounts() : patients(0), doctors(0), availableDoctors(0), staff(0) {}
+    };
+    virtual SystemCounts getSystemCounts() = 0;
+
+    // Rollup maintenance: verify lists every doctor-day where the statistics
+    // rollup disagrees with a recount, rebuild replaces it with a recount.
+    // Engines that count on demand have nothing to drift.
+    struct RollupDrift {
+        int doctorID;
+        std::string date;
+        int pending;     // Rollup minus recount
+        int confirmed;
+        int completed;
+        int cancelled;
+        double completedRevenue;
+        double openRevenue;
+        RollupDrift() : doctorID(0), pending(0), confirmed(0), completed(0), cancelled(0),
+                        completedRevenue(0.0), openRevenue(0.0) {}
+    };
+    virtual bool verifyStatisticsRollup(std::vector<RollupDrift>& drift) = 0; // False if the check could not run
+    virtual bool rebuildStatisticsRollup() = 0;
+
+    // Index regression check: the query plan of each hot query as the
+    // application issues it. Empty when the engine has no planner.
+    struct QueryPlan {
+        std::string method;      // Method that issues the query
+        std::string table;       // Table (or alias) the plan row describes
+        std::string accessType;  // EXPLAIN type: const, ref, range, index, ALL ...
+        std::string key;         // Index chosen, empty when none
+        std::string extra;
+        long long estimatedRows;
+        long long tableRows;
+        bool indexed;            // A key is used and the table is not fully scanned
+        QueryPlan() : estimatedRows(0), tableRows(0), indexed(false) {}
+    };
+    virtual std::vector<QueryPlan> explainHotQueries() = 0;
+
+    // Microbenchmark: by-name getters on SELECT a.* versus RowMapper<Appointment>
+    // over the same rows. Fetch = executeQuery (transfer), Map = row loop only.
+    // rows == 0 when the engine has no result sets to map.
+    struct RowMappingBenchmark {
+        int rows;
+        double byNameFetchMs;
+        double byNameMapMs;
+        double positionalFetchMs;
+        double positionalMapMs;
+        RowMappingBenchmark() : rows(0), byNameFetchMs(0.0), byNameMapMs(0.0),
+                                positionalFetchMs(0.0), positionalMapMs(0.0) {}
+    };
+    virtual RowMappingBenchmark benchmarkRowMapping(int rowLimit = 100000) = 0;
+
+protected:
+    // Completes a PendingLogin whose verdict has arrived: false unless the
+    // password matched. May upgrade the stored hash (see PasswordHasher::needsRehash).
+    virtual bool finishLogin(const char* table, const char* idColumn, int id, const std::string& password,
+                             const std::string& stored, std::future<bool>& verdict) = 0;
+
+    // For begin* implementations: a login that get() completes through
+    // finishLogin on this engine
+    template <typename Model>
+    PendingLogin<Model> pendingLogin(const char* table, const char* idColumn, int id, const Model& model,
+                                     const std::string& password, const std::string& stored,
+                                     std::future<bool> verdict) {
+        PendingLogin<Model> pending;
+        pending.owner = this;
+        pending.table = table;
+        pending.idColumn = idColumn;
+        pending.id = id;
+        pending.model = model;
+        pending.password = password;
+        pending.stored = stored;
+        pending.verdict = std::move(verdict);
+        return pending;
+    }
+};
+
+#endif // STORAGE_ENGINE_H
@@ -0,0 +1,39 @@
+-- ============================================================
+-- 001_appointment_indexes.sql
+-- Hospital Appointment Booking System
+-- ============================================================
+-- Adds the composite/covering indexes behind the hot Appointment
+-- queries and the ActivityLog listing to a database created from an
+-- older database_setup.sql. Fresh installs already have them.
+-- Run once:  mysql -u root hospital_appointment_db < migrations/001_appointment_indexes.sql
+-- Verify:    workshop1_adang.exe --check-indexes
+-- ============================================================
+
+USE hospital_appointment_db;
+
+-- checkDoctorAvailability: DoctorID = ? AND AppointmentDate = ? AND AppointmentTime = ?
+-- AND Status NOT IN (...). Status is included so the count never touches the rows.
+ALTER TABLE Appointment
+    ADD INDEX idx_appt_doctor_slot (DoctorID, AppointmentDate, AppointmentTime, Status);
+
+-- checkPatientDailyLimit: PatientID = ? AND DoctorID = ? AND AppointmentDate = ?
+-- AND Status NOT IN (...), covering for the same reason
+ALTER TABLE Appointment
+    ADD INDEX idx_appt_patient_doctor_date (PatientID, DoctorID, AppointmentDate, Status);
+
+-- getTodayAppointments / getWeeklyAppointments / getMonthlyAppointments /
+-- getAppointmentsByDateRange: date window, rows come back in time order
+ALTER TABLE Appointment
+    ADD INDEX idx_appt_date_time (AppointmentDate, AppointmentTime);
+
+-- getDailyStatistics / getWeeklyDailyStatistics / vw_DailyAppointmentSummary:
+-- per-day status counts answered from the index
+ALTER TABLE Appointment
+    ADD INDEX idx_appt_date_status (AppointmentDate, Status);
+
+-- getActivityLogs: ORDER BY LogTime DESC LIMIT ? reads the newest entries
+-- from the end of the index instead of sorting the whole log
+ALTER TABLE ActivityLog
+    ADD INDEX idx_activitylog_logtime (LogTime);
+
+ANALYZE TABLE Appointment, ActivityLog;
@@ -0,0 +1,45 @@
+-- ============================================================
+-- 002_atomic_booking.sql
+-- Hospital Appointment Booking System
+-- ============================================================
+-- Moves the booking rules into the schema so a booking is one
+-- atomic INSERT instead of check-then-insert:
+--   * a doctor slot can be held by only one Pending/Confirmed appointment
+--   * a patient can hold only one non-cancelled appointment per doctor per day
+-- Generated columns are NULL once an appointment stops holding the
+-- slot/day, and UNIQUE keys ignore NULLs, so cancelled (and, for the
+-- slot, completed) rows never block a new booking.
+-- Needs MySQL 5.7+ or MariaDB 10.2+.
+--
+-- Existing double bookings make this migration fail. Find them first:
+--   SELECT DoctorID, AppointmentDate, AppointmentTime, COUNT(*) FROM Appointment
+--   WHERE Status IN ('Pending', 'Confirmed')
+--   GROUP BY DoctorID, AppointmentDate, AppointmentTime HAVING COUNT(*) > 1;
+-- ============================================================
+
+USE hospital_appointment_db;
+
+ALTER TABLE Appointment
+    ADD COLUMN ActiveSlot TINYINT AS (IF(Status IN ('Pending', 'Confirmed'), 1, NULL)) STORED,
+    ADD COLUMN ActiveDay TINYINT AS (IF(Status <> 'Cancelled', 1, NULL)) STORED,
+    ADD UNIQUE KEY uq_appt_active_slot (DoctorID, AppointmentDate, AppointmentTime, ActiveSlot),
+    ADD UNIQUE KEY uq_appt_patient_day (PatientID, DoctorID, AppointmentDate, ActiveDay);
+
+DROP PROCEDURE IF EXISTS sp_BookAppointment;
+
+DELIMITER //
+-- Book and return the new ID in a single round trip. A clash fails the
+-- INSERT with a duplicate-key error naming uq_appt_active_slot or
+-- uq_appt_patient_day; nothing is written in that case.
+CREATE PROCEDURE sp_BookAppointment(
+    IN pPatientID INT, IN pDoctorID INT, IN pDate DATE, IN pTime TIME,
+    IN pReason VARCHAR(100), IN pDuration INT,
+    IN pConsultationFee DECIMAL(10,2), IN pMedicineFee DECIMAL(10,2))
+BEGIN
+    INSERT INTO Appointment (PatientID, DoctorID, AppointmentDate, AppointmentTime, Reason,
+                             Duration, ConsultationFee, MedicineFee, TotalCost, Status)
+    VALUES (pPatientID, pDoctorID, pDate, pTime, pReason,
+            pDuration, pConsultationFee, pMedicineFee, pConsultationFee + pMedicineFee, 'Pending');
+    SELECT LAST_INSERT_ID() AS AppointmentID;
+END //
+DELIMITER ;
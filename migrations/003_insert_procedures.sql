@@ -0,0 +1,45 @@
+-- ============================================================
+-- 003_insert_procedures.sql
+-- Hospital Appointment Booking System
+-- ============================================================
+-- registerPatient / addDoctor / addStaff now CALL these procedures
+-- and read the new ID from the same round trip. createAppointment
+-- uses sp_BookAppointment from 002.
+-- ============================================================
+
+USE hospital_appointment_db;
+
+DROP PROCEDURE IF EXISTS sp_RegisterPatient;
+DROP PROCEDURE IF EXISTS sp_AddDoctor;
+DROP PROCEDURE IF EXISTS sp_AddStaff;
+
+DELIMITER //
+-- Insert-and-return-ID procedures: the row and its generated key come back
+-- from one CALL, so callers never need a follow-up SELECT LAST_INSERT_ID()
+CREATE PROCEDURE sp_RegisterPatient(
+    IN pName VARCHAR(50), IN pPhone VARCHAR(20), IN pEmail VARCHAR(30),
+    IN pAddress VARCHAR(100), IN pDOB DATE, IN pGender VARCHAR(10), IN pPassword VARCHAR(50))
+BEGIN
+    INSERT INTO Patient (PatientName, PhoneNumber, Email, Address, DOB, Gender, Password)
+    VALUES (pName, pPhone, pEmail, pAddress, pDOB, pGender, pPassword);
+    SELECT LAST_INSERT_ID() AS PatientID;
+END //
+
+CREATE PROCEDURE sp_AddDoctor(
+    IN pName VARCHAR(50), IN pSpecialty VARCHAR(20), IN pRoom VARCHAR(10),
+    IN pPhone VARCHAR(20), IN pEmail VARCHAR(30), IN pPassword VARCHAR(50))
+BEGIN
+    INSERT INTO Doctors (DoctorName, Specialty, RoomNo, PhoneNumber, Email, Password, IsAvailable)
+    VALUES (pName, pSpecialty, pRoom, pPhone, pEmail, pPassword, TRUE);
+    SELECT LAST_INSERT_ID() AS DoctorID;
+END //
+
+CREATE PROCEDURE sp_AddStaff(
+    IN pName VARCHAR(50), IN pDepartment VARCHAR(50), IN pPhone VARCHAR(20),
+    IN pEmail VARCHAR(30), IN pPassword VARCHAR(50))
+BEGIN
+    INSERT INTO Staff (StaffName, Department, PhoneNumber, Email, Password)
+    VALUES (pName, pDepartment, pPhone, pEmail, pPassword);
+    SELECT LAST_INSERT_ID() AS StaffID;
+END //
+DELIMITER ;
@@ -0,0 +1,16 @@
+-- ============================================================
+-- 004_patient_name_index.sql
+-- Hospital Appointment Booking System
+-- ============================================================
+-- getPatientsPage walks patients in (PatientName, PatientID) order
+-- one page at a time. InnoDB secondary indexes carry the primary key,
+-- so this index already has that order and each page is a short
+-- range read. Appointment pages use idx_appt_date_time from 001.
+-- ============================================================
+
+USE hospital_appointment_db;
+
+ALTER TABLE Patient
+    ADD INDEX idx_patient_name (PatientName);
+
+ANALYZE TABLE Patient;
@@ -0,0 +1,128 @@
+-- ============================================================
+-- 005_statistics_rollup.sql
+-- Hospital Appointment Booking System
+-- ============================================================
+-- DoctorDailyStats holds per-doctor, per-day status counts and fee
+-- sums. Triggers on Appointment keep it current on every insert,
+-- status change and delete (createAppointment, bookAppointmentAtomic,
+-- updateAppointmentStatus, cancelAppointment, deletePatient), and the
+-- statistics methods read it instead of scanning Appointment.
+--
+-- Deleting a doctor cascades to both Appointment and DoctorDailyStats
+-- (FK cascades do not fire triggers, so the rollup row goes directly).
+--
+-- sp_RebuildDoctorDailyStats recounts from Appointment; it is called
+-- at the end of this script and by "--rebuild-rollups".
+-- ============================================================
+
+USE hospital_appointment_db;
+
+DROP TRIGGER IF EXISTS trg_appointment_stats_insert;
+DROP TRIGGER IF EXISTS trg_appointment_stats_update;
+DROP TRIGGER IF EXISTS trg_appointment_stats_delete;
+DROP PROCEDURE IF EXISTS sp_ApplyDoctorDailyStats;
+DROP PROCEDURE IF EXISTS sp_RebuildDoctorDailyStats;
+DROP TABLE IF EXISTS DoctorDailyStats;
+
+CREATE TABLE DoctorDailyStats (
+    DoctorID INT NOT NULL,
+    StatDate DATE NOT NULL,
+    Pending INT NOT NULL DEFAULT 0,
+    Confirmed INT NOT NULL DEFAULT 0,
+    Completed INT NOT NULL DEFAULT 0,
+    Cancelled INT NOT NULL DEFAULT 0,
+    CompletedConsultation DECIMAL(14,2) NOT NULL DEFAULT 0.00,
+    CompletedMedicine DECIMAL(14,2) NOT NULL DEFAULT 0.00,
+    CompletedRevenue DECIMAL(14,2) NOT NULL DEFAULT 0.00,
+    -- TotalCost of Pending + Confirmed appointments
+    OpenRevenue DECIMAL(14,2) NOT NULL DEFAULT 0.00,
+    PRIMARY KEY (DoctorID, StatDate),
+    -- Date-window reads (daily, weekly, monthly, report summaries)
+    INDEX idx_dds_date (StatDate),
+    FOREIGN KEY (DoctorID) REFERENCES Doctors(DoctorID) ON DELETE CASCADE
+) ENGINE=InnoDB;
+
+DELIMITER //
+-- Add (pSign = 1) or remove (pSign = -1) one appointment's contribution
+CREATE PROCEDURE sp_ApplyDoctorDailyStats(
+    IN pDoctorID INT, IN pDate DATE, IN pStatus VARCHAR(20),
+    IN pConsultationFee DECIMAL(10,2), IN pMedicineFee DECIMAL(10,2),
+    IN pTotalCost DECIMAL(10,2), IN pSign INT)
+BEGIN
+    INSERT INTO DoctorDailyStats (DoctorID, StatDate, Pending, Confirmed, Completed, Cancelled,
+                                  CompletedConsultation, CompletedMedicine, CompletedRevenue, OpenRevenue)
+    VALUES (pDoctorID, pDate,
+            pSign * (pStatus = 'Pending'), pSign * (pStatus = 'Confirmed'),
+            pSign * (pStatus = 'Completed'), pSign * (pStatus = 'Cancelled'),
+            IF(pStatus = 'Completed', pSign * pConsultationFee, 0),
+            IF(pStatus = 'Completed', pSign * pMedicineFee, 0),
+            IF(pStatus = 'Completed', pSign * pTotalCost, 0),
+            IF(pStatus IN ('Pending', 'Confirmed'), pSign * pTotalCost, 0))
+    ON DUPLICATE KEY UPDATE
+        Pending = Pending + VALUES(Pending),
+        Confirmed = Confirmed + VALUES(Confirmed),
+        Completed = Completed + VALUES(Completed),
+        Cancelled = Cancelled + VALUES(Cancelled),
+        CompletedConsultation = CompletedConsultation + VALUES(CompletedConsultation),
+        CompletedMedicine = CompletedMedicine + VALUES(CompletedMedicine),
+        CompletedRevenue = CompletedRevenue + VALUES(CompletedRevenue),
+        OpenRevenue = OpenRevenue + VALUES(OpenRevenue);
+END //
+
+-- Recount every doctor-day from Appointment in one transaction
+CREATE PROCEDURE sp_RebuildDoctorDailyStats()
+BEGIN
+    DECLARE EXIT HANDLER FOR SQLEXCEPTION
+    BEGIN
+        ROLLBACK;
+        RESIGNAL;
+    END;
+    START TRANSACTION;
+    DELETE FROM DoctorDailyStats;
+    INSERT INTO DoctorDailyStats (DoctorID, StatDate, Pending, Confirmed, Completed, Cancelled,
+                                  CompletedConsultation, CompletedMedicine, CompletedRevenue, OpenRevenue)
+    SELECT DoctorID, AppointmentDate,
+           SUM(Status = 'Pending'), SUM(Status = 'Confirmed'),
+           SUM(Status = 'Completed'), SUM(Status = 'Cancelled'),
+           SUM(IF(Status = 'Completed', ConsultationFee, 0)),
+           SUM(IF(Status = 'Completed', MedicineFee, 0)),
+           SUM(IF(Status = 'Completed', TotalCost, 0)),
+           SUM(IF(Status IN ('Pending', 'Confirmed'), TotalCost, 0))
+    FROM Appointment
+    GROUP BY DoctorID, AppointmentDate;
+    COMMIT;
+END //
+
+CREATE TRIGGER trg_appointment_stats_insert AFTER INSERT ON Appointment
+FOR EACH ROW
+BEGIN
+    CALL sp_ApplyDoctorDailyStats(NEW.DoctorID, NEW.AppointmentDate, NEW.Status,
+                                  NEW.ConsultationFee, NEW.MedicineFee, NEW.TotalCost, 1);
+END //
+
+CREATE TRIGGER trg_appointment_stats_update AFTER UPDATE ON Appointment
+FOR EACH ROW
+BEGIN
+    -- Only changes that move a count or a fee sum touch the rollup
+    IF NOT (OLD.Status <=> NEW.Status AND OLD.DoctorID <=> NEW.DoctorID
+            AND OLD.AppointmentDate <=> NEW.AppointmentDate
+            AND OLD.ConsultationFee <=> NEW.ConsultationFee
+            AND OLD.MedicineFee <=> NEW.MedicineFee
+            AND OLD.TotalCost <=> NEW.TotalCost) THEN
+        CALL sp_ApplyDoctorDailyStats(OLD.DoctorID, OLD.AppointmentDate, OLD.Status,
+                                      OLD.ConsultationFee, OLD.MedicineFee, OLD.TotalCost, -1);
+        CALL sp_ApplyDoctorDailyStats(NEW.DoctorID, NEW.AppointmentDate, NEW.Status,
+                                      NEW.ConsultationFee, NEW.MedicineFee, NEW.TotalCost, 1);
+    END IF;
+END //
+
+CREATE TRIGGER trg_appointment_stats_delete AFTER DELETE ON Appointment
+FOR EACH ROW
+BEGIN
+    CALL sp_ApplyDoctorDailyStats(OLD.DoctorID, OLD.AppointmentDate, OLD.Status,
+                                  OLD.ConsultationFee, OLD.MedicineFee, OLD.TotalCost, -1);
+END //
+DELIMITER ;
+
+-- Seed from the existing appointments
+CALL sp_RebuildDoctorDailyStats();
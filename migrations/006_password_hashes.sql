@@ -0,0 +1,52 @@
+-- ============================================================
+-- 006_password_hashes.sql
+-- Hospital Appointment Booking System
+-- ============================================================
+-- Passwords are now stored as salted scrypt hashes of the form
+-- $scrypt$ln=14,r=8,p=1$<salt>$<key> (about 90 characters), so the
+-- Password columns and the insert procedures' parameters are widened.
+--
+-- Existing plaintext passwords keep working: each row is rehashed on
+-- its owner's next successful login. To hash every remaining row at
+-- once, run "workshop1_adang.exe --migrate-passwords".
+-- ============================================================
+
+USE hospital_appointment_db;
+
+ALTER TABLE Admin MODIFY Password VARCHAR(255) NOT NULL;
+ALTER TABLE Doctors MODIFY Password VARCHAR(255) NOT NULL DEFAULT 'doc123';
+ALTER TABLE Staff MODIFY Password VARCHAR(255) NOT NULL DEFAULT 'staff123';
+ALTER TABLE Patient MODIFY Password VARCHAR(255) NOT NULL;
+
+DROP PROCEDURE IF EXISTS sp_RegisterPatient;
+DROP PROCEDURE IF EXISTS sp_AddDoctor;
+DROP PROCEDURE IF EXISTS sp_AddStaff;
+
+DELIMITER //
+CREATE PROCEDURE sp_RegisterPatient(
+    IN pName VARCHAR(50), IN pPhone VARCHAR(20), IN pEmail VARCHAR(30),
+    IN pAddress VARCHAR(100), IN pDOB DATE, IN pGender VARCHAR(10), IN pPassword VARCHAR(255))
+BEGIN
+    INSERT INTO Patient (PatientName, PhoneNumber, Email, Address, DOB, Gender, Password)
+    VALUES (pName, pPhone, pEmail, pAddress, pDOB, pGender, pPassword);
+    SELECT LAST_INSERT_ID() AS PatientID;
+END //
+
+CREATE PROCEDURE sp_AddDoctor(
+    IN pName VARCHAR(50), IN pSpecialty VARCHAR(20), IN pRoom VARCHAR(10),
+    IN pPhone VARCHAR(20), IN pEmail VARCHAR(30), IN pPassword VARCHAR(255))
+BEGIN
+    INSERT INTO Doctors (DoctorName, Specialty, RoomNo, PhoneNumber, Email, Password, IsAvailable)
+    VALUES (pName, pSpecialty, pRoom, pPhone, pEmail, pPassword, TRUE);
+    SELECT LAST_INSERT_ID() AS DoctorID;
+END //
+
+CREATE PROCEDURE sp_AddStaff(
+    IN pName VARCHAR(50), IN pDepartment VARCHAR(50), IN pPhone VARCHAR(20),
+    IN pEmail VARCHAR(30), IN pPassword VARCHAR(255))
+BEGIN
+    INSERT INTO Staff (StaffName, Department, PhoneNumber, Email, Password)
+    VALUES (pName, pDepartment, pPhone, pEmail, pPassword);
+    SELECT LAST_INSERT_ID() AS StaffID;
+END //
+DELIMITER ;
@@ -0,0 +1,19 @@
+-- ============================================================
+-- 007_slot_overlap_index.sql
+-- Hospital Appointment Booking System
+-- ============================================================
+-- checkDoctorAvailability now asks whether a requested interval
+-- overlaps any active appointment, which needs each candidate's
+-- Duration. Adding it to idx_appt_doctor_slot keeps the check
+-- answered from the index alone. (Days from today onwards are served
+-- from the in-memory slot bitmaps; this query covers earlier days.)
+-- Verify:    workshop1_adang.exe --check-indexes
+-- ============================================================
+
+USE hospital_appointment_db;
+
+ALTER TABLE Appointment
+    DROP INDEX idx_appt_doctor_slot,
+    ADD INDEX idx_appt_doctor_slot (DoctorID, AppointmentDate, AppointmentTime, Status, Duration);
+
+ANALYZE TABLE Appointment;
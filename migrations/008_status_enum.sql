@@ -0,0 +1,26 @@
+-- ============================================================
+-- 008_status_enum.sql
+-- Hospital Appointment Booking System
+-- ============================================================
+-- Appointment.Status becomes a one-byte ENUM. The application now
+-- reads it as Status + 0 and binds and filters it by position
+-- (1 Pending, 2 Confirmed, 3 Completed, 4 Cancelled), so status
+-- checks compare small integers instead of strings. The views,
+-- triggers and procedures keep comparing names, which ENUM still
+-- accepts.
+--
+-- Status changes are validated by the application: Pending ->
+-- Confirmed -> Completed, or Cancelled from any other status.
+-- Any status outside the four is set to Cancelled first (through the
+-- rollup triggers), so the conversion cannot fail.
+-- ============================================================
+
+USE hospital_appointment_db;
+
+UPDATE Appointment SET Status = 'Cancelled'
+WHERE Status NOT IN ('Pending', 'Confirmed', 'Completed', 'Cancelled');
+
+ALTER TABLE Appointment
+    MODIFY Status ENUM('Pending', 'Confirmed', 'Completed', 'Cancelled') NOT NULL DEFAULT 'Pending';
+
+ANALYZE TABLE Appointment;
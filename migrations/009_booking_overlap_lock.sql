@@ -0,0 +1,65 @@
+-- ============================================================
+-- 009_booking_overlap_lock.sql
+-- Hospital Appointment Booking System
+-- ============================================================
+-- The unique keys from 002 only stop two bookings at the same start
+-- time. sp_BookAppointment now also refuses a booking whose duration
+-- overlaps an active appointment. It locks the doctor's row for the
+-- check and the insert, so two sessions can no longer both pass the
+-- check. importAppointments takes the same lock for each doctor in a
+-- chunk and applies the same rule.
+--
+-- Existing overlaps are left alone. Find them with:
+--   SELECT a.AppointmentID, b.AppointmentID FROM Appointment a
+--   JOIN Appointment b ON a.DoctorID = b.DoctorID AND a.AppointmentDate = b.AppointmentDate
+--    AND a.AppointmentID < b.AppointmentID
+--    AND a.AppointmentTime < ADDTIME(b.AppointmentTime, SEC_TO_TIME(b.Duration * 60))
+--    AND b.AppointmentTime < ADDTIME(a.AppointmentTime, SEC_TO_TIME(a.Duration * 60))
+--   WHERE a.Status IN ('Pending', 'Confirmed') AND b.Status IN ('Pending', 'Confirmed');
+-- ============================================================
+
+USE hospital_appointment_db;
+
+DROP PROCEDURE IF EXISTS sp_BookAppointment;
+
+DELIMITER //
+-- Book and return the new ID in a single round trip. The doctor's row is
+-- locked first, so bookings (and imports) for one doctor take turns; with
+-- it held, a request overlapping an active appointment's duration is
+-- refused with an error whose text contains "slot overlap". A clash on
+-- the start time or the patient-day fails the INSERT with a duplicate-key
+-- error naming uq_appt_active_slot or uq_appt_patient_day. Nothing is
+-- written in either case.
+CREATE PROCEDURE sp_BookAppointment(
+    IN pPatientID INT, IN pDoctorID INT, IN pDate DATE, IN pTime TIME,
+    IN pReason VARCHAR(100), IN pDuration INT,
+    IN pConsultationFee DECIMAL(10,2), IN pMedicineFee DECIMAL(10,2))
+BEGIN
+    DECLARE vDoctorID INT;
+    DECLARE vOverlaps INT DEFAULT 0;
+    DECLARE EXIT HANDLER FOR SQLEXCEPTION
+    BEGIN
+        ROLLBACK;
+        RESIGNAL;
+    END;
+
+    START TRANSACTION;
+    SELECT DoctorID INTO vDoctorID FROM Doctors WHERE DoctorID = pDoctorID FOR UPDATE;
+    SELECT COUNT(*) INTO vOverlaps FROM Appointment
+    WHERE DoctorID = pDoctorID AND AppointmentDate = pDate
+      AND Status IN ('Pending', 'Confirmed')
+      AND AppointmentTime < ADDTIME(pTime, SEC_TO_TIME(pDuration * 60))
+      AND ADDTIME(AppointmentTime, SEC_TO_TIME(Duration * 60)) > pTime
+    FOR UPDATE;
+    IF vOverlaps > 0 THEN
+        SIGNAL SQLSTATE '45000' SET MESSAGE_TEXT = 'Doctor already has an appointment at this time (slot overlap)';
+    END IF;
+
+    INSERT INTO Appointment (PatientID, DoctorID, AppointmentDate, AppointmentTime, Reason,
+                             Duration, ConsultationFee, MedicineFee, TotalCost, Status)
+    VALUES (pPatientID, pDoctorID, pDate, pTime, pReason,
+            pDuration, pConsultationFee, pMedicineFee, pConsultationFee + pMedicineFee, 'Pending');
+    COMMIT;
+    SELECT LAST_INSERT_ID() AS AppointmentID;
+END //
+DELIMITER ;
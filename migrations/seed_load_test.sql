@@ -0,0 +1,63 @@
+-- ============================================================
+-- seed_load_test.sql - 1M Appointment Rows for Index Checks
+-- Hospital Appointment Booking System
+-- ============================================================
+-- Adds 200 doctors, 10,000 patients and 1,000,000 appointments
+-- (32 fifteen-minute slots per doctor per day, no double bookings)
+-- so that `workshop1_adang.exe --check-indexes` runs against
+-- realistic cardinalities. Load into a scratch copy of the
+-- database only. Needs MySQL 8.0+ or MariaDB 10.2+ (WITH).
+-- ============================================================
+
+USE hospital_appointment_db;
+
+INSERT INTO Doctors (DoctorName, Specialty, PhoneNumber, Email, RoomNo, Password, IsAvailable)
+WITH digits AS (
+    SELECT 0 AS d UNION ALL SELECT 1 UNION ALL SELECT 2 UNION ALL SELECT 3 UNION ALL SELECT 4
+    UNION ALL SELECT 5 UNION ALL SELECT 6 UNION ALL SELECT 7 UNION ALL SELECT 8 UNION ALL SELECT 9
+)
+SELECT CONCAT('Dr. Load ', n),
+       ELT(1 + n % 4, 'Cardiology', 'Pediatrics', 'Dermatology', 'Orthopedics'),
+       CONCAT('081', LPAD(n, 7, '0')), CONCAT('ltdoc', n, '@load.test'),
+       CONCAT('L', n), 'doc123', TRUE
+FROM (SELECT a.d + b.d * 10 + c.d * 100 AS n FROM digits a, digits b, digits c) numbers
+WHERE n < 200;
+
+INSERT INTO Patient (PatientName, PhoneNumber, Email, Address, DOB, Gender, Password)
+WITH digits AS (
+    SELECT 0 AS d UNION ALL SELECT 1 UNION ALL SELECT 2 UNION ALL SELECT 3 UNION ALL SELECT 4
+    UNION ALL SELECT 5 UNION ALL SELECT 6 UNION ALL SELECT 7 UNION ALL SELECT 8 UNION ALL SELECT 9
+)
+SELECT CONCAT('Load Patient ', n), CONCAT('082', LPAD(n, 7, '0')), CONCAT('ltpat', n, '@load.test'),
+       'Load test address', DATE_SUB('2000-01-01', INTERVAL n % 20000 DAY),
+       ELT(1 + n % 2, 'Male', 'Female'), 'patient123'
+FROM (SELECT a.d + b.d * 10 + c.d * 100 + e.d * 1000 AS n FROM digits a, digits b, digits c, digits e) numbers;
+
+SET @firstDoctor = (SELECT MIN(DoctorID) FROM Doctors WHERE Email LIKE 'ltdoc%@load.test');
+SET @firstPatient = (SELECT MIN(PatientID) FROM Patient WHERE Email LIKE 'ltpat%@load.test');
+
+-- n -> (doctor = n mod 200, slot = n div 200 mod 32, day = n div 6400), so every
+-- (DoctorID, AppointmentDate, AppointmentTime) is unique; dates span ~156 days around today
+INSERT INTO Appointment (PatientID, DoctorID, AppointmentDate, AppointmentTime, Reason,
+                         Duration, ConsultationFee, MedicineFee, TotalCost, Status)
+WITH digits AS (
+    SELECT 0 AS d UNION ALL SELECT 1 UNION ALL SELECT 2 UNION ALL SELECT 3 UNION ALL SELECT 4
+    UNION ALL SELECT 5 UNION ALL SELECT 6 UNION ALL SELECT 7 UNION ALL SELECT 8 UNION ALL SELECT 9
+)
+SELECT @firstPatient + (n * 7919) % 10000,
+       @firstDoctor + n % 200,
+       DATE_ADD(CURDATE(), INTERVAL (n DIV 6400) - 78 DAY),
+       SEC_TO_TIME((9 * 60 + ((n DIV 200) % 32) * 15) * 60),
+       'Load test', 15, 15.00, 30.00, 45.00,
+       ELT(1 + n % 4, 'Pending', 'Confirmed', 'Completed', 'Cancelled')
+FROM (
+    SELECT a.d + b.d * 10 + c.d * 100 + e.d * 1000 + f.d * 10000 + g.d * 100000 AS n
+    FROM digits a, digits b, digits c, digits e, digits f, digits g
+) numbers;
+
+-- Matching volume for the ActivityLog listing
+INSERT INTO ActivityLog (UserType, UserID, Action, Details, LogTime)
+SELECT 'Patient', PatientID, 'Load Test', NULL, TIMESTAMP(AppointmentDate, AppointmentTime)
+FROM Appointment WHERE Reason = 'Load test' AND AppointmentDate <= CURDATE();
+
+ANALYZE TABLE Doctors, Patient, Appointment, ActivityLog;
@@ -0,0 +1,118 @@
+// ============================================================
+// ActivityLogWriter.cpp - Background, Batched Activity Log Writer
+// Hospital Appointment Booking System
+// ============================================================
+
+#include "../include/ActivityLogWriter.h"
+#include <exception>
+#include <iostream>
+
+ActivityLogWriter::ActivityLogWriter(BatchSink s, const Config& c, ThreadHook start, ThreadHook end)
+    : sink(std::move(s)), config(c), onThreadStart(std::move(start)), onThreadEnd(std::move(end)),
+      stopping(false), inFlight(false), flushRequests(0) {
+    if (config.queueCapacity == 0) config.queueCapacity = 1;
+    if (config.maxBatch == 0) config.maxBatch = 1;
+    worker = std::thread(&ActivityLogWriter::run, this);
+}
+
+ActivityLogWriter::~ActivityLogWriter() {
+    stop();
+}
+
+bool ActivityLogWriter::enqueue(Entry entry) {
+    std::unique_lock<std::mutex> lock(mtx);
+    if (stopping) return false;
+
+    if (queue.size() >= config.queueCapacity) {
+        stats.blockedProducers++;
+        notFull.wait(lock, [this]() { return stopping || queue.size() < config.queueCapacity; });
+        if (stopping) return false;
+    }
+
+    entry.queuedAt = Clock::now();
+    queue.push_back(std::move(entry));
+    stats.enqueued++;
+    if (queue.size() > stats.maxQueueDepth) stats.maxQueueDepth = queue.size();
+
+    // The writer only needs waking for the first entry of a batch or a full batch
+    bool wake = queue.size() == 1 || queue.size() >= config.maxBatch;
+    lock.unlock();
+    if (wake) notEmpty.notify_one();
+    return true;
+}
+
+void ActivityLogWriter::flush() {
+    std::unique_lock<std::mutex> lock(mtx);
+    if (!worker.joinable()) return;
+    flushRequests++;
+    notEmpty.notify_one();
+    drained.wait(lock, [this]() { return queue.empty() && !inFlight; });
+    flushRequests--;
+}
+
+void ActivityLogWriter::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (!worker.joinable()) return;
+        stopping = true;
+    }
+    notEmpty.notify_one();
+    notFull.notify_all();
+    worker.join();
+}
+
+ActivityLogWriter::Stats ActivityLogWriter::getStats() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    Stats snapshot = stats;
+    snapshot.queueDepth = queue.size();
+    return snapshot;
+}
+
+void ActivityLogWriter::run() {
+    if (onThreadStart) onThreadStart();
+
+    std::vector<Entry> batch;
+    batch.reserve(config.maxBatch);
+
+    std::unique_lock<std::mutex> lock(mtx);
+    while (true) {
+        notEmpty.wait(lock, [this]() { return stopping || !queue.empty(); });
+        if (queue.empty()) break; // Stopping with nothing left to write
+
+        // Give the batch until the oldest entry's window closes to fill up
+        Clock::time_point deadline = queue.front().queuedAt + config.flushInterval;
+        notEmpty.wait_until(lock, deadline, [this]() {
+            return stopping || flushRequests > 0 || queue.size() >= config.maxBatch;
+        });
+
+        size_t count = queue.size() < config.maxBatch ? queue.size() : config.maxBatch;
+        for (size_t i = 0; i < count; i++) {
+            batch.push_back(std::move(queue.front()));
+            queue.pop_front();
+        }
+        inFlight = true;
+        lock.unlock();
+        notFull.notify_all();
+
+        bool ok = true;
+        try {
+            sink(batch);
+        }
+        catch (std::exception& e) {
+            std::cerr << "[ERROR] Activity log write failed: " << e.what() << std::endl;
+            ok = false;
+        }
+
+        lock.lock();
+        inFlight = false;
+        stats.batches++;
+        if (ok) stats.written += batch.size();
+        else stats.failed += batch.size();
+        batch.clear();
+        if (queue.empty()) drained.notify_all();
+    }
+    drained.notify_all();
+    lock.unlock();
+
+    if (onThreadEnd) onThreadEnd();
+}
@@ -5,7 +5,8 @@
 
 #include "../include/AdminModule.h"
 #include "../include/Utilities.h"
-#include "../include/DatabaseManager.h"
+#include "../include/StorageEngine.h"
+#include "../include/AppointmentExporter.h"
 #include <iostream>
 #include <iomanip>
 #include <vector>
@@ -14,7 +15,7 @@
 #undef max
 
 // OOP: Constructor calls base class constructor
-AdminModule::AdminModule(ConsoleUtils& c, DatabaseManager& d, UserSession& s)
+AdminModule::AdminModule(ConsoleUtils& c, StorageEngine& d, UserSession& s)
     : BaseModule(c, d, s) {}
 
 void AdminModule::managePatients() {
@@ -50,61 +51,74 @@ void AdminModule::managePatients() {
 }
 
 void AdminModule::viewAllPatients() {
-    console.clearScreen();
-    console.printHeader("ALL PATIENTS");
-    
-    std::vector<Patient> patients = db.searchPatients("");
-    
-    if (patients.empty()) {
-        console.printInfo("No patients registered in the system.");
-        console.pauseScreen();
-        return;
-    }
-    
-    console.setColor(WHITE);
-    std::cout << "\n  Total: " << patients.size() << " patient(s) registered.\n" << std::endl;
-    console.resetColor();
-    
-    console.setColor(DARK_CYAN);
-    std::cout << "  " << std::left 
-              << std::setw(5) << "ID"
-              << std::setw(25) << "Name"
-              << std::setw(15) << "Phone"
-              << std::setw(25) << "Email" << std::endl;
-    std::cout << "  " << std::string(70, '-') << std::endl;
-    console.resetColor();
-    
-    for (const auto& p : patients) {
-        std::cout << "  " << std::setw(5) << p.patientID
-                  << std::setw(25) << p.patientName
-                  << std::setw(15) << p.phoneNumber
-                  << std::setw(25) << p.email << std::endl;
-    }
-    
-    std::cout << std::endl;
-    console.setColor(YELLOW);
-    std::cout << "  >> Enter a Patient ID to view details (or 0 to go back):" << std::endl;
-    console.resetColor();
-    int patientID = console.getIntInput("     Patient ID: ", 0, 99999);
+    const int pageSize = 20;
     
-    if (patientID == 0) return;
+    // Start cursor of every page shown so far, so [P] can step back
+    std::vector<StorageEngine::PatientCursor> pageStarts(1);
+    int patientID = 0;
     
-    bool found = false;
-    for (const auto& p : patients) {
-        if (p.patientID == patientID) {
-            found = true;
-            break;
+    while (patientID == 0) {
+        console.clearScreen();
+        console.printHeader("ALL PATIENTS");
+        
+        StorageEngine::PatientPage page = db.getPatientsPage(pageStarts.back(), pageSize);
+        
+        if (page.patients.empty() && pageStarts.size() == 1) {
+            console.printInfo("No patients registered in the system.");
+            console.pauseScreen();
+            return;
+        }
+        
+        console.setColor(WHITE);
+        std::cout << "\n  Page " << pageStarts.size() << " - patients in name order.\n" << std::endl;
+        console.resetColor();
+        
+        console.setColor(DARK_CYAN);
+        std::cout << "  " << std::left 
+                  << std::setw(5) << "ID"
+                  << std::setw(25) << "Name"
+                  << std::setw(15) << "Phone"
+                  << std::setw(25) << "Email" << std::endl;
+        std::cout << "  " << std::string(70, '-') << std::endl;
+        console.resetColor();
+        
+        for (const auto& p : page.patients) {
+            std::cout << "  " << std::setw(5) << p.patientID
+                      << std::setw(25) << p.patientName
+                      << std::setw(15) << p.phoneNumber
+                      << std::setw(25) << p.email << std::endl;
+        }
+        
+        std::cout << std::endl;
+        console.setColor(YELLOW);
+        std::cout << "  >> Enter a Patient ID to view details";
+        if (page.hasMore) std::cout << ", N for next page";
+        if (pageStarts.size() > 1) std::cout << ", P for previous page";
+        std::cout << " (or 0 to go back):" << std::endl;
+        console.resetColor();
+        std::string choice = console.getStringInput("     Choice: ");
+        
+        if ((choice == "N" || choice == "n") && page.hasMore) {
+            pageStarts.push_back(page.next);
+        } else if ((choice == "P" || choice == "p") && pageStarts.size() > 1) {
+            pageStarts.pop_back();
+        } else if (choice == "0") {
+            return;
+        } else if (choice.size() <= 9 && choice.find_first_not_of("0123456789") == std::string::npos) {
+            patientID = std::stoi(choice);
+        } else {
+            console.printError("Invalid choice!");
+            Sleep(800);
         }
     }
     
-    if (!found) {
+    Patient p = db.getPatientById(patientID);
+    if (p.patientID == 0) {
         console.printError("Patient ID not found.");
         console.pauseScreen();
         return;
     }
     
-    Patient p = db.getPatientById(patientID);
-    
     console.clearScreen();
     console.printHeader("PATIENT DETAILS");
     
@@ -148,10 +162,10 @@ void AdminModule::viewAllPatients() {
             std::cout << "  Status        : ";
             console.resetColor();
             
-            if (apt.status == "Completed") console.setColor(GREEN);
-            else if (apt.status == "Confirmed") console.setColor(CYAN);
-            else if (apt.status == "Pending") console.setColor(YELLOW);
-            else if (apt.status == "Cancelled") console.setColor(RED);
+            if (apt.status == AppointmentStatus::Completed) console.setColor(GREEN);
+            else if (apt.status == AppointmentStatus::Confirmed) console.setColor(CYAN);
+            else if (apt.status == AppointmentStatus::Pending) console.setColor(YELLOW);
+            else if (apt.status == AppointmentStatus::Cancelled) console.setColor(RED);
             std::cout << apt.status << std::endl;
             console.resetColor();
             
@@ -171,7 +185,7 @@ void AdminModule::viewAllPatients() {
         int completedCount = 0;
         double totalRevenue = 0.0;
         for (const auto& apt : patientAppointments) {
-            if (apt.status == "Completed") {
+            if (apt.status == AppointmentStatus::Completed) {
                 completedCount++;
                 totalRevenue += apt.totalCost;
             }
@@ -203,8 +217,6 @@ void AdminModule::searchPatient() {
     console.clearScreen();
     console.printHeader("SEARCH PATIENT");
     
-    std::cin.ignore(10000, '\n');
-    
     console.setColor(WHITE);
     std::cout << "\n  Search for patients by name, email, or phone." << std::endl;
     std::cout << "  Enter partial or full text to search.\n" << std::endl;
@@ -214,7 +226,7 @@ void AdminModule::searchPatient() {
     std::cout << "  (Enter 0 to return to menu)\n" << std::endl;
     console.resetColor();
     
-    std::string search = console.getStringInput("  Search term: ");
+    std::string search = getPatientSearchInput("  Search term: ");
     
     // Check if user wants to return
     if (search == "0") {
@@ -318,10 +330,10 @@ void AdminModule::searchPatient() {
             std::cout << "  Status        : ";
             console.resetColor();
             
-            if (apt.status == "Completed") console.setColor(GREEN);
-            else if (apt.status == "Confirmed") console.setColor(CYAN);
-            else if (apt.status == "Pending") console.setColor(YELLOW);
-            else if (apt.status == "Cancelled") console.setColor(RED);
+            if (apt.status == AppointmentStatus::Completed) console.setColor(GREEN);
+            else if (apt.status == AppointmentStatus::Confirmed) console.setColor(CYAN);
+            else if (apt.status == AppointmentStatus::Pending) console.setColor(YELLOW);
+            else if (apt.status == AppointmentStatus::Cancelled) console.setColor(RED);
             std::cout << apt.status << std::endl;
             console.resetColor();
             
@@ -341,7 +353,7 @@ void AdminModule::searchPatient() {
         int completedCount = 0;
         double totalRevenue = 0.0;
         for (const auto& apt : patientAppointments) {
-            if (apt.status == "Completed") {
+            if (apt.status == AppointmentStatus::Completed) {
                 completedCount++;
                 totalRevenue += apt.totalCost;
             }
@@ -634,9 +646,10 @@ void AdminModule::addDoctor() {
     std::string confirm = console.getStringInput("\n  Create this doctor account? (Y/N): ");
     
     if (confirm == "Y" || confirm == "y") {
-        if (db.addDoctor(name, specialty, room, phone, email, password)) {
-            console.printSuccess("Doctor account created successfully!");
-            db.logActivity("Admin", session.userID, "Add Doctor", "Added: " + name);
+        std::optional<int> doctorID = db.addDoctor(name, specialty, room, phone, email, password);
+        if (doctorID) {
+            console.printSuccess("Doctor account created successfully! ID: " + std::to_string(*doctorID));
+            db.logActivity("Admin", session.userID, "Add Doctor", "Added: " + name + " (ID: " + std::to_string(*doctorID) + ")");
         } else {
             console.printError("Failed to create. Email/phone may already exist.");
         }
@@ -995,9 +1008,10 @@ void AdminModule::addStaff() {
     std::string confirm = console.getStringInput("\n  Create this staff account? (Y/N): ");
     
     if (confirm == "Y" || confirm == "y") {
-        if (db.addStaff(name, department, phone, email, password)) {
-            console.printSuccess("Staff account created successfully!");
-            db.logActivity("Admin", session.userID, "Add Staff", "Added: " + name);
+        std::optional<int> staffID = db.addStaff(name, department, phone, email, password);
+        if (staffID) {
+            console.printSuccess("Staff account created successfully! ID: " + std::to_string(*staffID));
+            db.logActivity("Admin", session.userID, "Add Staff", "Added: " + name + " (ID: " + std::to_string(*staffID) + ")");
         } else {
             console.printError("Failed to create. Email/phone may already exist.");
         }
@@ -1114,62 +1128,56 @@ void AdminModule::generateReport() {
     console.printMenuOption(1, "Today's Report      - Appointments for today");
     console.printMenuOption(2, "Weekly Summary      - Last 7 days");
     console.printMenuOption(3, "Monthly Summary     - Last 30 days");
-    console.printMenuOption(4, "Go Back             - Return to dashboard");
+    console.printMenuOption(4, "Export Appointments - CSV / NDJSON file for a date range");
+    console.printMenuOption(5, "Go Back             - Return to dashboard");
     
     std::cout << std::endl;
     console.setColor(WHITE);
-    std::cout << "  Enter a number (1-4) to select." << std::endl;
+    std::cout << "  Enter a number (1-5) to select." << std::endl;
     console.resetColor();
-    int choice = console.getIntInput("  Your choice: ", 1, 4);
+    int choice = console.getIntInput("  Your choice: ", 1, 5);
     
-    if (choice == 4) return;
+    if (choice == 5) return;
+    if (choice == 4) {
+        exportAppointments();
+        return;
+    }
     
     console.showLoading("\n  Generating report", 2);
     
     console.clearScreen();
     
-    std::vector<Appointment> appointments;
     std::string reportTitle;
     std::string periodInfo;
+    int lastDays;
     
-    // Get appointments based on report type
+    // Report window (aggregated in SQL, no appointment rows are fetched)
     if (choice == 1) {
         reportTitle = "TODAY'S REPORT";
         periodInfo = "Date: " + getCurrentDate();
-        appointments = db.getTodayAppointments();
+        lastDays = 0;
     } else if (choice == 2) {
         reportTitle = "WEEKLY SUMMARY REPORT";
         periodInfo = "Period: Last 7 days";
-        appointments = db.getWeeklyAppointments();
+        lastDays = 7;
     } else {
         reportTitle = "MONTHLY SUMMARY REPORT";
         periodInfo = "Period: Last 30 days";
-        appointments = db.getMonthlyAppointments();
+        lastDays = 30;
     }
+    StorageEngine::AppointmentSummary summary = db.getAppointmentSummary(lastDays);
     
     console.printHeader(reportTitle);
     console.setColor(WHITE);
     std::cout << "\n  " << periodInfo << "\n" << std::endl;
     console.resetColor();
     
-    // Calculate statistics
-    int total = (int)appointments.size();
-    int pending = 0, confirmed = 0, completed = 0, cancelled = 0;
-    double totalRevenue = 0.0;
-    double consultationRevenue = 0.0;
-    double medicineRevenue = 0.0;
-    
-    for (const auto& apt : appointments) {
-        if (apt.status == "Pending") pending++;
-        else if (apt.status == "Confirmed") confirmed++;
-        else if (apt.status == "Completed") {
-            completed++;
-            totalRevenue += apt.totalCost;
-            consultationRevenue += apt.consultationFee;
-            medicineRevenue += apt.medicineFee;
-        }
-        else if (apt.status == "Cancelled") cancelled++;
-    }
+    int total = summary.total;
+    int pending = summary.pending, confirmed = summary.confirmed;
+    int completed = summary.completed, cancelled = summary.cancelled;
+    double totalRevenue = summary.completedRevenue;
+    double consultationRevenue = summary.completedConsultation;
+    double medicineRevenue = summary.completedMedicine;
     
     // Appointment Statistics
     console.setColor(DARK_GRAY);
@@ -1265,9 +1273,7 @@ void AdminModule::generateReport() {
     }
     
     // System Overview
-    std::vector<Patient> patients = db.searchPatients("");
-    std::vector<Doctor> doctors = db.getAllDoctors(false);
-    std::vector<Staff> staffList = db.getAllStaff();
+    StorageEngine::SystemCounts systemCounts = db.getSystemCounts();
     
     std::cout << std::endl;
     console.setColor(DARK_GRAY);
@@ -1277,15 +1283,10 @@ void AdminModule::generateReport() {
     console.resetColor();
     
     console.setColor(WHITE);
-    std::cout << "  Total Patients        : " << patients.size() << std::endl;
-    std::cout << "  Total Doctors         : " << doctors.size() << std::endl;
-    std::cout << "  Total Staff           : " << staffList.size() << std::endl;
-    
-    int availableDocs = 0;
-    for (const auto& doc : doctors) {
-        if (doc.isAvailable) availableDocs++;
-    }
-    std::cout << "  Available Doctors     : " << availableDocs << std::endl;
+    std::cout << "  Total Patients        : " << systemCounts.patients << std::endl;
+    std::cout << "  Total Doctors         : " << systemCounts.doctors << std::endl;
+    std::cout << "  Total Staff           : " << systemCounts.staff << std::endl;
+    std::cout << "  Available Doctors     : " << systemCounts.availableDoctors << std::endl;
     console.resetColor();
     
     // Appointment Status Chart
@@ -1321,7 +1322,7 @@ void AdminModule::generateReport() {
     // Daily Trend (for weekly and monthly reports)
     if (choice >= 2) {
         // Get daily stats filtered by the correct date range
-        std::vector<DatabaseManager::DailyStats> dailyStats;
+        std::vector<StorageEngine::DailyStats> dailyStats;
         if (choice == 2) {
             dailyStats = db.getWeeklyDailyStatistics();  // Last 7 days only
         } else {
@@ -1364,31 +1365,80 @@ void AdminModule::generateReport() {
     console.pauseScreen();
 }
 
+void AdminModule::exportAppointments() {
+    console.clearScreen();
+    console.printHeader("EXPORT APPOINTMENTS");
+    
+    console.setColor(WHITE);
+    std::cout << "\n  Every appointment in the date range is written to a file, row by row." << std::endl;
+    console.setColor(DARK_GRAY);
+    std::cout << "  Dates: YYYY-MM-DD, both inclusive (e.g., 2025-11-01 to 2025-11-30)\n" << std::endl;
+    console.resetColor();
+    
+    std::string fromDate, toDate;
+    do {
+        fromDate = console.getStringInput("  From Date: ");
+        if (!console.isValidDate(fromDate)) console.printError("Invalid format! Use YYYY-MM-DD");
+    } while (!console.isValidDate(fromDate));
+    do {
+        toDate = console.getStringInput("  To Date  : ");
+        if (!console.isValidDate(toDate)) {
+            console.printError("Invalid format! Use YYYY-MM-DD");
+        } else if (toDate < fromDate) {
+            console.printError("To Date cannot be before From Date!");
+            toDate = "";
+        }
+    } while (!console.isValidDate(toDate));
+    
+    std::cout << std::endl;
+    console.printMenuOption(1, "CSV    - Spreadsheets");
+    console.printMenuOption(2, "NDJSON - One JSON object per line");
+    int format = console.getIntInput("  Format (1-2): ", 1, 2);
+    
+    AppointmentExporter::Options options;
+    options.format = format == 1 ? AppointmentExporter::Csv : AppointmentExporter::Ndjson;
+    options.sync = true; // The file is on disk when the screen says so
+    std::string defaultPath = "appointments_" + fromDate + "_" + toDate + (format == 1 ? ".csv" : ".ndjson");
+    std::string path = console.getStringInput("  File name (ENTER for " + defaultPath + "): ", true);
+    if (path.empty()) path = defaultPath;
+    
+    console.showLoading("\n  Exporting", 1);
+    AppointmentExporter exporter(db, options);
+    AppointmentExporter::Result result = exporter.exportRange(Date::parse(fromDate), Date::parse(toDate), path);
+    
+    if (!result.ok) {
+        console.printError("Export failed: " + result.error);
+        console.pauseScreen();
+        return;
+    }
+    
+    console.printSuccess("Export complete!");
+    console.setColor(WHITE);
+    std::cout << "\n  File              : " << path << std::endl;
+    std::cout << "  Appointments      : " << result.rows << std::endl;
+    std::cout << "  Size              : " << std::fixed << std::setprecision(1)
+              << result.bytes / (1024.0 * 1024.0) << " MiB" << std::endl;
+    std::cout << "  Time              : " << std::setprecision(2) << result.seconds << " s" << std::endl;
+    console.resetColor();
+    
+    db.logActivity("Admin", session.userID, "Export Appointments",
+                   std::to_string(result.rows) + " rows, " + fromDate + " to " + toDate);
+    
+    console.pauseScreen();
+}
+
 void AdminModule::systemStatistics() {
     console.clearScreen();
     console.printHeader("SYSTEM STATISTICS");
     
     console.showLoading("\n  Generating statistics", 2);
     
-    std::vector<Patient> patients = db.searchPatients("");
-    std::vector<Doctor> doctors = db.getAllDoctors(false);
-    std::vector<Staff> staff = db.getAllStaff();
-    std::vector<Appointment> appointments = db.getAllAppointments();
-    
-    int pending = 0, confirmed = 0, completed = 0, cancelled = 0;
-    double totalRevenue = 0.0;
-    double potentialRevenue = 0.0;
-    for (const auto& apt : appointments) {
-        if (apt.status == "Pending") { pending++; potentialRevenue += apt.totalCost; }
-        else if (apt.status == "Confirmed") { confirmed++; potentialRevenue += apt.totalCost; }
-        else if (apt.status == "Completed") { completed++; totalRevenue += apt.totalCost; }
-        else if (apt.status == "Cancelled") cancelled++;
-    }
+    // Two aggregate queries instead of loading every row
+    StorageEngine::SystemCounts systemCounts = db.getSystemCounts();
+    StorageEngine::AppointmentSummary summary = db.getAppointmentSummary();
     
-    int availableDoctors = 0;
-    for (const auto& doc : doctors) {
-        if (doc.isAvailable) availableDoctors++;
-    }
+    int pending = summary.pending, confirmed = summary.confirmed;
+    int completed = summary.completed, cancelled = summary.cancelled;
     
     std::cout << std::endl;
     console.setColor(DARK_GRAY);
@@ -1398,10 +1448,10 @@ void AdminModule::systemStatistics() {
     console.resetColor();
     
     console.setColor(WHITE);
-    std::cout << "  Total Patients        : " << patients.size() << std::endl;
-    std::cout << "  Total Doctors         : " << doctors.size() << std::endl;
-    std::cout << "  Available Doctors     : " << availableDoctors << std::endl;
-    std::cout << "  Total Staff           : " << staff.size() << std::endl;
+    std::cout << "  Total Patients        : " << systemCounts.patients << std::endl;
+    std::cout << "  Total Doctors         : " << systemCounts.doctors << std::endl;
+    std::cout << "  Available Doctors     : " << systemCounts.availableDoctors << std::endl;
+    std::cout << "  Total Staff           : " << systemCounts.staff << std::endl;
     console.resetColor();
     
     std::cout << std::endl;
@@ -1412,7 +1462,7 @@ void AdminModule::systemStatistics() {
     console.resetColor();
     
     console.setColor(WHITE);
-    std::cout << "  Total Appointments    : " << appointments.size() << std::endl;
+    std::cout << "  Total Appointments    : " << summary.total << std::endl;
     console.setColor(YELLOW);
     std::cout << "  Pending               : " << pending << std::endl;
     console.setColor(GREEN);
@@ -1423,10 +1473,12 @@ void AdminModule::systemStatistics() {
     std::cout << "  Cancelled             : " << cancelled << std::endl;
     console.resetColor();
     
-    if (appointments.size() > 0) {
-        double completionRate = (completed * 100.0) / appointments.size();
-        double cancellationRate = (cancelled * 100.0) / appointments.size();
-        double averageCost = (completed > 0) ? (totalRevenue / completed) : 0.0;
+    if (summary.total > 0) {
+        double completionRate = (completed * 100.0) / summary.total;
+        double cancellationRate = (cancelled * 100.0) / summary.total;
+        int billable = summary.total - cancelled;
+        double averageCost = billable > 0
+            ? (summary.completedRevenue + summary.potentialRevenue) / billable : 0.0;
         
         std::cout << std::endl;
         console.setColor(DARK_GRAY);
@@ -1448,17 +1500,15 @@ void AdminModule::systemStatistics() {
         std::cout << "  ------------------------------------------------\n" << std::endl;
         console.resetColor();
         
-        DatabaseManager::RevenueStats revStats = db.getRevenueStatistics();
-        
         console.setColor(WHITE);
-        std::cout << "  Consultation Fees     : RM " << std::fixed << std::setprecision(2) << revStats.totalConsultation << std::endl;
-        std::cout << "  Medicine Fees         : RM " << std::fixed << std::setprecision(2) << revStats.totalMedicine << std::endl;
+        std::cout << "  Consultation Fees     : RM " << std::fixed << std::setprecision(2) << summary.completedConsultation << std::endl;
+        std::cout << "  Medicine Fees         : RM " << std::fixed << std::setprecision(2) << summary.completedMedicine << std::endl;
         console.setColor(GREEN);
-        std::cout << "  Total Revenue (Comp.) : RM " << std::fixed << std::setprecision(2) << revStats.totalRevenue << std::endl;
+        std::cout << "  Total Revenue (Comp.) : RM " << std::fixed << std::setprecision(2) << summary.completedRevenue << std::endl;
         console.setColor(CYAN);
-        std::cout << "  Potential Revenue     : RM " << std::fixed << std::setprecision(2) << revStats.potentialRevenue << std::endl;
+        std::cout << "  Potential Revenue     : RM " << std::fixed << std::setprecision(2) << summary.potentialRevenue << std::endl;
         console.setColor(WHITE);
-        std::cout << "  Average Cost/Appt     : RM " << std::fixed << std::setprecision(2) << revStats.averageCost << std::endl;
+        std::cout << "  Average Cost/Appt     : RM " << std::fixed << std::setprecision(2) << averageCost << std::endl;
         console.resetColor();
     }
     
@@ -1489,7 +1539,7 @@ void AdminModule::systemStatistics() {
     }
     
     // Grade A: Doctor Statistics with SQL Aggregation
-    std::vector<DatabaseManager::DoctorStats> doctorStats = db.getDoctorStatistics();
+    std::vector<StorageEngine::DoctorStats> doctorStats = db.getDoctorStatistics();
     if (!doctorStats.empty()) {
         std::cout << std::endl;
         console.setColor(DARK_GRAY);
@@ -1516,7 +1566,64 @@ void AdminModule::systemStatistics() {
         }
         console.resetColor();
     }
-    
+
+    // Connection pool counters (used to size poolMaxSize)
+    ConnectionPoolStats poolStats = db.getPoolStats();
+    std::cout << std::endl;
+    console.setColor(DARK_GRAY);
+    std::cout << "  ------------------------------------------------" << std::endl;
+    std::cout << "  DATABASE CONNECTION POOL" << std::endl;
+    std::cout << "  ------------------------------------------------\n" << std::endl;
+    console.resetColor();
+
+    console.setColor(WHITE);
+    std::cout << "  Connections In Use    : " << poolStats.inUse << " (peak " << poolStats.peakInUse << ")" << std::endl;
+    std::cout << "  Idle Connections      : " << poolStats.idle << std::endl;
+    std::cout << "  Total Acquisitions    : " << poolStats.acquisitions << std::endl;
+    std::cout << "  Waited / Saturated    : " << poolStats.waits << " / " << poolStats.saturations << std::endl;
+    std::cout << "  Timeouts              : " << poolStats.timeouts << std::endl;
+    std::cout << "  Avg / Max Wait        : " << std::fixed << std::setprecision(2)
+              << (poolStats.waits > 0 ? poolStats.totalWaitMs / poolStats.waits : 0.0)
+              << " ms / " << poolStats.maxWaitMs << " ms" << std::endl;
+    std::cout << "  Opened / Evicted      : " << poolStats.created << " / " << poolStats.evicted << std::endl;
+    unsigned long long lookups = poolStats.statementHits + poolStats.statementMisses;
+    std::cout << "  Stmt Cache Hit/Miss   : " << poolStats.statementHits << " / " << poolStats.statementMisses
+              << " (" << std::fixed << std::setprecision(1)
+              << (lookups > 0 ? poolStats.statementHits * 100.0 / lookups : 0.0) << "% hit, "
+              << poolStats.statementEvictions << " evicted)" << std::endl;
+    ActivityLogWriter::Stats logStats = db.getActivityLogStats();
+    std::cout << "  Log Writes / Batches  : " << logStats.written << " / " << logStats.batches
+              << " (queued " << logStats.queueDepth << ", failed " << logStats.failed << ")" << std::endl;
+    DoctorCache::Stats cacheStats = db.getDoctorCacheStats();
+    unsigned long long cacheLookups = cacheStats.hits + cacheStats.misses;
+    std::cout << "  Doctor Cache Hit/Miss : " << cacheStats.hits << " / " << cacheStats.misses
+              << " (" << std::fixed << std::setprecision(1)
+              << (cacheLookups > 0 ? cacheStats.hits * 100.0 / cacheLookups : 0.0) << "% hit, "
+              << cacheStats.invalidations << " invalidated, " << cacheStats.expirations << " expired)" << std::endl;
+    std::cout << "  Doctor Cache Age      : " << std::fixed << std::setprecision(1)
+              << cacheStats.snapshotAgeMs / 1000.0 << " s (max served "
+              << cacheStats.maxServedAgeMs / 1000.0 << " s, " << cacheStats.doctors << " doctors)" << std::endl;
+    PatientSearchIndex::Stats searchStats = db.getPatientSearchStats();
+    std::cout << "  Patient Search Index  : " << searchStats.patients << " patients, "
+              << searchStats.trigrams << " trigrams, ~" << searchStats.memoryBytes / (1024 * 1024) << " MiB (avg "
+              << std::fixed << std::setprecision(1)
+              << (searchStats.searches > 0 ? searchStats.totalSearchUs / searchStats.searches : 0.0)
+              << " us/search, " << searchStats.scans << " scanned, "
+              << (searchStats.completions > 0 ? searchStats.totalCompleteUs / searchStats.completions : 0.0)
+              << " us/keystroke)" << std::endl;
+    DoctorSlotIndex::Stats slotStats = db.getSlotIndexStats();
+    std::cout << "  Slot Bitmaps          : " << slotStats.bookings << " active bookings over "
+              << slotStats.doctorDays << " doctor-days (" << slotStats.checks << " checks, "
+              << slotStats.conflicts << " clashes, " << slotStats.outsideWindow << " via SQL, "
+              << slotStats.searches << " free-slot searches)" << std::endl;
+    PasswordVerifier::Stats passwordStats = db.getPasswordStats();
+    std::cout << "  Password Checks       : " << passwordStats.verifications << " ("
+              << passwordStats.cacheHits << " cached, " << passwordStats.rejected << " rejected, avg "
+              << std::fixed << std::setprecision(1)
+              << (passwordStats.kdfRuns > 0 ? passwordStats.totalKdfMs / passwordStats.kdfRuns : 0.0)
+              << " ms/KDF)" << std::endl;
+    console.resetColor();
+
     db.logActivity("Admin", session.userID, "View Statistics", "System stats viewed");
     
     console.pauseScreen();
@@ -0,0 +1,309 @@
+// ============================================================
+// AppointmentColumns.cpp - Columnar Appointment Batch and Kernels
+// Hospital Appointment Booking System
+// ============================================================
+
+#include "../include/AppointmentColumns.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define APPOINTMENT_COLUMNS_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define AVX2_FUNCTION
+#else
+// GCC and Clang only emit AVX2 instructions in functions marked for it,
+// which keeps the rest of the program runnable on older CPUs
+#define AVX2_FUNCTION __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace {
+    typedef AppointmentColumns::PerStatus PerStatus;
+    const int STATUS_COUNT = AppointmentColumns::STATUS_COUNT;
+
+    // Rows per pass of the count kernel, so its 32-bit lane counters
+    // cannot overflow before they are added to the totals
+    const size_t COUNT_CHUNK = size_t(1) << 24;
+
+    int32_t toCents(double amount) {
+        double cents = std::round(amount * 100.0);
+        if (cents < INT32_MIN || cents > INT32_MAX) {
+            throw std::out_of_range("Fee out of range: " + std::to_string(amount));
+        }
+        return static_cast<int32_t>(cents);
+    }
+
+    bool inWindow(int32_t day, int firstDay, int lastDay) {
+        return day >= firstDay && day <= lastDay;
+    }
+
+    // ---------------- Scalar kernels ----------------
+
+    void countScalar(const uint8_t* status, const int32_t* day, size_t begin, size_t end,
+                     int firstDay, int lastDay, PerStatus& counts) {
+        for (size_t i = begin; i < end; i++) {
+            if (inWindow(day[i], firstDay, lastDay)) counts[status[i]]++;
+        }
+    }
+
+    void sumScalar(const uint8_t* status, const int32_t* day, const int32_t* cents, size_t begin, size_t end,
+                   int firstDay, int lastDay, PerStatus& sums) {
+        for (size_t i = begin; i < end; i++) {
+            if (inWindow(day[i], firstDay, lastDay)) sums[status[i]] += cents[i];
+        }
+    }
+
+    // Rows outside the window go to the extra last bucket
+    void groupScalar(const uint8_t* status, const int32_t* day, const int32_t* slot, size_t begin, size_t end,
+                     int firstDay, int lastDay, std::vector<long long>& buckets) {
+        const int32_t outside = static_cast<int32_t>(buckets.size() - 1);
+        for (size_t i = begin; i < end; i++) {
+            buckets[inWindow(day[i], firstDay, lastDay) ? slot[i] * STATUS_COUNT + status[i] : outside]++;
+        }
+    }
+
+#ifdef APPOINTMENT_COLUMNS_X86
+    // ---------------- AVX2 kernels ----------------
+
+    // All-ones in the lanes whose day is outside firstDay..lastDay
+    AVX2_FUNCTION inline __m256i outside8(const int32_t* day, __m256i first, __m256i last) {
+        __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(day));
+        return _mm256_or_si256(_mm256_cmpgt_epi32(first, d), _mm256_cmpgt_epi32(d, last));
+    }
+
+    AVX2_FUNCTION size_t countAvx2(const uint8_t* status, const int32_t* day, size_t rows,
+                                   int firstDay, int lastDay, PerStatus& counts) {
+        const __m256i first = _mm256_set1_epi32(firstDay);
+        const __m256i last = _mm256_set1_epi32(lastDay);
+        __m256i code[STATUS_COUNT];
+        for (int s = 0; s < STATUS_COUNT; s++) code[s] = _mm256_set1_epi32(s);
+
+        size_t i = 0;
+        while (i + 8 <= rows) {
+            size_t chunkEnd = i + (std::min)(COUNT_CHUNK, (rows - i) & ~size_t(7));
+            __m256i lanes[STATUS_COUNT];
+            for (int s = 0; s < STATUS_COUNT; s++) lanes[s] = _mm256_setzero_si256();
+            for (; i < chunkEnd; i += 8) {
+                __m256i out = outside8(day + i, first, last);
+                __m256i st = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(status + i)));
+                // A matching lane is -1, so subtracting counts it
+                for (int s = 0; s < STATUS_COUNT; s++) {
+                    lanes[s] = _mm256_sub_epi32(lanes[s], _mm256_andnot_si256(out, _mm256_cmpeq_epi32(st, code[s])));
+                }
+            }
+            for (int s = 0; s < STATUS_COUNT; s++) {
+                alignas(32) int32_t lane[8];
+                _mm256_store_si256(reinterpret_cast<__m256i*>(lane), lanes[s]);
+                for (int l = 0; l < 8; l++) counts[s] += static_cast<uint32_t>(lane[l]);
+            }
+        }
+        return i;
+    }
+
+    AVX2_FUNCTION size_t sumAvx2(const uint8_t* status, const int32_t* day, const int32_t* cents, size_t rows,
+                                 int firstDay, int lastDay, PerStatus& sums) {
+        const __m128i first = _mm_set1_epi32(firstDay);
+        const __m128i last = _mm_set1_epi32(lastDay);
+        __m256i code[STATUS_COUNT];
+        __m256i lanes[STATUS_COUNT];
+        for (int s = 0; s < STATUS_COUNT; s++) {
+            code[s] = _mm256_set1_epi64x(s);
+            lanes[s] = _mm256_setzero_si256();
+        }
+
+        size_t i = 0;
+        for (; i + 4 <= rows; i += 4) {
+            __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(day + i));
+            __m256i out = _mm256_cvtepi32_epi64(_mm_or_si128(_mm_cmpgt_epi32(first, d), _mm_cmpgt_epi32(d, last)));
+            int32_t packed;
+            std::memcpy(&packed, status + i, sizeof(packed));
+            __m256i st = _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(packed));
+            __m256i fee = _mm256_andnot_si256(out, _mm256_cvtepi32_epi64(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(cents + i))));
+            for (int s = 0; s < STATUS_COUNT; s++) {
+                lanes[s] = _mm256_add_epi64(lanes[s], _mm256_and_si256(_mm256_cmpeq_epi64(st, code[s]), fee));
+            }
+        }
+        for (int s = 0; s < STATUS_COUNT; s++) {
+            alignas(32) long long lane[4];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(lane), lanes[s]);
+            sums[s] += lane[0] + lane[1] + lane[2] + lane[3];
+        }
+        return i;
+    }
+
+    AVX2_FUNCTION size_t groupAvx2(const uint8_t* status, const int32_t* day, const int32_t* slot, size_t rows,
+                                   int firstDay, int lastDay, std::vector<long long>& buckets) {
+        const __m256i first = _mm256_set1_epi32(firstDay);
+        const __m256i last = _mm256_set1_epi32(lastDay);
+        const __m256i statusCount = _mm256_set1_epi32(STATUS_COUNT);
+        const __m256i outsideBucket = _mm256_set1_epi32(static_cast<int32_t>(buckets.size() - 1));
+        long long* counts = buckets.data();
+
+        size_t i = 0;
+        alignas(32) int32_t key[8];
+        for (; i + 8 <= rows; i += 8) {
+            __m256i out = outside8(day + i, first, last);
+            __m256i st = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(status + i)));
+            __m256i doctor = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(slot + i));
+            __m256i bucket = _mm256_add_epi32(_mm256_mullo_epi32(doctor, statusCount), st);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(key), _mm256_blendv_epi8(bucket, outsideBucket, out));
+            for (int l = 0; l < 8; l++) counts[key[l]]++;
+        }
+        return i;
+    }
+
+    bool detectAvx2() {
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7) return false;
+        __cpuid(info, 1);
+        const int osxsave = 1 << 27, avx = 1 << 28;
+        if ((info[2] & osxsave) == 0 || (info[2] & avx) == 0) return false;
+        if ((_xgetbv(0) & 6) != 6) return false; // The OS saves the YMM registers
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+#endif
+
+    bool useAvx2(AppointmentColumns::Kernel kernel) {
+        return kernel == AppointmentColumns::Auto && AppointmentColumns::hasAvx2();
+    }
+}
+
+bool AppointmentColumns::hasAvx2() {
+#ifdef APPOINTMENT_COLUMNS_X86
+    static const bool supported = detectAvx2();
+    return supported;
+#else
+    return false;
+#endif
+}
+
+void AppointmentColumns::reserve(size_t rows) {
+    appointmentIDs.reserve(rows);
+    statuses.reserve(rows);
+    days.reserve(rows);
+    doctorSlots.reserve(rows);
+    consultationCents.reserve(rows);
+    medicineCents.reserve(rows);
+    totalCents.reserve(rows);
+}
+
+void AppointmentColumns::clear() {
+    appointmentIDs.clear();
+    statuses.clear();
+    days.clear();
+    doctorSlots.clear();
+    consultationCents.clear();
+    medicineCents.clear();
+    totalCents.clear();
+    doctorIDs.clear();
+    slotOfDoctor.clear();
+}
+
+size_t AppointmentColumns::append(int appointmentID, int doctorID, int day, AppointmentStatus status,
+                                  double consultationFee, double medicineFee, double totalCost) {
+    int32_t consultation = toCents(consultationFee);
+    int32_t medicine = toCents(medicineFee);
+    int32_t total = toCents(totalCost);
+
+    std::unordered_map<int, int32_t>::const_iterator known = slotOfDoctor.find(doctorID);
+    int32_t slot;
+    if (known != slotOfDoctor.end()) {
+        slot = known->second;
+    } else {
+        slot = static_cast<int32_t>(doctorIDs.size());
+        doctorIDs.push_back(doctorID);
+        slotOfDoctor[doctorID] = slot;
+    }
+
+    appointmentIDs.push_back(appointmentID);
+    statuses.push_back(status.code());
+    days.push_back(day);
+    doctorSlots.push_back(slot);
+    consultationCents.push_back(consultation);
+    medicineCents.push_back(medicine);
+    totalCents.push_back(total);
+    return appointmentIDs.size() - 1;
+}
+
+int AppointmentColumns::erase(size_t row) {
+    size_t lastRow = appointmentIDs.size() - 1;
+    int moved = 0;
+    if (row != lastRow) {
+        appointmentIDs[row] = appointmentIDs[lastRow];
+        statuses[row] = statuses[lastRow];
+        days[row] = days[lastRow];
+        doctorSlots[row] = doctorSlots[lastRow];
+        consultationCents[row] = consultationCents[lastRow];
+        medicineCents[row] = medicineCents[lastRow];
+        totalCents[row] = totalCents[lastRow];
+        moved = appointmentIDs[row];
+    }
+    appointmentIDs.pop_back();
+    statuses.pop_back();
+    days.pop_back();
+    doctorSlots.pop_back();
+    consultationCents.pop_back();
+    medicineCents.pop_back();
+    totalCents.pop_back();
+    // Doctor slots are kept: a doctor with no rows left just counts zero
+    return moved;
+}
+
+const std::vector<int32_t>& AppointmentColumns::column(Fee fee) const {
+    if (fee == Consultation) return consultationCents;
+    if (fee == Medicine) return medicineCents;
+    return totalCents;
+}
+
+AppointmentColumns::PerStatus AppointmentColumns::countByStatus(int firstDay, int lastDay, Kernel kernel) const {
+    PerStatus counts = {};
+    size_t done = 0;
+#ifdef APPOINTMENT_COLUMNS_X86
+    if (useAvx2(kernel)) done = countAvx2(statuses.data(), days.data(), size(), firstDay, lastDay, counts);
+#endif
+    countScalar(statuses.data(), days.data(), done, size(), firstDay, lastDay, counts);
+    return counts;
+}
+
+AppointmentColumns::PerStatus AppointmentColumns::sumByStatus(Fee fee, int firstDay, int lastDay,
+                                                              Kernel kernel) const {
+    PerStatus sums = {};
+    const int32_t* cents = column(fee).data();
+    size_t done = 0;
+#ifdef APPOINTMENT_COLUMNS_X86
+    if (useAvx2(kernel)) done = sumAvx2(statuses.data(), days.data(), cents, size(), firstDay, lastDay, sums);
+#endif
+    sumScalar(statuses.data(), days.data(), cents, done, size(), firstDay, lastDay, sums);
+    return sums;
+}
+
+std::vector<AppointmentColumns::DoctorCounts> AppointmentColumns::countByDoctor(int firstDay, int lastDay,
+                                                                                Kernel kernel) const {
+    std::vector<long long> buckets(doctorIDs.size() * STATUS_COUNT + 1, 0);
+    size_t done = 0;
+#ifdef APPOINTMENT_COLUMNS_X86
+    if (useAvx2(kernel)) {
+        done = groupAvx2(statuses.data(), days.data(), doctorSlots.data(), size(), firstDay, lastDay, buckets);
+    }
+#endif
+    groupScalar(statuses.data(), days.data(), doctorSlots.data(), done, size(), firstDay, lastDay, buckets);
+
+    std::vector<DoctorCounts> doctors(doctorIDs.size());
+    for (size_t slot = 0; slot < doctorIDs.size(); slot++) {
+        doctors[slot].doctorID = doctorIDs[slot];
+        for (int s = 0; s < STATUS_COUNT; s++) doctors[slot].appointments[s] = buckets[slot * STATUS_COUNT + s];
+    }
+    return doctors;
+}
@@ -0,0 +1,275 @@
+// ============================================================
+// AppointmentExporter.cpp - Streaming CSV / NDJSON Appointment Export
+// Hospital Appointment Booking System
+// ============================================================
+
+#include "../include/AppointmentExporter.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <windows.h>
+
+namespace {
+    // Unbuffered writes must be whole sectors from sector-aligned memory;
+    // 4 KiB satisfies both 512-byte and 4K-sector disks
+    const size_t BLOCK_BYTES = 4096;
+
+    std::string lastError(const char* call) {
+        return std::string(call) + " failed (error " + std::to_string(GetLastError()) + ")";
+    }
+
+    // Sequential output through one aligned buffer
+    class OutputFile {
+    public:
+        std::string error;
+        unsigned long long bytes;
+        unsigned long long writes;
+
+        OutputFile() : bytes(0), writes(0), handle(INVALID_HANDLE_VALUE), buffer(nullptr),
+                       capacity(0), used(0), direct(false) {}
+        ~OutputFile() {
+            if (handle != INVALID_HANDLE_VALUE) CloseHandle(handle);
+            if (buffer) VirtualFree(buffer, 0, MEM_RELEASE);
+        }
+
+        bool open(const std::string& path, size_t bufferBytes, bool unbuffered) {
+            direct = unbuffered;
+            capacity = (std::max)((bufferBytes + BLOCK_BYTES - 1) / BLOCK_BYTES * BLOCK_BYTES, BLOCK_BYTES);
+            // Page-aligned, which also satisfies the sector alignment
+            buffer = static_cast<char*>(VirtualAlloc(nullptr, capacity, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+            if (!buffer) {
+                error = lastError("VirtualAlloc");
+                return false;
+            }
+            DWORD flags = FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN;
+            if (direct) flags |= FILE_FLAG_NO_BUFFERING | FILE_FLAG_WRITE_THROUGH;
+            handle = CreateFileA(path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, flags, nullptr);
+            if (handle == INVALID_HANDLE_VALUE) {
+                error = lastError("CreateFile");
+                return false;
+            }
+            return true;
+        }
+
+        bool append(const std::string& text) {
+            size_t done = 0;
+            while (done < text.size()) {
+                size_t take = (std::min)(text.size() - done, capacity - used);
+                std::memcpy(buffer + used, text.data() + done, take);
+                used += take;
+                done += take;
+                if (used == capacity && !writeBuffer(capacity)) return false;
+            }
+            return true;
+        }
+
+        bool close(bool sync) {
+            unsigned long long length = bytes + used;
+            if (used > 0) {
+                // Unbuffered: pad the tail to a whole block, then cut the file back
+                size_t size = used;
+                if (direct) {
+                    size = (used + BLOCK_BYTES - 1) / BLOCK_BYTES * BLOCK_BYTES;
+                    std::memset(buffer + used, 0, size - used);
+                }
+                if (!writeBuffer(size)) return false;
+                if (direct) {
+                    LARGE_INTEGER end;
+                    end.QuadPart = static_cast<LONGLONG>(length);
+                    if (!SetFilePointerEx(handle, end, nullptr, FILE_BEGIN) || !SetEndOfFile(handle)) {
+                        error = lastError("SetEndOfFile");
+                        return false;
+                    }
+                }
+            }
+            if (sync && !FlushFileBuffers(handle)) {
+                error = lastError("FlushFileBuffers");
+                return false;
+            }
+            CloseHandle(handle);
+            handle = INVALID_HANDLE_VALUE;
+            return true;
+        }
+
+    private:
+        HANDLE handle;
+        char* buffer;
+        size_t capacity;
+        size_t used;
+        bool direct;
+
+        bool writeBuffer(size_t size) {
+            DWORD written = 0;
+            if (!WriteFile(handle, buffer, static_cast<DWORD>(size), &written, nullptr) || written != size) {
+                error = lastError("WriteFile");
+                return false;
+            }
+            bytes += used;
+            writes++;
+            used = 0;
+            return true;
+        }
+    };
+
+    void appendCsvField(std::string& out, const std::string& text) {
+        if (text.find_first_of(",\"\r\n") == std::string::npos) {
+            out += text;
+            return;
+        }
+        out += '"';
+        for (char c : text) {
+            if (c == '"') out += '"';
+            out += c;
+        }
+        out += '"';
+    }
+
+    void appendJsonString(std::string& out, const std::string& text) {
+        static const char hex[] = "0123456789abcdef";
+        out += '"';
+        for (char c : text) {
+            unsigned char u = static_cast<unsigned char>(c);
+            if (c == '"' || c == '\\') {
+                out += '\\';
+                out += c;
+            } else if (c == '\n') {
+                out += "\\n";
+            } else if (c == '\r') {
+                out += "\\r";
+            } else if (c == '\t') {
+                out += "\\t";
+            } else if (u < 0x20) {
+                out += "\\u00";
+                out += hex[u >> 4];
+                out += hex[u & 15];
+            } else {
+                out += c;
+            }
+        }
+        out += '"';
+    }
+
+    // Fees are DECIMAL(10,2): always two places, no exponent
+    void appendMoney(std::string& out, double value) {
+        long long cents = std::llround(value * 100.0);
+        if (cents < 0) {
+            out += '-';
+            cents = -cents;
+        }
+        out += std::to_string(cents / 100);
+        out += '.';
+        out += static_cast<char>('0' + cents % 100 / 10);
+        out += static_cast<char>('0' + cents % 10);
+    }
+}
+
+AppointmentExporter::AppointmentExporter(StorageEngine& d, const Options& o)
+    : db(d), options(o) {}
+
+const char* AppointmentExporter::csvHeader() {
+    return "AppointmentID,Date,Time,Status,PatientID,PatientName,DoctorID,DoctorName,"
+           "Duration,Reason,ConsultationFee,MedicineFee,TotalCost\n";
+}
+
+void AppointmentExporter::appendCsv(std::string& out, const Appointment& a) {
+    out += std::to_string(a.appointmentID);
+    out += ',';
+    out += a.appointmentDate.toString();
+    out += ',';
+    out += a.appointmentTime.toString();
+    out += ',';
+    out += a.status.name(); // Names need no quoting
+    out += ',';
+    out += std::to_string(a.patientID);
+    out += ',';
+    appendCsvField(out, a.patientName);
+    out += ',';
+    out += std::to_string(a.doctorID);
+    out += ',';
+    appendCsvField(out, a.doctorName);
+    out += ',';
+    out += std::to_string(a.duration);
+    out += ',';
+    appendCsvField(out, a.reason);
+    out += ',';
+    appendMoney(out, a.consultationFee);
+    out += ',';
+    appendMoney(out, a.medicineFee);
+    out += ',';
+    appendMoney(out, a.totalCost);
+    out += '\n';
+}
+
+void AppointmentExporter::appendJson(std::string& out, const Appointment& a) {
+    out += "{\"appointmentID\":";
+    out += std::to_string(a.appointmentID);
+    out += ",\"date\":";
+    appendJsonString(out, a.appointmentDate.toString());
+    out += ",\"time\":";
+    appendJsonString(out, a.appointmentTime.toString());
+    out += ",\"status\":\"";
+    out += a.status.name();
+    out += '"';
+    out += ",\"patientID\":";
+    out += std::to_string(a.patientID);
+    out += ",\"patientName\":";
+    appendJsonString(out, a.patientName);
+    out += ",\"doctorID\":";
+    out += std::to_string(a.doctorID);
+    out += ",\"doctorName\":";
+    appendJsonString(out, a.doctorName);
+    out += ",\"duration\":";
+    out += std::to_string(a.duration);
+    out += ",\"reason\":";
+    appendJsonString(out, a.reason);
+    out += ",\"consultationFee\":";
+    appendMoney(out, a.consultationFee);
+    out += ",\"medicineFee\":";
+    appendMoney(out, a.medicineFee);
+    out += ",\"totalCost\":";
+    appendMoney(out, a.totalCost);
+    out += "}\n";
+}
+
+AppointmentExporter::Result AppointmentExporter::exportRange(const Date& fromDate, const Date& toDate,
+                                                             const std::string& path) {
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now();
+    Result result;
+
+    OutputFile file;
+    if (!file.open(path, options.bufferBytes, options.direct)) {
+        result.error = file.error;
+        return result;
+    }
+    bool written = options.format != Csv || file.append(csvHeader());
+
+    // Reused for every row, so its capacity settles after the first few
+    std::string record;
+    long long rows = -1;
+    if (written) {
+        rows = db.streamAppointmentsByDateRange(fromDate, toDate, [&](const Appointment& appointment) {
+            record.clear();
+            if (options.format == Csv) {
+                appendCsv(record, appointment);
+            } else {
+                appendJson(record, appointment);
+            }
+            return file.append(record);
+        });
+        written = file.error.empty() && file.close(options.sync);
+    }
+
+    result.rows = rows < 0 ? 0 : rows;
+    result.bytes = file.bytes;
+    result.writes = file.writes;
+    result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    result.ok = written && rows >= 0;
+    if (!written) {
+        result.error = file.error;
+    } else if (rows < 0) {
+        result.error = "Reading appointments failed";
+    }
+    return result;
+}
@@ -0,0 +1,189 @@
+// ============================================================
+// AppointmentImporter.cpp - Bulk CSV Appointment Import
+// Hospital Appointment Booking System
+// ============================================================
+
+#include "../include/AppointmentImporter.h"
+#include <chrono>
+
+namespace {
+    const size_t FIELD_COUNT = 6;
+    const size_t REASON_MAX_LENGTH = 100; // Appointment.Reason is VARCHAR(100)
+
+    // Next CSV record, joining physical lines while a quoted field is open.
+    // lines counts physical lines read; recordLine is where this record began.
+    bool readRecord(std::istream& in, std::vector<std::string>& fields, size_t& lines, size_t& recordLine) {
+        std::string text;
+        if (!std::getline(in, text)) return false;
+        recordLine = ++lines;
+        fields.assign(1, std::string());
+
+        bool quoted = false;
+        size_t i = 0;
+        while (true) {
+            if (i == text.size()) {
+                // A newline inside quotes belongs to the field
+                if (!quoted || !std::getline(in, text)) break;
+                lines++;
+                fields.back() += '\n';
+                i = 0;
+                continue;
+            }
+            char c = text[i++];
+            if (quoted) {
+                if (c == '"' && i < text.size() && text[i] == '"') {
+                    fields.back() += '"';
+                    i++;
+                } else if (c == '"') {
+                    quoted = false;
+                } else {
+                    fields.back() += c;
+                }
+            } else if (c == '"') {
+                quoted = true;
+            } else if (c == ',') {
+                fields.push_back(std::string());
+            } else if (c != '\r') {
+                fields.back() += c;
+            }
+        }
+        for (std::string& field : fields) {
+            field.erase(0, field.find_first_not_of(" \t"));
+            field.erase(field.find_last_not_of(" \t") + 1);
+        }
+        return true;
+    }
+
+    bool parsePositive(const std::string& text, int& value) {
+        if (text.empty() || text.size() > 9) return false;
+        value = 0;
+        for (char c : text) {
+            if (c < '0' || c > '9') return false;
+            value = value * 10 + (c - '0');
+        }
+        return value > 0;
+    }
+}
+
+AppointmentImporter::AppointmentImporter(StorageEngine& d, const Config& cfg)
+    : db(d), config(cfg) {}
+
+AppointmentImporter::Summary AppointmentImporter::run(std::istream& csv, std::ostream& errors) {
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now();
+    Summary summary;
+
+    doctorAvailable.clear();
+    for (const Doctor& doctor : db.getAllDoctors(false)) {
+        doctorAvailable[doctor.doctorID] = doctor.isAvailable;
+    }
+    today = Date::today();
+    booked.clear();
+    patientDays.clear();
+
+    std::vector<std::string> fields;
+    size_t lines = 0, line = 0;
+    bool first = true;
+    while (readRecord(csv, fields, lines, line)) {
+        if (fields.size() == 1 && fields[0].empty()) continue; // Blank line
+        if (first) {
+            first = false;
+            int patientID = 0;
+            if (!parsePositive(fields[0], patientID)) continue; // Header
+        }
+
+        summary.records++;
+        StorageEngine::ImportRow row;
+        std::string problem = validate(fields, line, row);
+        if (!problem.empty()) {
+            errors << "line " << line << ": " << problem << '\n';
+            summary.rejected++;
+            continue;
+        }
+        chunk.push_back(row);
+        chunkLines.push_back(line);
+        if (chunk.size() >= config.chunkRows) flush(summary, errors);
+    }
+    flush(summary, errors);
+
+    summary.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return summary;
+}
+
+std::string AppointmentImporter::validate(const std::vector<std::string>& fields, size_t line,
+                                          StorageEngine::ImportRow& row) {
+    if (fields.size() != FIELD_COUNT) {
+        return "Expected " + std::to_string(FIELD_COUNT) + " fields (PatientID,DoctorID,Date,Time,Duration,Reason), found " +
+               std::to_string(fields.size());
+    }
+    const std::string& date = fields[2];
+    std::string time = fields[3];
+    const std::string& reason = fields[5];
+
+    if (!parsePositive(fields[0], row.patientID)) return "Invalid patient ID \"" + fields[0] + "\"";
+    if (!parsePositive(fields[1], row.doctorID)) return "Invalid doctor ID \"" + fields[1] + "\"";
+
+    Date day = date.size() == 10 ? Date::parse(date) : Date();
+    if (!day.isValid()) return "Invalid date \"" + date + "\" (use YYYY-MM-DD)";
+    if (day < today) return "Date " + date + " is in the past";
+
+    // Database exports carry seconds; whole minutes are accepted
+    if (time.size() == 8 && time.compare(5, 3, ":00") == 0) time.resize(5);
+    TimeOfDay start = time.size() == 5 ? TimeOfDay::parse(time) : TimeOfDay();
+    if (!start.isValid()) return "Invalid time \"" + fields[3] + "\" (use HH:MM)";
+    if (start.minuteOfDay() < 8 * 60 || start.minuteOfDay() >= 17 * 60) {
+        return "Time " + time + " is outside clinic hours (08:00 - 17:00)";
+    }
+    if (start.minuteOfDay() % 15 != 0) return "Time " + time + " is not on the quarter hour";
+
+    if (!parsePositive(fields[4], row.duration) ||
+        (row.duration != 15 && row.duration != 30 && row.duration != 45 && row.duration != 60)) {
+        return "Invalid duration \"" + fields[4] + "\" (15, 30, 45 or 60 minutes)";
+    }
+    if (reason.empty()) return "Reason is empty";
+    if (reason.size() > REASON_MAX_LENGTH) return "Reason is longer than " + std::to_string(REASON_MAX_LENGTH) + " characters";
+
+    std::unordered_map<int, bool>::const_iterator doctor = doctorAvailable.find(row.doctorID);
+    if (doctor == doctorAvailable.end()) return "Unknown doctor " + std::to_string(row.doctorID);
+    if (!doctor->second) return "Doctor " + std::to_string(row.doctorID) + " is not accepting appointments";
+
+    // Against the rest of the file
+    std::tuple<int, int, int> patientDay(row.patientID, row.doctorID, day.dayNumber());
+    std::map<std::tuple<int, int, int>, size_t>::const_iterator same = patientDays.find(patientDay);
+    if (same != patientDays.end()) {
+        return "Patient already has an appointment with this doctor on " + date + " (line " +
+               std::to_string(same->second) + ")";
+    }
+    DoctorSlotIndex::DayMask mask = DoctorSlotIndex::intervalMask(start.minuteOfDay(), row.duration);
+    std::vector<std::pair<DoctorSlotIndex::DayMask, size_t>>& doctorDay =
+        booked[(uint64_t(uint32_t(row.doctorID)) << 32) | uint32_t(day.dayNumber())];
+    for (const std::pair<DoctorSlotIndex::DayMask, size_t>& taken : doctorDay) {
+        if (taken.first.overlaps(mask)) return "Overlaps line " + std::to_string(taken.second) + " for this doctor";
+    }
+
+    // Against what is already booked (the slot index, no query per row)
+    if (!db.checkDoctorAvailability(row.doctorID, day, start, row.duration)) {
+        return "Doctor already has an appointment during " + time + " - " + std::to_string(row.duration) + " minutes";
+    }
+
+    doctorDay.push_back(std::make_pair(mask, line));
+    patientDays[patientDay] = line;
+    row.date = day;
+    row.time = start;
+    row.reason = reason;
+    row.consultationFee = db.calculateConsultationFee(row.duration);
+    row.medicineFee = db.calculateMedicineFee(reason);
+    return std::string();
+}
+
+void AppointmentImporter::flush(Summary& summary, std::ostream& errors) {
+    if (chunk.empty()) return;
+    std::vector<StorageEngine::ImportFailure> failures = db.importAppointments(chunk);
+    for (const StorageEngine::ImportFailure& failure : failures) {
+        errors << "line " << chunkLines[failure.row] << ": " << failure.reason << '\n';
+    }
+    summary.imported += chunk.size() - failures.size();
+    summary.rejected += failures.size();
+    chunk.clear();
+    chunkLines.clear();
+}
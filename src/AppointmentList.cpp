@@ -0,0 +1,95 @@
+// ============================================================
+// AppointmentList.cpp - Compact Appointment Results with Interned Text
+// Hospital Appointment Booking System
+// ============================================================
+
+#include "../include/AppointmentList.h"
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+    int32_t toCents(double amount) {
+        double cents = std::round(amount * 100.0);
+        if (cents < INT32_MIN || cents > INT32_MAX) {
+            throw std::out_of_range("Fee out of range: " + std::to_string(amount));
+        }
+        return static_cast<int32_t>(cents);
+    }
+}
+
+AppointmentList::AppointmentList() : blockUsed(0) {
+    texts.push_back(std::string_view()); // Number 0 is the empty text
+    numbers[std::string_view()] = 0;
+}
+
+uint32_t AppointmentList::intern(const std::string& value) {
+    std::unordered_map<std::string_view, uint32_t>::const_iterator known = numbers.find(value);
+    if (known != numbers.end()) return known->second;
+
+    if (blocks.empty() || blockSizes.back() - blockUsed < value.size()) {
+        // Text longer than a block gets a block of its own
+        size_t bytes = value.size() > BLOCK_BYTES ? value.size() : BLOCK_BYTES;
+        blocks.push_back(std::unique_ptr<char[]>(new char[bytes]));
+        blockSizes.push_back(bytes);
+        blockUsed = 0;
+    }
+    char* copy = blocks.back().get() + blockUsed;
+    std::memcpy(copy, value.data(), value.size());
+    blockUsed += value.size();
+
+    uint32_t number = static_cast<uint32_t>(texts.size());
+    texts.push_back(std::string_view(copy, value.size()));
+    numbers[texts.back()] = number;
+    return number;
+}
+
+void AppointmentList::push_back(const Appointment& appointment) {
+    Record record;
+    record.appointmentID = appointment.appointmentID;
+    record.patientID = appointment.patientID;
+    record.doctorID = appointment.doctorID;
+    record.staffID = appointment.staffID;
+    record.appointmentDate = appointment.appointmentDate;
+    record.appointmentTime = appointment.appointmentTime;
+    record.consultationCents = toCents(appointment.consultationFee);
+    record.medicineCents = toCents(appointment.medicineFee);
+    record.totalCents = toCents(appointment.totalCost);
+    record.patientName = intern(appointment.patientName);
+    record.doctorName = intern(appointment.doctorName);
+    record.reason = intern(appointment.reason);
+    record.duration = static_cast<int16_t>(appointment.duration);
+    record.status = appointment.status;
+    records.push_back(record);
+}
+
+Appointment AppointmentList::at(size_t row) const {
+    const Record& record = records.at(row);
+    Appointment appointment;
+    appointment.appointmentID = record.appointmentID;
+    appointment.status = record.status;
+    appointment.appointmentTime = record.appointmentTime;
+    appointment.appointmentDate = record.appointmentDate;
+    appointment.reason = std::string(text(record.reason));
+    appointment.duration = record.duration;
+    appointment.consultationFee = record.consultationFee();
+    appointment.medicineFee = record.medicineFee();
+    appointment.totalCost = record.totalCost();
+    appointment.patientID = record.patientID;
+    appointment.doctorID = record.doctorID;
+    appointment.staffID = record.staffID;
+    appointment.patientName = std::string(text(record.patientName));
+    appointment.doctorName = std::string(text(record.doctorName));
+    return appointment;
+}
+
+size_t AppointmentList::memoryBytes() const {
+    size_t bytes = records.capacity() * sizeof(Record);
+    for (size_t size : blockSizes) bytes += size;
+    bytes += blocks.capacity() * sizeof(std::unique_ptr<char[]>) + blockSizes.capacity() * sizeof(size_t);
+    bytes += texts.capacity() * sizeof(std::string_view);
+    // One node per entry plus the bucket array
+    bytes += numbers.size() * (sizeof(std::pair<const std::string_view, uint32_t>) + 2 * sizeof(void*));
+    bytes += numbers.bucket_count() * sizeof(void*);
+    return bytes;
+}
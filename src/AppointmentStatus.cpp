@@ -0,0 +1,34 @@
+// ============================================================
+// AppointmentStatus.cpp - Appointment Status and Its Transitions
+// Hospital Appointment Booking System
+// ============================================================
+
+#include "../include/AppointmentStatus.h"
+
+namespace {
+    const char* const NAMES[AppointmentStatus::COUNT] = { "Pending", "Confirmed", "Completed", "Cancelled" };
+}
+
+std::optional<AppointmentStatus> AppointmentStatus::parse(const std::string& name) {
+    for (int code = 0; code < COUNT; code++) {
+        if (name == NAMES[code]) return AppointmentStatus(static_cast<Code>(code));
+    }
+    return std::nullopt;
+}
+
+const char* AppointmentStatus::name() const {
+    return NAMES[value];
+}
+
+bool AppointmentStatus::canBecome(AppointmentStatus next) const {
+    switch (next.value) {
+    case Confirmed: return value == Pending;
+    case Completed: return value == Confirmed;
+    case Cancelled: return value != Cancelled;
+    default:        return false; // Nothing returns to Pending
+    }
+}
+
+std::ostream& operator<<(std::ostream& out, AppointmentStatus status) {
+    return out << status.name();
+}
@@ -8,7 +8,7 @@
 #include <windows.h>
 #undef max
 
-AuthModule::AuthModule(ConsoleUtils& c, DatabaseManager& d, UserSession& s)
+AuthModule::AuthModule(ConsoleUtils& c, StorageEngine& d, UserSession& s)
     : console(c), db(d), session(s) {}
 
 bool AuthModule::login() {
@@ -42,12 +42,11 @@ bool AuthModule::login() {
     console.showLoading("\n  Verifying credentials", 2);
     
     // Try login as Patient
-    int patientID = db.loginPatient(email, password);
-    if (patientID > 0) {
-        Patient patient = db.getPatientById(patientID);
-        session.userID = patientID;
-        session.userName = patient.patientName;
-        session.userEmail = patient.email;
+    std::optional<Patient> patient = db.loginPatient(email, password);
+    if (patient) {
+        session.userID = patient->patientID;
+        session.userName = patient->patientName;
+        session.userEmail = patient->email;
         session.userType = "Patient";
         session.isLoggedIn = true;
         
@@ -62,18 +61,17 @@ bool AuthModule::login() {
         std::cout << "  You are logged in as: PATIENT" << std::endl;
         console.resetColor();
         
-        db.logActivity("Patient", patientID, "Login", "Successful login");
+        db.logActivity("Patient", patient->patientID, "Login", "Successful login");
         Sleep(1500);
         return true;
     }
     
     // Try login as Staff
-    int staffID = db.loginStaff(email, password);
-    if (staffID > 0) {
-        Staff staff = db.getStaffById(staffID);
-        session.userID = staffID;
-        session.userName = staff.staffName;
-        session.userEmail = staff.email;
+    std::optional<Staff> staff = db.loginStaff(email, password);
+    if (staff) {
+        session.userID = staff->staffID;
+        session.userName = staff->staffName;
+        session.userEmail = staff->email;
         session.userType = "Staff";
         session.isLoggedIn = true;
         
@@ -88,18 +86,17 @@ bool AuthModule::login() {
         std::cout << "  You are logged in as: STAFF" << std::endl;
         console.resetColor();
         
-        db.logActivity("Staff", staffID, "Login", "Successful login");
+        db.logActivity("Staff", staff->staffID, "Login", "Successful login");
         Sleep(1500);
         return true;
     }
     
     // Try login as Doctor
-    int doctorID = db.loginDoctor(email, password);
-    if (doctorID > 0) {
-        Doctor doctor = db.getDoctorById(doctorID);
-        session.userID = doctorID;
-        session.userName = doctor.doctorName;
-        session.userEmail = doctor.email;
+    std::optional<Doctor> doctor = db.loginDoctor(email, password);
+    if (doctor) {
+        session.userID = doctor->doctorID;
+        session.userName = doctor->doctorName;
+        session.userEmail = doctor->email;
         session.userType = "Doctor";
         session.isLoggedIn = true;
         
@@ -114,18 +111,17 @@ bool AuthModule::login() {
         std::cout << "  You are logged in as: DOCTOR" << std::endl;
         console.resetColor();
         
-        db.logActivity("Doctor", doctorID, "Login", "Successful login");
+        db.logActivity("Doctor", doctor->doctorID, "Login", "Successful login");
         Sleep(1500);
         return true;
     }
     
     // Try login as Admin
-    int adminID = db.loginAdmin(email, password);
-    if (adminID > 0) {
-        Admin admin = db.getAdminById(adminID);
-        session.userID = adminID;
-        session.userName = admin.adminName;
-        session.userEmail = admin.email;
+    std::optional<Admin> admin = db.loginAdmin(email, password);
+    if (admin) {
+        session.userID = admin->adminID;
+        session.userName = admin->adminName;
+        session.userEmail = admin->email;
         session.userType = "Admin";
         session.isLoggedIn = true;
         
@@ -140,7 +136,7 @@ bool AuthModule::login() {
         std::cout << "  You are logged in as: ADMIN" << std::endl;
         console.resetColor();
         
-        db.logActivity("Admin", adminID, "Login", "Successful login");
+        db.logActivity("Admin", admin->adminID, "Login", "Successful login");
         Sleep(1500);
         return true;
     }
@@ -214,14 +210,15 @@ bool AuthModule::loginAsPatient() {
         return false;
     }
     
+    // The password check runs on the worker pool while the spinner plays
+    StorageEngine::PendingLogin<Patient> pending = db.beginLoginPatient(email, password);
     console.showLoading("\n  Verifying credentials", 2);
     
-    int patientID = db.loginPatient(email, password);
-    if (patientID > 0) {
-        Patient patient = db.getPatientById(patientID);
-        session.userID = patientID;
-        session.userName = patient.patientName;
-        session.userEmail = patient.email;
+    std::optional<Patient> patient = pending.get();
+    if (patient) {
+        session.userID = patient->patientID;
+        session.userName = patient->patientName;
+        session.userEmail = patient->email;
         session.userType = "Patient";
         session.isLoggedIn = true;
         
@@ -236,7 +233,7 @@ bool AuthModule::loginAsPatient() {
         std::cout << "  You are logged in as: PATIENT" << std::endl;
         console.resetColor();
         
-        db.logActivity("Patient", patientID, "Login", "Successful login");
+        db.logActivity("Patient", patient->patientID, "Login", "Successful login");
         Sleep(1500);
         return true;
     }
@@ -308,14 +305,14 @@ bool AuthModule::loginAsDoctor() {
         return false;
     }
     
+    StorageEngine::PendingLogin<Doctor> pending = db.beginLoginDoctor(email, password);
     console.showLoading("\n  Verifying credentials", 2);
     
-    int doctorID = db.loginDoctor(email, password);
-    if (doctorID > 0) {
-        Doctor doctor = db.getDoctorById(doctorID);
-        session.userID = doctorID;
-        session.userName = doctor.doctorName;
-        session.userEmail = doctor.email;
+    std::optional<Doctor> doctor = pending.get();
+    if (doctor) {
+        session.userID = doctor->doctorID;
+        session.userName = doctor->doctorName;
+        session.userEmail = doctor->email;
         session.userType = "Doctor";
         session.isLoggedIn = true;
         
@@ -330,7 +327,7 @@ bool AuthModule::loginAsDoctor() {
         std::cout << "  You are logged in as: DOCTOR" << std::endl;
         console.resetColor();
         
-        db.logActivity("Doctor", doctorID, "Login", "Successful login");
+        db.logActivity("Doctor", doctor->doctorID, "Login", "Successful login");
         Sleep(1500);
         return true;
     }
@@ -402,14 +399,14 @@ bool AuthModule::loginAsStaff() {
         return false;
     }
     
+    StorageEngine::PendingLogin<Staff> pending = db.beginLoginStaff(email, password);
     console.showLoading("\n  Verifying credentials", 2);
     
-    int staffID = db.loginStaff(email, password);
-    if (staffID > 0) {
-        Staff staff = db.getStaffById(staffID);
-        session.userID = staffID;
-        session.userName = staff.staffName;
-        session.userEmail = staff.email;
+    std::optional<Staff> staff = pending.get();
+    if (staff) {
+        session.userID = staff->staffID;
+        session.userName = staff->staffName;
+        session.userEmail = staff->email;
         session.userType = "Staff";
         session.isLoggedIn = true;
         
@@ -424,7 +421,7 @@ bool AuthModule::loginAsStaff() {
         std::cout << "  You are logged in as: STAFF" << std::endl;
         console.resetColor();
         
-        db.logActivity("Staff", staffID, "Login", "Successful login");
+        db.logActivity("Staff", staff->staffID, "Login", "Successful login");
         Sleep(1500);
         return true;
     }
@@ -496,14 +493,14 @@ bool AuthModule::loginAsAdmin() {
         return false;
     }
     
+    StorageEngine::PendingLogin<Admin> pending = db.beginLoginAdmin(email, password);
     console.showLoading("\n  Verifying credentials", 2);
     
-    int adminID = db.loginAdmin(email, password);
-    if (adminID > 0) {
-        Admin admin = db.getAdminById(adminID);
-        session.userID = adminID;
-        session.userName = admin.adminName;
-        session.userEmail = admin.email;
+    std::optional<Admin> admin = pending.get();
+    if (admin) {
+        session.userID = admin->adminID;
+        session.userName = admin->adminName;
+        session.userEmail = admin->email;
         session.userType = "Admin";
         session.isLoggedIn = true;
         
@@ -518,7 +515,7 @@ bool AuthModule::loginAsAdmin() {
         std::cout << "  You are logged in as: ADMIN" << std::endl;
         console.resetColor();
         
-        db.logActivity("Admin", adminID, "Login", "Successful login");
+        db.logActivity("Admin", admin->adminID, "Login", "Successful login");
         Sleep(1500);
         return true;
     }
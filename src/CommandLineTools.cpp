@@ -0,0 +1,894 @@
+// ============================================================
+// CommandLineTools.cpp - Headless Maintenance and Benchmark Commands
+// Hospital Appointment Booking System
+// ============================================================
+
+#include "../include/CommandLineTools.h"
+#include "../include/AppointmentImporter.h"
+#include "../include/AppointmentExporter.h"
+#include "../include/AppointmentColumns.h"
+#include "../include/AppointmentList.h"
+#include "../include/MedicineFeeMatcher.h"
+#include <iostream>
+#include <algorithm>
+#include <iomanip>
+#include <chrono>
+#include <fstream>
+#include <cmath>
+#include <functional>
+#include <future>
+#include <cctype>
+#include <random>
+#include <map>
+#include <string>
+
+// --check-indexes: EXPLAIN every hot query and fail if any of them
+// would scan its table instead of using an index
+int runIndexCheck(StorageEngine& storage) {
+    if (!storage.connect()) {
+        std::cerr << "Database connection failed" << std::endl;
+        return 2;
+    }
+    
+    std::vector<StorageEngine::QueryPlan> plans = storage.explainHotQueries();
+    if (plans.empty()) {
+        storage.disconnect();
+        return 2;
+    }
+    
+    int failures = 0;
+    long long appointmentRows = 0;
+    std::cout << std::left << std::setw(32) << "Query" << std::setw(8) << "Type"
+              << std::setw(30) << "Key" << std::setw(12) << "Est. Rows" << "Result" << std::endl;
+    for (const StorageEngine::QueryPlan& plan : plans) {
+        if (plan.table == "a" || plan.table == "Appointment") appointmentRows = plan.tableRows;
+        if (!plan.indexed) failures++;
+        std::cout << std::left << std::setw(32) << plan.method
+                  << std::setw(8) << plan.accessType
+                  << std::setw(30) << (plan.key.empty() ? "(none)" : plan.key)
+                  << std::setw(12) << plan.estimatedRows
+                  << (plan.indexed ? "OK" : "FULL SCAN") << std::endl;
+    }
+    
+    std::cout << "\nAppointment rows: " << appointmentRows << std::endl;
+    if (appointmentRows < 1000000) {
+        std::cout << "[WARNING] Fewer than 1M appointments - load migrations/seed_load_test.sql "
+                  << "into a scratch database for a meaningful check" << std::endl;
+    }
+    std::cout << (failures == 0 ? "All hot queries are index-driven"
+                                : std::to_string(failures) + " query(s) not index-driven") << std::endl;
+    
+    storage.disconnect();
+    return failures == 0 ? 0 : 1;
+}
+
+// --bench-row-mapping [rows]: compare by-name and positional row mapping
+// over the same appointment result set (default 100,000 rows)
+int runRowMappingBenchmark(StorageEngine& storage, int rows) {
+    if (!storage.connect()) {
+        std::cerr << "Database connection failed" << std::endl;
+        return 2;
+    }
+    
+    StorageEngine::RowMappingBenchmark bench = storage.benchmarkRowMapping(rows);
+    storage.disconnect();
+    if (bench.rows == 0) {
+        std::cerr << "No appointment rows to map - load migrations/seed_load_test.sql first" << std::endl;
+        return 2;
+    }
+    
+    std::cout << "Rows mapped: " << bench.rows << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << std::left << std::setw(34) << "" << std::setw(12) << "Fetch ms" << std::setw(12) << "Map ms"
+              << "ns/row (map)" << std::endl;
+    std::cout << std::left << std::setw(34) << "SELECT a.* + by-name getters"
+              << std::setw(12) << bench.byNameFetchMs << std::setw(12) << bench.byNameMapMs
+              << bench.byNameMapMs * 1e6 / bench.rows << std::endl;
+    std::cout << std::left << std::setw(34) << "Column list + RowMapper<T>"
+              << std::setw(12) << bench.positionalFetchMs << std::setw(12) << bench.positionalMapMs
+              << bench.positionalMapMs * 1e6 / bench.rows << std::endl;
+    if (bench.positionalMapMs > 0.0) {
+        std::cout << "Mapping speedup: " << bench.byNameMapMs / bench.positionalMapMs << "x" << std::endl;
+    }
+    return 0;
+}
+
+// --verify-rollups / --rebuild-rollups: recount Appointment and compare it
+// with the DoctorDailyStats rollup (rebuilding it first when asked)
+int runRollupCheck(StorageEngine& storage, bool rebuild) {
+    if (!storage.connect()) {
+        std::cerr << "Database connection failed" << std::endl;
+        return 2;
+    }
+    
+    if (rebuild) {
+        if (!storage.rebuildStatisticsRollup()) {
+            storage.disconnect();
+            return 2;
+        }
+        std::cout << "Statistics rollup rebuilt" << std::endl;
+    }
+    
+    std::vector<StorageEngine::RollupDrift> drift;
+    bool ran = storage.verifyStatisticsRollup(drift);
+    storage.disconnect();
+    if (!ran) return 2;
+    
+    if (drift.empty()) {
+        std::cout << "Statistics rollup matches Appointment" << std::endl;
+        return 0;
+    }
+    
+    std::cout << "Rollup minus recount:" << std::endl;
+    std::cout << std::left << std::setw(8) << "Doctor" << std::setw(12) << "Date"
+              << std::setw(9) << "Pending" << std::setw(11) << "Confirmed" << std::setw(11) << "Completed"
+              << std::setw(11) << "Cancelled" << std::setw(12) << "Revenue" << "Open" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    for (const StorageEngine::RollupDrift& d : drift) {
+        std::cout << std::left << std::setw(8) << d.doctorID << std::setw(12) << d.date
+                  << std::setw(9) << d.pending << std::setw(11) << d.confirmed
+                  << std::setw(11) << d.completed << std::setw(11) << d.cancelled
+                  << std::setw(12) << d.completedRevenue << d.openRevenue << std::endl;
+    }
+    std::cout << drift.size() << " doctor-day(s) out of sync - run --rebuild-rollups" << std::endl;
+    return 1;
+}
+
+// --migrate-passwords: hash every password still stored as plaintext
+int runPasswordMigration(StorageEngine& storage) {
+    if (!storage.connect()) {
+        std::cerr << "Database connection failed" << std::endl;
+        return 2;
+    }
+    int migrated = storage.migratePlaintextPasswords();
+    storage.disconnect();
+    if (migrated < 0) return 2;
+    std::cout << migrated << " plaintext password(s) replaced with scrypt hashes" << std::endl;
+    return 0;
+}
+
+// --bench-passwords [logins]: password checks per second at each scrypt
+// cost, through the same worker pool the login path uses (no database needed)
+int runPasswordBenchmark(int logins) {
+    typedef std::chrono::steady_clock Clock;
+    const int costs[] = { 10, 12, 14, 15, 16 };
+    const std::string password = "benchmark-password";
+    if (logins < 1) logins = 1;
+    
+    PasswordVerifier::Config config;
+    config.cacheCapacity = 0; // Measure the KDF itself
+    std::cout << "Workers: " << config.workers << ", logins per cost: " << logins << std::endl;
+    std::cout << std::left << std::setw(16) << "Cost" << std::setw(12) << "Memory" << std::setw(18) << "ms/login (1 thr)"
+              << "logins/s (pool)" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    
+    for (int logN : costs) {
+        PasswordHasher::Cost cost;
+        cost.logN = logN;
+        std::string stored = PasswordHasher::hash(password, cost);
+        
+        Clock::time_point start = Clock::now();
+        PasswordHasher::verify(password, stored);
+        double singleMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        
+        PasswordVerifier verifier(config);
+        std::vector<std::future<bool>> verdicts;
+        start = Clock::now();
+        for (int i = 0; i < logins; i++) {
+            verdicts.push_back(verifier.verify(password, stored));
+        }
+        for (std::future<bool>& verdict : verdicts) {
+            verdict.get();
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        
+        std::cout << std::left << std::setw(16) << ("ln=" + std::to_string(logN) + ",r=" + std::to_string(cost.r) + ",p=" + std::to_string(cost.p))
+                  << std::setw(12) << (std::to_string(cost.memoryBytes() >> 20) + " MiB")
+                  << std::setw(18) << singleMs << logins / seconds << std::endl;
+    }
+    
+    // Repeat logins within the cache TTL skip the KDF entirely
+    PasswordHasher::Cost defaultCost;
+    std::string stored = PasswordHasher::hash(password, defaultCost);
+    PasswordVerifier cached((PasswordVerifier::Config()));
+    cached.verify(password, stored).get();
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < logins; i++) {
+        cached.verify(password, stored).get();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    std::cout << std::left << std::setw(46) << "Verification cache hit (default cost)"
+              << logins / seconds << std::endl;
+    return 0;
+}
+
+// --import-appointments <file.csv> [chunk rows]: bulk-load appointments
+// (see AppointmentImporter); rejected records go to stderr as "line N: ..."
+int runAppointmentImport(StorageEngine& storage, const char* path, int chunkRows) {
+    std::ifstream csv(path);
+    if (!csv) {
+        std::cerr << "Cannot open " << path << std::endl;
+        return 2;
+    }
+    if (!storage.connect()) {
+        std::cerr << "Database connection failed" << std::endl;
+        return 2;
+    }
+    
+    AppointmentImporter::Config config;
+    if (chunkRows > 0) config.chunkRows = chunkRows;
+    AppointmentImporter importer(storage, config);
+    AppointmentImporter::Summary summary = importer.run(csv, std::cerr);
+    storage.disconnect();
+    
+    std::cout << "Records: " << summary.records << ", imported: " << summary.imported
+              << ", rejected: " << summary.rejected << std::endl;
+    std::cout << std::fixed << std::setprecision(1) << "Time: " << summary.seconds << " s ("
+              << summary.rowsPerSecond() << " rows/s)" << std::endl;
+    return summary.rejected == 0 ? 0 : 1;
+}
+
+// --export-appointments <from> <to> <file> [csv|ndjson] [--direct] [--fsync]:
+// stream every appointment in the date range to a file (see AppointmentExporter)
+int runAppointmentExport(StorageEngine& storage, int argc, char* argv[]) {
+    Date fromDate = Date::parse(argv[2]);
+    Date toDate = Date::parse(argv[3]);
+    if (!fromDate.isValid() || !toDate.isValid()) {
+        std::cerr << "Dates must be YYYY-MM-DD" << std::endl;
+        return 2;
+    }
+    AppointmentExporter::Options options;
+    for (int i = 5; i < argc; i++) {
+        std::string option = argv[i];
+        if (option == "csv") options.format = AppointmentExporter::Csv;
+        else if (option == "ndjson") options.format = AppointmentExporter::Ndjson;
+        else if (option == "--direct") options.direct = true;
+        else if (option == "--fsync") options.sync = true;
+        else {
+            std::cerr << "Unknown export option: " << option << std::endl;
+            return 2;
+        }
+    }
+    if (!storage.connect()) {
+        std::cerr << "Database connection failed" << std::endl;
+        return 2;
+    }
+    
+    AppointmentExporter exporter(storage, options);
+    AppointmentExporter::Result result = exporter.exportRange(fromDate, toDate, argv[4]);
+    storage.disconnect();
+    if (!result.ok) {
+        std::cerr << "Export failed: " << result.error << std::endl;
+        return 2;
+    }
+    
+    std::cout << "Rows: " << result.rows << ", bytes: " << result.bytes << ", writes: " << result.writes << std::endl;
+    std::cout << std::fixed << std::setprecision(1) << "Time: " << result.seconds << " s ("
+              << (result.seconds > 0.0 ? result.rows / result.seconds : 0.0) << " rows/s, "
+              << (result.seconds > 0.0 ? result.bytes / (1024.0 * 1024.0) / result.seconds : 0.0) << " MiB/s)"
+              << std::endl;
+    return 0;
+}
+
+namespace {
+    // The calculateMedicineFee that MedicineFeeMatcher replaced: a lowercased
+    // copy, then one find() per keyword. Kept as the benchmark's baseline.
+    double scanMedicineFee(const std::string& reason) {
+        std::string lowerReason = reason;
+        std::transform(lowerReason.begin(), lowerReason.end(), lowerReason.begin(), ::tolower);
+    
+        if (lowerReason.find("fever") != std::string::npos || 
+            lowerReason.find("flu") != std::string::npos || 
+            lowerReason.find("cough") != std::string::npos ||
+            lowerReason.find("cold") != std::string::npos) {
+            return 25.00;
+        }
+        else if (lowerReason.find("pain") != std::string::npos ||
+                 lowerReason.find("headache") != std::string::npos ||
+                 lowerReason.find("backache") != std::string::npos) {
+            return 40.00;
+        }
+        else if (lowerReason.find("allergy") != std::string::npos ||
+                 lowerReason.find("rash") != std::string::npos ||
+                 lowerReason.find("itch") != std::string::npos ||
+                 lowerReason.find("skin") != std::string::npos) {
+            return 35.00;
+        }
+        else if (lowerReason.find("infection") != std::string::npos ||
+                 lowerReason.find("throat") != std::string::npos) {
+            return 50.00;
+        }
+        else if (lowerReason.find("diabetes") != std::string::npos ||
+                 lowerReason.find("blood pressure") != std::string::npos ||
+                 lowerReason.find("hypertension") != std::string::npos ||
+                 lowerReason.find("heart") != std::string::npos) {
+            return 80.00;
+        }
+        else if (lowerReason.find("checkup") != std::string::npos ||
+                 lowerReason.find("check up") != std::string::npos ||
+                 lowerReason.find("follow-up") != std::string::npos ||
+                 lowerReason.find("follow up") != std::string::npos ||
+                 lowerReason.find("screening") != std::string::npos) {
+            return 0.00;
+        }
+        return 30.00;
+    }
+
+}
+
+// --bench-medicine-fee [reasons]: price synthetic visit reasons (default
+// 1,000,000) with MedicineFeeMatcher and with scanMedicineFee, failing on
+// any disagreement (no database needed)
+int runMedicineFeeBenchmark(int count) {
+    typedef std::chrono::steady_clock Clock;
+    const char* words[] = { "Fever", "and", "headache", "since", "Monday", "FLU", "symptoms", "Follow-up", "for",
+                            "blood pressure", "review", "skin", "Rash", "on", "arm", "persistent", "Cough",
+                            "annual", "Screening", "sore", "Throat", "infection", "lower", "back", "pain", "check up",
+                            "DIABETES", "medication", "refill", "itchy", "eyes", "dizziness", "consultation",
+                            "heartburn", "fatigue", "x-ray", "results", "vaccination", "cold", "hands" };
+    const size_t wordCount = sizeof(words) / sizeof(words[0]);
+    if (count < 1) count = 1;
+    
+    // 1-8 words each: the short free text patients type
+    std::mt19937 random(11);
+    std::vector<std::string> reasons(count);
+    for (std::string& reason : reasons) {
+        int length = 1 + int(random() % 8);
+        for (int w = 0; w < length; w++) {
+            if (w > 0) reason += ' ';
+            reason += words[random() % wordCount];
+        }
+    }
+    
+    const MedicineFeeMatcher& matcher = MedicineFeeMatcher::instance();
+    for (const std::string& reason : reasons) {
+        if (matcher.fee(reason) != scanMedicineFee(reason)) {
+            std::cerr << "Mismatch for \"" << reason << "\": " << matcher.fee(reason) << " vs "
+                      << scanMedicineFee(reason) << std::endl;
+            return 1;
+        }
+    }
+    
+    // The totals are printed so neither loop can be optimized away
+    double scanTotal = 0.0, matchTotal = 0.0;
+    Clock::time_point start = Clock::now();
+    for (const std::string& reason : reasons) scanTotal += scanMedicineFee(reason);
+    double scanNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / count;
+    start = Clock::now();
+    for (const std::string& reason : reasons) matchTotal += matcher.fee(reason);
+    double matchNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / count;
+    
+    std::cout << std::fixed << std::setprecision(1)
+              << "Reasons: " << count << ", fees agree (RM " << scanTotal << " / RM " << matchTotal << ")" << std::endl
+              << "find() scans : " << scanNs << " ns/reason" << std::endl
+              << "Automaton    : " << matchNs << " ns/reason" << std::endl
+              << "Speedup      : " << (matchNs > 0.0 ? scanNs / matchNs : 0.0) << "x" << std::endl;
+    return 0;
+}
+
+// --bench-patient-search [patients]: build the trigram index over synthetic
+// patients (default 1,000,000) and time typical queries against a plain
+// substring scan of the same data (no database needed)
+int runPatientSearchBenchmark(int patients) {
+    typedef std::chrono::steady_clock Clock;
+    const char* firstNames[] = { "Ahmad", "Siti", "Muhammad", "Nur", "Lim", "Tan", "Wei", "Priya", "Ravi", "Aisyah",
+                                 "Daniel", "Sarah", "Farah", "Hafiz", "Mei", "Arjun", "Chong", "Zainab", "Kumar", "Grace" };
+    const char* lastNames[] = { "Abdullah", "Rahman", "Ismail", "Wong", "Lee", "Chen", "Ng", "Krishnan", "Subramaniam",
+                                "Hassan", "Ibrahim", "Yusof", "Ong", "Teo", "Nair", "Pillai", "Osman", "Razak", "Goh", "Lau" };
+    if (patients < 1) patients = 1;
+    
+    std::mt19937 random(42);
+    std::vector<PatientSearchIndex::Entry> entries(patients);
+    for (int i = 0; i < patients; i++) {
+        const char* first = firstNames[random() % 20];
+        const char* last = lastNames[random() % 20];
+        PatientSearchIndex::Entry& entry = entries[i];
+        entry.patientID = i + 1;
+        entry.name = std::string(first) + " " + last;
+        entry.email = std::string(first) + "." + last + std::to_string(i) + "@mail.com";
+        entry.phone = "01" + std::to_string(10000000 + random() % 90000000);
+    }
+    
+    PatientSearchIndex index([&entries]() { return entries; }, PatientSearchIndex::Config());
+    index.search("warm-up"); // Loads the index
+    PatientSearchIndex::Stats built = index.getStats();
+    std::cout << "Patients: " << built.patients << ", distinct trigrams: " << built.trigrams
+              << ", postings: " << built.postings << std::endl;
+    std::cout << std::fixed << std::setprecision(1) << "Build: " << built.lastLoadMs << " ms, ~"
+              << built.memoryBytes / (1024.0 * 1024.0) << " MiB" << std::endl;
+    
+    // Lowercased copies for the baseline, so it pays for nothing but the scan
+    std::vector<std::string> lowered(patients);
+    for (int i = 0; i < patients; i++) {
+        std::string text = entries[i].name + '\x1f' + entries[i].email + '\x1f' + entries[i].phone;
+        for (char& c : text) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        lowered[i] = text;
+    }
+    
+    const std::string queries[] = { "krishnan", "siti ismail", "farah.goh12", "4242", "0123456", "@mail.com", "ng", "nobody" };
+    std::cout << std::left << std::setw(14) << "Query" << std::setw(10) << "Matches" << std::setw(14) << "Index us"
+              << std::setw(14) << "Scan us" << "Speedup" << std::endl;
+    for (const std::string& query : queries) {
+        const int repeats = 20;
+        size_t matches = 0;
+        Clock::time_point start = Clock::now();
+        for (int r = 0; r < repeats; r++) {
+            matches = index.search(query).size();
+        }
+        double indexUs = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / repeats;
+        
+        size_t scanned = 0;
+        start = Clock::now();
+        for (const std::string& text : lowered) {
+            if (text.find(query) != std::string::npos) scanned++;
+        }
+        double scanUs = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+        if (scanned != matches) {
+            std::cerr << "Mismatch for \"" << query << "\": index " << matches << ", scan " << scanned << std::endl;
+            return 1;
+        }
+        std::cout << std::left << std::setw(14) << query << std::setw(10) << matches << std::setw(14) << indexUs
+                  << std::setw(14) << scanUs << (indexUs > 0.0 ? scanUs / indexUs : 0.0) << "x" << std::endl;
+    }
+    
+    // Typeahead: top 10 per keystroke; every hit must really start a name word or the phone
+    const std::string prefixes[] = { "a", "ah", "ahmad r", "kri", "0", "0123", "012-34" };
+    std::cout << std::left << std::setw(14) << "Prefix" << std::setw(10) << "Top 10" << "us/keystroke" << std::endl;
+    for (const std::string& prefix : prefixes) {
+        const int repeats = 1000;
+        std::vector<int> ids;
+        Clock::time_point start = Clock::now();
+        for (int r = 0; r < repeats; r++) {
+            ids = index.complete(prefix, 10);
+        }
+        double us = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / repeats;
+        
+        bool phone = prefix.find_first_not_of("0123456789-") == std::string::npos;
+        std::string wanted;
+        for (char c : prefix) {
+            if (!phone || c != '-') wanted += c;
+        }
+        for (int id : ids) {
+            const PatientSearchIndex::Entry& entry = entries[id - 1];
+            bool valid = phone ? entry.phone.compare(0, wanted.size(), wanted) == 0
+                               : (" " + lowered[id - 1].substr(0, entry.name.size())).find(" " + wanted) != std::string::npos;
+            if (!valid) {
+                std::cerr << "Bad completion for \"" << prefix << "\": patient " << id << std::endl;
+                return 1;
+            }
+        }
+        std::cout << std::left << std::setw(14) << prefix << std::setw(10) << ids.size() << us << std::endl;
+    }
+    return 0;
+}
+
+// --bench-free-slots [doctors]: fill four weeks of synthetic bookings for
+// doctors doctors (default 200) and time findFree() against probing every
+// quarter with isFree(), the loop it replaces (no database needed)
+int runFreeSlotBenchmark(int doctors) {
+    typedef std::chrono::steady_clock Clock;
+    const Date fromDate = Date::fromCivil(2026, 1, 5);
+    const int days = 28;
+    if (doctors < 1) doctors = 1;
+    
+    // Each doctor-day is booked back to back from 08:00 with random 15-60
+    // minute appointments, about one in ten left as a gap
+    std::mt19937 random(7);
+    DoctorSlotIndex::Load load;
+    load.fromDate = fromDate;
+    int firstDay = load.fromDate.dayNumber();
+    int appointmentID = 0;
+    for (int doctor = 1; doctor <= doctors; doctor++) {
+        for (int day = firstDay; day < firstDay + days; day++) {
+            for (int minute = 8 * 60; minute < 17 * 60; ) {
+                int duration = 15 * (1 + int(random() % 4));
+                if (random() % 10 != 0) {
+                    DoctorSlotIndex::Booking booking;
+                    booking.appointmentID = ++appointmentID;
+                    booking.doctorID = doctor;
+                    booking.date = Date::fromDayNumber(day);
+                    booking.time = TimeOfDay::fromMinutes(minute);
+                    booking.duration = duration;
+                    load.bookings.push_back(booking);
+                }
+                minute += duration;
+            }
+        }
+    }
+    DoctorSlotIndex index([&load]() { return load; }, DoctorSlotIndex::Config());
+    index.isFree(1, fromDate, TimeOfDay::fromMinutes(8 * 60), 15); // Loads the index
+    DoctorSlotIndex::Stats built = index.getStats();
+    std::cout << "Doctors: " << doctors << ", bookings: " << built.bookings << ", doctor-days: " << built.doctorDays
+              << std::endl;
+    
+    struct Case {
+        const char* label;
+        int doctorCount;
+        int duration;
+        int notBefore;
+        size_t count;
+    };
+    const Case cases[] = {
+        { "1 doctor, 30 min", 1, 30, 0, 5 },
+        { "1 doctor, 60 min", 1, 60, 13 * 60 + 7, 5 },
+        { "20 doctors, 45 min", 20, 45, 0, 8 },
+        { "all doctors, 60 min", doctors, 60, 0, 8 },
+    };
+    std::cout << std::left << std::setw(22) << "Search" << std::setw(8) << "Found" << std::setw(14) << "findFree us"
+              << std::setw(14) << "Probing us" << "Speedup" << std::endl;
+    for (const Case& c : cases) {
+        DoctorSlotIndex::SlotSearch search;
+        for (int doctor = 1; doctor <= (std::min)(c.doctorCount, doctors); doctor++) search.doctorIDs.push_back(doctor);
+        search.fromDate = fromDate;
+        search.notBeforeMinute = c.notBefore;
+        search.days = days;
+        search.duration = c.duration;
+        search.count = c.count;
+        
+        const int repeats = 1000;
+        std::vector<DoctorSlotIndex::FreeSlot> found;
+        Clock::time_point start = Clock::now();
+        for (int r = 0; r < repeats; r++) {
+            found = *index.findFree(search);
+        }
+        double findUs = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / repeats;
+        
+        // Baseline: every quarter start, day by day, doctor by doctor
+        std::vector<DoctorSlotIndex::FreeSlot> probed;
+        start = Clock::now();
+        for (int day = firstDay; day < firstDay + days && probed.size() < search.count; day++) {
+            Date date = Date::fromDayNumber(day);
+            for (int minute = search.openMinute; minute + c.duration <= search.closeMinute && probed.size() < search.count;
+                 minute += DoctorSlotIndex::SLOT_MINUTES) {
+                if (day == firstDay && minute < c.notBefore) continue;
+                TimeOfDay time = TimeOfDay::fromMinutes(minute);
+                for (size_t d = 0; d < search.doctorIDs.size() && probed.size() < search.count; d++) {
+                    if (*index.isFree(search.doctorIDs[d], date, time, c.duration)) {
+                        DoctorSlotIndex::FreeSlot slot;
+                        slot.doctorID = search.doctorIDs[d];
+                        slot.date = date;
+                        slot.time = time;
+                        probed.push_back(slot);
+                    }
+                }
+            }
+        }
+        double probeUs = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+        
+        bool same = found.size() == probed.size();
+        for (size_t i = 0; same && i < found.size(); i++) {
+            same = found[i].doctorID == probed[i].doctorID && found[i].date == probed[i].date &&
+                   found[i].time == probed[i].time;
+        }
+        if (!same) {
+            std::cerr << "Mismatch for \"" << c.label << "\"" << std::endl;
+            return 1;
+        }
+        std::cout << std::left << std::setw(22) << c.label << std::setw(8) << found.size() << std::setw(14) << findUs
+                  << std::setw(14) << probeUs << (findUs > 0.0 ? probeUs / findUs : 0.0) << "x" << std::endl;
+        if (!found.empty()) {
+            std::cout << "    first: doctor " << found[0].doctorID << " " << found[0].date << " "
+                      << found[0].time.shortString() << std::endl;
+        }
+    }
+    return 0;
+}
+
+// --bench-columns [rows]: count, sum and group synthetic appointments
+// (default 10,000,000) by status and doctor three ways - looping over
+// Appointment structs as the screens used to, and with AppointmentColumns'
+// scalar and AVX2 kernels - failing on any disagreement (no database needed)
+int runColumnBenchmark(long long rows) {
+    typedef std::chrono::steady_clock Clock;
+    typedef AppointmentColumns::PerStatus PerStatus;
+    const int doctorCount = 40;
+    const int spanDays = 365;
+    const size_t chunkRows = 1000000; // Appointment structs held at once
+    if (rows < 1) rows = 1;
+    
+    // A year of appointments; the window is its last 90 days
+    const int firstDay = Date::fromCivil(2025, 1, 1).dayNumber();
+    const int windowFirst = firstDay + spanDays - 90, windowLast = firstDay + spanDays - 1;
+    
+    // The row loops run one chunk of structs at a time, so their total
+    // covers every row without holding them all
+    std::mt19937 random(5);
+    AppointmentColumns columns;
+    columns.reserve(static_cast<size_t>(rows));
+    PerStatus rowCounts = {};
+    double rowSums[3][AppointmentColumns::STATUS_COUNT] = {};
+    std::map<int, PerStatus> rowDoctors;
+    double rowMs[3] = { 0.0, 0.0, 0.0 };
+    std::vector<Appointment> chunk;
+    for (long long done = 0; done < rows; ) {
+        chunk.assign(static_cast<size_t>((std::min)(static_cast<long long>(chunkRows), rows - done)), Appointment());
+        for (Appointment& apt : chunk) {
+            apt.appointmentID = static_cast<int>(++done);
+            apt.status = static_cast<AppointmentStatus::Code>(random() % AppointmentStatus::COUNT);
+            int day = int(random() % spanDays);
+            apt.appointmentDate = Date::fromDayNumber(firstDay + day);
+            apt.appointmentTime = TimeOfDay::fromMinutes(10 * 60 + 30);
+            apt.reason = "Follow-up";
+            apt.duration = 15 * (1 + int(random() % 4));
+            apt.consultationFee = apt.duration;
+            apt.medicineFee = (random() % 8001) / 100.0;
+            apt.totalCost = apt.consultationFee + apt.medicineFee;
+            apt.doctorID = 1 + int(random() % doctorCount);
+            apt.patientID = 1 + int(random() % 100000);
+            apt.patientName = "Patient " + std::to_string(apt.patientID);
+            apt.doctorName = "Dr. " + std::to_string(apt.doctorID);
+            columns.append(apt.appointmentID, apt.doctorID, firstDay + day, apt.status,
+                           apt.consultationFee, apt.medicineFee, apt.totalCost);
+        }
+        
+        // Row loops read each whole Appointment
+        Clock::time_point start = Clock::now();
+        for (const Appointment& apt : chunk) {
+            int day = apt.appointmentDate.dayNumber();
+            if (day >= windowFirst && day <= windowLast) rowCounts[apt.status.index()]++;
+        }
+        rowMs[0] += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        start = Clock::now();
+        for (const Appointment& apt : chunk) {
+            int day = apt.appointmentDate.dayNumber();
+            if (day < windowFirst || day > windowLast) continue;
+            int status = apt.status.index();
+            rowSums[AppointmentColumns::Consultation][status] += apt.consultationFee;
+            rowSums[AppointmentColumns::Medicine][status] += apt.medicineFee;
+            rowSums[AppointmentColumns::Total][status] += apt.totalCost;
+        }
+        rowMs[1] += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        start = Clock::now();
+        for (const Appointment& apt : chunk) {
+            int day = apt.appointmentDate.dayNumber();
+            if (day >= windowFirst && day <= windowLast) rowDoctors[apt.doctorID][apt.status.index()]++;
+        }
+        rowMs[2] += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+    chunk.clear();
+    chunk.shrink_to_fit();
+    std::cout << "Rows: " << rows << ", doctors: " << doctorCount << ", AVX2: "
+              << (AppointmentColumns::hasAvx2() ? "yes" : "no (both kernel columns run the scalar loops)") << std::endl;
+    
+    const AppointmentColumns::Kernel kernels[] = { AppointmentColumns::Scalar, AppointmentColumns::Auto };
+    double kernelMs[3][2];
+    for (int k = 0; k < 2; k++) {
+        Clock::time_point start = Clock::now();
+        PerStatus counts = columns.countByStatus(windowFirst, windowLast, kernels[k]);
+        kernelMs[0][k] = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        
+        PerStatus sums[3];
+        start = Clock::now();
+        for (int fee = 0; fee < 3; fee++) {
+            sums[fee] = columns.sumByStatus(static_cast<AppointmentColumns::Fee>(fee), windowFirst, windowLast, kernels[k]);
+        }
+        kernelMs[1][k] = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        
+        start = Clock::now();
+        std::vector<AppointmentColumns::DoctorCounts> doctors = columns.countByDoctor(windowFirst, windowLast, kernels[k]);
+        kernelMs[2][k] = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        
+        bool same = counts == rowCounts && doctors.size() == rowDoctors.size();
+        for (int fee = 0; same && fee < 3; fee++) {
+            for (int st = 0; st < AppointmentColumns::STATUS_COUNT; st++) {
+                // The row loop sums doubles, so allow for its rounding
+                double expected = rowSums[fee][st];
+                same = same && std::fabs(sums[fee][st] / 100.0 - expected) <= 1e-9 * std::fabs(expected) + 0.01;
+            }
+        }
+        for (size_t d = 0; same && d < doctors.size(); d++) {
+            same = doctors[d].appointments == rowDoctors[doctors[d].doctorID];
+        }
+        if (!same) {
+            std::cerr << "Mismatch between the row loops and the "
+                      << (kernels[k] == AppointmentColumns::Scalar ? "scalar" : "AVX2") << " kernels" << std::endl;
+            return 1;
+        }
+    }
+    
+    const char* labels[] = { "Count by status", "Sum by status (3 fees)", "Group by doctor" };
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << std::left << std::setw(26) << "Aggregate" << std::setw(14) << "Row loop ms" << std::setw(12)
+              << "Scalar ms" << std::setw(12) << "AVX2 ms" << "Speedup vs rows" << std::endl;
+    for (int i = 0; i < 3; i++) {
+        std::cout << std::left << std::setw(26) << labels[i] << std::setw(14) << rowMs[i] << std::setw(12)
+                  << kernelMs[i][0] << std::setw(12) << kernelMs[i][1]
+                  << (kernelMs[i][1] > 0.0 ? rowMs[i] / kernelMs[i][1] : 0.0) << "x" << std::endl;
+    }
+    return 0;
+}
+
+namespace {
+    // Heap bytes behind a string; short ones live inside the object
+    size_t heapBytes(const std::string& text) {
+        const char* object = reinterpret_cast<const char*>(&text);
+        bool local = text.data() >= object && text.data() < object + sizeof(text);
+        return local ? 0 : text.capacity() + 1;
+    }
+
+}
+
+// --bench-records [rows]: hold synthetic appointments (default 1,000,000)
+// over a four-doctor roster both as Appointment objects and as an
+// AppointmentList, then compare the memory each takes and the time for a
+// pass reading every row's fee and doctor name. Fails if any row reads
+// back differently (no database needed)
+int runRecordBenchmark(int rows) {
+    typedef std::chrono::steady_clock Clock;
+    const char* doctorNames[] = { "Dr. Noor Aini binti Hassan", "Dr. Ahmad Razak bin Ismail",
+                                  "Dr. Siti Rahmah binti Yusof", "Dr. Lim Wei Keat" };
+    const char* givenNames[] = { "Muhammad Adam", "Nur Aisyah", "Tan Mei Ling", "Siti Khadijah", "Ahmad Fauzi",
+                                 "Nurul Aina", "Rajesh Kumar", "Wong Kah Wai", "Farah Nadia", "Arjun Pillai" };
+    const char* familyNames[] = { "bin Abdullah", "binti Rahman", "Chong", "a/l Subramaniam", "binti Osman",
+                                  "bin Hamzah", "Lee", "a/p Muthu" };
+    const char* reasons[] = { "Fever and cough", "Regular checkup", "Skin rash", "Back pain", "Follow-up",
+                              "Blood pressure review", "Diabetes medication refill", "Annual screening",
+                              "Sore throat", "Vaccination" };
+    if (rows < 1) rows = 1;
+    
+    std::mt19937 random(17);
+    const int patientCount = (std::max)(1, rows / 20);
+    std::vector<std::string> patientNames(patientCount);
+    for (std::string& name : patientNames) {
+        name = std::string(givenNames[random() % 10]) + " " + familyNames[random() % 8];
+    }
+    const int firstDay = Date::fromCivil(2025, 1, 1).dayNumber();
+    std::vector<Appointment> appointments(static_cast<size_t>(rows));
+    for (int i = 0; i < rows; i++) {
+        Appointment& apt = appointments[i];
+        apt.appointmentID = i + 1;
+        apt.status = static_cast<AppointmentStatus::Code>(random() % AppointmentStatus::COUNT);
+        apt.appointmentDate = Date::fromDayNumber(firstDay + int(random() % 365));
+        apt.appointmentTime = TimeOfDay::fromMinutes(8 * 60 + 15 * int(random() % 36));
+        apt.reason = reasons[random() % 10];
+        apt.duration = 15 * (1 + int(random() % 4));
+        apt.consultationFee = apt.duration;
+        apt.medicineFee = (random() % 8001) / 100.0;
+        apt.totalCost = apt.consultationFee + apt.medicineFee;
+        apt.doctorID = 1 + int(random() % 4);
+        apt.doctorName = doctorNames[apt.doctorID - 1];
+        apt.patientID = 1 + int(random() % patientCount);
+        apt.patientName = patientNames[apt.patientID - 1];
+    }
+    
+    Clock::time_point start = Clock::now();
+    AppointmentList list;
+    list.reserve(appointments.size());
+    for (const Appointment& apt : appointments) list.push_back(apt);
+    double buildMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    
+    for (size_t i = 0; i < appointments.size(); i++) {
+        const Appointment& apt = appointments[i];
+        Appointment back = list.at(i);
+        if (back.appointmentID != apt.appointmentID || back.status != apt.status ||
+            back.appointmentDate != apt.appointmentDate || back.appointmentTime != apt.appointmentTime ||
+            back.reason != apt.reason || back.duration != apt.duration || back.patientID != apt.patientID ||
+            back.doctorID != apt.doctorID || back.patientName != apt.patientName ||
+            back.doctorName != apt.doctorName || std::fabs(back.totalCost - apt.totalCost) > 0.001 ||
+            std::fabs(back.medicineFee - apt.medicineFee) > 0.001) {
+            std::cerr << "Row " << i << " (appointment " << apt.appointmentID << ") reads back differently"
+                      << std::endl;
+            return 1;
+        }
+    }
+    
+    size_t objectBytes = appointments.capacity() * sizeof(Appointment);
+    for (const Appointment& apt : appointments) {
+        objectBytes += heapBytes(apt.reason) + heapBytes(apt.patientName) + heapBytes(apt.doctorName);
+    }
+    size_t listBytes = list.memoryBytes();
+    
+    // Checksums are printed so neither pass can be optimized away
+    double objectTotal = 0.0;
+    size_t objectChars = 0;
+    start = Clock::now();
+    for (const Appointment& apt : appointments) {
+        objectTotal += apt.totalCost;
+        objectChars += apt.doctorName.size();
+    }
+    double objectScanMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    long long listCents = 0;
+    size_t listChars = 0;
+    start = Clock::now();
+    for (const AppointmentList::Record& record : list) {
+        listCents += record.totalCents;
+        listChars += list.text(record.doctorName).size();
+    }
+    double listScanMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    
+    const double mb = 1024.0 * 1024.0;
+    std::cout << "Rows: " << rows << ", patients: " << patientCount << ", doctors: 4, distinct texts: "
+              << list.distinctTexts() << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << std::left << std::setw(22) << "Representation" << std::setw(12) << "MB" << std::setw(12)
+              << "Bytes/row" << "Scan ms" << std::endl;
+    std::cout << std::left << std::setw(22) << "Appointment objects" << std::setw(12) << objectBytes / mb
+              << std::setw(12) << double(objectBytes) / rows << objectScanMs << std::endl;
+    std::cout << std::left << std::setw(22) << "AppointmentList" << std::setw(12) << listBytes / mb
+              << std::setw(12) << double(listBytes) / rows << listScanMs << std::endl;
+    std::cout << "Compact list: " << (objectBytes > 0 ? 100.0 * listBytes / objectBytes : 0.0)
+              << "% of the memory, built in " << buildMs << " ms (checksums RM " << std::setprecision(2)
+              << objectTotal << " / RM " << listCents / 100.0 << ", " << objectChars << " / " << listChars
+              << " chars)" << std::endl;
+    std::cout << "(Heap bytes as requested from the allocator; its own bookkeeping is not counted)" << std::endl;
+    return 0;
+}
+
+// --bench-storage [calls]: copy the MySQL data into an InMemoryStorage and
+// time the same read-only calls on both engines (default 200 calls each).
+// The in-memory time is this program's share of a call; the difference is
+// what the database and the round trip add
+int runStorageBenchmark(DatabaseManager& mysqlStorage, InMemoryStorage& memoryStorage, int calls) {
+    typedef std::chrono::steady_clock Clock;
+    if (calls < 1) calls = 1;
+    if (!mysqlStorage.connect()) {
+        std::cerr << "Database connection failed" << std::endl;
+        return 2;
+    }
+    Clock::time_point copyStart = Clock::now();
+    if (!memoryStorage.copyFrom(mysqlStorage) || !memoryStorage.connect()) {
+        mysqlStorage.disconnect();
+        std::cerr << "Could not copy the database" << std::endl;
+        return 2;
+    }
+    double copySeconds = std::chrono::duration<double>(Clock::now() - copyStart).count();
+    StorageEngine::SystemCounts counts = memoryStorage.getSystemCounts();
+    StorageEngine::AppointmentSummary everything = memoryStorage.getAppointmentSummary();
+    std::cout << "Copied " << counts.patients << " patients, " << counts.doctors << " doctors, " << everything.total
+              << " appointments in " << std::fixed << std::setprecision(1) << copySeconds << " s" << std::endl;
+    
+    std::vector<Doctor> doctors = memoryStorage.getAllDoctors();
+    int doctorID = doctors.empty() ? 0 : doctors.front().doctorID;
+    StorageEngine::PatientPage firstPatients = memoryStorage.getPatientsPage(StorageEngine::PatientCursor(), 1);
+    int patientID = firstPatients.patients.empty() ? 0 : firstPatients.patients.front().patientID;
+    Date today = Date::today();
+    Date weekAgo = today.plusDays(-7);
+    StorageEngine::AppointmentCursor newest; // Defaults to before the first page
+    
+    // Each call returns a size both engines must agree on
+    struct Call {
+        const char* label;
+        std::function<size_t(StorageEngine&)> run;
+    };
+    const Call callList[] = {
+        { "getDoctorById", [doctorID](StorageEngine& s) { return size_t(s.getDoctorById(doctorID).doctorID); } },
+        { "getPatientById", [patientID](StorageEngine& s) { return size_t(s.getPatientById(patientID).patientID); } },
+        { "getAllDoctors", [](StorageEngine& s) { return s.getAllDoctors().size(); } },
+        { "searchPatients(\"ah\")", [](StorageEngine& s) { return s.searchPatients("ah").size(); } },
+        { "getPatientAppointments", [patientID](StorageEngine& s) { return s.getPatientAppointments(patientID).size(); } },
+        { "getDoctorAppointments(today)",
+          [doctorID, today](StorageEngine& s) { return s.getDoctorAppointments(doctorID, today).size(); } },
+        { "getAppointmentsByDateRange(7d)",
+          [weekAgo, today](StorageEngine& s) { return s.getAppointmentsByDateRange(weekAgo, today).size(); } },
+        { "getAppointmentsPage(50)",
+          [newest](StorageEngine& s) { return s.getAppointmentsPage(newest, 50).appointments.size(); } },
+        { "checkDoctorAvailability",
+          [doctorID, today](StorageEngine& s) { return size_t(s.checkDoctorAvailability(doctorID, today, TimeOfDay::fromMinutes(10 * 60))); } },
+        { "getAppointmentSummary(30d)", [](StorageEngine& s) { return size_t(s.getAppointmentSummary(30).total); } },
+    };
+    
+    int mismatches = 0;
+    std::cout << std::left << std::setw(32) << "Call" << std::setw(10) << "Result" << std::setw(12) << "MySQL us"
+              << std::setw(12) << "Memory us" << "Database share us" << std::endl;
+    for (const Call& call : callList) {
+        StorageEngine* engines[] = { &mysqlStorage, &memoryStorage };
+        size_t results[2] = { 0, 0 };
+        double us[2] = { 0.0, 0.0 };
+        for (int e = 0; e < 2; e++) {
+            results[e] = call.run(*engines[e]); // Warm-up, fills the caches and indexes
+            Clock::time_point start = Clock::now();
+            for (int c = 0; c < calls; c++) call.run(*engines[e]);
+            us[e] = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / calls;
+        }
+        std::cout << std::left << std::setw(32) << call.label << std::setw(10) << results[0] << std::setw(12) << us[0]
+                  << std::setw(12) << us[1] << us[0] - us[1] << std::endl;
+        if (results[0] != results[1]) {
+            std::cerr << "Mismatch for " << call.label << ": MySQL " << results[0] << ", memory " << results[1]
+                      << std::endl;
+            mismatches++;
+        }
+    }
+    memoryStorage.disconnect();
+    mysqlStorage.disconnect();
+    return mismatches == 0 ? 0 : 1;
+}
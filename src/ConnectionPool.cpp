@@ -0,0 +1,277 @@
+// ============================================================
+// ConnectionPool.cpp - Bounded, Thread-Safe MySQL Connection Pool
+// Hospital Appointment Booking System
+// ============================================================
+
+#include "../include/ConnectionPool.h"
+#include <iostream>
+
+namespace {
+    template <typename Entry>
+    void closeQuietly(Entry& entry) {
+        // Statements must be released before the connection that owns them
+        if (entry.statements) entry.statements->clear();
+        std::unique_ptr<sql::Connection>& connection = entry.connection;
+        if (!connection) return;
+        try {
+            if (!connection->isClosed()) connection->close();
+        }
+        catch (sql::SQLException&) {
+            // Connection already dead - nothing left to release
+        }
+        connection.reset();
+    }
+
+    double elapsedMs(ConnectionPool::Clock::time_point since) {
+        return std::chrono::duration<double, std::milli>(ConnectionPool::Clock::now() - since).count();
+    }
+}
+
+// ============================================================
+// Lease
+// ============================================================
+
+ConnectionPool::Lease& ConnectionPool::Lease::operator=(Lease&& other) noexcept {
+    if (this != &other) {
+        release();
+        pool = other.pool;
+        entry = std::move(other.entry);
+        broken = other.broken;
+        unwinding = other.unwinding;
+        other.pool = nullptr;
+    }
+    return *this;
+}
+
+void ConnectionPool::Lease::release() {
+    if (pool && entry) {
+        pool->giveBack(std::move(entry), broken, std::uncaught_exceptions() > unwinding);
+    }
+    pool = nullptr;
+    entry.reset();
+    broken = false;
+}
+
+// ============================================================
+// Pool
+// ============================================================
+
+ConnectionPool::ConnectionPool(Factory f, const Config& c)
+    : factory(std::move(f)), config(c), total(0), closed(false) {
+    if (config.maxSize == 0) config.maxSize = 1;
+    if (config.minSize > config.maxSize) config.minSize = config.maxSize;
+}
+
+ConnectionPool::~ConnectionPool() {
+    shutdown();
+}
+
+std::unique_ptr<ConnectionPool::PooledConnection> ConnectionPool::openConnection() {
+    std::unique_ptr<PooledConnection> entry(new PooledConnection());
+    entry->connection.reset(factory());
+    if (!entry->connection) {
+        throw sql::SQLException("Connection factory returned no connection");
+    }
+    entry->statements.reset(new StatementCache(config.statementCacheSize, &statementCounters));
+    entry->lastUsed = Clock::now();
+    return entry;
+}
+
+bool ConnectionPool::isHealthy(PooledConnection& entry) {
+    // Recently used connections are trusted; only ping ones that sat idle
+    // or whose last lease failed
+    if (!entry.suspect && Clock::now() - entry.lastUsed < config.validateAfter) {
+        return true;
+    }
+    try {
+        bool healthy = !entry.connection->isClosed() && entry.connection->isValid();
+        if (healthy) entry.suspect = false;
+        return healthy;
+    }
+    catch (sql::SQLException&) {
+        return false;
+    }
+}
+
+void ConnectionPool::evictIdleLocked(Clock::time_point now) {
+    // idle is used LIFO, so the front holds the connections that waited longest
+    std::vector<std::unique_ptr<PooledConnection>> doomed;
+    while (!idle.empty() && total > config.minSize &&
+           now - idle.front()->lastUsed > config.idleTimeout) {
+        doomed.push_back(std::move(idle.front()));
+        idle.erase(idle.begin());
+        total--;
+        stats.evicted++;
+    }
+    for (auto& entry : doomed) {
+        closeQuietly(*entry);
+    }
+}
+
+ConnectionPool::Lease ConnectionPool::acquire() {
+    const Clock::time_point start = Clock::now();
+    const Clock::time_point deadline = start + config.acquireTimeout;
+    bool waited = false;
+
+    std::unique_lock<std::mutex> lock(mtx);
+    while (true) {
+        if (closed) {
+            throw sql::SQLException("Connection pool is shut down");
+        }
+
+        std::unique_ptr<PooledConnection> entry;
+        bool fresh = false;
+
+        if (!idle.empty()) {
+            entry = std::move(idle.back());
+            idle.pop_back();
+        }
+        else if (total < config.maxSize) {
+            total++;
+            fresh = true;
+        }
+        else {
+            if (!waited) stats.saturations++;
+            waited = true;
+            if (available.wait_until(lock, deadline) == std::cv_status::timeout &&
+                idle.empty() && total >= config.maxSize) {
+                stats.timeouts++;
+                throw sql::SQLException("Timed out waiting for a database connection");
+            }
+            continue;
+        }
+
+        // Network work (ping / connect) happens without holding the lock
+        lock.unlock();
+        if (fresh) {
+            try {
+                entry = openConnection();
+            }
+            catch (...) {
+                lock.lock();
+                total--;
+                available.notify_one();
+                throw;
+            }
+        }
+        else if (!isHealthy(*entry)) {
+            closeQuietly(*entry);
+            lock.lock();
+            total--;
+            stats.failedHealthChecks++;
+            continue;
+        }
+        lock.lock();
+
+        if (fresh) stats.created++;
+        stats.acquisitions++;
+        if (waited) {
+            double waitMs = elapsedMs(start);
+            stats.waits++;
+            stats.totalWaitMs += waitMs;
+            if (waitMs > stats.maxWaitMs) stats.maxWaitMs = waitMs;
+        }
+        size_t inUse = total - idle.size();
+        if (inUse > stats.peakInUse) stats.peakInUse = inUse;
+        return Lease(this, std::move(entry));
+    }
+}
+
+void ConnectionPool::giveBack(std::unique_ptr<PooledConnection> entry, bool broken, bool suspect) {
+    std::unique_lock<std::mutex> lock(mtx);
+    if (closed || broken) {
+        total--;
+        lock.unlock();
+        closeQuietly(*entry);
+        available.notify_one();
+        return;
+    }
+    Clock::time_point now = Clock::now();
+    entry->lastUsed = now;
+    entry->suspect = suspect;
+    idle.push_back(std::move(entry));
+    evictIdleLocked(now);
+    lock.unlock();
+    available.notify_one();
+}
+
+bool ConnectionPool::healthCheck() {
+    std::vector<std::unique_ptr<PooledConnection>> checking;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (closed) return false;
+        checking.swap(idle);
+    }
+
+    std::vector<std::unique_ptr<PooledConnection>> healthy;
+    size_t dropped = 0;
+    for (auto& entry : checking) {
+        bool alive = false;
+        try {
+            alive = !entry->connection->isClosed() && entry->connection->isValid();
+        }
+        catch (sql::SQLException&) {
+            alive = false;
+        }
+        if (alive) {
+            entry->suspect = false;
+            healthy.push_back(std::move(entry));
+        } else {
+            closeQuietly(*entry);
+            dropped++;
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(mtx);
+    total -= dropped;
+    stats.failedHealthChecks += dropped;
+    for (auto& entry : healthy) {
+        idle.push_back(std::move(entry));
+    }
+
+    // Refill to the configured minimum
+    while (!closed && total < config.minSize) {
+        total++;
+        lock.unlock();
+        std::unique_ptr<PooledConnection> entry;
+        try {
+            entry = openConnection();
+        }
+        catch (sql::SQLException& e) {
+            std::cerr << "[ERROR] Connection pool refill failed: " << e.what() << std::endl;
+            lock.lock();
+            total--;
+            return false;
+        }
+        lock.lock();
+        stats.created++;
+        idle.push_back(std::move(entry));
+    }
+    available.notify_all();
+    return total > 0;
+}
+
+void ConnectionPool::shutdown() {
+    std::vector<std::unique_ptr<PooledConnection>> closing;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        closed = true;
+        closing.swap(idle);
+        total -= closing.size();
+    }
+    available.notify_all();
+    for (auto& entry : closing) {
+        closeQuietly(*entry);
+    }
+}
+
+ConnectionPool::Stats ConnectionPool::getStats() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    Stats snapshot = stats;
+    snapshot.idle = idle.size();
+    snapshot.inUse = total - idle.size();
+    snapshot.statementHits = statementCounters.hits;
+    snapshot.statementMisses = statementCounters.misses;
+    snapshot.statementEvictions = statementCounters.evictions;
+    return snapshot;
+}
@@ -4,176 +4,476 @@
 // ============================================================
 
 #include "../include/DatabaseManager.h"
+#include "../include/MedicineFeeMatcher.h"
 #include <iostream>
 #include <algorithm>
 #include <cctype>
+#include <chrono>
+#include <functional>
+#include <map>
 
-DatabaseManager::DatabaseManager() : driver(nullptr), isConnected(false) {}
+namespace {
+    // SELECT list + joins every Appointment query shares; RowMapper<Appointment>
+    // reads the columns back by position
+    std::string appointmentQuery(const std::string& clauses) {
+        return std::string("SELECT ") + RowMapper<Appointment>::columns + " FROM Appointment a "
+               "JOIN Patient p ON a.PatientID = p.PatientID "
+               "JOIN Doctors d ON a.DoctorID = d.DoctorID " + clauses;
+    }
+
+    template <typename Model>
+    std::string selectColumns(const std::string& clauses) {
+        return std::string("SELECT ") + RowMapper<Model>::columns + " " + clauses;
+    }
+
+    template <typename Model>
+    std::vector<Model> readAll(sql::ResultSet& res) {
+        std::vector<Model> rows;
+        while (res.next()) {
+            rows.push_back(RowMapper<Model>::read(res));
+        }
+        return rows;
+    }
+
+    // Hot-path query texts, shared with explainHotQueries() so the index
+    // check always EXPLAINs exactly what the application sends.
+    // Status is compared by ENUM position (AppointmentStatus::column()):
+    // 1 Pending, 2 Confirmed, 3 Completed, 4 Cancelled
+    // Dates are bound as TO_DAYS() and times as seconds, like the cursor
+    // in bindCursor, so no date or time text is sent
+    // Active appointments overlapping [time, time + duration minutes)
+    const char* const SQL_DOCTOR_SLOT_COUNT =
+        "SELECT COUNT(*) as cnt FROM Appointment WHERE DoctorID = ? AND AppointmentDate = FROM_DAYS(?) "
+        "AND AppointmentTime < SEC_TO_TIME(? + ? * 60) "
+        "AND ADDTIME(AppointmentTime, SEC_TO_TIME(Duration * 60)) > SEC_TO_TIME(?) "
+        "AND Status IN (1, 2)";
+
+    const char* const SQL_PATIENT_DAY_COUNT =
+        "SELECT COUNT(*) as cnt FROM Appointment WHERE PatientID = ? AND DoctorID = ? "
+        "AND AppointmentDate = FROM_DAYS(?) AND Status <> 4";
+
+    const std::string SQL_TODAY_APPOINTMENTS = appointmentQuery(
+        "WHERE a.AppointmentDate = CURDATE() "
+        "ORDER BY a.AppointmentTime");
+
+    const std::string SQL_ALL_APPOINTMENTS = appointmentQuery(
+        "ORDER BY a.AppointmentDate DESC, a.AppointmentTime");
+
+    const std::string SQL_APPOINTMENTS_BY_DATE_RANGE = appointmentQuery(
+        "WHERE a.AppointmentDate BETWEEN FROM_DAYS(?) AND FROM_DAYS(?) "
+        "ORDER BY a.AppointmentDate DESC, a.AppointmentTime");
+
+    // Exports walk idx_appt_date_time (whose entries end in the primary
+    // key), so the order costs no sort
+    const std::string SQL_APPOINTMENT_EXPORT = appointmentQuery(
+        "WHERE a.AppointmentDate BETWEEN FROM_DAYS(?) AND FROM_DAYS(?) "
+        "ORDER BY a.AppointmentDate, a.AppointmentTime, a.AppointmentID");
+
+    const std::string SQL_RECENT_ACTIVITY = selectColumns<ActivityLog>(
+        "FROM ActivityLog ORDER BY LogTime DESC LIMIT ?");
+
+    // Keyset pages: strictly after the cursor, newest first. The leading
+    // "<=" gives the optimizer a range on the date index; the OR chain
+    // breaks ties on time and then ID. The cursor is bound as TO_DAYS() and
+    // seconds (see bindCursor).
+    const std::string SQL_APPOINTMENTS_PAGE = appointmentQuery(
+        "WHERE a.AppointmentDate <= FROM_DAYS(?) AND (a.AppointmentDate < FROM_DAYS(?) "
+        "OR a.AppointmentTime < SEC_TO_TIME(?) OR (a.AppointmentTime = SEC_TO_TIME(?) AND a.AppointmentID < ?)) "
+        "ORDER BY a.AppointmentDate DESC, a.AppointmentTime DESC, a.AppointmentID DESC LIMIT ?");
+
+    const std::string SQL_DOCTOR_APPOINTMENTS_PAGE = appointmentQuery(
+        "WHERE a.DoctorID = ? AND a.AppointmentDate <= FROM_DAYS(?) AND (a.AppointmentDate < FROM_DAYS(?) "
+        "OR a.AppointmentTime < SEC_TO_TIME(?) OR (a.AppointmentTime = SEC_TO_TIME(?) AND a.AppointmentID < ?)) "
+        "ORDER BY a.AppointmentDate DESC, a.AppointmentTime DESC, a.AppointmentID DESC LIMIT ?");
+
+    const std::string SQL_PATIENTS_PAGE = selectColumns<Patient>(
+        "FROM Patient WHERE PatientName >= ? AND (PatientName > ? OR PatientID > ?) "
+        "ORDER BY PatientName, PatientID LIMIT ?");
+
+    // searchPatients reads index hits back by primary key, a fixed number of
+    // IDs per round trip so one cached statement serves every search; spare
+    // placeholders are bound to 0, which no PatientID takes
+    const size_t PATIENT_FETCH_BATCH = 100;
+
+    std::string patientsByIdQuery() {
+        std::string placeholders = "?";
+        for (size_t i = 1; i < PATIENT_FETCH_BATCH; i++) placeholders += ", ?";
+        return selectColumns<Patient>("FROM Patient WHERE PatientID IN (" + placeholders + ")");
+    }
+
+    const std::string SQL_PATIENTS_BY_ID = patientsByIdQuery();
+
+    // Rows for ids in whatever order MySQL returns them; missing IDs are skipped
+    std::vector<Patient> readPatientsById(ConnectionPool::Lease& conn, const std::vector<int>& ids) {
+        std::vector<Patient> patients;
+        sql::PreparedStatement* pstmt = conn.prepare(SQL_PATIENTS_BY_ID);
+        for (size_t first = 0; first < ids.size(); first += PATIENT_FETCH_BATCH) {
+            for (size_t i = 0; i < PATIENT_FETCH_BATCH; i++) {
+                pstmt->setInt(static_cast<int>(i + 1), first + i < ids.size() ? ids[first + i] : 0);
+            }
+            std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+            while (res->next()) {
+                patients.push_back(RowMapper<Patient>::read(*res));
+            }
+        }
+        return patients;
+    }
+
+    // Hit counts above this are cheaper to stream with a single LIKE scan
+    // than to read back a batch at a time
+    const size_t PATIENT_FETCH_LIMIT = 2000;
+
+    const int ER_DUP_ENTRY = 1062;
+    const int ER_DATA_TOO_LONG = 1406;
+    const int ER_NO_REFERENCED_ROW_2 = 1452;
+    const int ER_SIGNAL_EXCEPTION = 1644;
+
+    // Rows per multi-row INSERT in importAppointments
+    const size_t IMPORT_STATEMENT_ROWS = 256;
+
+    int compareIgnoringCase(const std::string& a, const std::string& b) {
+        size_t common = (std::min)(a.size(), b.size());
+        for (size_t i = 0; i < common; i++) {
+            int x = std::tolower(static_cast<unsigned char>(a[i]));
+            int y = std::tolower(static_cast<unsigned char>(b[i]));
+            if (x != y) return x < y ? -1 : 1;
+        }
+        return a.size() == b.size() ? 0 : (a.size() < b.size() ? -1 : 1);
+    }
+
+    // A CALL returns a trailing status result; it has to be consumed before
+    // the (cached) statement can run again
+    void drainResults(sql::PreparedStatement* pstmt) {
+        while (pstmt->getMoreResults()) {
+            std::unique_ptr<sql::ResultSet> extra(pstmt->getResultSet());
+        }
+    }
+
+    // Run an insert procedure (sp_RegisterPatient, sp_BookAppointment, ...)
+    // and read the generated key it selects back in the same round trip
+    std::optional<int> callReturningId(sql::PreparedStatement* pstmt) {
+        std::optional<int> id;
+        {
+            std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+            if (res->next() && res->getInt(1) > 0) {
+                id = res->getInt(1);
+            }
+        }
+        drainResults(pstmt);
+        return id;
+    }
+}
+
+DatabaseManager::DatabaseManager()
+    : driver(nullptr), isConnected(false),
+      doctorCache([this]() { return loadDoctors(); }, DoctorCache::Config{doctorCacheTtl}),
+      patientIndex([this]() { return loadPatientSearchEntries(); }, PatientSearchIndex::Config()),
+      slotIndex([this]() { return loadActiveBookings(); }, DoctorSlotIndex::Config()) {}
 
 DatabaseManager::~DatabaseManager() {
     disconnect();
 }
 
 bool DatabaseManager::connect() {
+    disconnect(); // Flush and release anything left from a previous connection
     try {
         driver = sql::mysql::get_mysql_driver_instance();
-        connection.reset(driver->connect(host, user, password));
-        connection->setSchema(database);
+        
+        ConnectionPool::Config config;
+        config.minSize = poolMinSize;
+        config.maxSize = poolMaxSize;
+        pool.reset(new ConnectionPool([this]() {
+            std::unique_ptr<sql::Connection> connection(driver->connect(host, user, password));
+            connection->setSchema(database);
+            return connection.release();
+        }, config));
+        
+        // Open the minimum number of connections up front so a bad
+        // configuration is reported here rather than on first use
+        if (!pool->healthCheck()) {
+            pool.reset();
+            isConnected = false;
+            return false;
+        }
+        
+        if (!passwordVerifier) {
+            passwordVerifier.reset(new PasswordVerifier(passwordConfig));
+        }
+        
+        sql::Driver* threadDriver = driver;
+        logWriter.reset(new ActivityLogWriter(
+            [this](const std::vector<ActivityLogWriter::Entry>& batch) { writeActivityBatch(batch); },
+            ActivityLogWriter::Config(),
+            [threadDriver]() { threadDriver->threadInit(); },
+            [threadDriver]() { threadDriver->threadEnd(); }));
         isConnected = true;
+        doctorCache.invalidate(); // May be a different database than last time
+        patientIndex.invalidate();
+        slotIndex.invalidate();
         return true;
     }
     catch (sql::SQLException& e) {
         std::cerr << "[ERROR] Database connection failed: " << e.what() << std::endl;
+        pool.reset();
         isConnected = false;
         return false;
     }
 }
 
 void DatabaseManager::disconnect() {
-    if (connection) {
-        connection->close();
-        connection.reset();
+    // Stop the log writer first so queued entries are written while the pool is still open
+    if (logWriter) {
+        logWriter->stop();
+        logWriter.reset();
+    }
+    if (pool) {
+        pool->shutdown();
+        pool.reset();
+    }
+    if (passwordVerifier) {
+        passwordVerifier->stop();
+        passwordVerifier.reset();
     }
     isConnected = false;
 }
 
 bool DatabaseManager::checkConnection() {
-    if (!isConnected || !connection || connection->isClosed()) {
+    if (!isConnected || !pool) {
         return connect();
     }
-    return true;
+    // Dead connections are closed together with their statement caches,
+    // so a reconnected slot always starts with an empty cache
+    return pool->healthCheck();
 }
 
-int DatabaseManager::getLastInsertId() {
-    try {
-        std::unique_ptr<sql::Statement> stmt(connection->createStatement());
-        std::unique_ptr<sql::ResultSet> res(stmt->executeQuery("SELECT LAST_INSERT_ID()"));
-        if (res->next()) {
-            return res->getInt(1);
-        }
-    }
-    catch (sql::SQLException& e) {
-        std::cerr << "[ERROR] " << e.what() << std::endl;
+ConnectionPool::Lease DatabaseManager::acquireConnection() {
+    if (!pool) {
+        throw sql::SQLException("Not connected to database");
     }
-    return 0;
+    return pool->acquire();
+}
+
+ConnectionPool::Stats DatabaseManager::getPoolStats() const {
+    return pool ? pool->getStats() : ConnectionPool::Stats();
 }
 
 // ============================================================
 // Authentication Methods
 // ============================================================
 
-int DatabaseManager::loginPatient(const std::string& email, const std::string& pwd) {
-    try {
-        std::unique_ptr<sql::PreparedStatement> pstmt(
-            connection->prepareStatement("SELECT PatientID FROM Patient WHERE Email = ? AND Password = ?"));
-        pstmt->setString(1, email);
-        pstmt->setString(2, pwd);
-        std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
-        if (res->next()) {
-            return res->getInt("PatientID");
+namespace {
+    // Number of entries in a RowMapper column list
+    int columnCount(const char* columns) {
+        int count = 1;
+        for (const char* c = columns; *c; c++) {
+            if (*c == ',') count++;
         }
+        return count;
     }
-    catch (sql::SQLException& e) {
-        std::cerr << "[ERROR] " << e.what() << std::endl;
-    }
-    return -1;
+    
+    const char* const PASSWORD_TABLES[][2] = {
+        { "Patient", "PatientID" }, { "Doctors", "DoctorID" }, { "Staff", "StaffID" }, { "Admin", "AdminID" }
+    };
 }
 
-int DatabaseManager::loginDoctor(const std::string& email, const std::string& pwd) {
+template <typename Model>
+DatabaseManager::PendingLogin<Model> DatabaseManager::beginLogin(const char* table, const char* idColumn,
+                                                              const std::string& email,
+                                                              const std::string& pwd) {
+    PendingLogin<Model> pending;
     try {
-        std::unique_ptr<sql::PreparedStatement> pstmt(
-            connection->prepareStatement("SELECT DoctorID FROM Doctors WHERE Email = ? AND Password = ?"));
+        if (!passwordVerifier) {
+            throw sql::SQLException("Not connected to database");
+        }
+        // Profile and stored hash in one round trip; the KDF runs off this thread
+        ConnectionPool::Lease conn = acquireConnection();
+        sql::PreparedStatement* pstmt = conn.prepare(std::string("SELECT ") + RowMapper<Model>::columns +
+                                                     ", Password FROM " + table + " WHERE Email = ?");
         pstmt->setString(1, email);
-        pstmt->setString(2, pwd);
         std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
-        if (res->next()) {
-            return res->getInt("DoctorID");
+        if (!res->next()) {
+            return pending;
         }
+        std::string stored = res->getString(columnCount(RowMapper<Model>::columns) + 1);
+        pending = pendingLogin(table, idColumn, res->getInt(1), RowMapper<Model>::read(*res), pwd, stored,
+                               passwordVerifier->verify(pwd, stored));
     }
     catch (sql::SQLException& e) {
         std::cerr << "[ERROR] " << e.what() << std::endl;
     }
-    return -1;
+    return pending;
 }
 
-int DatabaseManager::loginStaff(const std::string& email, const std::string& pwd) {
+bool DatabaseManager::finishLogin(const char* table, const char* idColumn, int id, const std::string& pwd,
+                                  const std::string& stored, std::future<bool>& verdict) {
     try {
-        std::unique_ptr<sql::PreparedStatement> pstmt(
-            connection->prepareStatement("SELECT StaffID FROM Staff WHERE Email = ? AND Password = ?"));
-        pstmt->setString(1, email);
-        pstmt->setString(2, pwd);
-        std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
-        if (res->next()) {
-            return res->getInt("StaffID");
+        if (!verdict.valid() || !verdict.get()) {
+            return false;
         }
     }
-    catch (sql::SQLException& e) {
-        std::cerr << "[ERROR] " << e.what() << std::endl;
+    catch (std::exception& e) {
+        std::cerr << "[ERROR] Password check failed: " << e.what() << std::endl;
+        return false;
     }
-    return -1;
+    
+    // Transparent migration: plaintext rows, and hashes made at an older
+    // cost, are rehashed with the current cost on their first good login.
+    // The compare on the old value skips rows changed in the meantime.
+    if (PasswordHasher::needsRehash(stored, passwordCost)) {
+        try {
+            std::string upgraded = hashPassword(pwd);
+            ConnectionPool::Lease conn = acquireConnection();
+            sql::PreparedStatement* pstmt = conn.prepare(std::string("UPDATE ") + table +
+                                                         " SET Password = ? WHERE " + idColumn + " = ? AND Password = ?");
+            pstmt->setString(1, upgraded);
+            pstmt->setInt(2, id);
+            pstmt->setString(3, stored);
+            pstmt->executeUpdate();
+        }
+        catch (std::exception& e) {
+            // The login itself stands; the upgrade is retried next time.
+            // Covers the KDF failing (e.g. bad_alloc) as well as SQL errors
+            std::cerr << "[ERROR] " << e.what() << std::endl;
+        }
+    }
+    return true;
+}
+
+std::string DatabaseManager::hashPassword(const std::string& pwd) {
+    if (!passwordVerifier) {
+        throw sql::SQLException("Not connected to database");
+    }
+    return passwordVerifier->hash(pwd, passwordCost).get();
+}
+
+DatabaseManager::PendingLogin<Patient> DatabaseManager::beginLoginPatient(const std::string& email, const std::string& pwd) {
+    return beginLogin<Patient>("Patient", "PatientID", email, pwd);
+}
+
+DatabaseManager::PendingLogin<Doctor> DatabaseManager::beginLoginDoctor(const std::string& email, const std::string& pwd) {
+    return beginLogin<Doctor>("Doctors", "DoctorID", email, pwd);
+}
+
+DatabaseManager::PendingLogin<Staff> DatabaseManager::beginLoginStaff(const std::string& email, const std::string& pwd) {
+    return beginLogin<Staff>("Staff", "StaffID", email, pwd);
+}
+
+DatabaseManager::PendingLogin<Admin> DatabaseManager::beginLoginAdmin(const std::string& email, const std::string& pwd) {
+    return beginLogin<Admin>("Admin", "AdminID", email, pwd);
+}
+
+std::optional<Patient> DatabaseManager::loginPatient(const std::string& email, const std::string& pwd) {
+    return beginLoginPatient(email, pwd).get();
+}
+
+std::optional<Doctor> DatabaseManager::loginDoctor(const std::string& email, const std::string& pwd) {
+    return beginLoginDoctor(email, pwd).get();
+}
+
+std::optional<Staff> DatabaseManager::loginStaff(const std::string& email, const std::string& pwd) {
+    return beginLoginStaff(email, pwd).get();
+}
+
+std::optional<Admin> DatabaseManager::loginAdmin(const std::string& email, const std::string& pwd) {
+    return beginLoginAdmin(email, pwd).get();
 }
 
-int DatabaseManager::loginAdmin(const std::string& email, const std::string& pwd) {
+int DatabaseManager::migratePlaintextPasswords() {
+    int migrated = 0;
     try {
-        std::unique_ptr<sql::PreparedStatement> pstmt(
-            connection->prepareStatement("SELECT AdminID FROM Admin WHERE Email = ? AND Password = ?"));
-        pstmt->setString(1, email);
-        pstmt->setString(2, pwd);
-        std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
-        if (res->next()) {
-            return res->getInt("AdminID");
+        if (!passwordVerifier) {
+            throw sql::SQLException("Not connected to database");
+        }
+        ConnectionPool::Lease conn = acquireConnection();
+        for (const auto& target : PASSWORD_TABLES) {
+            const std::string table = target[0];
+            const std::string idColumn = target[1];
+            
+            std::vector<std::pair<int, std::string>> rows;
+            sql::PreparedStatement* select = conn.prepare(
+                "SELECT " + idColumn + ", Password FROM " + table + " WHERE Password NOT LIKE '$scrypt$%'");
+            std::unique_ptr<sql::ResultSet> res(select->executeQuery());
+            while (res->next()) {
+                rows.push_back(std::make_pair(res->getInt(1), std::string(res->getString(2))));
+            }
+            
+            // Queue every row at once; the worker count bounds CPU and memory
+            std::vector<std::future<std::string>> hashes;
+            for (const auto& row : rows) {
+                hashes.push_back(passwordVerifier->hash(row.second, passwordCost));
+            }
+            
+            sql::PreparedStatement* update = conn.prepare(
+                "UPDATE " + table + " SET Password = ? WHERE " + idColumn + " = ? AND Password = ?");
+            for (size_t i = 0; i < rows.size(); i++) {
+                update->setString(1, hashes[i].get());
+                update->setInt(2, rows[i].first);
+                update->setString(3, rows[i].second);
+                migrated += update->executeUpdate();
+            }
         }
     }
     catch (sql::SQLException& e) {
         std::cerr << "[ERROR] " << e.what() << std::endl;
+        return -1;
     }
-    return -1;
+    return migrated;
+}
+
+PasswordVerifier::Stats DatabaseManager::getPasswordStats() const {
+    return passwordVerifier ? passwordVerifier->getStats() : PasswordVerifier::Stats();
 }
 
 // ============================================================
 // Patient Operations
 // ============================================================
 
-bool DatabaseManager::registerPatient(const std::string& name, const std::string& phone,
-                                      const std::string& email, const std::string& address,
-                                      const std::string& dob, const std::string& gender,
-                                      const std::string& pwd) {
+std::optional<int> DatabaseManager::registerPatient(const std::string& name, const std::string& phone,
+                                                    const std::string& email, const std::string& address,
+                                                    const std::string& dob, const std::string& gender,
+                                                    const std::string& pwd) {
     try {
-        std::unique_ptr<sql::PreparedStatement> pstmt(
-            connection->prepareStatement(
-                "INSERT INTO Patient (PatientName, PhoneNumber, Email, Address, DOB, Gender, Password) "
-                "VALUES (?, ?, ?, ?, ?, ?, ?)"));
+        std::string hashed = hashPassword(pwd); // Before taking a connection: the KDF is slow
+        ConnectionPool::Lease conn = acquireConnection();
+        sql::PreparedStatement* pstmt = conn.prepare("CALL sp_RegisterPatient(?, ?, ?, ?, ?, ?, ?)");
         pstmt->setString(1, name);
         pstmt->setString(2, phone);
         pstmt->setString(3, email);
         pstmt->setString(4, address);
         pstmt->setString(5, dob);
         pstmt->setString(6, gender);
-        pstmt->setString(7, pwd);
-        pstmt->executeUpdate();
-        return true;
+        pstmt->setString(7, hashed);
+        std::optional<int> patientID = callReturningId(pstmt);
+        if (patientID) {
+            PatientSearchIndex::Entry entry;
+            entry.patientID = *patientID;
+            entry.name = name;
+            entry.email = email;
+            entry.phone = phone;
+            patientIndex.upsert(entry);
+        }
+        return patientID;
     }
     catch (sql::SQLException& e) {
         std::cerr << "[ERROR] " << e.what() << std::endl;
-        return false;
+        return std::nullopt;
+    }
+    catch (std::exception& e) {
+        // hashPassword rethrows whatever the KDF worker threw
+        std::cerr << "[ERROR] Password hashing failed: " << e.what() << std::endl;
+        return std::nullopt;
     }
 }
 
 Patient DatabaseManager::getPatientById(int patientID) {
     Patient patient;
     try {
-        std::unique_ptr<sql::PreparedStatement> pstmt(
-            connection->prepareStatement("SELECT * FROM Patient WHERE PatientID = ?"));
+        ConnectionPool::Lease conn = acquireConnection();
+        sql::PreparedStatement* pstmt = conn.prepare(selectColumns<Patient>("FROM Patient WHERE PatientID = ?"));
         pstmt->setInt(1, patientID);
         std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
         if (res->next()) {
-            patient.patientID = res->getInt("PatientID");
-            patient.patientName = res->getString("PatientName");
-            patient.phoneNumber = res->getString("PhoneNumber");
-            patient.email = res->getString("Email");
-            patient.address = res->getString("Address");
-            patient.dateOfBirth = res->getString("DOB");
-            patient.gender = res->getString("Gender");
+            patient = RowMapper<Patient>::read(*res);
         }
     }
     catch (sql::SQLException& e) {
@@ -185,15 +485,24 @@ Patient DatabaseManager::getPatientById(int patientID) {
 bool DatabaseManager::updatePatient(int patientID, const std::string& name, const std::string& phone,
                                    const std::string& email, const std::string& address) {
     try {
-        std::unique_ptr<sql::PreparedStatement> pstmt(
-            connection->prepareStatement(
-                "UPDATE Patient SET PatientName = ?, PhoneNumber = ?, Email = ?, Address = ? WHERE PatientID = ?"));
+        ConnectionPool::Lease conn = acquireConnection();
+        sql::PreparedStatement* pstmt = conn.prepare(
+            "UPDATE Patient SET PatientName = ?, PhoneNumber = ?, Email = ?, Address = ? WHERE PatientID = ?");
         pstmt->setString(1, name);
         pstmt->setString(2, phone);
         pstmt->setString(3, email);
         pstmt->setString(4, address);
         pstmt->setInt(5, patientID);
-        pstmt->executeUpdate();
+        // No row changed: either no such patient (which must not enter the
+        // index) or the same values, which the index already holds
+        if (pstmt->executeUpdate() > 0) {
+            PatientSearchIndex::Entry entry;
+            entry.patientID = patientID;
+            entry.name = name;
+            entry.email = email;
+            entry.phone = phone;
+            patientIndex.upsert(entry);
+        }
         return true;
     }
     catch (sql::SQLException& e) {
@@ -204,17 +513,18 @@ bool DatabaseManager::updatePatient(int patientID, const std::string& name, cons
 
 bool DatabaseManager::deletePatient(int patientID) {
     try {
+        ConnectionPool::Lease conn = acquireConnection();
         // Delete appointments first
-        std::unique_ptr<sql::PreparedStatement> pstmt1(
-            connection->prepareStatement("DELETE FROM Appointment WHERE PatientID = ?"));
+        sql::PreparedStatement* pstmt1 = conn.prepare("DELETE FROM Appointment WHERE PatientID = ?");
         pstmt1->setInt(1, patientID);
         pstmt1->executeUpdate();
         
         // Delete patient
-        std::unique_ptr<sql::PreparedStatement> pstmt2(
-            connection->prepareStatement("DELETE FROM Patient WHERE PatientID = ?"));
+        sql::PreparedStatement* pstmt2 = conn.prepare("DELETE FROM Patient WHERE PatientID = ?");
         pstmt2->setInt(1, patientID);
         pstmt2->executeUpdate();
+        patientIndex.remove(patientID);
+        slotIndex.invalidate(); // Its appointments went with it
         return true;
     }
     catch (sql::SQLException& e) {
@@ -223,33 +533,83 @@ bool DatabaseManager::deletePatient(int patientID) {
     }
 }
 
+std::vector<PatientSearchIndex::Entry> DatabaseManager::loadPatientSearchEntries() {
+    ConnectionPool::Lease conn = acquireConnection();
+    sql::PreparedStatement* pstmt = conn.prepare("SELECT PatientID, PatientName, Email, PhoneNumber FROM Patient");
+    std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+    std::vector<PatientSearchIndex::Entry> entries;
+    while (res->next()) {
+        PatientSearchIndex::Entry entry;
+        entry.patientID = res->getInt(1);
+        entry.name = res->getString(2);
+        entry.email = res->getString(3);
+        entry.phone = res->getString(4);
+        entries.push_back(entry);
+    }
+    return entries;
+}
+
 std::vector<Patient> DatabaseManager::searchPatients(const std::string& search) {
     std::vector<Patient> patients;
     try {
-        std::string query = "SELECT * FROM Patient";
+        std::vector<int> ids;
         if (!search.empty()) {
-            query += " WHERE PatientName LIKE ? OR Email LIKE ? OR PhoneNumber LIKE ?";
+            ids = patientIndex.search(search);
+            if (ids.empty()) return patients;
         }
-        query += " ORDER BY PatientName";
         
-        std::unique_ptr<sql::PreparedStatement> pstmt(connection->prepareStatement(query));
-        if (!search.empty()) {
-            std::string searchPattern = "%" + search + "%";
-            pstmt->setString(1, searchPattern);
-            pstmt->setString(2, searchPattern);
-            pstmt->setString(3, searchPattern);
+        ConnectionPool::Lease conn = acquireConnection();
+        if (search.empty() || ids.size() > PATIENT_FETCH_LIMIT) {
+            std::string query = selectColumns<Patient>("FROM Patient");
+            if (!search.empty()) {
+                query += " WHERE PatientName LIKE ? OR Email LIKE ? OR PhoneNumber LIKE ?";
+            }
+            query += " ORDER BY PatientName";
+            
+            sql::PreparedStatement* pstmt = conn.prepare(query);
+            if (!search.empty()) {
+                std::string searchPattern = "%" + search + "%";
+                pstmt->setString(1, searchPattern);
+                pstmt->setString(2, searchPattern);
+                pstmt->setString(3, searchPattern);
+            }
+            std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+            return readAll<Patient>(*res);
         }
-        std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
-        while (res->next()) {
-            Patient p;
-            p.patientID = res->getInt("PatientID");
-            p.patientName = res->getString("PatientName");
-            p.phoneNumber = res->getString("PhoneNumber");
-            p.email = res->getString("Email");
-            p.address = res->getString("Address");
-            p.dateOfBirth = res->getString("DOB");
-            p.gender = res->getString("Gender");
-            patients.push_back(p);
+        
+        for (const Patient& patient : readPatientsById(conn, ids)) {
+            // Another process may have changed the row since it was indexed
+            if (PatientSearchIndex::matches(search, patient.patientName, patient.email, patient.phoneNumber)) {
+                patients.push_back(patient);
+            }
+        }
+        // Same order as ORDER BY PatientName under the case-insensitive collation
+        std::sort(patients.begin(), patients.end(), [](const Patient& a, const Patient& b) {
+            int order = compareIgnoringCase(a.patientName, b.patientName);
+            return order != 0 ? order < 0 : a.patientID < b.patientID;
+        });
+    }
+    catch (sql::SQLException& e) {
+        std::cerr << "[ERROR] " << e.what() << std::endl;
+    }
+    return patients;
+}
+
+std::vector<Patient> DatabaseManager::suggestPatients(const std::string& prefix, size_t limit) {
+    std::vector<Patient> patients;
+    try {
+        std::vector<int> ids = patientIndex.complete(prefix, (std::min)(limit, PATIENT_FETCH_BATCH));
+        if (ids.empty()) return patients;
+        
+        ConnectionPool::Lease conn = acquireConnection();
+        std::vector<Patient> rows = readPatientsById(conn, ids);
+        for (int id : ids) {
+            for (const Patient& row : rows) {
+                if (row.patientID == id) {
+                    patients.push_back(row);
+                    break;
+                }
+            }
         }
     }
     catch (sql::SQLException& e) {
@@ -258,25 +618,60 @@ std::vector<Patient> DatabaseManager::searchPatients(const std::string& search)
     return patients;
 }
 
+PatientSearchIndex::Stats DatabaseManager::getPatientSearchStats() const {
+    return patientIndex.getStats();
+}
+
+DatabaseManager::PatientPage DatabaseManager::getPatientsPage(const PatientCursor& after, int pageSize) {
+    PatientPage page;
+    try {
+        ConnectionPool::Lease conn = acquireConnection();
+        sql::PreparedStatement* pstmt = conn.prepare(SQL_PATIENTS_PAGE);
+        pstmt->setString(1, after.patientName);
+        pstmt->setString(2, after.patientName);
+        pstmt->setInt(3, after.patientID);
+        pstmt->setInt(4, pageSize + 1); // One extra row tells whether another page exists
+        std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+        page.patients = readAll<Patient>(*res);
+        if (static_cast<int>(page.patients.size()) > pageSize) {
+            page.patients.pop_back();
+            page.hasMore = true;
+        }
+        if (!page.patients.empty()) {
+            page.next.patientName = page.patients.back().patientName;
+            page.next.patientID = page.patients.back().patientID;
+        }
+    }
+    catch (sql::SQLException& e) {
+        std::cerr << "[ERROR] " << e.what() << std::endl;
+    }
+    return page;
+}
+
 // ============================================================
 // Doctor Operations
 // ============================================================
 
+std::vector<Doctor> DatabaseManager::loadDoctors() {
+    ConnectionPool::Lease conn = acquireConnection();
+    sql::PreparedStatement* pstmt = conn.prepare(selectColumns<Doctor>("FROM Doctors ORDER BY DoctorName"));
+    std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+    return readAll<Doctor>(*res);
+}
+
 Doctor DatabaseManager::getDoctorById(int doctorID) {
     Doctor doctor;
     try {
-        std::unique_ptr<sql::PreparedStatement> pstmt(
-            connection->prepareStatement("SELECT * FROM Doctors WHERE DoctorID = ?"));
+        if (doctorCache.find(doctorID, doctor)) {
+            return doctor;
+        }
+        // Not in the roster - may have been added by another process since the last load
+        ConnectionPool::Lease conn = acquireConnection();
+        sql::PreparedStatement* pstmt = conn.prepare(selectColumns<Doctor>("FROM Doctors WHERE DoctorID = ?"));
         pstmt->setInt(1, doctorID);
         std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
         if (res->next()) {
-            doctor.doctorID = res->getInt("DoctorID");
-            doctor.doctorName = res->getString("DoctorName");
-            doctor.specialty = res->getString("Specialty");
-            doctor.phoneNumber = res->getString("PhoneNumber");
-            doctor.email = res->getString("Email");
-            doctor.roomNo = res->getString("RoomNo");
-            doctor.isAvailable = res->getBoolean("IsAvailable");
+            doctor = RowMapper<Doctor>::read(*res);
         }
     }
     catch (sql::SQLException& e) {
@@ -288,22 +683,12 @@ Doctor DatabaseManager::getDoctorById(int doctorID) {
 std::vector<Doctor> DatabaseManager::getAllDoctors(bool availableOnly) {
     std::vector<Doctor> doctors;
     try {
-        std::string query = "SELECT * FROM Doctors";
-        if (availableOnly) query += " WHERE IsAvailable = TRUE";
-        query += " ORDER BY DoctorName";
-        
-        std::unique_ptr<sql::Statement> stmt(connection->createStatement());
-        std::unique_ptr<sql::ResultSet> res(stmt->executeQuery(query));
-        while (res->next()) {
-            Doctor d;
-            d.doctorID = res->getInt("DoctorID");
-            d.doctorName = res->getString("DoctorName");
-            d.specialty = res->getString("Specialty");
-            d.phoneNumber = res->getString("PhoneNumber");
-            d.email = res->getString("Email");
-            d.roomNo = res->getString("RoomNo");
-            d.isAvailable = res->getBoolean("IsAvailable");
-            doctors.push_back(d);
+        DoctorCache::Roster roster = doctorCache.roster();
+        if (!availableOnly) {
+            return *roster;
+        }
+        for (const Doctor& doctor : *roster) {
+            if (doctor.isAvailable) doctors.push_back(doctor);
         }
     }
     catch (sql::SQLException& e) {
@@ -312,41 +697,46 @@ std::vector<Doctor> DatabaseManager::getAllDoctors(bool availableOnly) {
     return doctors;
 }
 
-bool DatabaseManager::addDoctor(const std::string& name, const std::string& specialty,
-                               const std::string& room, const std::string& phone,
-                               const std::string& email, const std::string& password) {
+std::optional<int> DatabaseManager::addDoctor(const std::string& name, const std::string& specialty,
+                                             const std::string& room, const std::string& phone,
+                                             const std::string& email, const std::string& password) {
     try {
-        std::unique_ptr<sql::PreparedStatement> pstmt(
-            connection->prepareStatement(
-                "INSERT INTO Doctors (DoctorName, Specialty, RoomNo, PhoneNumber, Email, Password, IsAvailable) "
-                "VALUES (?, ?, ?, ?, ?, ?, TRUE)"));
+        std::string hashed = hashPassword(password);
+        ConnectionPool::Lease conn = acquireConnection();
+        sql::PreparedStatement* pstmt = conn.prepare("CALL sp_AddDoctor(?, ?, ?, ?, ?, ?)");
         pstmt->setString(1, name);
         pstmt->setString(2, specialty);
         pstmt->setString(3, room);
         pstmt->setString(4, phone);
         pstmt->setString(5, email);
-        pstmt->setString(6, password);
-        pstmt->executeUpdate();
-        return true;
+        pstmt->setString(6, hashed);
+        std::optional<int> doctorID = callReturningId(pstmt);
+        doctorCache.invalidate();
+        return doctorID;
     }
     catch (sql::SQLException& e) {
         std::cerr << "[ERROR] " << e.what() << std::endl;
-        return false;
+        return std::nullopt;
+    }
+    catch (std::exception& e) {
+        std::cerr << "[ERROR] Password hashing failed: " << e.what() << std::endl;
+        return std::nullopt;
     }
 }
 
 bool DatabaseManager::updateDoctor(int doctorID, const std::string& name, const std::string& specialty,
                                   const std::string& room, const std::string& phone) {
     try {
-        std::unique_ptr<sql::PreparedStatement> pstmt(
-            connection->prepareStatement(
-                "UPDATE Doctors SET DoctorName = ?, Specialty = ?, RoomNo = ?, PhoneNumber = ? WHERE DoctorID = ?"));
+        ConnectionPool::Lease conn = acquireConnection();
+        sql::PreparedStatement* pstmt = conn.prepare(
+            "UPDATE Doctors SET DoctorName = ?, Specialty = ?, RoomNo = ?, PhoneNumber = ? WHERE DoctorID = ?");
         pstmt->setString(1, name);
         pstmt->setString(2, specialty);
         pstmt->setString(3, room);
         pstmt->setString(4, phone);
         pstmt->setInt(5, doctorID);
         pstmt->executeUpdate();
+        doctorCache.invalidate();
         return true;
     }
     catch (sql::SQLException& e) {
@@ -357,11 +747,12 @@ bool DatabaseManager::updateDoctor(int doctorID, const std::string& name, const
 
 bool DatabaseManager::updateDoctorAvailability(int doctorID, bool isAvailable) {
     try {
-        std::unique_ptr<sql::PreparedStatement> pstmt(
-            connection->prepareStatement("UPDATE Doctors SET IsAvailable = ? WHERE DoctorID = ?"));
+        ConnectionPool::Lease conn = acquireConnection();
+        sql::PreparedStatement* pstmt = conn.prepare("UPDATE Doctors SET IsAvailable = ? WHERE DoctorID = ?");
         pstmt->setBoolean(1, isAvailable);
         pstmt->setInt(2, doctorID);
         pstmt->executeUpdate();
+        doctorCache.invalidate();
         return true;
     }
     catch (sql::SQLException& e) {
@@ -372,17 +763,19 @@ bool DatabaseManager::updateDoctorAvailability(int doctorID, bool isAvailable) {
 
 bool DatabaseManager::deleteDoctor(int doctorID) {
     try {
+        ConnectionPool::Lease conn = acquireConnection();
         // Cancel appointments first
-        std::unique_ptr<sql::PreparedStatement> pstmt1(
-            connection->prepareStatement("UPDATE Appointment SET Status = 'Cancelled' WHERE DoctorID = ?"));
+        sql::PreparedStatement* pstmt1 = conn.prepare(
+            "UPDATE Appointment SET Status = 4 WHERE DoctorID = ?");
         pstmt1->setInt(1, doctorID);
         pstmt1->executeUpdate();
         
         // Delete doctor
-        std::unique_ptr<sql::PreparedStatement> pstmt2(
-            connection->prepareStatement("DELETE FROM Doctors WHERE DoctorID = ?"));
+        sql::PreparedStatement* pstmt2 = conn.prepare("DELETE FROM Doctors WHERE DoctorID = ?");
         pstmt2->setInt(1, doctorID);
         pstmt2->executeUpdate();
+        doctorCache.invalidate();
+        slotIndex.invalidate();
         return true;
     }
     catch (sql::SQLException& e) {
@@ -391,6 +784,10 @@ bool DatabaseManager::deleteDoctor(int doctorID) {
     }
 }
 
+DoctorCache::Stats DatabaseManager::getDoctorCacheStats() const {
+    return doctorCache.getStats();
+}
+
 // ============================================================
 // Staff Operations
 // ============================================================
@@ -398,16 +795,12 @@ bool DatabaseManager::deleteDoctor(int doctorID) {
 Staff DatabaseManager::getStaffById(int staffID) {
     Staff staff;
     try {
-        std::unique_ptr<sql::PreparedStatement> pstmt(
-            connection->prepareStatement("SELECT * FROM Staff WHERE StaffID = ?"));
+        ConnectionPool::Lease conn = acquireConnection();
+        sql::PreparedStatement* pstmt = conn.prepare(selectColumns<Staff>("FROM Staff WHERE StaffID = ?"));
         pstmt->setInt(1, staffID);
         std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
         if (res->next()) {
-            staff.staffID = res->getInt("StaffID");
-            staff.staffName = res->getString("StaffName");
-            staff.department = res->getString("Department");
-            staff.phoneNumber = res->getString("PhoneNumber");
-            staff.email = res->getString("Email");
+            staff = RowMapper<Staff>::read(*res);
         }
     }
     catch (sql::SQLException& e) {
@@ -419,17 +812,10 @@ Staff DatabaseManager::getStaffById(int staffID) {
 std::vector<Staff> DatabaseManager::getAllStaff() {
     std::vector<Staff> staffList;
     try {
-        std::unique_ptr<sql::Statement> stmt(connection->createStatement());
-        std::unique_ptr<sql::ResultSet> res(stmt->executeQuery("SELECT * FROM Staff ORDER BY StaffName"));
-        while (res->next()) {
-            Staff s;
-            s.staffID = res->getInt("StaffID");
-            s.staffName = res->getString("StaffName");
-            s.department = res->getString("Department");
-            s.phoneNumber = res->getString("PhoneNumber");
-            s.email = res->getString("Email");
-            staffList.push_back(s);
-        }
+        ConnectionPool::Lease conn = acquireConnection();
+        sql::PreparedStatement* pstmt = conn.prepare(selectColumns<Staff>("FROM Staff ORDER BY StaffName"));
+        std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+        staffList = readAll<Staff>(*res);
     }
     catch (sql::SQLException& e) {
         std::cerr << "[ERROR] " << e.what() << std::endl;
@@ -437,32 +823,34 @@ std::vector<Staff> DatabaseManager::getAllStaff() {
     return staffList;
 }
 
-bool DatabaseManager::addStaff(const std::string& name, const std::string& department,
-                              const std::string& phone, const std::string& email,
-                              const std::string& password) {
+std::optional<int> DatabaseManager::addStaff(const std::string& name, const std::string& department,
+                                            const std::string& phone, const std::string& email,
+                                            const std::string& password) {
     try {
-        std::unique_ptr<sql::PreparedStatement> pstmt(
-            connection->prepareStatement(
-                "INSERT INTO Staff (StaffName, Department, PhoneNumber, Email, Password) "
-                "VALUES (?, ?, ?, ?, ?)"));
+        std::string hashed = hashPassword(password);
+        ConnectionPool::Lease conn = acquireConnection();
+        sql::PreparedStatement* pstmt = conn.prepare("CALL sp_AddStaff(?, ?, ?, ?, ?)");
         pstmt->setString(1, name);
         pstmt->setString(2, department);
         pstmt->setString(3, phone);
         pstmt->setString(4, email);
-        pstmt->setString(5, password);
-        pstmt->executeUpdate();
-        return true;
+        pstmt->setString(5, hashed);
+        return callReturningId(pstmt);
     }
     catch (sql::SQLException& e) {
         std::cerr << "[ERROR] " << e.what() << std::endl;
-        return false;
+        return std::nullopt;
+    }
+    catch (std::exception& e) {
+        std::cerr << "[ERROR] Password hashing failed: " << e.what() << std::endl;
+        return std::nullopt;
     }
 }
 
 bool DatabaseManager::deleteStaff(int staffID) {
     try {
-        std::unique_ptr<sql::PreparedStatement> pstmt(
-            connection->prepareStatement("DELETE FROM Staff WHERE StaffID = ?"));
+        ConnectionPool::Lease conn = acquireConnection();
+        sql::PreparedStatement* pstmt = conn.prepare("DELETE FROM Staff WHERE StaffID = ?");
         pstmt->setInt(1, staffID);
         pstmt->executeUpdate();
         return true;
@@ -480,15 +868,12 @@ bool DatabaseManager::deleteStaff(int staffID) {
 Admin DatabaseManager::getAdminById(int adminID) {
     Admin admin;
     try {
-        std::unique_ptr<sql::PreparedStatement> pstmt(
-            connection->prepareStatement("SELECT AdminID, AdminName, PhoneNumber, Email FROM Admin WHERE AdminID = ?"));
+        ConnectionPool::Lease conn = acquireConnection();
+        sql::PreparedStatement* pstmt = conn.prepare(selectColumns<Admin>("FROM Admin WHERE AdminID = ?"));
         pstmt->setInt(1, adminID);
         std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
         if (res->next()) {
-            admin.adminID = res->getInt("AdminID");
-            admin.adminName = res->getString("AdminName");
-            admin.phoneNumber = res->getString("PhoneNumber");
-            admin.email = res->getString("Email");
+            admin = RowMapper<Admin>::read(*res);
         }
     }
     catch (sql::SQLException& e) {
@@ -501,31 +886,298 @@ Admin DatabaseManager::getAdminById(int adminID) {
 // Appointment Operations
 // ============================================================
 
-bool DatabaseManager::createAppointment(int patientID, int doctorID, const std::string& date,
-                                        const std::string& time, const std::string& reason,
-                                        int duration, double consultationFee, double medicineFee) {
+std::optional<int> DatabaseManager::createAppointment(int patientID, int doctorID, const Date& date,
+                                                      const TimeOfDay& time, const std::string& reason,
+                                                      int duration, double consultationFee, double medicineFee) {
+    // Same single-statement path as a patient booking, so the slot rules hold here too
+    BookingResult booking = bookAppointmentAtomic(patientID, doctorID, date, time, reason,
+                                                  duration, consultationFee, medicineFee);
+    if (booking.outcome == BookingResult::SlotTaken) {
+        std::cerr << "[ERROR] Doctor already has an appointment at " << date << " " << time.shortString() << std::endl;
+    }
+    else if (booking.outcome == BookingResult::DailyLimitReached) {
+        std::cerr << "[ERROR] Patient already has an appointment with this doctor on " << date << std::endl;
+    }
+    if (booking.outcome != BookingResult::Booked) return std::nullopt;
+    return booking.appointmentID;
+}
+
+DatabaseManager::BookingResult DatabaseManager::bookAppointmentAtomic(int patientID, int doctorID,
+                                                                      const Date& date,
+                                                                      const TimeOfDay& time,
+                                                                      const std::string& reason,
+                                                                      int duration, double consultationFee,
+                                                                      double medicineFee) {
+    BookingResult result;
     try {
-        double totalCost = consultationFee + medicineFee;
-        std::unique_ptr<sql::PreparedStatement> pstmt(
-            connection->prepareStatement(
-                "INSERT INTO Appointment (PatientID, DoctorID, AppointmentDate, AppointmentTime, Reason, Duration, ConsultationFee, MedicineFee, TotalCost, Status) "
-                "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, 'Pending')"));
+        // No refusal from slotIndex here: it rounds off-grid times outward and
+        // misses other processes' cancellations until it reloads, while
+        // sp_BookAppointment checks overlaps with the doctor locked
+        ConnectionPool::Lease conn = acquireConnection();
+        sql::PreparedStatement* pstmt = conn.prepare(
+            "CALL sp_BookAppointment(?, ?, FROM_DAYS(?), SEC_TO_TIME(?), ?, ?, ?, ?)");
         pstmt->setInt(1, patientID);
         pstmt->setInt(2, doctorID);
-        pstmt->setString(3, date);
-        pstmt->setString(4, time);
+        pstmt->setInt(3, date.toDays());
+        pstmt->setInt(4, time.toSeconds());
         pstmt->setString(5, reason);
         pstmt->setInt(6, duration);
         pstmt->setDouble(7, consultationFee);
         pstmt->setDouble(8, medicineFee);
-        pstmt->setDouble(9, totalCost);
-        pstmt->executeUpdate();
-        return true;
+        std::optional<int> appointmentID = callReturningId(pstmt);
+        if (appointmentID) {
+            result.outcome = BookingResult::Booked;
+            result.appointmentID = *appointmentID;
+            DoctorSlotIndex::Booking booking;
+            booking.appointmentID = *appointmentID;
+            booking.doctorID = doctorID;
+            booking.date = date;
+            booking.time = time;
+            booking.duration = duration;
+            slotIndex.add(booking);
+        }
+    }
+    catch (sql::SQLException& e) {
+        // The unique key or signal that rejected the row tells which rule was hit
+        std::string message = e.what();
+        if (e.getErrorCode() == ER_DUP_ENTRY && message.find("uq_appt_active_slot") != std::string::npos) {
+            result.outcome = BookingResult::SlotTaken;
+        }
+        else if (e.getErrorCode() == ER_DUP_ENTRY && message.find("uq_appt_patient_day") != std::string::npos) {
+            result.outcome = BookingResult::DailyLimitReached;
+        }
+        else if (e.getErrorCode() == ER_SIGNAL_EXCEPTION && message.find("slot overlap") != std::string::npos) {
+            result.outcome = BookingResult::SlotTaken; // Raised by sp_BookAppointment's overlap check
+        }
+        else {
+            std::cerr << "[ERROR] " << e.what() << std::endl;
+        }
+    }
+    return result;
+}
+
+namespace {
+    std::string appointmentInsertSql(size_t rows) {
+        std::string sql = "INSERT INTO Appointment (PatientID, DoctorID, AppointmentDate, AppointmentTime, Reason, "
+                          "Duration, ConsultationFee, MedicineFee, TotalCost, Status) VALUES ";
+        for (size_t i = 0; i < rows; i++) {
+            if (i > 0) sql += ", ";
+            sql += "(?, ?, FROM_DAYS(?), SEC_TO_TIME(?), ?, ?, ?, ?, ?, 1)"; // Pending
+        }
+        return sql;
+    }
+
+    void bindImportRow(sql::PreparedStatement* pstmt, unsigned int& param, const DatabaseManager::ImportRow& row) {
+        pstmt->setInt(param++, row.patientID);
+        pstmt->setInt(param++, row.doctorID);
+        pstmt->setInt(param++, row.date.toDays());
+        pstmt->setInt(param++, row.time.toSeconds());
+        pstmt->setString(param++, row.reason);
+        pstmt->setInt(param++, row.duration);
+        pstmt->setDouble(param++, row.consultationFee);
+        pstmt->setDouble(param++, row.medicineFee);
+        pstmt->setDouble(param++, row.consultationFee + row.medicineFee);
+    }
+
+    // Errors that reject the statement's rows but leave the transaction usable
+    bool isRowError(const sql::SQLException& e) {
+        return e.getErrorCode() == ER_DUP_ENTRY || e.getErrorCode() == ER_NO_REFERENCED_ROW_2 ||
+               e.getErrorCode() == ER_DATA_TOO_LONG;
+    }
+
+    const char* const OVERLAP_TEXT = "Doctor already has an appointment at this time";
+
+    // Active appointments' [start, end) minutes per doctor-day
+    class BookedRanges {
+    public:
+        void add(int doctorID, const Date& date, const TimeOfDay& time, int duration) {
+            int start = time.minuteOfDay();
+            ranges[std::make_pair(doctorID, date.dayNumber())].push_back(std::make_pair(start, start + duration));
+        }
+        bool overlaps(int doctorID, const Date& date, const TimeOfDay& time, int duration) const {
+            std::map<std::pair<int, int>, std::vector<std::pair<int, int>>>::const_iterator day =
+                ranges.find(std::make_pair(doctorID, date.dayNumber()));
+            if (day == ranges.end()) return false;
+            int start = time.minuteOfDay();
+            for (const std::pair<int, int>& range : day->second) {
+                if (range.first < start + duration && start < range.second) return true;
+            }
+            return false;
+        }
+        void clear() { ranges.clear(); }
+
+    private:
+        std::map<std::pair<int, int>, std::vector<std::pair<int, int>>> ranges;
+    };
+
+    // Doctors are locked a fixed number of IDs per statement, padded with 0
+    // (no DoctorID), so one cached statement serves every import. The lock
+    // is the one sp_BookAppointment takes, so neither path can slip a
+    // booking in while the other is checking overlaps; the appointments
+    // are read with FOR UPDATE to see the latest commits, not the snapshot.
+    const size_t DOCTOR_LOCK_BATCH = 32;
+
+    std::string doctorPlaceholders() {
+        std::string placeholders = "?";
+        for (size_t i = 1; i < DOCTOR_LOCK_BATCH; i++) placeholders += ", ?";
+        return placeholders;
+    }
+
+    const std::string SQL_LOCK_DOCTORS =
+        "SELECT DoctorID FROM Doctors WHERE DoctorID IN (" + doctorPlaceholders() + ") "
+        "ORDER BY DoctorID FOR UPDATE";
+
+    const std::string SQL_ACTIVE_RANGES =
+        "SELECT DoctorID, TO_DAYS(AppointmentDate), TIME_TO_SEC(AppointmentTime) DIV 60, Duration "
+        "FROM Appointment WHERE DoctorID IN (" + doctorPlaceholders() + ") "
+        "AND AppointmentDate BETWEEN FROM_DAYS(?) AND FROM_DAYS(?) AND Status IN (1, 2) FOR UPDATE";
+
+    // Locks the rows' doctors in ascending ID order (so two imports cannot
+    // deadlock) and returns their active appointments over the rows' dates
+    BookedRanges lockDoctorDays(ConnectionPool::Lease& conn, const std::vector<DatabaseManager::ImportRow>& rows) {
+        std::vector<int> doctorIDs;
+        Date first = rows.front().date;
+        Date last = rows.front().date;
+        for (const DatabaseManager::ImportRow& row : rows) {
+            doctorIDs.push_back(row.doctorID);
+            if (row.date < first) first = row.date;
+            if (row.date > last) last = row.date;
+        }
+        std::sort(doctorIDs.begin(), doctorIDs.end());
+        doctorIDs.erase(std::unique(doctorIDs.begin(), doctorIDs.end()), doctorIDs.end());
+
+        BookedRanges booked;
+        sql::PreparedStatement* lock = conn.prepare(SQL_LOCK_DOCTORS);
+        sql::PreparedStatement* load = conn.prepare(SQL_ACTIVE_RANGES);
+        for (size_t begin = 0; begin < doctorIDs.size(); begin += DOCTOR_LOCK_BATCH) {
+            for (size_t i = 0; i < DOCTOR_LOCK_BATCH; i++) {
+                int doctorID = begin + i < doctorIDs.size() ? doctorIDs[begin + i] : 0;
+                lock->setInt(static_cast<int>(i + 1), doctorID);
+                load->setInt(static_cast<int>(i + 1), doctorID);
+            }
+            std::unique_ptr<sql::ResultSet> locked(lock->executeQuery());
+            load->setInt(static_cast<int>(DOCTOR_LOCK_BATCH + 1), first.toDays());
+            load->setInt(static_cast<int>(DOCTOR_LOCK_BATCH + 2), last.toDays());
+            std::unique_ptr<sql::ResultSet> res(load->executeQuery());
+            while (res->next()) {
+                booked.add(res->getInt(1), Date::fromToDays(res->getInt(2)),
+                           TimeOfDay::fromMinutes(res->getInt(3)), res->getInt(4));
+            }
+        }
+        return booked;
+    }
+
+    std::string rowErrorText(const sql::SQLException& e) {
+        std::string message = e.what();
+        if (e.getErrorCode() == ER_DUP_ENTRY && message.find("uq_appt_active_slot") != std::string::npos) {
+            return OVERLAP_TEXT;
+        }
+        if (e.getErrorCode() == ER_DUP_ENTRY && message.find("uq_appt_patient_day") != std::string::npos) {
+            return "Patient already has an appointment with this doctor on this date";
+        }
+        if (e.getErrorCode() == ER_NO_REFERENCED_ROW_2) return "Unknown patient or doctor";
+        return message;
+    }
+
+    // Inserts the listed rows, power-of-two statements at a time as in
+    // writeActivityBatch; the rows written are added to booked
+    void insertImportRows(ConnectionPool::Lease& conn, const std::vector<DatabaseManager::ImportRow>& rows,
+                          const std::vector<size_t>& pending, BookedRanges& booked,
+                          std::vector<DatabaseManager::ImportFailure>& failures) {
+        size_t done = 0;
+        while (done < pending.size()) {
+            size_t count = 1;
+            while (count * 2 <= pending.size() - done && count * 2 <= IMPORT_STATEMENT_ROWS) count *= 2;
+            
+            try {
+                sql::PreparedStatement* pstmt = conn.prepare(appointmentInsertSql(count));
+                unsigned int param = 1;
+                for (size_t i = done; i < done + count; i++) bindImportRow(pstmt, param, rows[pending[i]]);
+                pstmt->executeUpdate();
+                for (size_t i = done; i < done + count; i++) {
+                    const DatabaseManager::ImportRow& row = rows[pending[i]];
+                    booked.add(row.doctorID, row.date, row.time, row.duration);
+                }
+            }
+            catch (sql::SQLException& e) {
+                if (!isRowError(e)) throw;
+                // Only that statement was undone; find the rows at fault
+                sql::PreparedStatement* single = conn.prepare(appointmentInsertSql(1));
+                for (size_t i = done; i < done + count; i++) {
+                    const DatabaseManager::ImportRow& row = rows[pending[i]];
+                    try {
+                        unsigned int param = 1;
+                        bindImportRow(single, param, row);
+                        single->executeUpdate();
+                        booked.add(row.doctorID, row.date, row.time, row.duration);
+                    }
+                    catch (sql::SQLException& rowError) {
+                        if (!isRowError(rowError)) throw;
+                        failures.push_back(DatabaseManager::ImportFailure{ pending[i], rowErrorText(rowError) });
+                    }
+                }
+            }
+            done += count;
+        }
+    }
+}
+
+std::vector<DatabaseManager::ImportFailure> DatabaseManager::importAppointments(const std::vector<ImportRow>& rows) {
+    std::vector<ImportFailure> failures;
+    if (rows.empty()) return failures;
+    try {
+        ConnectionPool::Lease conn = acquireConnection();
+        conn->setAutoCommit(false);
+        try {
+            // The overlap rule is checked here rather than by a key: each
+            // row against the doctor's active appointments and the rows
+            // already written. Rows waiting to be written are flushed
+            // before a row that overlaps one of them is judged, so a
+            // waiting row later refused by a key never counts against it.
+            BookedRanges booked = lockDoctorDays(conn, rows);
+            BookedRanges waiting;
+            std::vector<size_t> pending;
+            for (size_t i = 0; i < rows.size(); i++) {
+                const ImportRow& row = rows[i];
+                if (waiting.overlaps(row.doctorID, row.date, row.time, row.duration)) {
+                    insertImportRows(conn, rows, pending, booked, failures);
+                    pending.clear();
+                    waiting.clear();
+                }
+                if (booked.overlaps(row.doctorID, row.date, row.time, row.duration)) {
+                    failures.push_back(ImportFailure{ i, OVERLAP_TEXT });
+                    continue;
+                }
+                pending.push_back(i);
+                waiting.add(row.doctorID, row.date, row.time, row.duration);
+            }
+            insertImportRows(conn, rows, pending, booked, failures);
+            std::sort(failures.begin(), failures.end(),
+                      [](const ImportFailure& a, const ImportFailure& b) { return a.row < b.row; });
+            conn->commit();
+            conn->setAutoCommit(true);
+        }
+        catch (sql::SQLException&) {
+            try {
+                conn->rollback();
+                conn->setAutoCommit(true);
+            }
+            catch (sql::SQLException&) {
+                conn.invalidate(); // Never hand back a connection stuck mid-transaction
+            }
+            throw;
+        }
+        // The new IDs are not known here, so reload rather than add bookings one by one
+        slotIndex.invalidate();
     }
     catch (sql::SQLException& e) {
         std::cerr << "[ERROR] " << e.what() << std::endl;
-        return false;
+        failures.clear();
+        for (size_t i = 0; i < rows.size(); i++) {
+            failures.push_back(ImportFailure{ i, std::string("Not imported: ") + e.what() });
+        }
     }
+    return failures;
 }
 
 double DatabaseManager::calculateConsultationFee(int duration) {
@@ -534,78 +1186,19 @@ double DatabaseManager::calculateConsultationFee(int duration) {
 }
 
 double DatabaseManager::calculateMedicineFee(const std::string& reason) {
-    // Calculate medicine fee based on appointment reason
-    std::string lowerReason = reason;
-    std::transform(lowerReason.begin(), lowerReason.end(), lowerReason.begin(), ::tolower);
-    
-    // Common conditions and their medicine fees (in RM)
-    if (lowerReason.find("fever") != std::string::npos || 
-        lowerReason.find("flu") != std::string::npos || 
-        lowerReason.find("cough") != std::string::npos ||
-        lowerReason.find("cold") != std::string::npos) {
-        return 25.00; // Basic medication for common cold/flu
-    }
-    else if (lowerReason.find("pain") != std::string::npos ||
-             lowerReason.find("headache") != std::string::npos ||
-             lowerReason.find("backache") != std::string::npos) {
-        return 40.00; // Pain medication
-    }
-    else if (lowerReason.find("allergy") != std::string::npos ||
-             lowerReason.find("rash") != std::string::npos ||
-             lowerReason.find("itch") != std::string::npos ||
-             lowerReason.find("skin") != std::string::npos) {
-        return 35.00; // Antihistamines and topical treatments
-    }
-    else if (lowerReason.find("infection") != std::string::npos ||
-             lowerReason.find("throat") != std::string::npos) {
-        return 50.00; // Antibiotics
-    }
-    else if (lowerReason.find("diabetes") != std::string::npos ||
-             lowerReason.find("blood pressure") != std::string::npos ||
-             lowerReason.find("hypertension") != std::string::npos ||
-             lowerReason.find("heart") != std::string::npos) {
-        return 80.00; // Chronic condition medication
-    }
-    else if (lowerReason.find("checkup") != std::string::npos ||
-             lowerReason.find("check up") != std::string::npos ||
-             lowerReason.find("follow-up") != std::string::npos ||
-             lowerReason.find("follow up") != std::string::npos ||
-             lowerReason.find("screening") != std::string::npos) {
-        return 0.00; // No medicine needed for routine checkups
-    }
-    else {
-        return 30.00; // Default medicine fee for general conditions
-    }
+    // Keyword categories and fees are in MedicineFeeMatcher.cpp
+    return MedicineFeeMatcher::instance().fee(reason);
 }
 
 std::vector<Appointment> DatabaseManager::getPatientAppointments(int patientID) {
     std::vector<Appointment> appointments;
     try {
-        std::unique_ptr<sql::PreparedStatement> pstmt(
-            connection->prepareStatement(
-                "SELECT a.*, p.PatientName, d.DoctorName FROM Appointment a "
-                "JOIN Patient p ON a.PatientID = p.PatientID "
-                "JOIN Doctors d ON a.DoctorID = d.DoctorID "
-                "WHERE a.PatientID = ? ORDER BY a.AppointmentDate DESC, a.AppointmentTime DESC"));
+        ConnectionPool::Lease conn = acquireConnection();
+        sql::PreparedStatement* pstmt = conn.prepare(appointmentQuery(
+            "WHERE a.PatientID = ? ORDER BY a.AppointmentDate DESC, a.AppointmentTime DESC"));
         pstmt->setInt(1, patientID);
         std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
-        while (res->next()) {
-            Appointment a;
-            a.appointmentID = res->getInt("AppointmentID");
-            a.status = res->getString("Status");
-            a.appointmentTime = res->getString("AppointmentTime");
-            a.appointmentDate = res->getString("AppointmentDate");
-            a.reason = res->getString("Reason");
-            a.duration = res->getInt("Duration");
-            a.consultationFee = res->getDouble("ConsultationFee");
-            a.medicineFee = res->getDouble("MedicineFee");
-            a.totalCost = res->getDouble("TotalCost");
-            a.patientID = res->getInt("PatientID");
-            a.doctorID = res->getInt("DoctorID");
-            a.patientName = res->getString("PatientName");
-            a.doctorName = res->getString("DoctorName");
-            appointments.push_back(a);
-        }
+        appointments = readAll<Appointment>(*res);
     }
     catch (sql::SQLException& e) {
         std::cerr << "[ERROR] " << e.what() << std::endl;
@@ -613,41 +1206,23 @@ std::vector<Appointment> DatabaseManager::getPatientAppointments(int patientID)
     return appointments;
 }
 
-std::vector<Appointment> DatabaseManager::getDoctorAppointments(int doctorID, const std::string& date) {
+std::vector<Appointment> DatabaseManager::getDoctorAppointments(int doctorID, const Date& date) {
     std::vector<Appointment> appointments;
     try {
-        std::string query = "SELECT a.*, p.PatientName, d.DoctorName FROM Appointment a "
-                           "JOIN Patient p ON a.PatientID = p.PatientID "
-                           "JOIN Doctors d ON a.DoctorID = d.DoctorID "
-                           "WHERE a.DoctorID = ?";
-        if (!date.empty()) {
-            query += " AND a.AppointmentDate = ?";
+        ConnectionPool::Lease conn = acquireConnection();
+        std::string query = appointmentQuery("WHERE a.DoctorID = ?");
+        if (date.isValid()) {
+            query += " AND a.AppointmentDate = FROM_DAYS(?)";
         }
         query += " ORDER BY a.AppointmentDate, a.AppointmentTime";
         
-        std::unique_ptr<sql::PreparedStatement> pstmt(connection->prepareStatement(query));
+        sql::PreparedStatement* pstmt = conn.prepare(query);
         pstmt->setInt(1, doctorID);
-        if (!date.empty()) {
-            pstmt->setString(2, date);
+        if (date.isValid()) {
+            pstmt->setInt(2, date.toDays());
         }
         std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
-        while (res->next()) {
-            Appointment a;
-            a.appointmentID = res->getInt("AppointmentID");
-            a.status = res->getString("Status");
-            a.appointmentTime = res->getString("AppointmentTime");
-            a.appointmentDate = res->getString("AppointmentDate");
-            a.reason = res->getString("Reason");
-            a.duration = res->getInt("Duration");
-            a.consultationFee = res->getDouble("ConsultationFee");
-            a.medicineFee = res->getDouble("MedicineFee");
-            a.totalCost = res->getDouble("TotalCost");
-            a.patientID = res->getInt("PatientID");
-            a.doctorID = res->getInt("DoctorID");
-            a.patientName = res->getString("PatientName");
-            a.doctorName = res->getString("DoctorName");
-            appointments.push_back(a);
-        }
+        appointments = readAll<Appointment>(*res);
     }
     catch (sql::SQLException& e) {
         std::cerr << "[ERROR] " << e.what() << std::endl;
@@ -656,38 +1231,36 @@ std::vector<Appointment> DatabaseManager::getDoctorAppointments(int doctorID, co
 }
 
 std::vector<Appointment> DatabaseManager::getDoctorAllAppointments(int doctorID) {
-    return getDoctorAppointments(doctorID, "");
+    return getDoctorAppointments(doctorID, Date());
 }
 
 std::vector<Appointment> DatabaseManager::getAllAppointments() {
     std::vector<Appointment> appointments;
     try {
-        std::unique_ptr<sql::Statement> stmt(connection->createStatement());
-        std::unique_ptr<sql::ResultSet> res(stmt->executeQuery(
-            "SELECT a.*, p.PatientName, d.DoctorName FROM Appointment a "
-            "JOIN Patient p ON a.PatientID = p.PatientID "
-            "JOIN Doctors d ON a.DoctorID = d.DoctorID "
-            "ORDER BY a.AppointmentDate DESC, a.AppointmentTime"));
-        while (res->next()) {
-            Appointment a;
-            a.appointmentID = res->getInt("AppointmentID");
-            a.status = res->getString("Status");
-            a.appointmentTime = res->getString("AppointmentTime");
-            a.appointmentDate = res->getString("AppointmentDate");
-            a.reason = res->getString("Reason");
-            a.duration = res->getInt("Duration");
-            a.consultationFee = res->getDouble("ConsultationFee");
-            a.medicineFee = res->getDouble("MedicineFee");
-            a.totalCost = res->getDouble("TotalCost");
-            a.patientID = res->getInt("PatientID");
-            a.doctorID = res->getInt("DoctorID");
-            a.patientName = res->getString("PatientName");
-            a.doctorName = res->getString("DoctorName");
-            appointments.push_back(a);
-        }
+        ConnectionPool::Lease conn = acquireConnection();
+        sql::PreparedStatement* pstmt = conn.prepare(SQL_ALL_APPOINTMENTS);
+        std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+        appointments = readAll<Appointment>(*res);
+    }
+    catch (sql::SQLException& e) {
+        std::cerr << "[ERROR] " << e.what() << std::endl;
+    }
+    return appointments;
+}
+
+AppointmentList DatabaseManager::getAllAppointmentsCompact() {
+    AppointmentList appointments;
+    try {
+        ConnectionPool::Lease conn = acquireConnection();
+        sql::PreparedStatement* pstmt = conn.prepare(SQL_ALL_APPOINTMENTS);
+        std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+        appointments.reserve(res->rowsCount());
+        // Only one row is ever held as an Appointment
+        while (res->next()) appointments.push_back(RowMapper<Appointment>::read(*res));
     }
     catch (sql::SQLException& e) {
         std::cerr << "[ERROR] " << e.what() << std::endl;
+        appointments = AppointmentList();
     }
     return appointments;
 }
@@ -695,30 +1268,12 @@ std::vector<Appointment> DatabaseManager::getAllAppointments() {
 std::vector<Appointment> DatabaseManager::getPendingAppointments() {
     std::vector<Appointment> appointments;
     try {
-        std::unique_ptr<sql::Statement> stmt(connection->createStatement());
-        std::unique_ptr<sql::ResultSet> res(stmt->executeQuery(
-            "SELECT a.*, p.PatientName, d.DoctorName FROM Appointment a "
-            "JOIN Patient p ON a.PatientID = p.PatientID "
-            "JOIN Doctors d ON a.DoctorID = d.DoctorID "
-            "WHERE a.Status = 'Pending' "
+        ConnectionPool::Lease conn = acquireConnection();
+        sql::PreparedStatement* pstmt = conn.prepare(appointmentQuery(
+            "WHERE a.Status = 1 " // Pending
             "ORDER BY a.AppointmentDate, a.AppointmentTime"));
-        while (res->next()) {
-            Appointment a;
-            a.appointmentID = res->getInt("AppointmentID");
-            a.status = res->getString("Status");
-            a.appointmentTime = res->getString("AppointmentTime");
-            a.appointmentDate = res->getString("AppointmentDate");
-            a.reason = res->getString("Reason");
-            a.duration = res->getInt("Duration");
-            a.consultationFee = res->getDouble("ConsultationFee");
-            a.medicineFee = res->getDouble("MedicineFee");
-            a.totalCost = res->getDouble("TotalCost");
-            a.patientID = res->getInt("PatientID");
-            a.doctorID = res->getInt("DoctorID");
-            a.patientName = res->getString("PatientName");
-            a.doctorName = res->getString("DoctorName");
-            appointments.push_back(a);
-        }
+        std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+        appointments = readAll<Appointment>(*res);
     }
     catch (sql::SQLException& e) {
         std::cerr << "[ERROR] " << e.what() << std::endl;
@@ -726,70 +1281,119 @@ std::vector<Appointment> DatabaseManager::getPendingAppointments() {
     return appointments;
 }
 
-std::vector<Appointment> DatabaseManager::getAppointmentsByDateRange(const std::string& startDate, const std::string& endDate) {
+namespace {
+    // The four cursor parameters of the page queries, from param on
+    void bindCursor(sql::PreparedStatement* pstmt, unsigned int param, const DatabaseManager::AppointmentCursor& after) {
+        pstmt->setInt(param, after.appointmentDate.toDays());
+        pstmt->setInt(param + 1, after.appointmentDate.toDays());
+        pstmt->setInt(param + 2, after.appointmentTime.toSeconds());
+        pstmt->setInt(param + 3, after.appointmentTime.toSeconds());
+    }
+
+    // Trim the look-ahead row and point the cursor at the last row shown
+    void finishAppointmentPage(DatabaseManager::AppointmentPage& page, int pageSize) {
+        if (static_cast<int>(page.appointments.size()) > pageSize) {
+            page.appointments.pop_back();
+            page.hasMore = true;
+        }
+        if (!page.appointments.empty()) {
+            const Appointment& last = page.appointments.back();
+            page.next.appointmentDate = last.appointmentDate;
+            page.next.appointmentTime = last.appointmentTime;
+            page.next.appointmentID = last.appointmentID;
+        }
+    }
+}
+
+DatabaseManager::AppointmentPage DatabaseManager::getAppointmentsPage(const AppointmentCursor& after, int pageSize) {
+    AppointmentPage page;
+    try {
+        ConnectionPool::Lease conn = acquireConnection();
+        sql::PreparedStatement* pstmt = conn.prepare(SQL_APPOINTMENTS_PAGE);
+        bindCursor(pstmt, 1, after);
+        pstmt->setInt(5, after.appointmentID);
+        pstmt->setInt(6, pageSize + 1);
+        std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+        page.appointments = readAll<Appointment>(*res);
+        finishAppointmentPage(page, pageSize);
+    }
+    catch (sql::SQLException& e) {
+        std::cerr << "[ERROR] " << e.what() << std::endl;
+    }
+    return page;
+}
+
+DatabaseManager::AppointmentPage DatabaseManager::getDoctorAppointmentsPage(int doctorID, const AppointmentCursor& after,
+                                                                            int pageSize) {
+    AppointmentPage page;
+    try {
+        ConnectionPool::Lease conn = acquireConnection();
+        sql::PreparedStatement* pstmt = conn.prepare(SQL_DOCTOR_APPOINTMENTS_PAGE);
+        pstmt->setInt(1, doctorID);
+        bindCursor(pstmt, 2, after);
+        pstmt->setInt(6, after.appointmentID);
+        pstmt->setInt(7, pageSize + 1);
+        std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+        page.appointments = readAll<Appointment>(*res);
+        finishAppointmentPage(page, pageSize);
+    }
+    catch (sql::SQLException& e) {
+        std::cerr << "[ERROR] " << e.what() << std::endl;
+    }
+    return page;
+}
+
+std::vector<Appointment> DatabaseManager::getAppointmentsByDateRange(const Date& startDate, const Date& endDate) {
     std::vector<Appointment> appointments;
     try {
-        std::unique_ptr<sql::PreparedStatement> pstmt(
-            connection->prepareStatement(
-                "SELECT a.*, p.PatientName, d.DoctorName FROM Appointment a "
-                "JOIN Patient p ON a.PatientID = p.PatientID "
-                "JOIN Doctors d ON a.DoctorID = d.DoctorID "
-                "WHERE a.AppointmentDate BETWEEN ? AND ? "
-                "ORDER BY a.AppointmentDate DESC, a.AppointmentTime"));
-        pstmt->setString(1, startDate);
-        pstmt->setString(2, endDate);
+        ConnectionPool::Lease conn = acquireConnection();
+        sql::PreparedStatement* pstmt = conn.prepare(SQL_APPOINTMENTS_BY_DATE_RANGE);
+        pstmt->setInt(1, startDate.toDays());
+        pstmt->setInt(2, endDate.toDays());
         std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+        appointments = readAll<Appointment>(*res);
+    }
+    catch (sql::SQLException& e) {
+        std::cerr << "[ERROR] " << e.what() << std::endl;
+    }
+    return appointments;
+}
+
+long long DatabaseManager::streamAppointmentsByDateRange(const Date& startDate, const Date& endDate,
+                                                         const std::function<bool(const Appointment&)>& onRow) {
+    try {
+        ConnectionPool::Lease conn = acquireConnection();
+        // Not from the statement cache: its result type differs from every
+        // other statement, and the connection is busy until the rows are read
+        std::unique_ptr<sql::PreparedStatement> pstmt(conn->prepareStatement(SQL_APPOINTMENT_EXPORT));
+        pstmt->setResultSetType(sql::ResultSet::TYPE_FORWARD_ONLY);
+        pstmt->setInt(1, startDate.toDays());
+        pstmt->setInt(2, endDate.toDays());
+        std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+        long long rows = 0;
         while (res->next()) {
-            Appointment a;
-            a.appointmentID = res->getInt("AppointmentID");
-            a.status = res->getString("Status");
-            a.appointmentTime = res->getString("AppointmentTime");
-            a.appointmentDate = res->getString("AppointmentDate");
-            a.reason = res->getString("Reason");
-            a.duration = res->getInt("Duration");
-            a.consultationFee = res->getDouble("ConsultationFee");
-            a.medicineFee = res->getDouble("MedicineFee");
-            a.totalCost = res->getDouble("TotalCost");
-            a.patientID = res->getInt("PatientID");
-            a.doctorID = res->getInt("DoctorID");
-            a.patientName = res->getString("PatientName");
-            a.doctorName = res->getString("DoctorName");
-            appointments.push_back(a);
+            if (!onRow(RowMapper<Appointment>::read(*res))) {
+                // Stopped mid-result: retire the connection instead of pooling it
+                conn.invalidate();
+                break;
+            }
+            rows++;
         }
+        return rows;
     }
     catch (sql::SQLException& e) {
         std::cerr << "[ERROR] " << e.what() << std::endl;
     }
-    return appointments;
+    return -1;
 }
 
 std::vector<Appointment> DatabaseManager::getTodayAppointments() {
     std::vector<Appointment> appointments;
     try {
-        std::unique_ptr<sql::Statement> stmt(connection->createStatement());
-        std::unique_ptr<sql::ResultSet> res(stmt->executeQuery(
-            "SELECT a.*, p.PatientName, d.DoctorName FROM Appointment a "
-            "JOIN Patient p ON a.PatientID = p.PatientID "
-            "JOIN Doctors d ON a.DoctorID = d.DoctorID "
-            "WHERE a.AppointmentDate = CURDATE() "
-            "ORDER BY a.AppointmentTime"));
-        while (res->next()) {
-            Appointment a;
-            a.appointmentID = res->getInt("AppointmentID");
-            a.status = res->getString("Status");
-            a.appointmentTime = res->getString("AppointmentTime");
-            a.appointmentDate = res->getString("AppointmentDate");
-            a.reason = res->getString("Reason");
-            a.duration = res->getInt("Duration");
-            a.consultationFee = res->getDouble("ConsultationFee");
-            a.medicineFee = res->getDouble("MedicineFee");
-            a.totalCost = res->getDouble("TotalCost");
-            a.patientID = res->getInt("PatientID");
-            a.doctorID = res->getInt("DoctorID");
-            a.patientName = res->getString("PatientName");
-            a.doctorName = res->getString("DoctorName");
-            appointments.push_back(a);
-        }
+        ConnectionPool::Lease conn = acquireConnection();
+        sql::PreparedStatement* pstmt = conn.prepare(SQL_TODAY_APPOINTMENTS);
+        std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+        appointments = readAll<Appointment>(*res);
     }
     catch (sql::SQLException& e) {
         std::cerr << "[ERROR] " << e.what() << std::endl;
@@ -800,31 +1404,13 @@ std::vector<Appointment> DatabaseManager::getTodayAppointments() {
 std::vector<Appointment> DatabaseManager::getWeeklyAppointments() {
     std::vector<Appointment> appointments;
     try {
-        std::unique_ptr<sql::Statement> stmt(connection->createStatement());
-        std::unique_ptr<sql::ResultSet> res(stmt->executeQuery(
-            "SELECT a.*, p.PatientName, d.DoctorName FROM Appointment a "
-            "JOIN Patient p ON a.PatientID = p.PatientID "
-            "JOIN Doctors d ON a.DoctorID = d.DoctorID "
+        ConnectionPool::Lease conn = acquireConnection();
+        sql::PreparedStatement* pstmt = conn.prepare(appointmentQuery(
             "WHERE a.AppointmentDate >= DATE_SUB(CURDATE(), INTERVAL 7 DAY) "
             "AND a.AppointmentDate <= CURDATE() "
             "ORDER BY a.AppointmentDate DESC, a.AppointmentTime"));
-        while (res->next()) {
-            Appointment a;
-            a.appointmentID = res->getInt("AppointmentID");
-            a.status = res->getString("Status");
-            a.appointmentTime = res->getString("AppointmentTime");
-            a.appointmentDate = res->getString("AppointmentDate");
-            a.reason = res->getString("Reason");
-            a.duration = res->getInt("Duration");
-            a.consultationFee = res->getDouble("ConsultationFee");
-            a.medicineFee = res->getDouble("MedicineFee");
-            a.totalCost = res->getDouble("TotalCost");
-            a.patientID = res->getInt("PatientID");
-            a.doctorID = res->getInt("DoctorID");
-            a.patientName = res->getString("PatientName");
-            a.doctorName = res->getString("DoctorName");
-            appointments.push_back(a);
-        }
+        std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+        appointments = readAll<Appointment>(*res);
     }
     catch (sql::SQLException& e) {
         std::cerr << "[ERROR] " << e.what() << std::endl;
@@ -835,31 +1421,13 @@ std::vector<Appointment> DatabaseManager::getWeeklyAppointments() {
 std::vector<Appointment> DatabaseManager::getMonthlyAppointments() {
     std::vector<Appointment> appointments;
     try {
-        std::unique_ptr<sql::Statement> stmt(connection->createStatement());
-        std::unique_ptr<sql::ResultSet> res(stmt->executeQuery(
-            "SELECT a.*, p.PatientName, d.DoctorName FROM Appointment a "
-            "JOIN Patient p ON a.PatientID = p.PatientID "
-            "JOIN Doctors d ON a.DoctorID = d.DoctorID "
+        ConnectionPool::Lease conn = acquireConnection();
+        sql::PreparedStatement* pstmt = conn.prepare(appointmentQuery(
             "WHERE a.AppointmentDate >= DATE_SUB(CURDATE(), INTERVAL 30 DAY) "
             "AND a.AppointmentDate <= CURDATE() "
             "ORDER BY a.AppointmentDate DESC, a.AppointmentTime"));
-        while (res->next()) {
-            Appointment a;
-            a.appointmentID = res->getInt("AppointmentID");
-            a.status = res->getString("Status");
-            a.appointmentTime = res->getString("AppointmentTime");
-            a.appointmentDate = res->getString("AppointmentDate");
-            a.reason = res->getString("Reason");
-            a.duration = res->getInt("Duration");
-            a.consultationFee = res->getDouble("ConsultationFee");
-            a.medicineFee = res->getDouble("MedicineFee");
-            a.totalCost = res->getDouble("TotalCost");
-            a.patientID = res->getInt("PatientID");
-            a.doctorID = res->getInt("DoctorID");
-            a.patientName = res->getString("PatientName");
-            a.doctorName = res->getString("DoctorName");
-            appointments.push_back(a);
-        }
+        std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+        appointments = readAll<Appointment>(*res);
     }
     catch (sql::SQLException& e) {
         std::cerr << "[ERROR] " << e.what() << std::endl;
@@ -870,28 +1438,13 @@ std::vector<Appointment> DatabaseManager::getMonthlyAppointments() {
 Appointment DatabaseManager::getAppointmentById(int appointmentID) {
     Appointment appt;
     try {
-        std::unique_ptr<sql::PreparedStatement> pstmt(
-            connection->prepareStatement(
-                "SELECT a.*, p.PatientName, d.DoctorName FROM Appointment a "
-                "JOIN Patient p ON a.PatientID = p.PatientID "
-                "JOIN Doctors d ON a.DoctorID = d.DoctorID "
-                "WHERE a.AppointmentID = ?"));
+        ConnectionPool::Lease conn = acquireConnection();
+        sql::PreparedStatement* pstmt = conn.prepare(appointmentQuery(
+            "WHERE a.AppointmentID = ?"));
         pstmt->setInt(1, appointmentID);
         std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
         if (res->next()) {
-            appt.appointmentID = res->getInt("AppointmentID");
-            appt.status = res->getString("Status");
-            appt.appointmentTime = res->getString("AppointmentTime");
-            appt.appointmentDate = res->getString("AppointmentDate");
-            appt.reason = res->getString("Reason");
-            appt.duration = res->getInt("Duration");
-            appt.consultationFee = res->getDouble("ConsultationFee");
-            appt.medicineFee = res->getDouble("MedicineFee");
-            appt.totalCost = res->getDouble("TotalCost");
-            appt.patientID = res->getInt("PatientID");
-            appt.doctorID = res->getInt("DoctorID");
-            appt.patientName = res->getString("PatientName");
-            appt.doctorName = res->getString("DoctorName");
+            appt = RowMapper<Appointment>::read(*res);
         }
     }
     catch (sql::SQLException& e) {
@@ -900,13 +1453,25 @@ Appointment DatabaseManager::getAppointmentById(int appointmentID) {
     return appt;
 }
 
-bool DatabaseManager::updateAppointmentStatus(int appointmentID, const std::string& status) {
+bool DatabaseManager::updateAppointmentStatus(int appointmentID, AppointmentStatus from, AppointmentStatus to) {
+    if (!from.canBecome(to)) {
+        std::cerr << "[ERROR] A " << from << " appointment cannot become " << to << std::endl;
+        return false;
+    }
     try {
-        std::unique_ptr<sql::PreparedStatement> pstmt(
-            connection->prepareStatement("UPDATE Appointment SET Status = ? WHERE AppointmentID = ?"));
-        pstmt->setString(1, status);
+        ConnectionPool::Lease conn = acquireConnection();
+        // Only moves the row if it is still in status from
+        sql::PreparedStatement* pstmt = conn.prepare(
+            "UPDATE Appointment SET Status = ? WHERE AppointmentID = ? AND Status = ?");
+        pstmt->setInt(1, to.column());
         pstmt->setInt(2, appointmentID);
-        pstmt->executeUpdate();
+        pstmt->setInt(3, from.column());
+        if (pstmt->executeUpdate() == 0) {
+            std::cerr << "[ERROR] Appointment " << appointmentID << " is not " << from << std::endl;
+            return false;
+        }
+        // No legal transition takes a slot back, so only releases are tracked
+        if (!to.holdsSlot()) slotIndex.remove(appointmentID);
         return true;
     }
     catch (sql::SQLException& e) {
@@ -916,18 +1481,38 @@ bool DatabaseManager::updateAppointmentStatus(int appointmentID, const std::stri
 }
 
 bool DatabaseManager::cancelAppointment(int appointmentID) {
-    return updateAppointmentStatus(appointmentID, "Cancelled");
+    try {
+        ConnectionPool::Lease conn = acquireConnection();
+        sql::PreparedStatement* pstmt = conn.prepare(
+            "UPDATE Appointment SET Status = 4 WHERE AppointmentID = ? AND Status <> 4");
+        pstmt->setInt(1, appointmentID);
+        if (pstmt->executeUpdate() == 0) {
+            std::cerr << "[ERROR] Appointment " << appointmentID << " not found or already cancelled" << std::endl;
+            return false;
+        }
+        slotIndex.remove(appointmentID);
+        return true;
+    }
+    catch (sql::SQLException& e) {
+        std::cerr << "[ERROR] " << e.what() << std::endl;
+        return false;
+    }
 }
 
-bool DatabaseManager::checkDoctorAvailability(int doctorID, const std::string& date, const std::string& time) {
+bool DatabaseManager::checkDoctorAvailability(int doctorID, const Date& date, const TimeOfDay& time,
+                                              int duration) {
     try {
-        std::unique_ptr<sql::PreparedStatement> pstmt(
-            connection->prepareStatement(
-                "SELECT COUNT(*) as cnt FROM Appointment WHERE DoctorID = ? AND AppointmentDate = ? "
-                "AND AppointmentTime = ? AND Status NOT IN ('Cancelled', 'Completed')"));
+        std::optional<bool> free = slotIndex.isFree(doctorID, date, time, duration);
+        if (free) return *free;
+        
+        // Day before the index window (or an invalid value): ask MySQL
+        ConnectionPool::Lease conn = acquireConnection();
+        sql::PreparedStatement* pstmt = conn.prepare(SQL_DOCTOR_SLOT_COUNT);
         pstmt->setInt(1, doctorID);
-        pstmt->setString(2, date);
-        pstmt->setString(3, time);
+        pstmt->setInt(2, date.toDays());
+        pstmt->setInt(3, time.toSeconds());
+        pstmt->setInt(4, duration);
+        pstmt->setInt(5, time.toSeconds());
         std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
         if (res->next()) {
             return res->getInt("cnt") == 0;
@@ -939,15 +1524,74 @@ bool DatabaseManager::checkDoctorAvailability(int doctorID, const std::string& d
     return false;
 }
 
-bool DatabaseManager::checkPatientDailyLimit(int patientID, int doctorID, const std::string& date) {
+DoctorSlotIndex::Load DatabaseManager::loadActiveBookings() {
+    ConnectionPool::Lease conn = acquireConnection();
+    DoctorSlotIndex::Load load;
+    sql::PreparedStatement* today = conn.prepare("SELECT TO_DAYS(CURDATE())");
+    std::unique_ptr<sql::ResultSet> day(today->executeQuery());
+    if (day->next()) load.fromDate = Date::fromToDays(day->getInt(1));
+    
+    sql::PreparedStatement* pstmt = conn.prepare(
+        "SELECT AppointmentID, DoctorID, TO_DAYS(AppointmentDate), TIME_TO_SEC(AppointmentTime) DIV 60, Duration "
+        "FROM Appointment WHERE AppointmentDate >= FROM_DAYS(?) AND Status IN (1, 2)");
+    pstmt->setInt(1, load.fromDate.toDays());
+    std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+    while (res->next()) {
+        DoctorSlotIndex::Booking booking;
+        booking.appointmentID = res->getInt(1);
+        booking.doctorID = res->getInt(2);
+        booking.date = Date::fromToDays(res->getInt(3));
+        booking.time = TimeOfDay::fromMinutes(res->getInt(4));
+        booking.duration = res->getInt(5);
+        load.bookings.push_back(booking);
+    }
+    return load;
+}
+
+std::vector<DoctorSlotIndex::FreeSlot> DatabaseManager::findFreeSlots(const std::vector<int>& doctorIDs,
+                                                                      const Date& fromDate,
+                                                                      const TimeOfDay& notBefore, int duration,
+                                                                      int days, size_t count) {
     try {
-        std::unique_ptr<sql::PreparedStatement> pstmt(
-            connection->prepareStatement(
-                "SELECT COUNT(*) as cnt FROM Appointment WHERE PatientID = ? AND DoctorID = ? "
-                "AND AppointmentDate = ? AND Status NOT IN ('Cancelled')"));
+        DoctorSlotIndex::SlotSearch search;
+        search.doctorIDs = doctorIDs;
+        search.fromDate = fromDate;
+        search.notBeforeMinute = notBefore.isValid() ? notBefore.minuteOfDay() : 0;
+        search.duration = duration;
+        search.days = days;
+        search.count = count;
+        std::optional<std::vector<DoctorSlotIndex::FreeSlot>> slots = slotIndex.findFree(search);
+        if (slots) return *slots;
+    }
+    catch (sql::SQLException& e) {
+        std::cerr << "[ERROR] " << e.what() << std::endl;
+    }
+    return std::vector<DoctorSlotIndex::FreeSlot>();
+}
+
+std::vector<DoctorSlotIndex::FreeSlot> DatabaseManager::findFreeSlotsInSpecialty(const std::string& specialty,
+                                                                                 const Date& fromDate,
+                                                                                 const TimeOfDay& notBefore,
+                                                                                 int duration, int days, size_t count) {
+    std::vector<int> doctorIDs;
+    for (const Doctor& doctor : getAllDoctors(true)) {
+        if (doctor.specialty == specialty) doctorIDs.push_back(doctor.doctorID);
+    }
+    if (doctorIDs.empty()) return std::vector<DoctorSlotIndex::FreeSlot>();
+    return findFreeSlots(doctorIDs, fromDate, notBefore, duration, days, count);
+}
+
+DoctorSlotIndex::Stats DatabaseManager::getSlotIndexStats() const {
+    return slotIndex.getStats();
+}
+
+bool DatabaseManager::checkPatientDailyLimit(int patientID, int doctorID, const Date& date) {
+    try {
+        ConnectionPool::Lease conn = acquireConnection();
+        sql::PreparedStatement* pstmt = conn.prepare(SQL_PATIENT_DAY_COUNT);
         pstmt->setInt(1, patientID);
         pstmt->setInt(2, doctorID);
-        pstmt->setString(3, date);
+        pstmt->setInt(3, date.toDays());
         std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
         if (res->next()) {
             return res->getInt("cnt") == 0;
@@ -963,42 +1607,73 @@ bool DatabaseManager::checkPatientDailyLimit(int patientID, int doctorID, const
 // Activity Log Operations
 // ============================================================
 
+namespace {
+    // Multi-row INSERT for the given number of log entries
+    std::string activityInsertSql(size_t rows) {
+        std::string sql = "INSERT INTO ActivityLog (UserType, UserID, Action, Details, LogTime) VALUES ";
+        for (size_t i = 0; i < rows; i++) {
+            if (i > 0) sql += ", ";
+            sql += "(?, ?, ?, ?, NOW() - INTERVAL ? MICROSECOND)";
+        }
+        return sql;
+    }
+}
+
 bool DatabaseManager::logActivity(const std::string& userType, int userID, 
                                   const std::string& action, const std::string& details) {
-    try {
-        std::unique_ptr<sql::PreparedStatement> pstmt(
-            connection->prepareStatement(
-                "INSERT INTO ActivityLog (UserType, UserID, Action, Details) VALUES (?, ?, ?, ?)"));
-        pstmt->setString(1, userType);
-        pstmt->setInt(2, userID);
-        pstmt->setString(3, action);
-        pstmt->setString(4, details);
-        pstmt->executeUpdate();
-        return true;
-    }
-    catch (sql::SQLException& e) {
-        std::cerr << "[ERROR] " << e.what() << std::endl;
+    if (!logWriter) {
+        std::cerr << "[ERROR] Not connected to database" << std::endl;
         return false;
     }
+    ActivityLogWriter::Entry entry;
+    entry.userType = userType;
+    entry.userID = userID;
+    entry.action = action;
+    entry.details = details;
+    return logWriter->enqueue(std::move(entry));
+}
+
+void DatabaseManager::writeActivityBatch(const std::vector<ActivityLogWriter::Entry>& batch) {
+    ConnectionPool::Lease conn = acquireConnection();
+    ActivityLogWriter::Clock::time_point now = ActivityLogWriter::Clock::now();
+    
+    size_t done = 0;
+    while (done < batch.size()) {
+        // Power-of-two chunks keep the number of distinct INSERT texts (and
+        // therefore statement cache entries) down to a handful
+        size_t rows = 1;
+        while (rows * 2 <= batch.size() - done) rows *= 2;
+        
+        sql::PreparedStatement* pstmt = conn.prepare(activityInsertSql(rows));
+        unsigned int param = 1;
+        for (size_t i = done; i < done + rows; i++) {
+            const ActivityLogWriter::Entry& entry = batch[i];
+            long long ageMicros = std::chrono::duration_cast<std::chrono::microseconds>(
+                now - entry.queuedAt).count();
+            pstmt->setString(param++, entry.userType);
+            pstmt->setInt(param++, entry.userID);
+            pstmt->setString(param++, entry.action);
+            pstmt->setString(param++, entry.details);
+            pstmt->setInt64(param++, ageMicros > 0 ? ageMicros : 0);
+        }
+        pstmt->executeUpdate();
+        done += rows;
+    }
+}
+
+ActivityLogWriter::Stats DatabaseManager::getActivityLogStats() const {
+    return logWriter ? logWriter->getStats() : ActivityLogWriter::Stats();
 }
 
 std::vector<ActivityLog> DatabaseManager::getActivityLogs(int limit) {
     std::vector<ActivityLog> logs;
+    if (logWriter) logWriter->flush(); // Include entries still waiting in the queue
     try {
-        std::unique_ptr<sql::PreparedStatement> pstmt(
-            connection->prepareStatement("SELECT * FROM ActivityLog ORDER BY LogTime DESC LIMIT ?"));
+        ConnectionPool::Lease conn = acquireConnection();
+        sql::PreparedStatement* pstmt = conn.prepare(SQL_RECENT_ACTIVITY);
         pstmt->setInt(1, limit);
         std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
-        while (res->next()) {
-            ActivityLog log;
-            log.logID = res->getInt("LogID");
-            log.userType = res->getString("UserType");
-            log.userID = res->getInt("UserID");
-            log.action = res->getString("Action");
-            log.details = res->getString("Details");
-            log.timestamp = res->getString("LogTime");
-            logs.push_back(log);
-        }
+        logs = readAll<ActivityLog>(*res);
     }
     catch (sql::SQLException& e) {
         std::cerr << "[ERROR] " << e.what() << std::endl;
@@ -1010,19 +1685,24 @@ std::vector<ActivityLog> DatabaseManager::getActivityLogs(int limit) {
 // Grade A: Complex Calculations (SQL Aggregations)
 // ============================================================
 
+// The statistics below read DoctorDailyStats (one row per doctor-day, kept
+// current by triggers on Appointment) rather than scanning Appointment
+
 std::vector<DatabaseManager::DoctorStats> DatabaseManager::getDoctorStatistics() {
     std::vector<DatabaseManager::DoctorStats> stats;
     try {
-        std::unique_ptr<sql::Statement> stmt(connection->createStatement());
-        std::unique_ptr<sql::ResultSet> res(stmt->executeQuery(
+        ConnectionPool::Lease conn = acquireConnection();
+        sql::PreparedStatement* pstmt = conn.prepare(
             "SELECT d.DoctorID, d.DoctorName, "
-            "COUNT(a.AppointmentID) AS TotalAppointments, "
-            "SUM(CASE WHEN a.Status = 'Confirmed' THEN 1 ELSE 0 END) AS ConfirmedCount, "
-            "AVG(CASE WHEN a.Status = 'Completed' THEN 1.0 ELSE 0.0 END) * 100 AS CompletionRate "
+            "COALESCE(SUM(r.Pending + r.Confirmed + r.Completed + r.Cancelled), 0) AS TotalAppointments, "
+            "COALESCE(SUM(r.Confirmed), 0) AS ConfirmedCount, "
+            "COALESCE(SUM(r.Completed) * 100.0 / "
+            "NULLIF(SUM(r.Pending + r.Confirmed + r.Completed + r.Cancelled), 0), 0) AS CompletionRate "
             "FROM Doctors d "
-            "LEFT JOIN Appointment a ON d.DoctorID = a.DoctorID "
+            "LEFT JOIN DoctorDailyStats r ON d.DoctorID = r.DoctorID "
             "GROUP BY d.DoctorID, d.DoctorName "
-            "ORDER BY TotalAppointments DESC"));
+            "ORDER BY TotalAppointments DESC");
+        std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
         while (res->next()) {
             DatabaseManager::DoctorStats s;
             s.doctorID = res->getInt("DoctorID");
@@ -1042,15 +1722,17 @@ std::vector<DatabaseManager::DoctorStats> DatabaseManager::getDoctorStatistics()
 std::vector<DatabaseManager::MonthlyStats> DatabaseManager::getMonthlyStatistics() {
     std::vector<DatabaseManager::MonthlyStats> stats;
     try {
-        std::unique_ptr<sql::Statement> stmt(connection->createStatement());
-        std::unique_ptr<sql::ResultSet> res(stmt->executeQuery(
-            "SELECT YEAR(AppointmentDate) AS Year, MONTH(AppointmentDate) AS Month, "
-            "COUNT(*) AS TotalAppointments, "
-            "SUM(CASE WHEN Status = 'Completed' THEN 1 ELSE 0 END) AS Completed, "
-            "AVG(CASE WHEN Status = 'Completed' THEN 1.0 ELSE 0.0 END) * 100 AS CompletionPercentage "
-            "FROM Appointment "
-            "GROUP BY YEAR(AppointmentDate), MONTH(AppointmentDate) "
-            "ORDER BY Year DESC, Month DESC"));
+        ConnectionPool::Lease conn = acquireConnection();
+        sql::PreparedStatement* pstmt = conn.prepare(
+            "SELECT YEAR(StatDate) AS Year, MONTH(StatDate) AS Month, "
+            "SUM(Pending + Confirmed + Completed + Cancelled) AS TotalAppointments, "
+            "SUM(Completed) AS Completed, "
+            "SUM(Completed) * 100.0 / SUM(Pending + Confirmed + Completed + Cancelled) AS CompletionPercentage "
+            "FROM DoctorDailyStats "
+            "GROUP BY YEAR(StatDate), MONTH(StatDate) "
+            "HAVING TotalAppointments > 0 "
+            "ORDER BY Year DESC, Month DESC");
+        std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
         while (res->next()) {
             DatabaseManager::MonthlyStats s;
             s.year = res->getInt("Year");
@@ -1067,25 +1749,28 @@ std::vector<DatabaseManager::MonthlyStats> DatabaseManager::getMonthlyStatistics
     return stats;
 }
 
-std::vector<DatabaseManager::DailyStats> DatabaseManager::getDailyStatistics() {
-    std::vector<DatabaseManager::DailyStats> stats;
-    try {
-        std::unique_ptr<sql::Statement> stmt(connection->createStatement());
-        std::unique_ptr<sql::ResultSet> res(stmt->executeQuery(
-            "SELECT AppointmentDate, "
-            "COUNT(*) AS Total, "
-            "SUM(CASE WHEN Status = 'Confirmed' THEN 1 ELSE 0 END) AS Confirmed, "
-            "SUM(CASE WHEN Status = 'Pending' THEN 1 ELSE 0 END) AS Pending, "
-            "SUM(CASE WHEN Status = 'Completed' THEN 1 ELSE 0 END) AS Completed, "
-            "SUM(CASE WHEN Status = 'Cancelled' THEN 1 ELSE 0 END) AS Cancelled "
-            "FROM Appointment "
-            "WHERE AppointmentDate >= DATE_SUB(CURDATE(), INTERVAL 30 DAY) "
-            "AND AppointmentDate <= CURDATE() "
-            "GROUP BY AppointmentDate "
-            "ORDER BY AppointmentDate DESC"));
+namespace {
+    // Per-day totals over the last `days` days, newest first
+    std::vector<DatabaseManager::DailyStats> readDailyStats(ConnectionPool::Lease& conn, int days) {
+        std::vector<DatabaseManager::DailyStats> stats;
+        sql::PreparedStatement* pstmt = conn.prepare(
+            "SELECT StatDate, "
+            "SUM(Pending + Confirmed + Completed + Cancelled) AS Total, "
+            "SUM(Confirmed) AS Confirmed, "
+            "SUM(Pending) AS Pending, "
+            "SUM(Completed) AS Completed, "
+            "SUM(Cancelled) AS Cancelled "
+            "FROM DoctorDailyStats "
+            "WHERE StatDate >= DATE_SUB(CURDATE(), INTERVAL ? DAY) "
+            "AND StatDate <= CURDATE() "
+            "GROUP BY StatDate "
+            "HAVING Total > 0 "
+            "ORDER BY StatDate DESC");
+        pstmt->setInt(1, days);
+        std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
         while (res->next()) {
             DatabaseManager::DailyStats s;
-            s.date = res->getString("AppointmentDate");
+            s.date = res->getString("StatDate");
             s.total = res->getInt("Total");
             s.confirmed = res->getInt("Confirmed");
             s.pending = res->getInt("Pending");
@@ -1093,58 +1778,45 @@ std::vector<DatabaseManager::DailyStats> DatabaseManager::getDailyStatistics() {
             s.cancelled = res->getInt("Cancelled");
             stats.push_back(s);
         }
+        return stats;
+    }
+}
+
+std::vector<DatabaseManager::DailyStats> DatabaseManager::getDailyStatistics() {
+    try {
+        ConnectionPool::Lease conn = acquireConnection();
+        return readDailyStats(conn, 30);
     }
     catch (sql::SQLException& e) {
         std::cerr << "[ERROR] " << e.what() << std::endl;
     }
-    return stats;
+    return std::vector<DailyStats>();
 }
 
 std::vector<DatabaseManager::DailyStats> DatabaseManager::getWeeklyDailyStatistics() {
-    std::vector<DatabaseManager::DailyStats> stats;
     try {
-        std::unique_ptr<sql::Statement> stmt(connection->createStatement());
-        std::unique_ptr<sql::ResultSet> res(stmt->executeQuery(
-            "SELECT AppointmentDate, "
-            "COUNT(*) AS Total, "
-            "SUM(CASE WHEN Status = 'Confirmed' THEN 1 ELSE 0 END) AS Confirmed, "
-            "SUM(CASE WHEN Status = 'Pending' THEN 1 ELSE 0 END) AS Pending, "
-            "SUM(CASE WHEN Status = 'Completed' THEN 1 ELSE 0 END) AS Completed, "
-            "SUM(CASE WHEN Status = 'Cancelled' THEN 1 ELSE 0 END) AS Cancelled "
-            "FROM Appointment "
-            "WHERE AppointmentDate >= DATE_SUB(CURDATE(), INTERVAL 7 DAY) "
-            "AND AppointmentDate <= CURDATE() "
-            "GROUP BY AppointmentDate "
-            "ORDER BY AppointmentDate DESC"));
-        while (res->next()) {
-            DatabaseManager::DailyStats s;
-            s.date = res->getString("AppointmentDate");
-            s.total = res->getInt("Total");
-            s.confirmed = res->getInt("Confirmed");
-            s.pending = res->getInt("Pending");
-            s.completed = res->getInt("Completed");
-            s.cancelled = res->getInt("Cancelled");
-            stats.push_back(s);
-        }
+        ConnectionPool::Lease conn = acquireConnection();
+        return readDailyStats(conn, 7);
     }
     catch (sql::SQLException& e) {
         std::cerr << "[ERROR] " << e.what() << std::endl;
     }
-    return stats;
+    return std::vector<DailyStats>();
 }
 
 DatabaseManager::RevenueStats DatabaseManager::getRevenueStatistics() {
     RevenueStats stats;
     try {
-        std::unique_ptr<sql::Statement> stmt(connection->createStatement());
-        std::unique_ptr<sql::ResultSet> res(stmt->executeQuery(
+        ConnectionPool::Lease conn = acquireConnection();
+        sql::PreparedStatement* pstmt = conn.prepare(
             "SELECT "
-            "SUM(CASE WHEN Status = 'Completed' THEN TotalCost ELSE 0 END) AS TotalRevenue, "
-            "SUM(CASE WHEN Status IN ('Pending', 'Confirmed') THEN TotalCost ELSE 0 END) AS PotentialRevenue, "
-            "AVG(TotalCost) AS AverageCost, "
-            "SUM(CASE WHEN Status = 'Completed' THEN ConsultationFee ELSE 0 END) AS TotalConsultation, "
-            "SUM(CASE WHEN Status = 'Completed' THEN MedicineFee ELSE 0 END) AS TotalMedicine "
-            "FROM Appointment WHERE Status != 'Cancelled'"));
+            "SUM(CompletedRevenue) AS TotalRevenue, "
+            "SUM(OpenRevenue) AS PotentialRevenue, "
+            "SUM(CompletedRevenue + OpenRevenue) / NULLIF(SUM(Pending + Confirmed + Completed), 0) AS AverageCost, "
+            "SUM(CompletedConsultation) AS TotalConsultation, "
+            "SUM(CompletedMedicine) AS TotalMedicine "
+            "FROM DoctorDailyStats");
+        std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
         if (res->next()) {
             stats.totalRevenue = res->getDouble("TotalRevenue");
             stats.potentialRevenue = res->getDouble("PotentialRevenue");
@@ -1157,4 +1829,321 @@ DatabaseManager::RevenueStats DatabaseManager::getRevenueStatistics() {
         std::cerr << "[ERROR] " << e.what() << std::endl;
     }
     return stats;
-}
\ No newline at end of file
+}
+
+namespace {
+    // Totals summed from DoctorDailyStats rows; clauses narrows the rows
+    const std::string SQL_SUMMARY_COLUMNS =
+        "SELECT SUM(Pending), SUM(Confirmed), SUM(Completed), SUM(Cancelled), "
+        "SUM(CompletedRevenue), SUM(CompletedConsultation), SUM(CompletedMedicine), "
+        "SUM(OpenRevenue) FROM DoctorDailyStats";
+
+    StorageEngine::AppointmentSummary readSummary(sql::PreparedStatement* pstmt) {
+        StorageEngine::AppointmentSummary summary;
+        std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+        if (res->next()) {
+            summary.pending = res->getInt(1);
+            summary.confirmed = res->getInt(2);
+            summary.completed = res->getInt(3);
+            summary.cancelled = res->getInt(4);
+            summary.total = summary.pending + summary.confirmed + summary.completed + summary.cancelled;
+            summary.completedRevenue = res->getDouble(5);
+            summary.completedConsultation = res->getDouble(6);
+            summary.completedMedicine = res->getDouble(7);
+            summary.potentialRevenue = res->getDouble(8);
+        }
+        return summary;
+    }
+}
+
+DatabaseManager::AppointmentSummary DatabaseManager::getAppointmentSummary(int lastDays) {
+    AppointmentSummary summary;
+    try {
+        ConnectionPool::Lease conn = acquireConnection();
+        std::string query = SQL_SUMMARY_COLUMNS;
+        if (lastDays >= 0) {
+            query += " WHERE StatDate BETWEEN DATE_SUB(CURDATE(), INTERVAL ? DAY) AND CURDATE()";
+        }
+        
+        sql::PreparedStatement* pstmt = conn.prepare(query);
+        if (lastDays >= 0) {
+            pstmt->setInt(1, lastDays);
+        }
+        summary = readSummary(pstmt);
+    }
+    catch (sql::SQLException& e) {
+        std::cerr << "[ERROR] " << e.what() << std::endl;
+    }
+    return summary;
+}
+
+DatabaseManager::AppointmentSummary DatabaseManager::getDoctorAppointmentSummary(int doctorID) {
+    AppointmentSummary summary;
+    try {
+        // The rollup's primary key leads with DoctorID
+        ConnectionPool::Lease conn = acquireConnection();
+        sql::PreparedStatement* pstmt = conn.prepare(SQL_SUMMARY_COLUMNS + " WHERE DoctorID = ?");
+        pstmt->setInt(1, doctorID);
+        summary = readSummary(pstmt);
+    }
+    catch (sql::SQLException& e) {
+        std::cerr << "[ERROR] " << e.what() << std::endl;
+    }
+    return summary;
+}
+
+DatabaseManager::SystemCounts DatabaseManager::getSystemCounts() {
+    SystemCounts counts;
+    try {
+        ConnectionPool::Lease conn = acquireConnection();
+        sql::PreparedStatement* pstmt = conn.prepare(
+            "SELECT (SELECT COUNT(*) FROM Patient) AS Patients, "
+            "(SELECT COUNT(*) FROM Doctors) AS Doctors, "
+            "(SELECT COUNT(*) FROM Doctors WHERE IsAvailable = TRUE) AS AvailableDoctors, "
+            "(SELECT COUNT(*) FROM Staff) AS Staff");
+        std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+        if (res->next()) {
+            counts.patients = res->getInt("Patients");
+            counts.doctors = res->getInt("Doctors");
+            counts.availableDoctors = res->getInt("AvailableDoctors");
+            counts.staff = res->getInt("Staff");
+        }
+    }
+    catch (sql::SQLException& e) {
+        std::cerr << "[ERROR] " << e.what() << std::endl;
+    }
+    return counts;
+}
+
+// ============================================================
+// Statistics Rollup Maintenance
+// ============================================================
+
+bool DatabaseManager::verifyStatisticsRollup(std::vector<RollupDrift>& drift) {
+    drift.clear();
+    try {
+        ConnectionPool::Lease conn = acquireConnection();
+        // Rollup rows minus a fresh recount; any doctor-day left non-zero has drifted
+        sql::PreparedStatement* pstmt = conn.prepare(
+            "SELECT DoctorID, StatDate, SUM(Pending), SUM(Confirmed), SUM(Completed), SUM(Cancelled), "
+            "SUM(CompletedRevenue), SUM(OpenRevenue) FROM ("
+            "SELECT DoctorID, StatDate, Pending, Confirmed, Completed, Cancelled, "
+            "CompletedConsultation, CompletedMedicine, CompletedRevenue, OpenRevenue "
+            "FROM DoctorDailyStats "
+            "UNION ALL "
+            "SELECT DoctorID, AppointmentDate, -SUM(Status = 1), -SUM(Status = 2), "
+            "-SUM(Status = 3), -SUM(Status = 4), "
+            "-SUM(IF(Status = 3, ConsultationFee, 0)), "
+            "-SUM(IF(Status = 3, MedicineFee, 0)), "
+            "-SUM(IF(Status = 3, TotalCost, 0)), "
+            "-SUM(IF(Status IN (1, 2), TotalCost, 0)) "
+            "FROM Appointment GROUP BY DoctorID, AppointmentDate"
+            ") d GROUP BY DoctorID, StatDate "
+            "HAVING SUM(Pending) <> 0 OR SUM(Confirmed) <> 0 OR SUM(Completed) <> 0 "
+            "OR SUM(Cancelled) <> 0 OR SUM(CompletedConsultation) <> 0 "
+            "OR SUM(CompletedMedicine) <> 0 OR SUM(CompletedRevenue) <> 0 OR SUM(OpenRevenue) <> 0 "
+            "ORDER BY StatDate, DoctorID");
+        std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+        while (res->next()) {
+            RollupDrift d;
+            d.doctorID = res->getInt(1);
+            d.date = res->getString(2);
+            d.pending = res->getInt(3);
+            d.confirmed = res->getInt(4);
+            d.completed = res->getInt(5);
+            d.cancelled = res->getInt(6);
+            d.completedRevenue = res->getDouble(7);
+            d.openRevenue = res->getDouble(8);
+            drift.push_back(d);
+        }
+        return true;
+    }
+    catch (sql::SQLException& e) {
+        std::cerr << "[ERROR] " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool DatabaseManager::rebuildStatisticsRollup() {
+    try {
+        ConnectionPool::Lease conn = acquireConnection();
+        sql::PreparedStatement* pstmt = conn.prepare("CALL sp_RebuildDoctorDailyStats()");
+        pstmt->execute();
+        drainResults(pstmt);
+        return true;
+    }
+    catch (sql::SQLException& e) {
+        std::cerr << "[ERROR] " << e.what() << std::endl;
+        return false;
+    }
+}
+
+// ============================================================
+// Index Regression Check (EXPLAIN)
+// ============================================================
+
+std::vector<DatabaseManager::QueryPlan> DatabaseManager::explainHotQueries() {
+    std::vector<QueryPlan> plans;
+    try {
+        ConnectionPool::Lease conn = acquireConnection();
+        
+        long long appointmentRows = 0;
+        long long activityRows = 0;
+        long long patientRows = 0;
+        sql::PreparedStatement* countStmt = conn.prepare(
+            "SELECT (SELECT COUNT(*) FROM Appointment) AS Appointments, "
+            "(SELECT COUNT(*) FROM ActivityLog) AS ActivityLogs, "
+            "(SELECT COUNT(*) FROM Patient) AS Patients");
+        std::unique_ptr<sql::ResultSet> counts(countStmt->executeQuery());
+        if (counts->next()) {
+            appointmentRows = counts->getInt64("Appointments");
+            activityRows = counts->getInt64("ActivityLogs");
+            patientRows = counts->getInt64("Patients");
+        }
+        
+        // Bind a real booking so the optimizer sees representative values
+        int patientID = 0, doctorID = 0;
+        Date date = Date::fromCivil(2000, 1, 1);
+        TimeOfDay time = TimeOfDay::fromMinutes(9 * 60);
+        sql::PreparedStatement* sampleStmt = conn.prepare(
+            "SELECT PatientID, DoctorID, TO_DAYS(AppointmentDate), TIME_TO_SEC(AppointmentTime) DIV 60 "
+            "FROM Appointment ORDER BY AppointmentID DESC LIMIT 1");
+        std::unique_ptr<sql::ResultSet> sample(sampleStmt->executeQuery());
+        if (sample->next()) {
+            patientID = sample->getInt(1);
+            doctorID = sample->getInt(2);
+            date = Date::fromToDays(sample->getInt(3));
+            time = TimeOfDay::fromMinutes(sample->getInt(4));
+        }
+        DatabaseManager::AppointmentCursor cursor;
+        cursor.appointmentDate = date;
+        cursor.appointmentTime = time;
+        
+        struct HotQuery {
+            const char* method;
+            std::string sql;
+            const char* table; // Alias or table name as EXPLAIN reports it
+            long long tableRows;
+            std::function<void(sql::PreparedStatement*)> bind;
+        };
+        std::vector<HotQuery> queries = {
+            { "checkDoctorAvailability", SQL_DOCTOR_SLOT_COUNT, "Appointment", appointmentRows,
+              [&](sql::PreparedStatement* p) {
+                  p->setInt(1, doctorID); p->setInt(2, date.toDays()); p->setInt(3, time.toSeconds());
+                  p->setInt(4, 30); p->setInt(5, time.toSeconds()); } },
+            { "checkPatientDailyLimit", SQL_PATIENT_DAY_COUNT, "Appointment", appointmentRows,
+              [&](sql::PreparedStatement* p) { p->setInt(1, patientID); p->setInt(2, doctorID); p->setInt(3, date.toDays()); } },
+            { "getTodayAppointments", SQL_TODAY_APPOINTMENTS, "a", appointmentRows,
+              [](sql::PreparedStatement*) {} },
+            { "getAppointmentsByDateRange", SQL_APPOINTMENTS_BY_DATE_RANGE, "a", appointmentRows,
+              [&](sql::PreparedStatement* p) { p->setInt(1, date.toDays()); p->setInt(2, date.toDays()); } },
+            { "streamAppointmentsByDateRange", SQL_APPOINTMENT_EXPORT, "a", appointmentRows,
+              [&](sql::PreparedStatement* p) { p->setInt(1, date.toDays()); p->setInt(2, date.toDays()); } },
+            { "getActivityLogs", SQL_RECENT_ACTIVITY, "ActivityLog", activityRows,
+              [](sql::PreparedStatement* p) { p->setInt(1, 50); } },
+            { "getAppointmentsPage", SQL_APPOINTMENTS_PAGE, "a", appointmentRows,
+              [&](sql::PreparedStatement* p) {
+                  bindCursor(p, 1, cursor); p->setInt(5, 2147483647); p->setInt(6, 21); } },
+            { "getPatientsPage", SQL_PATIENTS_PAGE, "Patient", patientRows,
+              [](sql::PreparedStatement* p) {
+                  p->setString(1, "M"); p->setString(2, "M"); p->setInt(3, 0); p->setInt(4, 21); } },
+            { "searchPatients", SQL_PATIENTS_BY_ID, "Patient", patientRows,
+              [&](sql::PreparedStatement* p) {
+                  for (size_t i = 0; i < PATIENT_FETCH_BATCH; i++) p->setInt(static_cast<int>(i + 1), patientID); } }
+        };
+        
+        for (const HotQuery& query : queries) {
+            QueryPlan plan;
+            plan.method = query.method;
+            plan.table = query.table;
+            plan.tableRows = query.tableRows;
+            
+            sql::PreparedStatement* pstmt = conn.prepare("EXPLAIN " + query.sql);
+            query.bind(pstmt);
+            std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+            while (res->next()) {
+                if (std::string(res->getString("table")) != query.table) continue;
+                plan.accessType = res->getString("type");
+                plan.key = res->isNull("key") ? "" : std::string(res->getString("key"));
+                plan.estimatedRows = res->isNull("rows") ? 0 : res->getInt64("rows");
+                plan.extra = res->isNull("Extra") ? "" : std::string(res->getString("Extra"));
+                break;
+            }
+            // A named key alone is not enough: type ALL means a full table scan
+            plan.indexed = !plan.key.empty() && plan.accessType != "ALL";
+            plans.push_back(plan);
+        }
+    }
+    catch (sql::SQLException& e) {
+        std::cerr << "[ERROR] " << e.what() << std::endl;
+    }
+    return plans;
+}
+
+// ============================================================
+// Row Mapping Benchmark
+// ============================================================
+
+DatabaseManager::RowMappingBenchmark DatabaseManager::benchmarkRowMapping(int rowLimit) {
+    using BenchClock = std::chrono::steady_clock;
+    RowMappingBenchmark result;
+    try {
+        ConnectionPool::Lease conn = acquireConnection();
+        
+        // Previous shape: SELECT a.* and a by-name lookup for every column of every row
+        sql::PreparedStatement* byName = conn.prepare(
+            "SELECT a.*, p.PatientName, d.DoctorName FROM Appointment a "
+            "JOIN Patient p ON a.PatientID = p.PatientID "
+            "JOIN Doctors d ON a.DoctorID = d.DoctorID "
+            "ORDER BY a.AppointmentID LIMIT ?");
+        byName->setInt(1, rowLimit);
+        BenchClock::time_point start = BenchClock::now();
+        std::unique_ptr<sql::ResultSet> res(byName->executeQuery());
+        BenchClock::time_point fetched = BenchClock::now();
+        std::vector<Appointment> appointments;
+        appointments.reserve(res->rowsCount());
+        while (res->next()) {
+            Appointment a;
+            a.appointmentID = res->getInt("AppointmentID");
+            a.status = AppointmentStatus::parse(res->getString("Status")).value_or(AppointmentStatus::Cancelled);
+            a.appointmentTime = TimeOfDay::parse(res->getString("AppointmentTime"));
+            a.appointmentDate = Date::parse(res->getString("AppointmentDate"));
+            a.reason = res->getString("Reason");
+            a.duration = res->getInt("Duration");
+            a.consultationFee = res->getDouble("ConsultationFee");
+            a.medicineFee = res->getDouble("MedicineFee");
+            a.totalCost = res->getDouble("TotalCost");
+            a.patientID = res->getInt("PatientID");
+            a.doctorID = res->getInt("DoctorID");
+            a.staffID = res->getInt("StaffID");
+            a.patientName = res->getString("PatientName");
+            a.doctorName = res->getString("DoctorName");
+            appointments.push_back(a);
+        }
+        BenchClock::time_point mapped = BenchClock::now();
+        result.rows = static_cast<int>(appointments.size());
+        result.byNameFetchMs = std::chrono::duration<double, std::milli>(fetched - start).count();
+        result.byNameMapMs = std::chrono::duration<double, std::milli>(mapped - fetched).count();
+        res.reset();
+        appointments.clear();
+        
+        // Current shape: explicit column list read by position
+        sql::PreparedStatement* positional = conn.prepare(
+            appointmentQuery("ORDER BY a.AppointmentID LIMIT ?"));
+        positional->setInt(1, rowLimit);
+        start = BenchClock::now();
+        res.reset(positional->executeQuery());
+        fetched = BenchClock::now();
+        appointments.reserve(res->rowsCount());
+        while (res->next()) {
+            appointments.push_back(RowMapper<Appointment>::read(*res));
+        }
+        mapped = BenchClock::now();
+        result.positionalFetchMs = std::chrono::duration<double, std::milli>(fetched - start).count();
+        result.positionalMapMs = std::chrono::duration<double, std::milli>(mapped - fetched).count();
+    }
+    catch (sql::SQLException& e) {
+        std::cerr << "[ERROR] " << e.what() << std::endl;
+    }
+    return result;
+}
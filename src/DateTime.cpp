@@ -0,0 +1,160 @@
+// ============================================================
+// DateTime.cpp - Compact Date and Time-of-Day Values
+// Hospital Appointment Booking System
+// ============================================================
+
+#include "../include/DateTime.h"
+#include <ctime>
+
+namespace {
+    // value = the count digits at text[pos...]; false if any is not a digit
+    bool digitsAt(const std::string& text, size_t pos, size_t count, int& value) {
+        if (text.size() < pos + count) return false;
+        value = 0;
+        for (size_t i = pos; i < pos + count; i++) {
+            if (text[i] < '0' || text[i] > '9') return false;
+            value = value * 10 + (text[i] - '0');
+        }
+        return true;
+    }
+
+    void putDigits(char* out, int value, int count) {
+        for (int i = count - 1; i >= 0; i--) {
+            out[i] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        }
+    }
+
+    int daysInMonth(int year, int month) {
+        static const int days[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+        bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+        return month == 2 && leap ? 29 : days[month - 1];
+    }
+
+    // The local date at now, and the first moment of the next day
+    void localDay(time_t now, int& year, int& month, int& day, time_t& nextMidnight) {
+        struct tm local;
+        localtime_s(&local, &now);
+        year = local.tm_year + 1900;
+        month = local.tm_mon + 1;
+        day = local.tm_mday;
+        local.tm_mday += 1;
+        local.tm_hour = 0;
+        local.tm_min = 0;
+        local.tm_sec = 0;
+        local.tm_isdst = -1;
+        nextMidnight = mktime(&local);
+    }
+}
+
+Date Date::fromCivil(int year, int month, int day) {
+    // Days from civil date, with March as month 0 so leap days come last
+    year -= month <= 2;
+    int era = (year >= 0 ? year : year - 399) / 400;
+    int yearOfEra = year - era * 400;
+    int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return Date(era * 146097 + dayOfEra - 719468);
+}
+
+void Date::civil(int& year, int& month, int& day) const {
+    // Inverse of fromCivil()
+    int z = number + 719468;
+    int era = (z >= 0 ? z : z - 146096) / 146097;
+    int dayOfEra = z - era * 146097;
+    int yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    int dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    int shiftedMonth = (5 * dayOfYear + 2) / 153;
+    day = dayOfYear - (153 * shiftedMonth + 2) / 5 + 1;
+    month = shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9;
+    year = yearOfEra + era * 400 + (month <= 2);
+}
+
+Date Date::parse(const std::string& text) {
+    int year, month, day;
+    if (text.size() < 10 || text[4] != '-' || text[7] != '-' ||
+        !digitsAt(text, 0, 4, year) || !digitsAt(text, 5, 2, month) || !digitsAt(text, 8, 2, day) ||
+        year < 1000 || month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month)) {
+        return Date();
+    }
+    return fromCivil(year, month, day);
+}
+
+Date Date::today() {
+    // Per thread, so no lock is needed
+    thread_local Date cached;
+    thread_local time_t validUntil = 0;
+    time_t now = time(0);
+    if (now >= validUntil || !cached.isValid()) {
+        int year, month, day;
+        localDay(now, year, month, day, validUntil);
+        cached = fromCivil(year, month, day);
+    }
+    return cached;
+}
+
+int Date::year() const {
+    int y, m, d;
+    civil(y, m, d);
+    return y;
+}
+
+int Date::month() const {
+    int y, m, d;
+    civil(y, m, d);
+    return m;
+}
+
+int Date::day() const {
+    int y, m, d;
+    civil(y, m, d);
+    return d;
+}
+
+std::string Date::toString() const {
+    if (!isValid()) return std::string();
+    int y, m, d;
+    civil(y, m, d);
+    if (y < 0 || y > 9999) return std::to_string(y) + "-" + std::to_string(m) + "-" + std::to_string(d);
+    char text[10] = { 0, 0, 0, 0, '-', 0, 0, '-', 0, 0 };
+    putDigits(text, y, 4);
+    putDigits(text + 5, m, 2);
+    putDigits(text + 8, d, 2);
+    return std::string(text, sizeof(text));
+}
+
+TimeOfDay TimeOfDay::parse(const std::string& text) {
+    int hour, minute, second = 0;
+    if (text.size() < 5 || text[2] != ':' || !digitsAt(text, 0, 2, hour) || !digitsAt(text, 3, 2, minute) ||
+        hour > 23 || minute > 59) {
+        return TimeOfDay();
+    }
+    if (text.size() > 5 && (text.size() < 8 || text[5] != ':' || !digitsAt(text, 6, 2, second) || second > 59)) {
+        return TimeOfDay();
+    }
+    return TimeOfDay(hour * 60 + minute);
+}
+
+std::string TimeOfDay::toString() const {
+    if (!isValid()) return std::string();
+    char text[8] = { 0, 0, ':', 0, 0, ':', '0', '0' };
+    putDigits(text, minutes / 60, 2);
+    putDigits(text + 3, minutes % 60, 2);
+    return std::string(text, sizeof(text));
+}
+
+std::string TimeOfDay::shortString() const {
+    if (!isValid()) return std::string();
+    char text[5] = { 0, 0, ':', 0, 0 };
+    putDigits(text, minutes / 60, 2);
+    putDigits(text + 3, minutes % 60, 2);
+    return std::string(text, sizeof(text));
+}
+
+std::ostream& operator<<(std::ostream& out, const Date& date) {
+    return out << date.toString();
+}
+
+std::ostream& operator<<(std::ostream& out, const TimeOfDay& time) {
+    return out << time.toString();
+}
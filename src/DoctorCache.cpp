@@ -0,0 +1,86 @@
+// ============================================================
+// DoctorCache.cpp - Read-Through Doctor Directory Cache
+// Hospital Appointment Booking System
+// ============================================================
+
+#include "../include/DoctorCache.h"
+
+namespace {
+    double elapsedMs(DoctorCache::Clock::time_point since, DoctorCache::Clock::time_point now) {
+        return std::chrono::duration<double, std::milli>(now - since).count();
+    }
+}
+
+DoctorCache::DoctorCache(Loader l, const Config& c)
+    : loader(std::move(l)), config(c), version(0) {}
+
+std::shared_ptr<const DoctorCache::Snapshot> DoctorCache::acquire() {
+    unsigned long long loadVersion;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        Clock::time_point now = Clock::now();
+        if (current && now - current->loadedAt >= config.ttl) {
+            current.reset();
+            stats.expirations++;
+        }
+        if (current) {
+            double age = elapsedMs(current->loadedAt, now);
+            if (age > stats.maxServedAgeMs) stats.maxServedAgeMs = age;
+            stats.hits++;
+            return current;
+        }
+        stats.misses++;
+        loadVersion = version;
+    }
+
+    // The query runs without the lock; concurrent misses may each load
+    Clock::time_point start = Clock::now();
+    std::shared_ptr<Snapshot> fresh(new Snapshot());
+    std::shared_ptr<std::vector<Doctor>> doctors(new std::vector<Doctor>(loader()));
+    for (size_t i = 0; i < doctors->size(); i++) {
+        fresh->byID[(*doctors)[i].doctorID] = i;
+    }
+    fresh->doctors = doctors;
+    fresh->loadedAt = Clock::now();
+
+    std::lock_guard<std::mutex> lock(mtx);
+    stats.loads++;
+    stats.lastLoadMs = elapsedMs(start, fresh->loadedAt);
+    if (version == loadVersion) {
+        current = fresh;
+    } else {
+        // A write landed mid-load; serve this result once but do not keep it
+        stats.discardedLoads++;
+    }
+    return fresh;
+}
+
+DoctorCache::Roster DoctorCache::roster() {
+    return acquire()->doctors;
+}
+
+bool DoctorCache::find(int doctorID, Doctor& doctor) {
+    std::shared_ptr<const Snapshot> snapshot = acquire();
+    std::unordered_map<int, size_t>::const_iterator it = snapshot->byID.find(doctorID);
+    if (it == snapshot->byID.end()) return false;
+    doctor = (*snapshot->doctors)[it->second];
+    return true;
+}
+
+void DoctorCache::invalidate() {
+    std::lock_guard<std::mutex> lock(mtx);
+    version++;
+    current.reset();
+    stats.invalidations++;
+}
+
+DoctorCache::Stats DoctorCache::getStats() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    Stats snapshot = stats;
+    snapshot.version = version;
+    if (current) {
+        snapshot.snapshotAgeMs = elapsedMs(current->loadedAt, Clock::now());
+        snapshot.doctors = current->doctors->size();
+    }
+    return snapshot;
+}
@@ -4,21 +4,37 @@
 // ============================================================
 
 #include "../include/DoctorModule.h"
-#include "../include/Utilities.h"
 #include <iostream>
 #include <iomanip>
+#include <functional>
+#include <unordered_set>
 #include <vector>
 #include <windows.h>
 
+namespace {
+    // Every appointment of the doctor, newest first, read through the keyset
+    // pages so the whole history is never held at once
+    void forEachAppointment(StorageEngine& db, int doctorID, const std::function<void(const Appointment&)>& onRow) {
+        const int pageSize = 500;
+        StorageEngine::AppointmentCursor cursor;
+        while (true) {
+            StorageEngine::AppointmentPage page = db.getDoctorAppointmentsPage(doctorID, cursor, pageSize);
+            for (const Appointment& appointment : page.appointments) onRow(appointment);
+            if (!page.hasMore) return;
+            cursor = page.next;
+        }
+    }
+}
+
 // OOP: Constructor calls base class constructor
-DoctorModule::DoctorModule(ConsoleUtils& c, DatabaseManager& d, UserSession& s)
+DoctorModule::DoctorModule(ConsoleUtils& c, StorageEngine& d, UserSession& s)
     : BaseModule(c, d, s) {}
 
 void DoctorModule::viewTodayAppointments() {
     console.clearScreen();
     console.printHeader("TODAY'S APPOINTMENTS");
     
-    std::string today = getCurrentDate();
+    Date today = Date::today();
     std::vector<Appointment> appointments = db.getDoctorAppointments(session.userID, today);
     
     console.setColor(WHITE);
@@ -46,13 +62,14 @@ void DoctorModule::viewTodayAppointments() {
     std::cout << "  " << std::string(72, '-') << std::endl;
     console.resetColor();
     
-    int confirmed = 0, pending = 0, completed = 0;
+    int counts[AppointmentStatus::COUNT] = {};
     double todayRevenue = 0.0;
     
     for (const auto& apt : appointments) {
-        if (apt.status == "Confirmed") { console.setColor(GREEN); confirmed++; }
-        else if (apt.status == "Pending") { console.setColor(YELLOW); pending++; }
-        else if (apt.status == "Completed") { console.setColor(CYAN); completed++; todayRevenue += apt.totalCost; }
+        counts[apt.status.index()]++;
+        if (apt.status == AppointmentStatus::Confirmed) console.setColor(GREEN);
+        else if (apt.status == AppointmentStatus::Pending) console.setColor(YELLOW);
+        else if (apt.status == AppointmentStatus::Completed) { console.setColor(CYAN); todayRevenue += apt.totalCost; }
         else console.resetColor();
         
         std::string shortReason = apt.reason.length() > 16 ? 
@@ -62,7 +79,7 @@ void DoctorModule::viewTodayAppointments() {
         
         std::cout << "  " << std::setw(6) << apt.appointmentID
                   << std::setw(22) << patientName
-                  << std::setw(8) << apt.appointmentTime.substr(0, 5)
+                  << std::setw(8) << apt.appointmentTime.shortString()
                   << std::setw(7) << ("RM" + std::to_string((int)apt.totalCost))
                   << std::setw(11) << apt.status
                   << std::setw(18) << shortReason << std::endl;
@@ -71,9 +88,9 @@ void DoctorModule::viewTodayAppointments() {
     
     std::cout << "\n  " << std::string(72, '-') << std::endl;
     std::cout << "  SUMMARY: ";
-    console.setColor(GREEN); std::cout << confirmed << " Confirmed  ";
-    console.setColor(YELLOW); std::cout << pending << " Pending  ";
-    console.setColor(CYAN); std::cout << completed << " Completed";
+    console.setColor(GREEN); std::cout << counts[AppointmentStatus::Confirmed] << " Confirmed  ";
+    console.setColor(YELLOW); std::cout << counts[AppointmentStatus::Pending] << " Pending  ";
+    console.setColor(CYAN); std::cout << counts[AppointmentStatus::Completed] << " Completed";
     console.resetColor();
     std::cout << "\n  Today's Revenue: RM " << std::fixed << std::setprecision(2) << todayRevenue << std::endl;
     
@@ -81,71 +98,97 @@ void DoctorModule::viewTodayAppointments() {
 }
 
 void DoctorModule::viewAllAppointments() {
-    console.clearScreen();
-    console.printHeader("ALL MY APPOINTMENTS");
+    const int pageSize = 20;
     
-    std::vector<Appointment> appointments = db.getDoctorAllAppointments(session.userID);
+    // Start cursor of every page shown so far, as in StaffModule
+    std::vector<StorageEngine::AppointmentCursor> pageStarts(1);
+    StorageEngine::AppointmentSummary counts = db.getDoctorAppointmentSummary(session.userID);
     
-    if (appointments.empty()) {
-        console.printInfo("You have no appointments.");
-        console.pauseScreen();
-        return;
-    }
-    
-    console.setColor(WHITE);
-    std::cout << "\n  Showing all your appointments (past and future).\n" << std::endl;
-    console.resetColor();
-    
-    console.setColor(DARK_CYAN);
-    std::cout << "  " << std::left 
-              << std::setw(6) << "ID"
-              << std::setw(18) << "Patient"
-              << std::setw(12) << "Date"
-              << std::setw(8) << "Time"
-              << std::setw(8) << "Cost"
-              << std::setw(11) << "Status" << std::endl;
-    std::cout << "  " << std::string(63, '-') << std::endl;
-    console.resetColor();
-    
-    double totalEarnings = 0.0;
-    for (const auto& apt : appointments) {
-        if (apt.status == "Confirmed") console.setColor(GREEN);
-        else if (apt.status == "Pending") console.setColor(YELLOW);
-        else if (apt.status == "Completed") { console.setColor(CYAN); totalEarnings += apt.totalCost; }
-        else if (apt.status == "Cancelled") console.setColor(RED);
-        else console.resetColor();
+    while (true) {
+        console.clearScreen();
+        console.printHeader("ALL MY APPOINTMENTS");
         
-        std::string patientName = apt.patientName.length() > 16 ? 
-            apt.patientName.substr(0, 13) + "..." : apt.patientName;
+        StorageEngine::AppointmentPage page = db.getDoctorAppointmentsPage(session.userID, pageStarts.back(), pageSize);
         
-        std::cout << "  " << std::setw(6) << apt.appointmentID
-                  << std::setw(18) << patientName
-                  << std::setw(12) << apt.appointmentDate
-                  << std::setw(8) << apt.appointmentTime.substr(0, 5)
-                  << std::setw(8) << ("RM" + std::to_string((int)apt.totalCost))
-                  << std::setw(11) << apt.status << std::endl;
+        if (page.appointments.empty() && pageStarts.size() == 1) {
+            console.printInfo("You have no appointments.");
+            console.pauseScreen();
+            return;
+        }
+        
+        console.setColor(WHITE);
+        std::cout << "\n  Page " << pageStarts.size() << " - all your appointments (past and future), newest first.\n" << std::endl;
+        console.resetColor();
+        
+        console.setColor(DARK_CYAN);
+        std::cout << "  " << std::left 
+                  << std::setw(6) << "ID"
+                  << std::setw(18) << "Patient"
+                  << std::setw(12) << "Date"
+                  << std::setw(8) << "Time"
+                  << std::setw(8) << "Cost"
+                  << std::setw(11) << "Status" << std::endl;
+        std::cout << "  " << std::string(63, '-') << std::endl;
+        console.resetColor();
+        
+        for (const auto& apt : page.appointments) {
+            if (apt.status == AppointmentStatus::Confirmed) console.setColor(GREEN);
+            else if (apt.status == AppointmentStatus::Pending) console.setColor(YELLOW);
+            else if (apt.status == AppointmentStatus::Completed) console.setColor(CYAN);
+            else if (apt.status == AppointmentStatus::Cancelled) console.setColor(RED);
+            else console.resetColor();
+            
+            std::string patientName = apt.patientName.length() > 16 ? 
+                apt.patientName.substr(0, 13) + "..." : apt.patientName;
+            
+            std::cout << "  " << std::setw(6) << apt.appointmentID
+                      << std::setw(18) << patientName
+                      << std::setw(12) << apt.appointmentDate
+                      << std::setw(8) << apt.appointmentTime.shortString()
+                      << std::setw(8) << ("RM" + std::to_string((int)apt.totalCost))
+                      << std::setw(11) << apt.status << std::endl;
+        }
+        console.resetColor();
+        
+        // Totals cover every appointment of this doctor, not just this page
+        std::cout << "\n  Total: " << counts.total << " appointment(s)";
+        console.setColor(CYAN);
+        std::cout << "  |  Total Earnings: RM " << std::fixed << std::setprecision(2) << counts.completedRevenue;
+        console.resetColor();
+        std::cout << std::endl;
+        
+        std::cout << std::endl;
+        console.setColor(YELLOW);
+        std::cout << "  >> ";
+        if (page.hasMore) std::cout << "[N] Next page  ";
+        if (pageStarts.size() > 1) std::cout << "[P] Previous page  ";
+        std::cout << "[0] Back" << std::endl;
+        console.resetColor();
+        std::string choice = console.getStringInput("     Choice: ");
+        
+        if ((choice == "N" || choice == "n") && page.hasMore) {
+            pageStarts.push_back(page.next);
+        } else if ((choice == "P" || choice == "p") && pageStarts.size() > 1) {
+            pageStarts.pop_back();
+        } else if (choice == "0") {
+            return;
+        } else {
+            console.printError("Invalid choice!");
+            Sleep(800);
+        }
     }
-    console.resetColor();
-    
-    std::cout << "\n  Total: " << appointments.size() << " appointment(s)";
-    console.setColor(CYAN);
-    std::cout << "  |  Total Earnings: RM " << std::fixed << std::setprecision(2) << totalEarnings;
-    console.resetColor();
-    std::cout << std::endl;
-    
-    console.pauseScreen();
 }
 
 void DoctorModule::completeAppointment() {
     console.clearScreen();
     console.printHeader("COMPLETE APPOINTMENT");
     
-    std::string today = getCurrentDate();
+    Date today = Date::today();
     std::vector<Appointment> appointments = db.getDoctorAppointments(session.userID, today);
     
     std::vector<Appointment> confirmed;
     for (const auto& apt : appointments) {
-        if (apt.status == "Confirmed") {
+        if (apt.status == AppointmentStatus::Confirmed) {
             confirmed.push_back(apt);
         }
     }
@@ -177,7 +220,7 @@ void DoctorModule::completeAppointment() {
         std::cout << "  " << std::setw(5) << (i + 1)
                   << std::setw(8) << confirmed[i].appointmentID
                   << std::setw(25) << confirmed[i].patientName
-                  << std::setw(10) << confirmed[i].appointmentTime.substr(0, 5) << std::endl;
+                  << std::setw(10) << confirmed[i].appointmentTime.shortString() << std::endl;
     }
     
     std::cout << std::endl;
@@ -192,7 +235,7 @@ void DoctorModule::completeAppointment() {
     std::cout << "\n  APPOINTMENT TO COMPLETE:" << std::endl;
     std::cout << "  +-----------------------------------+" << std::endl;
     std::cout << "  | Patient : " << std::left << std::setw(24) << confirmed[choice - 1].patientName << "|" << std::endl;
-    std::cout << "  | Time    : " << std::left << std::setw(24) << confirmed[choice - 1].appointmentTime.substr(0, 5) << "|" << std::endl;
+    std::cout << "  | Time    : " << std::left << std::setw(24) << confirmed[choice - 1].appointmentTime.shortString() << "|" << std::endl;
     std::cout << "  +-----------------------------------+" << std::endl;
     console.resetColor();
     
@@ -204,7 +247,8 @@ void DoctorModule::completeAppointment() {
     std::string confirm = console.getStringInput("     Type Y to confirm, N to go back: ");
     
     if (confirm == "Y" || confirm == "y") {
-        if (db.updateAppointmentStatus(confirmed[choice - 1].appointmentID, "Completed")) {
+        if (db.updateAppointmentStatus(confirmed[choice - 1].appointmentID, AppointmentStatus::Confirmed,
+                                   AppointmentStatus::Completed)) {
             console.printSuccess("Appointment marked as COMPLETED!");
             db.logActivity("Doctor", session.userID, "Complete Appointment",
                           "ID: " + std::to_string(confirmed[choice - 1].appointmentID));
@@ -222,21 +266,16 @@ void DoctorModule::viewPatientInfo() {
     console.clearScreen();
     console.printHeader("VIEW PATIENT INFORMATION");
     
-    std::vector<Appointment> appointments = db.getDoctorAllAppointments(session.userID);
-    
+    // Read a page at a time; only the distinct patients are kept
     std::vector<int> patientIDs;
     std::vector<std::string> patientNames;
-    
-    for (const auto& apt : appointments) {
-        bool found = false;
-        for (int id : patientIDs) {
-            if (id == apt.patientID) { found = true; break; }
-        }
-        if (!found) {
+    std::unordered_set<int> seen;
+    forEachAppointment(db, session.userID, [&](const Appointment& apt) {
+        if (seen.insert(apt.patientID).second) {
             patientIDs.push_back(apt.patientID);
             patientNames.push_back(apt.patientName);
         }
-    }
+    });
     
     if (patientIDs.empty()) {
         console.printInfo("No patients found.");
@@ -292,11 +331,11 @@ void DoctorModule::viewPatientInfo() {
     
     // Get appointments for this patient with this doctor
     std::vector<Appointment> patientAppointments;
-    for (const auto& apt : appointments) {
+    forEachAppointment(db, session.userID, [&](const Appointment& apt) {
         if (apt.patientID == p.patientID) {
             patientAppointments.push_back(apt);
         }
-    }
+    });
     
     // Display appointment history
     if (!patientAppointments.empty()) {
@@ -319,10 +358,10 @@ void DoctorModule::viewPatientInfo() {
             std::cout << "  Status        : ";
             console.resetColor();
             
-            if (apt.status == "Completed") console.setColor(GREEN);
-            else if (apt.status == "Confirmed") console.setColor(CYAN);
-            else if (apt.status == "Pending") console.setColor(YELLOW);
-            else if (apt.status == "Cancelled") console.setColor(RED);
+            if (apt.status == AppointmentStatus::Completed) console.setColor(GREEN);
+            else if (apt.status == AppointmentStatus::Confirmed) console.setColor(CYAN);
+            else if (apt.status == AppointmentStatus::Pending) console.setColor(YELLOW);
+            else if (apt.status == AppointmentStatus::Cancelled) console.setColor(RED);
             std::cout << apt.status << std::endl;
             console.resetColor();
             
@@ -0,0 +1,295 @@
+// ============================================================
+// DoctorSlotIndex.cpp - In-Memory Doctor Slot Availability Bitmaps
+// Hospital Appointment Booking System
+// ============================================================
+
+#include "../include/DoctorSlotIndex.h"
+#include <algorithm>
+
+namespace {
+    double elapsedMs(DoctorSlotIndex::Clock::time_point since) {
+        return std::chrono::duration<double, std::milli>(DoctorSlotIndex::Clock::now() - since).count();
+    }
+
+    uint64_t dayKey(int doctorID, int day) {
+        return (uint64_t(uint32_t(doctorID)) << 32) | uint32_t(day);
+    }
+
+    // Every quarter moved one place earlier: bit q takes bit q + 1
+    DoctorSlotIndex::DayMask shiftDown(const DoctorSlotIndex::DayMask& mask) {
+        DoctorSlotIndex::DayMask shifted;
+        shifted.words[0] = (mask.words[0] >> 1) | (mask.words[1] << 63);
+        shifted.words[1] = mask.words[1] >> 1;
+        return shifted;
+    }
+
+    // Lowest set quarter, or -1
+    int firstQuarter(const DoctorSlotIndex::DayMask& mask) {
+        for (int w = 0; w < 2; w++) {
+            uint64_t bits = mask.words[w];
+            if (bits == 0) continue;
+            int bit = 0;
+            while ((bits & 0xFFFF) == 0) { bits >>= 16; bit += 16; }
+            while ((bits & 1) == 0) { bits >>= 1; bit++; }
+            return w * 64 + bit;
+        }
+        return -1;
+    }
+
+    // A doctor's remaining starts on the day being searched; the heap in
+    // findFree() keeps the earliest (then lowest doctor position) on top
+    struct Candidate {
+        int quarter;
+        size_t doctor;
+        DoctorSlotIndex::DayMask starts;
+    };
+
+    bool laterCandidate(const Candidate& a, const Candidate& b) {
+        return a.quarter != b.quarter ? a.quarter > b.quarter : a.doctor > b.doctor;
+    }
+}
+
+struct DoctorSlotIndex::Table {
+    struct Day {
+        DayMask busy;                                     // OR of the masks below
+        std::vector<std::pair<int, DayMask>> appointments; // (AppointmentID, mask)
+    };
+
+    int firstDay;
+    std::unordered_map<uint64_t, Day> days;
+    std::unordered_map<int, uint64_t> dayOf; // AppointmentID -> days key
+    size_t bookings;
+
+    Table() : firstDay(0), bookings(0) {}
+
+    void add(int appointmentID, int doctorID, int day, const DayMask& mask) {
+        remove(appointmentID);
+        uint64_t key = dayKey(doctorID, day);
+        Day& entry = days[key];
+        entry.appointments.push_back(std::make_pair(appointmentID, mask));
+        entry.busy.words[0] |= mask.words[0];
+        entry.busy.words[1] |= mask.words[1];
+        dayOf[appointmentID] = key;
+        bookings++;
+    }
+
+    void remove(int appointmentID) {
+        std::unordered_map<int, uint64_t>::iterator held = dayOf.find(appointmentID);
+        if (held == dayOf.end()) return;
+        std::unordered_map<uint64_t, Day>::iterator day = days.find(held->second);
+        dayOf.erase(held);
+        bookings--;
+        if (day == days.end()) return;
+
+        // Appointments may share a quarter (off-grid times), so rebuild the
+        // union rather than clearing this one's bits
+        Day& entry = day->second;
+        entry.busy = DayMask();
+        for (size_t i = 0; i < entry.appointments.size(); ) {
+            if (entry.appointments[i].first == appointmentID) {
+                entry.appointments.erase(entry.appointments.begin() + i);
+                continue;
+            }
+            entry.busy.words[0] |= entry.appointments[i].second.words[0];
+            entry.busy.words[1] |= entry.appointments[i].second.words[1];
+            i++;
+        }
+        if (entry.appointments.empty()) days.erase(day);
+    }
+};
+
+DoctorSlotIndex::DoctorSlotIndex(Loader l, const Config& c)
+    : loader(std::move(l)), config(c), version(0) {}
+
+DoctorSlotIndex::~DoctorSlotIndex() {}
+
+std::optional<bool> DoctorSlotIndex::isFree(int doctorID, const Date& date, const TimeOfDay& time, int duration) {
+    if (!date.isValid() || !time.isValid()) return std::nullopt;
+    int day = date.dayNumber();
+    int minute = time.minuteOfDay();
+    ensureLoaded();
+
+    std::lock_guard<std::mutex> lock(mtx);
+    if (!table || day < table->firstDay) {
+        stats.outsideWindow++;
+        return std::nullopt;
+    }
+    stats.checks++;
+    std::unordered_map<uint64_t, Table::Day>::const_iterator it = table->days.find(dayKey(doctorID, day));
+    if (it == table->days.end()) return true;
+    if (it->second.busy.overlaps(intervalMask(minute, duration))) {
+        stats.conflicts++;
+        return false;
+    }
+    return true;
+}
+
+std::optional<std::vector<DoctorSlotIndex::FreeSlot>> DoctorSlotIndex::findFree(const SlotSearch& search) {
+    if (!search.fromDate.isValid() || search.duration <= 0) return std::nullopt;
+    int firstDay = search.fromDate.dayNumber();
+    ensureLoaded();
+
+    std::lock_guard<std::mutex> lock(mtx);
+    if (!table || firstDay < table->firstDay) {
+        stats.outsideWindow++;
+        return std::nullopt;
+    }
+
+    // Quarters a start may use: inside opening hours, with room to finish by closing
+    int quarters = (search.duration + SLOT_MINUTES - 1) / SLOT_MINUTES;
+    int firstStart = (search.openMinute + SLOT_MINUTES - 1) / SLOT_MINUTES;
+    int lastStart = search.closeMinute / SLOT_MINUTES - quarters;
+    DayMask opening = lastStart >= firstStart ? intervalMask(firstStart * SLOT_MINUTES, (lastStart - firstStart + 1) * SLOT_MINUTES)
+                                              : DayMask();
+    DayMask firstDayOpening = opening;
+    int earliest = (search.notBeforeMinute + SLOT_MINUTES - 1) / SLOT_MINUTES;
+    if (earliest > 0) {
+        DayMask past = intervalMask(0, earliest * SLOT_MINUTES);
+        firstDayOpening.words[0] &= ~past.words[0];
+        firstDayOpening.words[1] &= ~past.words[1];
+    }
+
+    std::vector<FreeSlot> slots;
+    std::vector<Candidate> heap;
+    for (int day = firstDay; day < firstDay + search.days && slots.size() < search.count; day++) {
+        const DayMask& allowed = day == firstDay ? firstDayOpening : opening;
+        heap.clear();
+        for (size_t d = 0; d < search.doctorIDs.size(); d++) {
+            DayMask free;
+            free.words[0] = ~uint64_t(0);
+            free.words[1] = ~uint64_t(0);
+            std::unordered_map<uint64_t, Table::Day>::const_iterator it = table->days.find(dayKey(search.doctorIDs[d], day));
+            if (it != table->days.end()) {
+                free.words[0] = ~it->second.busy.words[0];
+                free.words[1] = ~it->second.busy.words[1];
+            }
+            // A start fits when it and the next quarters - 1 quarters are all free
+            DayMask fits = free;
+            DayMask ahead = free;
+            for (int k = 1; k < quarters; k++) {
+                ahead = shiftDown(ahead);
+                fits.words[0] &= ahead.words[0];
+                fits.words[1] &= ahead.words[1];
+            }
+            fits.words[0] &= allowed.words[0];
+            fits.words[1] &= allowed.words[1];
+            int quarter = firstQuarter(fits);
+            if (quarter >= 0) heap.push_back(Candidate{ quarter, d, fits });
+        }
+        
+        // Only the starts actually returned are taken off the heap, so a
+        // wide specialty costs one mask per doctor, not one entry per start
+        std::make_heap(heap.begin(), heap.end(), laterCandidate);
+        while (!heap.empty() && slots.size() < search.count) {
+            std::pop_heap(heap.begin(), heap.end(), laterCandidate);
+            Candidate& next = heap.back();
+            FreeSlot slot;
+            slot.doctorID = search.doctorIDs[next.doctor];
+            slot.date = Date::fromDayNumber(day);
+            slot.time = TimeOfDay::fromMinutes(next.quarter * SLOT_MINUTES);
+            slots.push_back(slot);
+            
+            next.starts.words[next.quarter >> 6] &= ~(uint64_t(1) << (next.quarter & 63));
+            next.quarter = firstQuarter(next.starts);
+            if (next.quarter < 0) {
+                heap.pop_back();
+            } else {
+                std::push_heap(heap.begin(), heap.end(), laterCandidate);
+            }
+        }
+    }
+
+    stats.searches++;
+    return slots;
+}
+
+void DoctorSlotIndex::add(const Booking& booking) {
+    std::lock_guard<std::mutex> lock(mtx);
+    version++;
+    stats.adds++;
+    if (!table) return;
+    if (!booking.date.isValid() || !booking.time.isValid()) {
+        table.reset(); // Cannot place it; reload rather than miss it
+        return;
+    }
+    if (booking.date.dayNumber() >= table->firstDay) {
+        table->add(booking.appointmentID, booking.doctorID, booking.date.dayNumber(),
+                   intervalMask(booking.time.minuteOfDay(), booking.duration));
+    }
+}
+
+void DoctorSlotIndex::remove(int appointmentID) {
+    std::lock_guard<std::mutex> lock(mtx);
+    version++;
+    stats.removals++;
+    if (table) table->remove(appointmentID);
+}
+
+void DoctorSlotIndex::invalidate() {
+    std::lock_guard<std::mutex> lock(mtx);
+    version++;
+    table.reset();
+}
+
+DoctorSlotIndex::Stats DoctorSlotIndex::getStats() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    Stats snapshot = stats;
+    if (table) {
+        snapshot.doctorDays = table->days.size();
+        snapshot.bookings = table->bookings;
+    }
+    return snapshot;
+}
+
+DoctorSlotIndex::DayMask DoctorSlotIndex::intervalMask(int minute, int duration) {
+    DayMask mask;
+    int first = minute / SLOT_MINUTES;
+    int last = (minute + (std::max)(duration, 1) - 1) / SLOT_MINUTES;
+    if (last >= SLOTS_PER_DAY) last = SLOTS_PER_DAY - 1;
+    for (int w = 0; w < 2; w++) {
+        int low = (std::max)(first, w * 64);
+        int high = (std::min)(last, w * 64 + 63);
+        if (low > high) continue;
+        int width = high - low + 1;
+        uint64_t bits = width == 64 ? ~uint64_t(0) : ((uint64_t(1) << width) - 1);
+        mask.words[w] |= bits << (low - w * 64);
+    }
+    return mask;
+}
+
+void DoctorSlotIndex::ensureLoaded() {
+    unsigned long long loadVersion;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (table && Clock::now() - loadedAt >= config.ttl) {
+            table.reset();
+            stats.expirations++;
+        }
+        if (table) return;
+        loadVersion = version;
+    }
+
+    // The query runs without the lock; concurrent misses may each load
+    Clock::time_point start = Clock::now();
+    Load load = loader();
+    std::unique_ptr<Table> fresh(new Table());
+    fresh->firstDay = load.fromDate.dayNumber();
+    for (const Booking& booking : load.bookings) {
+        if (booking.date.isValid() && booking.date.dayNumber() >= fresh->firstDay && booking.time.isValid()) {
+            fresh->add(booking.appointmentID, booking.doctorID, booking.date.dayNumber(),
+                       intervalMask(booking.time.minuteOfDay(), booking.duration));
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mtx);
+    stats.loads++;
+    stats.lastLoadMs = elapsedMs(start);
+    if (!load.fromDate.isValid()) return; // Unusable date from the loader; callers fall back
+    if (version == loadVersion) {
+        table = std::move(fresh);
+        loadedAt = Clock::now();
+    } else {
+        // A write landed mid-load; the next check loads again
+        stats.discardedLoads++;
+    }
+}
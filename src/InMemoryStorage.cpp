@@ -0,0 +1,1537 @@
+// ============================================================
+// InMemoryStorage.cpp - In-Process Storage Engine (No Database)
+// Hospital Appointment Booking System
+// ============================================================
+
+#include "../include/InMemoryStorage.h"
+#include "../include/MedicineFeeMatcher.h"
+#include "../include/Utilities.h"
+#include <iostream>
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <stdexcept>
+
+namespace {
+    const size_t REASON_MAX_LENGTH = 100;  // Appointment.Reason is VARCHAR(100)
+    const size_t PATIENT_SUGGEST_LIMIT = 100;
+    const size_t STREAM_BATCH = 1024;      // Rows copied per lock by streamAppointmentsByDateRange
+    const int COPY_PAGE = 1000;            // Patients per page read by copyFrom
+
+    void reportError(const std::string& message) {
+        std::cerr << "[ERROR] " << message << std::endl;
+    }
+
+    std::string lowered(const std::string& text) {
+        std::string lower = text;
+        for (char& c : lower) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        return lower;
+    }
+
+    int compareIgnoringCase(const std::string& a, const std::string& b) {
+        size_t common = (std::min)(a.size(), b.size());
+        for (size_t i = 0; i < common; i++) {
+            int x = std::tolower(static_cast<unsigned char>(a[i]));
+            int y = std::tolower(static_cast<unsigned char>(b[i]));
+            if (x != y) return x < y ? -1 : 1;
+        }
+        return a.size() == b.size() ? 0 : (a.size() < b.size() ? -1 : 1);
+    }
+
+    // DECIMAL(10,2) columns keep whole cents
+    double cents(double amount) {
+        return std::round(amount * 100.0) / 100.0;
+    }
+
+    int& idOf(Patient& patient) { return patient.patientID; }
+    int& idOf(Doctor& doctor) { return doctor.doctorID; }
+    int& idOf(Staff& member) { return member.staffID; }
+    int& idOf(Admin& admin) { return admin.adminID; }
+
+    // INSERT into an account table: the UNIQUE Email and PhoneNumber keys,
+    // then AUTO_INCREMENT unless the model already carries an ID
+    template <typename Table, typename Model>
+    std::optional<int> insertAccount(Table& table, Model model, const std::string& password) {
+        std::string email = lowered(model.email);
+        if (table.emails.count(email)) {
+            reportError("Duplicate entry '" + model.email + "' for key 'Email'");
+            return std::nullopt;
+        }
+        if (table.phones.count(model.phoneNumber)) {
+            reportError("Duplicate entry '" + model.phoneNumber + "' for key 'PhoneNumber'");
+            return std::nullopt;
+        }
+        int& id = idOf(model);
+        if (id <= 0) {
+            id = ++table.lastID;
+        } else if (table.rows.count(id)) {
+            reportError("Duplicate entry '" + std::to_string(id) + "' for key 'PRIMARY'");
+            return std::nullopt;
+        } else {
+            table.lastID = (std::max)(table.lastID, id);
+        }
+        table.emails[email] = id;
+        table.phones[model.phoneNumber] = id;
+        table.passwords[id] = password;
+        table.rows[id] = model;
+        return id;
+    }
+
+    // New Email and PhoneNumber for an existing account, checked against the others
+    template <typename Table>
+    bool rekeyAccount(Table& table, int id, const std::string& email, const std::string& phone) {
+        auto& row = table.rows.at(id);
+        std::string key = lowered(email);
+        auto sameEmail = table.emails.find(key);
+        if (sameEmail != table.emails.end() && sameEmail->second != id) {
+            reportError("Duplicate entry '" + email + "' for key 'Email'");
+            return false;
+        }
+        auto samePhone = table.phones.find(phone);
+        if (samePhone != table.phones.end() && samePhone->second != id) {
+            reportError("Duplicate entry '" + phone + "' for key 'PhoneNumber'");
+            return false;
+        }
+        table.emails.erase(lowered(row.email));
+        table.phones.erase(row.phoneNumber);
+        table.emails[key] = id;
+        table.phones[phone] = id;
+        row.email = email;
+        row.phoneNumber = phone;
+        return true;
+    }
+
+    template <typename Table>
+    void eraseAccount(Table& table, int id) {
+        auto row = table.rows.find(id);
+        if (row == table.rows.end()) return;
+        table.emails.erase(lowered(row->second.email));
+        table.phones.erase(row->second.phoneNumber);
+        table.passwords.erase(id);
+        table.rows.erase(row);
+    }
+
+    template <typename Table>
+    void plaintextPasswords(const Table& table, std::vector<std::pair<int, std::string>>& rows) {
+        for (const auto& password : table.passwords) {
+            if (!password.second.empty() && !PasswordHasher::isHash(password.second)) {
+                rows.push_back(password);
+            }
+        }
+    }
+
+    // Replace stored with upgraded unless the password changed in the meantime
+    template <typename Table>
+    int replacePassword(Table& table, int id, const std::string& stored, const std::string& upgraded) {
+        auto password = table.passwords.find(id);
+        if (password == table.passwords.end() || password->second != stored) return 0;
+        password->second = upgraded;
+        return 1;
+    }
+
+    // Entries of a (day, minute, ID) index dated firstDay..lastDay; none
+    // when the range is reversed, as BETWEEN gives in MySQL
+    template <typename Index>
+    std::pair<typename Index::const_iterator, typename Index::const_iterator> daysOf(const Index& index, int firstDay,
+                                                                                   int lastDay) {
+        if (firstDay > lastDay) return std::make_pair(index.end(), index.end());
+        const int lowest = (std::numeric_limits<int>::min)();
+        const int highest = (std::numeric_limits<int>::max)();
+        typename Index::key_type from = { firstDay, lowest, lowest };
+        typename Index::key_type to = { lastDay, highest, highest };
+        return std::make_pair(index.lower_bound(from), index.upper_bound(to));
+    }
+
+    // From (date, time) order to the listings' date DESC, time ASC
+    void newestDayFirst(std::vector<Appointment>& rows) {
+        std::stable_sort(rows.begin(), rows.end(), [](const Appointment& a, const Appointment& b) {
+            return a.appointmentDate > b.appointmentDate;
+        });
+    }
+
+    DoctorSlotIndex::Booking bookingOf(const Appointment& appointment) {
+        DoctorSlotIndex::Booking booking;
+        booking.appointmentID = appointment.appointmentID;
+        booking.doctorID = appointment.doctorID;
+        booking.date = appointment.appointmentDate;
+        booking.time = appointment.appointmentTime;
+        booking.duration = appointment.duration;
+        return booking;
+    }
+
+    void tally(StorageEngine::AppointmentSummary& summary, const Appointment& appointment) {
+        switch (appointment.status.code()) {
+        case AppointmentStatus::Pending:
+            summary.pending++;
+            summary.potentialRevenue += appointment.totalCost;
+            break;
+        case AppointmentStatus::Confirmed:
+            summary.confirmed++;
+            summary.potentialRevenue += appointment.totalCost;
+            break;
+        case AppointmentStatus::Completed:
+            summary.completed++;
+            summary.completedRevenue += appointment.totalCost;
+            summary.completedConsultation += appointment.consultationFee;
+            summary.completedMedicine += appointment.medicineFee;
+            break;
+        case AppointmentStatus::Cancelled:
+            summary.cancelled++;
+            break;
+        }
+        summary.total++;
+    }
+
+    int today() {
+        return Date::today().dayNumber();
+    }
+}
+
+bool InMemoryStorage::PatientNameOrder::operator()(const std::pair<std::string, int>& a,
+                                                   const std::pair<std::string, int>& b) const {
+    int order = compareIgnoringCase(a.first, b.first);
+    return order != 0 ? order < 0 : a.second < b.second;
+}
+
+InMemoryStorage::InMemoryStorage()
+    : lastAppointmentID(0), isConnected(false),
+      patientIndex([this]() { return loadPatientSearchEntries(); }, PatientSearchIndex::Config()),
+      slotIndex([this]() { return loadActiveBookings(); }, DoctorSlotIndex::Config()) {}
+
+InMemoryStorage::~InMemoryStorage() {
+    disconnect();
+}
+
+void InMemoryStorage::clear() {
+    patients = AccountTable<Patient>();
+    doctors = AccountTable<Doctor>();
+    staff = AccountTable<Staff>();
+    admins = AccountTable<Admin>();
+    patientsByName.clear();
+    appointments.clear();
+    appointmentsByDate.clear();
+    appointmentsByDoctor.clear();
+    appointmentsByPatient.clear();
+    appointmentColumns.clear();
+    columnRows.clear();
+    lastAppointmentID = 0;
+    activityLog.clear();
+}
+
+void InMemoryStorage::seedDemoData() {
+    const Admin adminRows[] = {
+        { 0, "System Admin", "0123456789", "admin@hospital.com" }
+    };
+    const Doctor doctorRows[] = {
+        { 0, "Dr. Noor Aini", "Cardiology", "0111111111", "noor@hospital.com", "R101", true },
+        { 0, "Dr. Ahmad Razak", "Pediatrics", "0122222222", "ahmad@hospital.com", "R102", true },
+        { 0, "Dr. Siti Rahmah", "Dermatology", "0133333333", "siti@hospital.com", "R103", true },
+        { 0, "Dr. Lim Wei Keat", "Orthopedics", "0144444444", "lim@hospital.com", "R104", true }
+    };
+    const Staff staffRows[] = {
+        { 0, "Sarah Ibrahim", "Reception", "0155555555", "sarah@hospital.com" },
+        { 0, "Muthu Kumar", "Nurse", "0166666666", "muthu@hospital.com" }
+    };
+    const Patient patientRows[] = {
+        { 0, "Muhammad Hafiz", "0199999999", "hafiz@email.com", "789 Jalan Sejahtera, Shah Alam", "2000-03-10", "Male" },
+        { 0, "ADAM QUSSYAIRI BIN YUSOFF", "0195114255", "adam@gmail.com", "No 49 durian tunggal", "2005-09-19", "Male" },
+        { 0, "Siti Khadijah", "0188888888", "khadijah@email.com", "456 Jalan Damai, PJ", "1988-12-20", "Female" },
+        { 0, "Ahmad Fauzi", "0177777777", "fauzi@email.com", "123 Jalan Merdeka, KL", "1995-05-15", "Male" },
+        { 0, "Nurul Aina", "0166666666", "aina@email.com", "321 Jalan Bahagia, Melaka", "1992-08-25", "Female" }
+    };
+    const char* const patientPasswords[] = { "patient123", "adam0113", "patient123", "patient123", "patient123" };
+    struct SampleAppointment {
+        AppointmentStatus::Code status;
+        const char* time;
+        int dayOffset; // From today
+        const char* reason;
+        int duration;
+        double consultationFee;
+        double medicineFee;
+        int patientID;
+        int doctorID;
+        int staffID;
+    };
+    const SampleAppointment appointmentRows[] = {
+        { AppointmentStatus::Confirmed, "10:30:00", 0, "Fever and cough", 30, 30.00, 25.00, 1, 1, 1 },
+        { AppointmentStatus::Pending, "11:00:00", 1, "Regular checkup", 15, 15.00, 0.00, 2, 1, 0 },
+        { AppointmentStatus::Completed, "14:00:00", -1, "Skin rash", 45, 45.00, 35.00, 3, 3, 1 },
+        { AppointmentStatus::Confirmed, "09:00:00", 2, "Back pain", 60, 60.00, 40.00, 4, 4, 1 },
+        { AppointmentStatus::Pending, "15:30:00", 3, "Follow-up", 30, 30.00, 0.00, 5, 2, 0 },
+        { AppointmentStatus::Cancelled, "10:00:00", -2, "Cancelled appointment", 15, 15.00, 0.00, 1, 2, 1 }
+    };
+    const char* const logRows[][3] = {
+        { "Admin", "Login", "Successful login" },
+        { "Patient", "Registration", "New patient registered" },
+        { "Patient", "Login", "Successful login" },
+        { "Doctor", "Login", "Successful login" },
+        { "Staff", "Login", "Successful login" },
+        { "Staff", "Approve Appointment", "ID: 1" }
+    };
+
+    int day = today();
+    std::string now = getCurrentDate() + " " + getCurrentTime();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        clear();
+        for (const Admin& admin : adminRows) insertAccount(admins, admin, "admin123");
+        for (const Doctor& doctor : doctorRows) insertAccount(doctors, doctor, "doc123");
+        for (const Staff& member : staffRows) insertAccount(staff, member, "staff123");
+        for (size_t i = 0; i < sizeof(patientRows) / sizeof(patientRows[0]); i++) {
+            std::optional<int> id = insertAccount(patients, patientRows[i], patientPasswords[i]);
+            if (id) patientsByName.insert(std::make_pair(patientRows[i].patientName, *id));
+        }
+        for (const SampleAppointment& row : appointmentRows) {
+            Appointment appointment;
+            appointment.status = row.status;
+            appointment.appointmentTime = TimeOfDay::parse(row.time);
+            appointment.appointmentDate = Date::fromDayNumber(day + row.dayOffset);
+            appointment.reason = row.reason;
+            appointment.duration = row.duration;
+            appointment.consultationFee = row.consultationFee;
+            appointment.medicineFee = row.medicineFee;
+            appointment.totalCost = row.consultationFee + row.medicineFee;
+            appointment.patientID = row.patientID;
+            appointment.doctorID = row.doctorID;
+            appointment.staffID = row.staffID;
+            storeAppointment(appointment);
+        }
+        for (const auto& row : logRows) {
+            ActivityLog log;
+            log.logID = static_cast<int>(activityLog.size()) + 1;
+            log.userType = row[0];
+            log.userID = 1;
+            log.action = row[1];
+            log.details = row[2];
+            log.timestamp = now;
+            activityLog.push_back(log);
+        }
+    }
+    patientIndex.invalidate();
+    slotIndex.invalidate();
+}
+
+bool InMemoryStorage::copyFrom(StorageEngine& source) {
+    std::vector<Doctor> doctorRows = source.getAllDoctors(false);
+    std::vector<Staff> staffRows = source.getAllStaff();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        clear();
+        for (const Doctor& doctor : doctorRows) insertAccount(doctors, doctor, std::string());
+        for (const Staff& member : staffRows) insertAccount(staff, member, std::string());
+    }
+
+    PatientCursor cursor;
+    while (true) {
+        PatientPage page = source.getPatientsPage(cursor, COPY_PAGE);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (const Patient& patient : page.patients) {
+                if (insertAccount(patients, patient, std::string())) {
+                    patientsByName.insert(std::make_pair(patient.patientName, patient.patientID));
+                }
+            }
+        }
+        if (!page.hasMore) break;
+        cursor = page.next;
+    }
+
+    long long copied = source.streamAppointmentsByDateRange(Date::fromCivil(1000, 1, 1), Date::fromCivil(9999, 12, 31),
+                                                            [this](const Appointment& appointment) {
+        std::lock_guard<std::mutex> lock(mutex);
+        storeAppointment(appointment);
+        return true;
+    });
+    patientIndex.invalidate();
+    slotIndex.invalidate();
+    return copied >= 0;
+}
+
+// ============================================================
+// Connection
+// ============================================================
+
+bool InMemoryStorage::connect() {
+    if (!passwordVerifier) {
+        passwordVerifier.reset(new PasswordVerifier(passwordConfig));
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    isConnected = true;
+    return true;
+}
+
+void InMemoryStorage::disconnect() {
+    if (passwordVerifier) {
+        passwordVerifier->stop();
+        passwordVerifier.reset();
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    isConnected = false;
+}
+
+bool InMemoryStorage::checkConnection() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (isConnected) return true;
+    }
+    return connect();
+}
+
+ConnectionPoolStats InMemoryStorage::getPoolStats() const {
+    return ConnectionPoolStats();
+}
+
+// ============================================================
+// Authentication
+// ============================================================
+
+template <typename Model>
+InMemoryStorage::PendingLogin<Model> InMemoryStorage::beginLogin(AccountTable<Model>& table, const char* tableName,
+                                                                 const char* idColumn, const std::string& email,
+                                                                 const std::string& pwd) {
+    if (!passwordVerifier) {
+        reportError("Not connected to database");
+        return PendingLogin<Model>();
+    }
+    int id = 0;
+    Model model;
+    std::string stored;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto account = table.emails.find(lowered(email));
+        if (account == table.emails.end()) return PendingLogin<Model>();
+        id = account->second;
+        model = table.rows.at(id);
+        stored = table.passwords[id];
+    }
+    if (stored.empty()) return PendingLogin<Model>(); // Copied without its password
+    return pendingLogin(tableName, idColumn, id, model, pwd, stored, passwordVerifier->verify(pwd, stored));
+}
+
+bool InMemoryStorage::finishLogin(const char* table, const char* /*idColumn*/, int id, const std::string& pwd,
+                                  const std::string& stored, std::future<bool>& verdict) {
+    try {
+        if (!verdict.valid() || !verdict.get()) {
+            return false;
+        }
+    }
+    catch (std::exception& e) {
+        std::cerr << "[ERROR] Password check failed: " << e.what() << std::endl;
+        return false;
+    }
+
+    // Same upgrade as DatabaseManager: plaintext and older-cost hashes are
+    // rehashed on their first good login
+    if (PasswordHasher::needsRehash(stored, passwordCost)) {
+        try {
+            std::string upgraded = hashPassword(pwd);
+            std::string name = table;
+            std::lock_guard<std::mutex> lock(mutex);
+            if (name == "Patient") replacePassword(patients, id, stored, upgraded);
+            else if (name == "Doctors") replacePassword(doctors, id, stored, upgraded);
+            else if (name == "Staff") replacePassword(staff, id, stored, upgraded);
+            else if (name == "Admin") replacePassword(admins, id, stored, upgraded);
+        }
+        catch (std::exception& e) {
+            // The login itself stands; the upgrade is retried next time
+            std::cerr << "[ERROR] " << e.what() << std::endl;
+        }
+    }
+    return true;
+}
+
+std::string InMemoryStorage::hashPassword(const std::string& pwd) {
+    if (!passwordVerifier) {
+        throw std::runtime_error("Not connected to database");
+    }
+    return passwordVerifier->hash(pwd, passwordCost).get();
+}
+
+InMemoryStorage::PendingLogin<Patient> InMemoryStorage::beginLoginPatient(const std::string& email, const std::string& pwd) {
+    return beginLogin(patients, "Patient", "PatientID", email, pwd);
+}
+
+InMemoryStorage::PendingLogin<Doctor> InMemoryStorage::beginLoginDoctor(const std::string& email, const std::string& pwd) {
+    return beginLogin(doctors, "Doctors", "DoctorID", email, pwd);
+}
+
+InMemoryStorage::PendingLogin<Staff> InMemoryStorage::beginLoginStaff(const std::string& email, const std::string& pwd) {
+    return beginLogin(staff, "Staff", "StaffID", email, pwd);
+}
+
+InMemoryStorage::PendingLogin<Admin> InMemoryStorage::beginLoginAdmin(const std::string& email, const std::string& pwd) {
+    return beginLogin(admins, "Admin", "AdminID", email, pwd);
+}
+
+std::optional<Patient> InMemoryStorage::loginPatient(const std::string& email, const std::string& pwd) {
+    return beginLoginPatient(email, pwd).get();
+}
+
+std::optional<Doctor> InMemoryStorage::loginDoctor(const std::string& email, const std::string& pwd) {
+    return beginLoginDoctor(email, pwd).get();
+}
+
+std::optional<Staff> InMemoryStorage::loginStaff(const std::string& email, const std::string& pwd) {
+    return beginLoginStaff(email, pwd).get();
+}
+
+std::optional<Admin> InMemoryStorage::loginAdmin(const std::string& email, const std::string& pwd) {
+    return beginLoginAdmin(email, pwd).get();
+}
+
+int InMemoryStorage::migratePlaintextPasswords() {
+    if (!passwordVerifier) {
+        reportError("Not connected to database");
+        return -1;
+    }
+    // Patient, Doctors, Staff, Admin
+    std::vector<std::pair<int, std::string>> rows[4];
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        plaintextPasswords(patients, rows[0]);
+        plaintextPasswords(doctors, rows[1]);
+        plaintextPasswords(staff, rows[2]);
+        plaintextPasswords(admins, rows[3]);
+    }
+
+    // Queue every row at once, then wait with the lock released
+    std::vector<std::future<std::string>> pending[4];
+    for (int t = 0; t < 4; t++) {
+        for (const auto& row : rows[t]) pending[t].push_back(passwordVerifier->hash(row.second, passwordCost));
+    }
+    std::vector<std::string> hashes[4];
+    for (int t = 0; t < 4; t++) {
+        for (std::future<std::string>& hash : pending[t]) hashes[t].push_back(hash.get());
+    }
+
+    int migrated = 0;
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t i = 0; i < rows[0].size(); i++) migrated += replacePassword(patients, rows[0][i].first, rows[0][i].second, hashes[0][i]);
+    for (size_t i = 0; i < rows[1].size(); i++) migrated += replacePassword(doctors, rows[1][i].first, rows[1][i].second, hashes[1][i]);
+    for (size_t i = 0; i < rows[2].size(); i++) migrated += replacePassword(staff, rows[2][i].first, rows[2][i].second, hashes[2][i]);
+    for (size_t i = 0; i < rows[3].size(); i++) migrated += replacePassword(admins, rows[3][i].first, rows[3][i].second, hashes[3][i]);
+    return migrated;
+}
+
+PasswordVerifier::Stats InMemoryStorage::getPasswordStats() const {
+    return passwordVerifier ? passwordVerifier->getStats() : PasswordVerifier::Stats();
+}
+
+// ============================================================
+// Patient Operations
+// ============================================================
+
+std::optional<int> InMemoryStorage::registerPatient(const std::string& name, const std::string& phone,
+                                                    const std::string& email, const std::string& address,
+                                                    const std::string& dob, const std::string& gender,
+                                                    const std::string& pwd) {
+    try {
+        std::string hashed = hashPassword(pwd);
+        Patient patient;
+        patient.patientName = name;
+        patient.phoneNumber = phone;
+        patient.email = email;
+        patient.address = address;
+        patient.dateOfBirth = dob;
+        patient.gender = gender;
+        std::optional<int> patientID;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            patientID = insertAccount(patients, patient, hashed);
+            if (patientID) patientsByName.insert(std::make_pair(name, *patientID));
+        }
+        if (patientID) {
+            PatientSearchIndex::Entry entry;
+            entry.patientID = *patientID;
+            entry.name = name;
+            entry.email = email;
+            entry.phone = phone;
+            patientIndex.upsert(entry);
+        }
+        return patientID;
+    }
+    catch (std::exception& e) {
+        std::cerr << "[ERROR] " << e.what() << std::endl;
+        return std::nullopt;
+    }
+}
+
+Patient InMemoryStorage::getPatientById(int patientID) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::unordered_map<int, Patient>::const_iterator patient = patients.rows.find(patientID);
+    return patient != patients.rows.end() ? patient->second : Patient();
+}
+
+bool InMemoryStorage::updatePatient(int patientID, const std::string& name, const std::string& phone,
+                                    const std::string& email, const std::string& address) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::unordered_map<int, Patient>::iterator patient = patients.rows.find(patientID);
+        if (patient == patients.rows.end()) return true; // Like an UPDATE matching no row
+        if (!rekeyAccount(patients, patientID, email, phone)) return false;
+        patientsByName.erase(std::make_pair(patient->second.patientName, patientID));
+        patientsByName.insert(std::make_pair(name, patientID));
+        patient->second.patientName = name;
+        patient->second.address = address;
+    }
+    PatientSearchIndex::Entry entry;
+    entry.patientID = patientID;
+    entry.name = name;
+    entry.email = email;
+    entry.phone = phone;
+    patientIndex.upsert(entry);
+    return true;
+}
+
+bool InMemoryStorage::deletePatient(int patientID) {
+    std::vector<int> removed;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::unordered_map<int, AppointmentIndex>::const_iterator held = appointmentsByPatient.find(patientID);
+        if (held != appointmentsByPatient.end()) {
+            for (const AppointmentKey& key : held->second) removed.push_back(key.appointmentID);
+        }
+        for (int appointmentID : removed) eraseAppointment(appointmentID);
+        std::unordered_map<int, Patient>::const_iterator patient = patients.rows.find(patientID);
+        if (patient != patients.rows.end()) {
+            patientsByName.erase(std::make_pair(patient->second.patientName, patientID));
+        }
+        eraseAccount(patients, patientID);
+    }
+    patientIndex.remove(patientID);
+    for (int appointmentID : removed) slotIndex.remove(appointmentID);
+    return true;
+}
+
+std::vector<PatientSearchIndex::Entry> InMemoryStorage::loadPatientSearchEntries() {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<PatientSearchIndex::Entry> entries;
+    entries.reserve(patients.rows.size());
+    for (const auto& patient : patients.rows) {
+        PatientSearchIndex::Entry entry;
+        entry.patientID = patient.first;
+        entry.name = patient.second.patientName;
+        entry.email = patient.second.email;
+        entry.phone = patient.second.phoneNumber;
+        entries.push_back(entry);
+    }
+    return entries;
+}
+
+std::vector<Patient> InMemoryStorage::searchPatients(const std::string& search) {
+    std::vector<Patient> found;
+    if (search.empty()) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const std::pair<std::string, int>& name : patientsByName) found.push_back(patients.rows.at(name.second));
+        return found;
+    }
+
+    std::vector<int> ids = patientIndex.search(search);
+    std::lock_guard<std::mutex> lock(mutex);
+    for (int id : ids) {
+        std::unordered_map<int, Patient>::const_iterator patient = patients.rows.find(id);
+        // Changed or deleted since the index answered
+        if (patient != patients.rows.end() &&
+            PatientSearchIndex::matches(search, patient->second.patientName, patient->second.email,
+                                        patient->second.phoneNumber)) {
+            found.push_back(patient->second);
+        }
+    }
+    PatientNameOrder order;
+    std::sort(found.begin(), found.end(), [&order](const Patient& a, const Patient& b) {
+        return order(std::make_pair(a.patientName, a.patientID), std::make_pair(b.patientName, b.patientID));
+    });
+    return found;
+}
+
+std::vector<Patient> InMemoryStorage::suggestPatients(const std::string& prefix, size_t limit) {
+    std::vector<int> ids = patientIndex.complete(prefix, (std::min)(limit, PATIENT_SUGGEST_LIMIT));
+    std::vector<Patient> found;
+    std::lock_guard<std::mutex> lock(mutex);
+    for (int id : ids) {
+        std::unordered_map<int, Patient>::const_iterator patient = patients.rows.find(id);
+        if (patient != patients.rows.end()) found.push_back(patient->second);
+    }
+    return found;
+}
+
+PatientSearchIndex::Stats InMemoryStorage::getPatientSearchStats() const {
+    return patientIndex.getStats();
+}
+
+InMemoryStorage::PatientPage InMemoryStorage::getPatientsPage(const PatientCursor& after, int pageSize) {
+    PatientPage page;
+    std::lock_guard<std::mutex> lock(mutex);
+    std::set<std::pair<std::string, int>, PatientNameOrder>::const_iterator name =
+        patientsByName.upper_bound(std::make_pair(after.patientName, after.patientID));
+    // One extra row tells whether another page exists
+    for (; name != patientsByName.end() && static_cast<int>(page.patients.size()) <= pageSize; ++name) {
+        page.patients.push_back(patients.rows.at(name->second));
+    }
+    if (static_cast<int>(page.patients.size()) > pageSize) {
+        page.patients.pop_back();
+        page.hasMore = true;
+    }
+    if (!page.patients.empty()) {
+        page.next.patientName = page.patients.back().patientName;
+        page.next.patientID = page.patients.back().patientID;
+    }
+    return page;
+}
+
+// ============================================================
+// Doctor Operations
+// ============================================================
+
+Doctor InMemoryStorage::getDoctorById(int doctorID) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::unordered_map<int, Doctor>::const_iterator doctor = doctors.rows.find(doctorID);
+    return doctor != doctors.rows.end() ? doctor->second : Doctor();
+}
+
+std::vector<Doctor> InMemoryStorage::getAllDoctors(bool availableOnly) {
+    std::vector<Doctor> roster;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& doctor : doctors.rows) {
+            if (!availableOnly || doctor.second.isAvailable) roster.push_back(doctor.second);
+        }
+    }
+    std::sort(roster.begin(), roster.end(), [](const Doctor& a, const Doctor& b) {
+        int order = compareIgnoringCase(a.doctorName, b.doctorName);
+        return order != 0 ? order < 0 : a.doctorID < b.doctorID;
+    });
+    return roster;
+}
+
+std::optional<int> InMemoryStorage::addDoctor(const std::string& name, const std::string& specialty,
+                                              const std::string& room, const std::string& phone,
+                                              const std::string& email, const std::string& pwd) {
+    try {
+        std::string hashed = hashPassword(pwd);
+        Doctor doctor;
+        doctor.doctorName = name;
+        doctor.specialty = specialty;
+        doctor.roomNo = room;
+        doctor.phoneNumber = phone;
+        doctor.email = email;
+        doctor.isAvailable = true;
+        std::lock_guard<std::mutex> lock(mutex);
+        return insertAccount(doctors, doctor, hashed);
+    }
+    catch (std::exception& e) {
+        std::cerr << "[ERROR] " << e.what() << std::endl;
+        return std::nullopt;
+    }
+}
+
+bool InMemoryStorage::updateDoctor(int doctorID, const std::string& name, const std::string& specialty,
+                                   const std::string& room, const std::string& phone) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::unordered_map<int, Doctor>::iterator doctor = doctors.rows.find(doctorID);
+    if (doctor == doctors.rows.end()) return true;
+    if (!rekeyAccount(doctors, doctorID, doctor->second.email, phone)) return false;
+    doctor->second.doctorName = name;
+    doctor->second.specialty = specialty;
+    doctor->second.roomNo = room;
+    return true;
+}
+
+bool InMemoryStorage::updateDoctorAvailability(int doctorID, bool isAvailable) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::unordered_map<int, Doctor>::iterator doctor = doctors.rows.find(doctorID);
+    if (doctor != doctors.rows.end()) doctor->second.isAvailable = isAvailable;
+    return true;
+}
+
+bool InMemoryStorage::deleteDoctor(int doctorID) {
+    // The doctor's appointments go too (ON DELETE CASCADE)
+    std::vector<int> removed;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::unordered_map<int, AppointmentIndex>::const_iterator held = appointmentsByDoctor.find(doctorID);
+        if (held != appointmentsByDoctor.end()) {
+            for (const AppointmentKey& key : held->second) removed.push_back(key.appointmentID);
+        }
+        for (int appointmentID : removed) eraseAppointment(appointmentID);
+        eraseAccount(doctors, doctorID);
+    }
+    for (int appointmentID : removed) slotIndex.remove(appointmentID);
+    return true;
+}
+
+DoctorCache::Stats InMemoryStorage::getDoctorCacheStats() const {
+    return DoctorCache::Stats();
+}
+
+// ============================================================
+// Staff and Admin Operations
+// ============================================================
+
+Staff InMemoryStorage::getStaffById(int staffID) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::unordered_map<int, Staff>::const_iterator member = staff.rows.find(staffID);
+    return member != staff.rows.end() ? member->second : Staff();
+}
+
+std::vector<Staff> InMemoryStorage::getAllStaff() {
+    std::vector<Staff> staffList;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& member : staff.rows) staffList.push_back(member.second);
+    }
+    std::sort(staffList.begin(), staffList.end(), [](const Staff& a, const Staff& b) {
+        int order = compareIgnoringCase(a.staffName, b.staffName);
+        return order != 0 ? order < 0 : a.staffID < b.staffID;
+    });
+    return staffList;
+}
+
+std::optional<int> InMemoryStorage::addStaff(const std::string& name, const std::string& department,
+                                             const std::string& phone, const std::string& email,
+                                             const std::string& pwd) {
+    try {
+        std::string hashed = hashPassword(pwd);
+        Staff member;
+        member.staffName = name;
+        member.department = department;
+        member.phoneNumber = phone;
+        member.email = email;
+        std::lock_guard<std::mutex> lock(mutex);
+        return insertAccount(staff, member, hashed);
+    }
+    catch (std::exception& e) {
+        std::cerr << "[ERROR] " << e.what() << std::endl;
+        return std::nullopt;
+    }
+}
+
+bool InMemoryStorage::deleteStaff(int staffID) {
+    std::lock_guard<std::mutex> lock(mutex);
+    eraseAccount(staff, staffID);
+    // Appointment.StaffID is ON DELETE SET NULL
+    for (auto& appointment : appointments) {
+        if (appointment.second.staffID == staffID) appointment.second.staffID = 0;
+    }
+    return true;
+}
+
+Admin InMemoryStorage::getAdminById(int adminID) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::unordered_map<int, Admin>::const_iterator admin = admins.rows.find(adminID);
+    return admin != admins.rows.end() ? admin->second : Admin();
+}
+
+// ============================================================
+// Appointment Operations
+// ============================================================
+
+InMemoryStorage::AppointmentKey InMemoryStorage::keyOf(const Appointment& appointment) {
+    AppointmentKey key;
+    key.day = appointment.appointmentDate.dayNumber();
+    key.minute = appointment.appointmentTime.minuteOfDay();
+    key.appointmentID = appointment.appointmentID;
+    return key;
+}
+
+int InMemoryStorage::storeAppointment(Appointment appointment) {
+    if (appointment.appointmentID <= 0) {
+        appointment.appointmentID = ++lastAppointmentID;
+    } else {
+        lastAppointmentID = (std::max)(lastAppointmentID, appointment.appointmentID);
+    }
+    appointment.patientName.clear(); // Joined from the patient and doctor on every read
+    appointment.doctorName.clear();
+    AppointmentKey key = keyOf(appointment);
+    appointmentsByDate.insert(key);
+    appointmentsByDoctor[appointment.doctorID].insert(key);
+    appointmentsByPatient[appointment.patientID].insert(key);
+    columnRows[appointment.appointmentID] = appointmentColumns.append(
+        appointment.appointmentID, appointment.doctorID, key.day, appointment.status,
+        appointment.consultationFee, appointment.medicineFee, appointment.totalCost);
+    appointments[appointment.appointmentID] = appointment;
+    return appointment.appointmentID;
+}
+
+void InMemoryStorage::eraseAppointment(int appointmentID) {
+    std::unordered_map<int, Appointment>::iterator appointment = appointments.find(appointmentID);
+    if (appointment == appointments.end()) return;
+    AppointmentKey key = keyOf(appointment->second);
+    appointmentsByDate.erase(key);
+    std::unordered_map<int, AppointmentIndex>::iterator doctor = appointmentsByDoctor.find(appointment->second.doctorID);
+    if (doctor != appointmentsByDoctor.end()) {
+        doctor->second.erase(key);
+        if (doctor->second.empty()) appointmentsByDoctor.erase(doctor);
+    }
+    std::unordered_map<int, AppointmentIndex>::iterator patient = appointmentsByPatient.find(appointment->second.patientID);
+    if (patient != appointmentsByPatient.end()) {
+        patient->second.erase(key);
+        if (patient->second.empty()) appointmentsByPatient.erase(patient);
+    }
+    std::unordered_map<int, size_t>::iterator row = columnRows.find(appointmentID);
+    int moved = appointmentColumns.erase(row->second);
+    if (moved != 0) columnRows[moved] = row->second;
+    columnRows.erase(row);
+    appointments.erase(appointment);
+}
+
+Appointment InMemoryStorage::joined(const Appointment& appointment) const {
+    Appointment row = appointment;
+    std::unordered_map<int, Patient>::const_iterator patient = patients.rows.find(appointment.patientID);
+    if (patient != patients.rows.end()) row.patientName = patient->second.patientName;
+    std::unordered_map<int, Doctor>::const_iterator doctor = doctors.rows.find(appointment.doctorID);
+    if (doctor != doctors.rows.end()) row.doctorName = doctor->second.doctorName;
+    return row;
+}
+
+std::vector<Appointment> InMemoryStorage::joinedRange(AppointmentIndex::const_iterator first,
+                                                      AppointmentIndex::const_iterator last) const {
+    std::vector<Appointment> rows;
+    for (; first != last; ++first) rows.push_back(joined(appointments.at(first->appointmentID)));
+    return rows;
+}
+
+bool InMemoryStorage::overlapsActive(int doctorID, int day, int minute, int duration) const {
+    std::unordered_map<int, AppointmentIndex>::const_iterator doctor = appointmentsByDoctor.find(doctorID);
+    if (doctor == appointmentsByDoctor.end()) return false;
+    std::pair<AppointmentIndex::const_iterator, AppointmentIndex::const_iterator> sameDay = daysOf(doctor->second, day, day);
+    for (AppointmentIndex::const_iterator key = sameDay.first; key != sameDay.second; ++key) {
+        const Appointment& other = appointments.at(key->appointmentID);
+        if (other.status.holdsSlot() && key->minute < minute + duration && minute < key->minute + other.duration) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string InMemoryStorage::rejection(const Appointment& appointment, BookingResult::Outcome& outcome) const {
+    outcome = BookingResult::Failed;
+    if (!appointment.appointmentDate.isValid() || !appointment.appointmentTime.isValid()) {
+        return "Incorrect date or time value";
+    }
+    int day = appointment.appointmentDate.dayNumber();
+    int minute = appointment.appointmentTime.minuteOfDay();
+    if (!patients.rows.count(appointment.patientID) || !doctors.rows.count(appointment.doctorID)) {
+        return "Unknown patient or doctor";
+    }
+    if (appointment.reason.size() > REASON_MAX_LENGTH) return "Data too long for column 'Reason'";
+
+    // Overlapping durations as well as equal start times, on every day
+    if (appointment.status.holdsSlot() &&
+        overlapsActive(appointment.doctorID, day, minute, appointment.duration)) {
+        outcome = BookingResult::SlotTaken;
+        return "Doctor already has an appointment at this time";
+    }
+    if (appointment.status != AppointmentStatus::Cancelled) {
+        std::unordered_map<int, AppointmentIndex>::const_iterator patient = appointmentsByPatient.find(appointment.patientID);
+        if (patient != appointmentsByPatient.end()) {
+            std::pair<AppointmentIndex::const_iterator, AppointmentIndex::const_iterator> sameDay =
+                daysOf(patient->second, day, day);
+            for (AppointmentIndex::const_iterator key = sameDay.first; key != sameDay.second; ++key) {
+                const Appointment& other = appointments.at(key->appointmentID);
+                if (other.doctorID == appointment.doctorID && other.status != AppointmentStatus::Cancelled) {
+                    outcome = BookingResult::DailyLimitReached;
+                    return "Patient already has an appointment with this doctor on this date";
+                }
+            }
+        }
+    }
+    return std::string();
+}
+
+std::optional<int> InMemoryStorage::createAppointment(int patientID, int doctorID, const Date& date,
+                                                      const TimeOfDay& time, const std::string& reason,
+                                                      int duration, double consultationFee, double medicineFee) {
+    BookingResult booking = bookAppointmentAtomic(patientID, doctorID, date, time, reason,
+                                                  duration, consultationFee, medicineFee);
+    if (booking.outcome == BookingResult::SlotTaken) {
+        std::cerr << "[ERROR] Doctor already has an appointment at " << date << " " << time.shortString() << std::endl;
+    }
+    else if (booking.outcome == BookingResult::DailyLimitReached) {
+        std::cerr << "[ERROR] Patient already has an appointment with this doctor on " << date << std::endl;
+    }
+    if (booking.outcome != BookingResult::Booked) return std::nullopt;
+    return booking.appointmentID;
+}
+
+InMemoryStorage::BookingResult InMemoryStorage::bookAppointmentAtomic(int patientID, int doctorID,
+                                                                      const Date& date,
+                                                                      const TimeOfDay& time,
+                                                                      const std::string& reason,
+                                                                      int duration, double consultationFee,
+                                                                      double medicineFee) {
+    BookingResult result;
+    Appointment appointment;
+    appointment.status = AppointmentStatus::Pending;
+    appointment.patientID = patientID;
+    appointment.doctorID = doctorID;
+    appointment.appointmentDate = date;
+    appointment.appointmentTime = time;
+    if (!date.isValid() || !time.isValid()) {
+        reportError("Incorrect date or time value");
+        return result;
+    }
+    appointment.reason = reason;
+    appointment.duration = duration;
+    appointment.consultationFee = cents(consultationFee);
+    appointment.medicineFee = cents(medicineFee);
+    appointment.totalCost = cents(consultationFee + medicineFee);
+
+    std::string problem;
+    {
+        // Check and insert under one lock, so concurrent bookings cannot both succeed
+        std::lock_guard<std::mutex> lock(mutex);
+        problem = rejection(appointment, result.outcome);
+        if (problem.empty()) {
+            appointment.appointmentID = storeAppointment(appointment);
+            result.outcome = BookingResult::Booked;
+            result.appointmentID = appointment.appointmentID;
+        }
+    }
+    if (result.outcome == BookingResult::Booked) {
+        slotIndex.add(bookingOf(appointment));
+    } else if (result.outcome == BookingResult::Failed) {
+        reportError(problem);
+    }
+    return result;
+}
+
+std::vector<InMemoryStorage::ImportFailure> InMemoryStorage::importAppointments(const std::vector<ImportRow>& rows) {
+    std::vector<ImportFailure> failures;
+    std::vector<DoctorSlotIndex::Booking> booked;
+    {
+        // One lock for the whole batch: other callers see all of it or none
+        std::lock_guard<std::mutex> lock(mutex);
+        for (size_t i = 0; i < rows.size(); i++) {
+            const ImportRow& row = rows[i];
+            Appointment appointment;
+            appointment.status = AppointmentStatus::Pending;
+            appointment.patientID = row.patientID;
+            appointment.doctorID = row.doctorID;
+            appointment.appointmentDate = row.date;
+            appointment.appointmentTime = row.time;
+            appointment.reason = row.reason;
+            appointment.duration = row.duration;
+            appointment.consultationFee = cents(row.consultationFee);
+            appointment.medicineFee = cents(row.medicineFee);
+            appointment.totalCost = cents(row.consultationFee + row.medicineFee);
+
+            BookingResult::Outcome outcome;
+            std::string problem = rejection(appointment, outcome);
+            if (!problem.empty()) {
+                failures.push_back(ImportFailure{ i, problem });
+                continue;
+            }
+            appointment.appointmentID = storeAppointment(appointment);
+            booked.push_back(bookingOf(appointment));
+        }
+    }
+    for (const DoctorSlotIndex::Booking& booking : booked) slotIndex.add(booking);
+    return failures;
+}
+
+double InMemoryStorage::calculateConsultationFee(int duration) {
+    // RM1 per minute
+    return static_cast<double>(duration);
+}
+
+double InMemoryStorage::calculateMedicineFee(const std::string& reason) {
+    return MedicineFeeMatcher::instance().fee(reason);
+}
+
+std::vector<Appointment> InMemoryStorage::getPatientAppointments(int patientID) {
+    std::vector<Appointment> rows;
+    std::lock_guard<std::mutex> lock(mutex);
+    std::unordered_map<int, AppointmentIndex>::const_iterator patient = appointmentsByPatient.find(patientID);
+    if (patient == appointmentsByPatient.end()) return rows;
+    // Newest date and time first
+    for (AppointmentIndex::const_reverse_iterator key = patient->second.rbegin(); key != patient->second.rend(); ++key) {
+        rows.push_back(joined(appointments.at(key->appointmentID)));
+    }
+    return rows;
+}
+
+std::vector<Appointment> InMemoryStorage::getDoctorAppointments(int doctorID, const Date& date) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::unordered_map<int, AppointmentIndex>::const_iterator doctor = appointmentsByDoctor.find(doctorID);
+    if (doctor == appointmentsByDoctor.end()) return std::vector<Appointment>();
+    if (!date.isValid()) return joinedRange(doctor->second.begin(), doctor->second.end());
+    int day = date.dayNumber();
+    std::pair<AppointmentIndex::const_iterator, AppointmentIndex::const_iterator> sameDay = daysOf(doctor->second, day, day);
+    return joinedRange(sameDay.first, sameDay.second);
+}
+
+std::vector<Appointment> InMemoryStorage::getDoctorAllAppointments(int doctorID) {
+    return getDoctorAppointments(doctorID, Date());
+}
+
+std::vector<Appointment> InMemoryStorage::getAllAppointments() {
+    std::vector<Appointment> rows;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        rows = joinedRange(appointmentsByDate.begin(), appointmentsByDate.end());
+    }
+    newestDayFirst(rows);
+    return rows;
+}
+
+AppointmentList InMemoryStorage::getAllAppointmentsCompact() {
+    AppointmentList rows;
+    std::lock_guard<std::mutex> lock(mutex);
+    rows.reserve(appointments.size());
+    // Days newest first, each in time order, as getAllAppointments() sorts them
+    AppointmentIndex::const_iterator dayEnd = appointmentsByDate.end();
+    while (dayEnd != appointmentsByDate.begin()) {
+        int day = std::prev(dayEnd)->day;
+        AppointmentIndex::const_iterator dayStart = daysOf(appointmentsByDate, day, day).first;
+        for (AppointmentIndex::const_iterator key = dayStart; key != dayEnd; ++key) {
+            rows.push_back(joined(appointments.at(key->appointmentID)));
+        }
+        dayEnd = dayStart;
+    }
+    return rows;
+}
+
+std::vector<Appointment> InMemoryStorage::getAppointmentsByDateRange(const Date& startDate, const Date& endDate) {
+    if (!startDate.isValid() || !endDate.isValid()) return std::vector<Appointment>();
+    int firstDay = startDate.dayNumber();
+    int lastDay = endDate.dayNumber();
+    std::vector<Appointment> rows;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::pair<AppointmentIndex::const_iterator, AppointmentIndex::const_iterator> range =
+            daysOf(appointmentsByDate, firstDay, lastDay);
+        rows = joinedRange(range.first, range.second);
+    }
+    newestDayFirst(rows);
+    return rows;
+}
+
+long long InMemoryStorage::streamAppointmentsByDateRange(const Date& startDate, const Date& endDate,
+                                                         const std::function<bool(const Appointment&)>& onRow) {
+    if (!startDate.isValid() || !endDate.isValid()) {
+        reportError("Incorrect date value");
+        return -1;
+    }
+    int firstDay = startDate.dayNumber();
+    int lastDay = endDate.dayNumber();
+
+    long long rows = 0;
+    std::vector<Appointment> batch;
+    std::optional<AppointmentKey> last; // Resume after this key
+    while (true) {
+        batch.clear();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::pair<AppointmentIndex::const_iterator, AppointmentIndex::const_iterator> range =
+                daysOf(appointmentsByDate, firstDay, lastDay);
+            AppointmentIndex::const_iterator key = last ? appointmentsByDate.upper_bound(*last) : range.first;
+            for (; key != range.second && batch.size() < STREAM_BATCH; ++key) {
+                batch.push_back(joined(appointments.at(key->appointmentID)));
+                last = *key;
+            }
+        }
+        if (batch.empty()) return rows;
+        for (const Appointment& appointment : batch) {
+            if (!onRow(appointment)) return rows;
+            rows++;
+        }
+    }
+}
+
+std::vector<Appointment> InMemoryStorage::getTodayAppointments() {
+    int day = today();
+    std::lock_guard<std::mutex> lock(mutex);
+    std::pair<AppointmentIndex::const_iterator, AppointmentIndex::const_iterator> range =
+        daysOf(appointmentsByDate, day, day);
+    return joinedRange(range.first, range.second);
+}
+
+std::vector<Appointment> InMemoryStorage::getWeeklyAppointments() {
+    int day = today();
+    return getAppointmentsByDateRange(Date::fromDayNumber(day - 7), Date::fromDayNumber(day));
+}
+
+std::vector<Appointment> InMemoryStorage::getMonthlyAppointments() {
+    int day = today();
+    return getAppointmentsByDateRange(Date::fromDayNumber(day - 30), Date::fromDayNumber(day));
+}
+
+std::vector<Appointment> InMemoryStorage::getPendingAppointments() {
+    std::vector<Appointment> rows;
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const AppointmentKey& key : appointmentsByDate) {
+        const Appointment& appointment = appointments.at(key.appointmentID);
+        if (appointment.status == AppointmentStatus::Pending) rows.push_back(joined(appointment));
+    }
+    return rows;
+}
+
+InMemoryStorage::AppointmentPage InMemoryStorage::pageBefore(const AppointmentIndex& index,
+                                                             const AppointmentCursor& after, int pageSize) const {
+    AppointmentPage page;
+    AppointmentKey cursor;
+    cursor.day = after.appointmentDate.dayNumber();
+    cursor.minute = after.appointmentTime.minuteOfDay();
+    cursor.appointmentID = after.appointmentID;
+    if (!after.appointmentDate.isValid() || !after.appointmentTime.isValid()) return page;
+
+    // Walk back from the cursor; one extra row tells whether another page exists
+    AppointmentIndex::const_iterator key = index.lower_bound(cursor);
+    while (key != index.begin() && static_cast<int>(page.appointments.size()) <= pageSize) {
+        --key;
+        page.appointments.push_back(joined(appointments.at(key->appointmentID)));
+    }
+    if (static_cast<int>(page.appointments.size()) > pageSize) {
+        page.appointments.pop_back();
+        page.hasMore = true;
+    }
+    if (!page.appointments.empty()) {
+        const Appointment& last = page.appointments.back();
+        page.next.appointmentDate = last.appointmentDate;
+        page.next.appointmentTime = last.appointmentTime;
+        page.next.appointmentID = last.appointmentID;
+    }
+    return page;
+}
+
+InMemoryStorage::AppointmentPage InMemoryStorage::getAppointmentsPage(const AppointmentCursor& after, int pageSize) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return pageBefore(appointmentsByDate, after, pageSize);
+}
+
+InMemoryStorage::AppointmentPage InMemoryStorage::getDoctorAppointmentsPage(int doctorID, const AppointmentCursor& after,
+                                                                            int pageSize) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::unordered_map<int, AppointmentIndex>::const_iterator doctor = appointmentsByDoctor.find(doctorID);
+    if (doctor == appointmentsByDoctor.end()) return AppointmentPage();
+    return pageBefore(doctor->second, after, pageSize);
+}
+
+Appointment InMemoryStorage::getAppointmentById(int appointmentID) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::unordered_map<int, Appointment>::const_iterator appointment = appointments.find(appointmentID);
+    return appointment != appointments.end() ? joined(appointment->second) : Appointment();
+}
+
+bool InMemoryStorage::updateAppointmentStatus(int appointmentID, AppointmentStatus from, AppointmentStatus to) {
+    if (!from.canBecome(to)) {
+        reportError(std::string("A ") + from.name() + " appointment cannot become " + to.name());
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::unordered_map<int, Appointment>::iterator appointment = appointments.find(appointmentID);
+        if (appointment == appointments.end() || appointment->second.status != from) {
+            reportError("Appointment " + std::to_string(appointmentID) + " is not " + from.name());
+            return false;
+        }
+        // No legal transition takes a slot or a patient-day back, so
+        // nothing booked in the meantime can clash
+        appointment->second.status = to;
+        appointmentColumns.setStatus(columnRows.at(appointmentID), to);
+    }
+    if (!to.holdsSlot()) slotIndex.remove(appointmentID);
+    return true;
+}
+
+bool InMemoryStorage::cancelAppointment(int appointmentID) {
+    AppointmentStatus current;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::unordered_map<int, Appointment>::const_iterator appointment = appointments.find(appointmentID);
+        if (appointment == appointments.end()) {
+            reportError("Appointment " + std::to_string(appointmentID) + " not found");
+            return false;
+        }
+        current = appointment->second.status;
+    }
+    // Fails rather than cancelling twice if it changed in between
+    return updateAppointmentStatus(appointmentID, current, AppointmentStatus::Cancelled);
+}
+
+bool InMemoryStorage::checkDoctorAvailability(int doctorID, const Date& date, const TimeOfDay& time,
+                                              int duration) {
+    std::optional<bool> free = slotIndex.isFree(doctorID, date, time, duration);
+    if (free) return *free;
+
+    // Day before the index window: look at the doctor's day directly
+    if (!date.isValid() || !time.isValid()) return false;
+    std::lock_guard<std::mutex> lock(mutex);
+    return !overlapsActive(doctorID, date.dayNumber(), time.minuteOfDay(), duration);
+}
+
+DoctorSlotIndex::Load InMemoryStorage::loadActiveBookings() {
+    DoctorSlotIndex::Load load;
+    load.fromDate = Date::today();
+    int day = load.fromDate.dayNumber();
+    std::lock_guard<std::mutex> lock(mutex);
+    std::pair<AppointmentIndex::const_iterator, AppointmentIndex::const_iterator> range =
+        daysOf(appointmentsByDate, day, (std::numeric_limits<int>::max)());
+    for (AppointmentIndex::const_iterator key = range.first; key != range.second; ++key) {
+        const Appointment& appointment = appointments.at(key->appointmentID);
+        if (appointment.status.holdsSlot()) load.bookings.push_back(bookingOf(appointment));
+    }
+    return load;
+}
+
+std::vector<DoctorSlotIndex::FreeSlot> InMemoryStorage::findFreeSlots(const std::vector<int>& doctorIDs,
+                                                                      const Date& fromDate,
+                                                                      const TimeOfDay& notBefore, int duration,
+                                                                      int days, size_t count) {
+    DoctorSlotIndex::SlotSearch search;
+    search.doctorIDs = doctorIDs;
+    search.fromDate = fromDate;
+    search.notBeforeMinute = notBefore.isValid() ? notBefore.minuteOfDay() : 0;
+    search.duration = duration;
+    search.days = days;
+    search.count = count;
+    std::optional<std::vector<DoctorSlotIndex::FreeSlot>> slots = slotIndex.findFree(search);
+    return slots ? *slots : std::vector<DoctorSlotIndex::FreeSlot>();
+}
+
+std::vector<DoctorSlotIndex::FreeSlot> InMemoryStorage::findFreeSlotsInSpecialty(const std::string& specialty,
+                                                                                 const Date& fromDate,
+                                                                                 const TimeOfDay& notBefore,
+                                                                                 int duration, int days, size_t count) {
+    std::vector<int> doctorIDs;
+    for (const Doctor& doctor : getAllDoctors(true)) {
+        if (doctor.specialty == specialty) doctorIDs.push_back(doctor.doctorID);
+    }
+    if (doctorIDs.empty()) return std::vector<DoctorSlotIndex::FreeSlot>();
+    return findFreeSlots(doctorIDs, fromDate, notBefore, duration, days, count);
+}
+
+DoctorSlotIndex::Stats InMemoryStorage::getSlotIndexStats() const {
+    return slotIndex.getStats();
+}
+
+bool InMemoryStorage::checkPatientDailyLimit(int patientID, int doctorID, const Date& date) {
+    if (!date.isValid()) return false;
+    int day = date.dayNumber();
+    std::lock_guard<std::mutex> lock(mutex);
+    std::unordered_map<int, AppointmentIndex>::const_iterator patient = appointmentsByPatient.find(patientID);
+    if (patient == appointmentsByPatient.end()) return true;
+    std::pair<AppointmentIndex::const_iterator, AppointmentIndex::const_iterator> sameDay = daysOf(patient->second, day, day);
+    for (AppointmentIndex::const_iterator key = sameDay.first; key != sameDay.second; ++key) {
+        const Appointment& appointment = appointments.at(key->appointmentID);
+        if (appointment.doctorID == doctorID && appointment.status != AppointmentStatus::Cancelled) return false;
+    }
+    return true;
+}
+
+// ============================================================
+// Activity Log
+// ============================================================
+
+bool InMemoryStorage::logActivity(const std::string& userType, int userID,
+                                  const std::string& action, const std::string& details) {
+    std::string now = getCurrentDate() + " " + getCurrentTime();
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!isConnected) {
+        reportError("Not connected to database");
+        return false;
+    }
+    ActivityLog log;
+    log.logID = static_cast<int>(activityLog.size()) + 1;
+    log.userType = userType;
+    log.userID = userID;
+    log.action = action;
+    log.details = details;
+    log.timestamp = now;
+    activityLog.push_back(log);
+    return true;
+}
+
+ActivityLogWriter::Stats InMemoryStorage::getActivityLogStats() const {
+    return ActivityLogWriter::Stats();
+}
+
+std::vector<ActivityLog> InMemoryStorage::getActivityLogs(int limit) {
+    std::vector<ActivityLog> logs;
+    std::lock_guard<std::mutex> lock(mutex);
+    for (std::vector<ActivityLog>::const_reverse_iterator log = activityLog.rbegin();
+         log != activityLog.rend() && static_cast<int>(logs.size()) < limit; ++log) {
+        logs.push_back(*log);
+    }
+    return logs;
+}
+
+// ============================================================
+// Statistics (counted from the appointments on each call)
+// ============================================================
+
+InMemoryStorage::AppointmentSummary InMemoryStorage::summarize(int firstDay, int lastDay) const {
+    AppointmentColumns::PerStatus counts = appointmentColumns.countByStatus(firstDay, lastDay);
+    AppointmentColumns::PerStatus total = appointmentColumns.sumByStatus(AppointmentColumns::Total, firstDay, lastDay);
+    AppointmentColumns::PerStatus consultation =
+        appointmentColumns.sumByStatus(AppointmentColumns::Consultation, firstDay, lastDay);
+    AppointmentColumns::PerStatus medicine =
+        appointmentColumns.sumByStatus(AppointmentColumns::Medicine, firstDay, lastDay);
+
+    AppointmentSummary summary;
+    summary.pending = static_cast<int>(counts[AppointmentStatus::Pending]);
+    summary.confirmed = static_cast<int>(counts[AppointmentStatus::Confirmed]);
+    summary.completed = static_cast<int>(counts[AppointmentStatus::Completed]);
+    summary.cancelled = static_cast<int>(counts[AppointmentStatus::Cancelled]);
+    summary.total = summary.pending + summary.confirmed + summary.completed + summary.cancelled;
+    summary.completedRevenue = total[AppointmentStatus::Completed] / 100.0;
+    summary.completedConsultation = consultation[AppointmentStatus::Completed] / 100.0;
+    summary.completedMedicine = medicine[AppointmentStatus::Completed] / 100.0;
+    summary.potentialRevenue = (total[AppointmentStatus::Pending] + total[AppointmentStatus::Confirmed]) / 100.0;
+    return summary;
+}
+
+std::vector<InMemoryStorage::DailyStats> InMemoryStorage::dailyStatistics(int days) const {
+    int lastDay = today();
+    std::map<int, AppointmentSummary> perDay;
+    std::pair<AppointmentIndex::const_iterator, AppointmentIndex::const_iterator> range =
+        daysOf(appointmentsByDate, lastDay - days, lastDay);
+    for (AppointmentIndex::const_iterator key = range.first; key != range.second; ++key) {
+        tally(perDay[key->day], appointments.at(key->appointmentID));
+    }
+
+    std::vector<DailyStats> stats;
+    for (std::map<int, AppointmentSummary>::const_reverse_iterator day = perDay.rbegin(); day != perDay.rend(); ++day) {
+        if (day->second.total == 0) continue;
+        DailyStats s;
+        s.date = Date::fromDayNumber(day->first).toString();
+        s.total = day->second.total;
+        s.confirmed = day->second.confirmed;
+        s.pending = day->second.pending;
+        s.completed = day->second.completed;
+        s.cancelled = day->second.cancelled;
+        stats.push_back(s);
+    }
+    return stats;
+}
+
+std::vector<InMemoryStorage::DoctorStats> InMemoryStorage::getDoctorStatistics() {
+    std::vector<DoctorStats> stats;
+    std::lock_guard<std::mutex> lock(mutex);
+    std::unordered_map<int, AppointmentColumns::PerStatus> perDoctor;
+    for (const AppointmentColumns::DoctorCounts& doctor : appointmentColumns.countByDoctor()) {
+        perDoctor[doctor.doctorID] = doctor.appointments;
+    }
+
+    for (const auto& doctor : doctors.rows) {
+        const AppointmentColumns::PerStatus& counts = perDoctor[doctor.first];
+        int completed = static_cast<int>(counts[AppointmentStatus::Completed]);
+        DoctorStats s;
+        s.doctorID = doctor.first;
+        s.doctorName = doctor.second.doctorName;
+        s.totalAppointments = static_cast<int>(counts[AppointmentStatus::Pending] + counts[AppointmentStatus::Confirmed] +
+                                               completed + counts[AppointmentStatus::Cancelled]);
+        s.confirmedCount = static_cast<int>(counts[AppointmentStatus::Confirmed]);
+        s.completionRate = s.totalAppointments > 0 ? completed * 100.0 / s.totalAppointments : 0.0;
+        stats.push_back(s);
+    }
+    std::sort(stats.begin(), stats.end(), [](const DoctorStats& a, const DoctorStats& b) {
+        return a.totalAppointments != b.totalAppointments ? a.totalAppointments > b.totalAppointments
+                                                          : a.doctorID < b.doctorID;
+    });
+    return stats;
+}
+
+std::vector<InMemoryStorage::MonthlyStats> InMemoryStorage::getMonthlyStatistics() {
+    std::lock_guard<std::mutex> lock(mutex);
+    // Keyed year * 12 + month - 1, so the map runs in calendar order
+    std::map<int, AppointmentSummary> perMonth;
+    for (const auto& appointment : appointments) {
+        const Date& date = appointment.second.appointmentDate;
+        int month = date.year() * 12 + date.month() - 1;
+        tally(perMonth[month], appointment.second);
+    }
+
+    std::vector<MonthlyStats> stats;
+    for (std::map<int, AppointmentSummary>::const_reverse_iterator month = perMonth.rbegin();
+         month != perMonth.rend(); ++month) {
+        if (month->second.total == 0) continue;
+        MonthlyStats s;
+        s.year = month->first / 12;
+        s.month = month->first % 12 + 1;
+        s.totalAppointments = month->second.total;
+        s.completed = month->second.completed;
+        s.completionPercentage = s.completed * 100.0 / s.totalAppointments;
+        stats.push_back(s);
+    }
+    return stats;
+}
+
+std::vector<InMemoryStorage::DailyStats> InMemoryStorage::getDailyStatistics() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return dailyStatistics(30);
+}
+
+std::vector<InMemoryStorage::DailyStats> InMemoryStorage::getWeeklyDailyStatistics() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return dailyStatistics(7);
+}
+
+InMemoryStorage::RevenueStats InMemoryStorage::getRevenueStatistics() {
+    AppointmentSummary summary;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        summary = summarize((std::numeric_limits<int>::min)(), (std::numeric_limits<int>::max)());
+    }
+    RevenueStats stats;
+    stats.totalRevenue = summary.completedRevenue;
+    stats.potentialRevenue = summary.potentialRevenue;
+    int billable = summary.pending + summary.confirmed + summary.completed;
+    stats.averageCost = billable > 0 ? (summary.completedRevenue + summary.potentialRevenue) / billable : 0.0;
+    stats.totalConsultation = summary.completedConsultation;
+    stats.totalMedicine = summary.completedMedicine;
+    return stats;
+}
+
+InMemoryStorage::AppointmentSummary InMemoryStorage::getAppointmentSummary(int lastDays) {
+    int lastDay = today();
+    std::lock_guard<std::mutex> lock(mutex);
+    if (lastDays < 0) {
+        return summarize((std::numeric_limits<int>::min)(), (std::numeric_limits<int>::max)());
+    }
+    return summarize(lastDay - lastDays, lastDay);
+}
+
+InMemoryStorage::AppointmentSummary InMemoryStorage::getDoctorAppointmentSummary(int doctorID) {
+    AppointmentSummary summary;
+    std::lock_guard<std::mutex> lock(mutex);
+    std::unordered_map<int, AppointmentIndex>::const_iterator doctor = appointmentsByDoctor.find(doctorID);
+    if (doctor == appointmentsByDoctor.end()) return summary;
+    for (const AppointmentKey& key : doctor->second) {
+        tally(summary, appointments.at(key.appointmentID));
+    }
+    return summary;
+}
+
+InMemoryStorage::SystemCounts InMemoryStorage::getSystemCounts() {
+    SystemCounts counts;
+    std::lock_guard<std::mutex> lock(mutex);
+    counts.patients = static_cast<int>(patients.rows.size());
+    counts.doctors = static_cast<int>(doctors.rows.size());
+    for (const auto& doctor : doctors.rows) {
+        if (doctor.second.isAvailable) counts.availableDoctors++;
+    }
+    counts.staff = static_cast<int>(staff.rows.size());
+    return counts;
+}
+
+bool InMemoryStorage::verifyStatisticsRollup(std::vector<RollupDrift>& drift) {
+    drift.clear();
+    return true;
+}
+
+bool InMemoryStorage::rebuildStatisticsRollup() {
+    return true;
+}
+
+std::vector<InMemoryStorage::QueryPlan> InMemoryStorage::explainHotQueries() {
+    return std::vector<QueryPlan>();
+}
+
+InMemoryStorage::RowMappingBenchmark InMemoryStorage::benchmarkRowMapping(int) {
+    return RowMappingBenchmark();
+}
@@ -0,0 +1,115 @@
+// ============================================================
+// MedicineFeeMatcher.cpp - Keyword Automaton for Medicine Fees
+// Hospital Appointment Booking System
+// ============================================================
+
+#include "../include/MedicineFeeMatcher.h"
+#include <queue>
+#include <stdexcept>
+
+namespace {
+    // Common conditions and their medicine fees (in RM), highest priority first
+    struct FeeCategory {
+        double fee;
+        const char* keywords[6]; // nullptr-terminated
+    };
+
+    const FeeCategory CATEGORIES[] = {
+        { 25.00, { "fever", "flu", "cough", "cold", nullptr } },                      // Basic medication for common cold/flu
+        { 40.00, { "pain", "headache", "backache", nullptr } },                       // Pain medication
+        { 35.00, { "allergy", "rash", "itch", "skin", nullptr } },                    // Antihistamines and topical treatments
+        { 50.00, { "infection", "throat", nullptr } },                                // Antibiotics
+        { 80.00, { "diabetes", "blood pressure", "hypertension", "heart", nullptr } }, // Chronic condition medication
+        { 0.00, { "checkup", "check up", "follow-up", "follow up", "screening", nullptr } } // Routine checkups
+    };
+    const size_t CATEGORY_COUNT = sizeof(CATEGORIES) / sizeof(CATEGORIES[0]);
+
+    const double DEFAULT_FEE = 30.00; // No keyword: general conditions
+}
+
+const MedicineFeeMatcher& MedicineFeeMatcher::instance() {
+    static const MedicineFeeMatcher matcher;
+    return matcher;
+}
+
+MedicineFeeMatcher::MedicineFeeMatcher() {
+    columnOf.fill(0);
+    for (int c = 'a'; c <= 'z'; c++) {
+        columnOf[c] = static_cast<uint8_t>(c - 'a' + 1);
+        columnOf[c - 'a' + 'A'] = static_cast<uint8_t>(c - 'a' + 1);
+    }
+    columnOf[' '] = 27;
+    columnOf['-'] = 28;
+
+    // Trie of every keyword; missing edges are -1 until filled in below
+    std::vector<std::array<int, COLUMNS>> edges(1);
+    edges[0].fill(-1);
+    found.assign(1, 0);
+    for (size_t category = 0; category < CATEGORY_COUNT; category++) {
+        for (const char* const* keyword = CATEGORIES[category].keywords; *keyword; keyword++) {
+            int state = 0;
+            for (const char* p = *keyword; *p; p++) {
+                int column = columnOf[static_cast<unsigned char>(*p)];
+                if (column == 0 || (*p >= 'A' && *p <= 'Z')) {
+                    throw std::logic_error(std::string("Keyword needs lowercase letters, spaces or '-': ") + *keyword);
+                }
+                if (edges[state][column] < 0) {
+                    edges[state][column] = static_cast<int>(edges.size());
+                    edges.push_back(std::array<int, COLUMNS>());
+                    edges.back().fill(-1);
+                    found.push_back(0);
+                }
+                state = edges[state][column];
+            }
+            found[state] |= 1u << category;
+        }
+    }
+
+    // Breadth-first: each state's failure link points at a shallower state,
+    // so its transitions and matches are complete before they are borrowed
+    std::vector<int> fail(edges.size(), 0);
+    std::queue<int> pending;
+    for (int column = 0; column < COLUMNS; column++) {
+        if (edges[0][column] < 0) {
+            edges[0][column] = 0;
+        } else {
+            pending.push(edges[0][column]);
+        }
+    }
+    while (!pending.empty()) {
+        int state = pending.front();
+        pending.pop();
+        found[state] |= found[fail[state]];
+        for (int column = 0; column < COLUMNS; column++) {
+            int child = edges[state][column];
+            if (child < 0) {
+                edges[state][column] = edges[fail[state]][column];
+            } else {
+                fail[child] = edges[fail[state]][column];
+                pending.push(child);
+            }
+        }
+    }
+
+    next.resize(edges.size() * COLUMNS);
+    for (size_t state = 0; state < edges.size(); state++) {
+        for (int column = 0; column < COLUMNS; column++) {
+            next[state * COLUMNS + column] = static_cast<uint16_t>(edges[state][column]);
+        }
+    }
+}
+
+double MedicineFeeMatcher::fee(const std::string& reason) const {
+    uint32_t matched = 0;
+    size_t state = 0;
+    for (char c : reason) {
+        state = next[state * COLUMNS + columnOf[static_cast<unsigned char>(c)]];
+        matched |= found[state];
+        if (matched & 1u) break; // Nothing outranks the first category
+    }
+    if (matched == 0) return DEFAULT_FEE;
+
+    size_t category = 0;
+    while (!(matched & (1u << category))) category++;
+    return CATEGORIES[category].fee;
+}
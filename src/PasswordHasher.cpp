@@ -0,0 +1,369 @@
+// ============================================================
+// PasswordHasher.cpp - Salted scrypt Password Hashing
+// Hospital Appointment Booking System
+// ============================================================
+
+#include "../include/PasswordHasher.h"
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+    const char* const HASH_PREFIX = "$scrypt$";
+    const size_t SALT_BYTES = 16;
+    const size_t KEY_BYTES = 32;
+
+    // ------------------------------------------------------------
+    // SHA-256 / HMAC-SHA256 / PBKDF2 (the outer layers of scrypt)
+    // ------------------------------------------------------------
+
+    const uint32_t SHA256_K[64] = {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+    };
+
+    inline uint32_t rotr(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+    inline uint32_t rotl(uint32_t x, int n) { return (x << n) | (x >> (32 - n)); }
+
+    class Sha256 {
+    public:
+        Sha256() : length(0), used(0) {
+            const uint32_t init[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                       0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+            std::memcpy(state, init, sizeof(state));
+        }
+
+        void update(const uint8_t* data, size_t len) {
+            length += len;
+            while (len > 0) {
+                size_t take = 64 - used < len ? 64 - used : len;
+                std::memcpy(buffer + used, data, take);
+                used += take;
+                data += take;
+                len -= take;
+                if (used == 64) {
+                    compress(buffer);
+                    used = 0;
+                }
+            }
+        }
+
+        void final(uint8_t out[32]) {
+            uint64_t bits = length * 8;
+            uint8_t pad = 0x80;
+            update(&pad, 1);
+            pad = 0;
+            while (used != 56) update(&pad, 1);
+            uint8_t lengthBytes[8];
+            for (int i = 0; i < 8; i++) lengthBytes[i] = uint8_t(bits >> (56 - 8 * i));
+            update(lengthBytes, 8);
+            for (int i = 0; i < 8; i++) {
+                out[4 * i] = uint8_t(state[i] >> 24);
+                out[4 * i + 1] = uint8_t(state[i] >> 16);
+                out[4 * i + 2] = uint8_t(state[i] >> 8);
+                out[4 * i + 3] = uint8_t(state[i]);
+            }
+        }
+
+    private:
+        uint32_t state[8];
+        uint64_t length;
+        uint8_t buffer[64];
+        size_t used;
+
+        void compress(const uint8_t block[64]) {
+            uint32_t w[64];
+            for (int i = 0; i < 16; i++) {
+                w[i] = (uint32_t(block[4 * i]) << 24) | (uint32_t(block[4 * i + 1]) << 16) |
+                       (uint32_t(block[4 * i + 2]) << 8) | uint32_t(block[4 * i + 3]);
+            }
+            for (int i = 16; i < 64; i++) {
+                uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+                uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+                w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+            }
+            uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+            uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+            for (int i = 0; i < 64; i++) {
+                uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + SHA256_K[i] + w[i];
+                uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+                h = g; g = f; f = e; e = d + t1;
+                d = c; c = b; b = a; a = t1 + t2;
+            }
+            state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+            state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+        }
+    };
+
+    // HMAC-SHA256 with the keyed inner/outer states computed once
+    class HmacSha256 {
+    public:
+        HmacSha256(const uint8_t* key, size_t keyLen) {
+            uint8_t block[64] = { 0 };
+            if (keyLen > 64) {
+                Sha256 digest;
+                digest.update(key, keyLen);
+                digest.final(block);
+            } else {
+                std::memcpy(block, key, keyLen);
+            }
+            uint8_t pad[64];
+            for (int i = 0; i < 64; i++) pad[i] = block[i] ^ 0x36;
+            inner.update(pad, 64);
+            for (int i = 0; i < 64; i++) pad[i] = block[i] ^ 0x5c;
+            outer.update(pad, 64);
+        }
+
+        // MAC of (a || b) without concatenating
+        void mac(const uint8_t* a, size_t aLen, const uint8_t* b, size_t bLen, uint8_t out[32]) const {
+            Sha256 in = inner;
+            in.update(a, aLen);
+            in.update(b, bLen);
+            uint8_t innerDigest[32];
+            in.final(innerDigest);
+            Sha256 out2 = outer;
+            out2.update(innerDigest, 32);
+            out2.final(out);
+        }
+
+    private:
+        Sha256 inner;
+        Sha256 outer;
+    };
+
+    // PBKDF2-HMAC-SHA256 with one iteration (all scrypt needs)
+    void pbkdf2Once(const HmacSha256& prf, const uint8_t* salt, size_t saltLen, uint8_t* out, size_t outLen) {
+        uint8_t block[32];
+        for (uint32_t i = 1; outLen > 0; i++) {
+            uint8_t counter[4] = { uint8_t(i >> 24), uint8_t(i >> 16), uint8_t(i >> 8), uint8_t(i) };
+            prf.mac(salt, saltLen, counter, 4, block);
+            size_t take = outLen < 32 ? outLen : 32;
+            std::memcpy(out, block, take);
+            out += take;
+            outLen -= take;
+        }
+    }
+
+    // ------------------------------------------------------------
+    // scrypt core: Salsa20/8, BlockMix, ROMix
+    // ------------------------------------------------------------
+
+    void salsa20_8(uint32_t b[16]) {
+        uint32_t x[16];
+        std::memcpy(x, b, sizeof(x));
+        for (int i = 0; i < 8; i += 2) {
+            x[4] ^= rotl(x[0] + x[12], 7);   x[8] ^= rotl(x[4] + x[0], 9);
+            x[12] ^= rotl(x[8] + x[4], 13);  x[0] ^= rotl(x[12] + x[8], 18);
+            x[9] ^= rotl(x[5] + x[1], 7);    x[13] ^= rotl(x[9] + x[5], 9);
+            x[1] ^= rotl(x[13] + x[9], 13);  x[5] ^= rotl(x[1] + x[13], 18);
+            x[14] ^= rotl(x[10] + x[6], 7);  x[2] ^= rotl(x[14] + x[10], 9);
+            x[6] ^= rotl(x[2] + x[14], 13);  x[10] ^= rotl(x[6] + x[2], 18);
+            x[3] ^= rotl(x[15] + x[11], 7);  x[7] ^= rotl(x[3] + x[15], 9);
+            x[11] ^= rotl(x[7] + x[3], 13);  x[15] ^= rotl(x[11] + x[7], 18);
+
+            x[1] ^= rotl(x[0] + x[3], 7);    x[2] ^= rotl(x[1] + x[0], 9);
+            x[3] ^= rotl(x[2] + x[1], 13);   x[0] ^= rotl(x[3] + x[2], 18);
+            x[6] ^= rotl(x[5] + x[4], 7);    x[7] ^= rotl(x[6] + x[5], 9);
+            x[4] ^= rotl(x[7] + x[6], 13);   x[5] ^= rotl(x[4] + x[7], 18);
+            x[11] ^= rotl(x[10] + x[9], 7);  x[8] ^= rotl(x[11] + x[10], 9);
+            x[9] ^= rotl(x[8] + x[11], 13);  x[10] ^= rotl(x[9] + x[8], 18);
+            x[12] ^= rotl(x[15] + x[14], 7); x[13] ^= rotl(x[12] + x[15], 9);
+            x[14] ^= rotl(x[13] + x[12], 13); x[15] ^= rotl(x[14] + x[13], 18);
+        }
+        for (int i = 0; i < 16; i++) b[i] += x[i];
+    }
+
+    // in and out are 2r 64-byte blocks (32r words); they must not overlap
+    void blockMix(const uint32_t* in, uint32_t* out, int r) {
+        uint32_t x[16];
+        std::memcpy(x, in + (2 * r - 1) * 16, sizeof(x));
+        for (int i = 0; i < 2 * r; i++) {
+            for (int k = 0; k < 16; k++) x[k] ^= in[i * 16 + k];
+            salsa20_8(x);
+            // Even blocks go to the first half of the output, odd blocks to the second
+            std::memcpy(out + ((i / 2) + (i % 2) * r) * 16, x, sizeof(x));
+        }
+    }
+
+    void roMix(uint8_t* block, int r, uint64_t n, std::vector<uint32_t>& v) {
+        const size_t words = size_t(32) * r;
+        std::vector<uint32_t> x(words), y(words);
+        for (size_t k = 0; k < words; k++) {
+            const uint8_t* p = block + 4 * k;
+            x[k] = uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+        }
+        for (uint64_t i = 0; i < n; i++) {
+            std::memcpy(&v[size_t(i) * words], x.data(), words * 4);
+            blockMix(x.data(), y.data(), r);
+            x.swap(y);
+        }
+        for (uint64_t i = 0; i < n; i++) {
+            uint64_t j = x[(2 * r - 1) * 16] & (n - 1);
+            const uint32_t* vj = &v[size_t(j) * words];
+            for (size_t k = 0; k < words; k++) x[k] ^= vj[k];
+            blockMix(x.data(), y.data(), r);
+            x.swap(y);
+        }
+        for (size_t k = 0; k < words; k++) {
+            uint8_t* p = block + 4 * k;
+            p[0] = uint8_t(x[k]); p[1] = uint8_t(x[k] >> 8);
+            p[2] = uint8_t(x[k] >> 16); p[3] = uint8_t(x[k] >> 24);
+        }
+    }
+
+    // ------------------------------------------------------------
+    // Encoding
+    // ------------------------------------------------------------
+
+    const char* const BASE64 = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    std::string base64Encode(const uint8_t* data, size_t len) {
+        std::string out;
+        for (size_t i = 0; i < len; i += 3) {
+            uint32_t chunk = uint32_t(data[i]) << 16;
+            if (i + 1 < len) chunk |= uint32_t(data[i + 1]) << 8;
+            if (i + 2 < len) chunk |= data[i + 2];
+            out += BASE64[(chunk >> 18) & 63];
+            out += BASE64[(chunk >> 12) & 63];
+            if (i + 1 < len) out += BASE64[(chunk >> 6) & 63];
+            if (i + 2 < len) out += BASE64[chunk & 63];
+        }
+        return out;
+    }
+
+    bool base64Decode(const std::string& text, std::vector<uint8_t>& out) {
+        out.clear();
+        uint32_t bits = 0;
+        int count = 0;
+        for (char c : text) {
+            const char* pos = std::strchr(BASE64, c);
+            if (c == '\0' || pos == nullptr) return false;
+            bits = (bits << 6) | uint32_t(pos - BASE64);
+            count += 6;
+            if (count >= 8) {
+                count -= 8;
+                out.push_back(uint8_t(bits >> count));
+            }
+        }
+        return true;
+    }
+
+    struct ParsedHash {
+        PasswordHasher::Cost cost;
+        std::vector<uint8_t> salt;
+        std::vector<uint8_t> key;
+    };
+
+    // Reads "<name>=<digits>" at pos and moves pos past it
+    bool readParam(const std::string& text, size_t& pos, const char* name, int& value) {
+        size_t nameLen = std::strlen(name);
+        if (text.compare(pos, nameLen, name) != 0 || pos + nameLen >= text.size() || text[pos + nameLen] != '=') {
+            return false;
+        }
+        pos += nameLen + 1;
+        size_t start = pos;
+        value = 0;
+        while (pos < text.size() && text[pos] >= '0' && text[pos] <= '9' && pos - start < 4) {
+            value = value * 10 + (text[pos] - '0');
+            pos++;
+        }
+        return pos > start;
+    }
+
+    bool parseHash(const std::string& stored, ParsedHash& parsed) {
+        if (stored.compare(0, std::strlen(HASH_PREFIX), HASH_PREFIX) != 0) return false;
+        size_t pos = std::strlen(HASH_PREFIX);
+        if (!readParam(stored, pos, "ln", parsed.cost.logN) || pos >= stored.size() || stored[pos++] != ',' ||
+            !readParam(stored, pos, "r", parsed.cost.r) || pos >= stored.size() || stored[pos++] != ',' ||
+            !readParam(stored, pos, "p", parsed.cost.p) || pos >= stored.size() || stored[pos++] != '$') {
+            return false;
+        }
+        // Bounds keep a corrupted row from requesting gigabytes
+        if (parsed.cost.logN < 1 || parsed.cost.logN > 20 || parsed.cost.r < 1 || parsed.cost.r > 32 ||
+            parsed.cost.p < 1 || parsed.cost.p > 16) {
+            return false;
+        }
+        size_t split = stored.find('$', pos);
+        if (split == std::string::npos) return false;
+        return base64Decode(stored.substr(pos, split - pos), parsed.salt) &&
+               base64Decode(stored.substr(split + 1), parsed.key) &&
+               !parsed.salt.empty() && !parsed.key.empty();
+    }
+
+    bool constantTimeEquals(const uint8_t* a, const uint8_t* b, size_t len) {
+        uint8_t diff = 0;
+        for (size_t i = 0; i < len; i++) diff |= a[i] ^ b[i];
+        return diff == 0;
+    }
+}
+
+void PasswordHasher::deriveKey(const std::string& password, const uint8_t* salt, size_t saltLen,
+                               const Cost& cost, uint8_t* out, size_t outLen) {
+    const size_t blockBytes = size_t(128) * cost.r;
+    const uint64_t n = uint64_t(1) << cost.logN;
+    HmacSha256 prf(reinterpret_cast<const uint8_t*>(password.data()), password.size());
+
+    std::vector<uint8_t> b(blockBytes * cost.p);
+    pbkdf2Once(prf, salt, saltLen, b.data(), b.size());
+
+    std::vector<uint32_t> v(size_t(n) * 32 * cost.r);
+    for (int i = 0; i < cost.p; i++) {
+        roMix(b.data() + blockBytes * i, cost.r, n, v);
+    }
+
+    pbkdf2Once(prf, b.data(), b.size(), out, outLen);
+}
+
+std::string PasswordHasher::keyedDigest(const std::string& key, const std::string& message) {
+    HmacSha256 prf(reinterpret_cast<const uint8_t*>(key.data()), key.size());
+    uint8_t digest[32];
+    prf.mac(reinterpret_cast<const uint8_t*>(message.data()), message.size(), nullptr, 0, digest);
+    return std::string(reinterpret_cast<const char*>(digest), sizeof(digest));
+}
+
+std::string PasswordHasher::hash(const std::string& password, const Cost& cost) {
+    uint8_t salt[SALT_BYTES];
+    std::random_device random;
+    for (size_t i = 0; i < SALT_BYTES; i += 4) {
+        uint32_t word = random();
+        std::memcpy(salt + i, &word, 4);
+    }
+    uint8_t key[KEY_BYTES];
+    deriveKey(password, salt, SALT_BYTES, cost, key, KEY_BYTES);
+
+    char params[48];
+    std::snprintf(params, sizeof(params), "ln=%d,r=%d,p=%d", cost.logN, cost.r, cost.p);
+    return std::string(HASH_PREFIX) + params + "$" + base64Encode(salt, SALT_BYTES) + "$" +
+           base64Encode(key, KEY_BYTES);
+}
+
+bool PasswordHasher::verify(const std::string& password, const std::string& stored) {
+    if (!isHash(stored)) {
+        // Legacy plaintext row (upgraded to a hash after the next successful login)
+        return password.size() == stored.size() &&
+               constantTimeEquals(reinterpret_cast<const uint8_t*>(password.data()),
+                                  reinterpret_cast<const uint8_t*>(stored.data()), stored.size());
+    }
+    ParsedHash parsed;
+    if (!parseHash(stored, parsed)) return false;
+    std::vector<uint8_t> key(parsed.key.size());
+    deriveKey(password, parsed.salt.data(), parsed.salt.size(), parsed.cost, key.data(), key.size());
+    return constantTimeEquals(key.data(), parsed.key.data(), key.size());
+}
+
+bool PasswordHasher::isHash(const std::string& stored) {
+    return stored.compare(0, std::strlen(HASH_PREFIX), HASH_PREFIX) == 0;
+}
+
+bool PasswordHasher::needsRehash(const std::string& stored, const Cost& cost) {
+    ParsedHash parsed;
+    if (!parseHash(stored, parsed)) return true;
+    return parsed.cost.logN != cost.logN || parsed.cost.r != cost.r || parsed.cost.p != cost.p;
+}
@@ -0,0 +1,172 @@
+// ============================================================
+// PasswordVerifier.cpp - Password KDF Worker Pool + Verification Cache
+// Hospital Appointment Booking System
+// ============================================================
+
+#include "../include/PasswordVerifier.h"
+#include <cstring>
+#include <memory>
+#include <random>
+
+PasswordVerifier::PasswordVerifier(const Config& c) : config(c), stopping(false) {
+    if (config.workers == 0) config.workers = 1;
+
+    std::random_device random;
+    for (int i = 0; i < 8; i++) {
+        uint32_t word = random();
+        secret.append(reinterpret_cast<const char*>(&word), sizeof(word));
+    }
+
+    for (size_t i = 0; i < config.workers; i++) {
+        workers.push_back(std::thread(&PasswordVerifier::run, this));
+    }
+}
+
+PasswordVerifier::~PasswordVerifier() {
+    stop();
+}
+
+std::future<bool> PasswordVerifier::verify(const std::string& password, const std::string& stored) {
+    std::shared_ptr<std::promise<bool>> result(new std::promise<bool>());
+    std::future<bool> verdict = result->get_future();
+
+    // Only real hashes are worth caching; plaintext compares are already cheap
+    bool cacheable = config.cacheCapacity > 0 && PasswordHasher::isHash(stored);
+    std::string key;
+    if (cacheable) {
+        key = PasswordHasher::keyedDigest(secret, stored + '\0' + password);
+        std::lock_guard<std::mutex> lock(mtx);
+        stats.verifications++;
+        if (cacheLookup(key)) {
+            stats.cacheHits++;
+            result->set_value(true);
+            return verdict;
+        }
+    } else {
+        std::lock_guard<std::mutex> lock(mtx);
+        stats.verifications++;
+    }
+
+    submit([this, result, password, stored, key, cacheable]() {
+        Clock::time_point start = Clock::now();
+        bool ok = false;
+        try {
+            ok = PasswordHasher::verify(password, stored);
+        }
+        catch (...) {
+            result->set_exception(std::current_exception());
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mtx);
+        recordKdf(start);
+        if (ok && cacheable) cacheInsert(key);
+        if (!ok) stats.rejected++;
+        result->set_value(ok);
+    });
+    return verdict;
+}
+
+std::future<std::string> PasswordVerifier::hash(const std::string& password, const PasswordHasher::Cost& cost) {
+    std::shared_ptr<std::promise<std::string>> result(new std::promise<std::string>());
+    std::future<std::string> hashed = result->get_future();
+    submit([this, result, password, cost]() {
+        Clock::time_point start = Clock::now();
+        try {
+            std::string value = PasswordHasher::hash(password, cost);
+            std::lock_guard<std::mutex> lock(mtx);
+            recordKdf(start);
+            stats.hashes++;
+            result->set_value(value);
+        }
+        catch (...) {
+            result->set_exception(std::current_exception());
+        }
+    });
+    return hashed;
+}
+
+void PasswordVerifier::submit(std::function<void()> job) {
+    std::unique_lock<std::mutex> lock(mtx);
+    if (stopping) {
+        // Pool already shut down: run on the caller rather than lose the result
+        lock.unlock();
+        job();
+        return;
+    }
+    jobs.push_back(std::move(job));
+    if (jobs.size() > stats.maxQueueDepth) stats.maxQueueDepth = jobs.size();
+    lock.unlock();
+    ready.notify_one();
+}
+
+void PasswordVerifier::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (stopping) return;
+        stopping = true;
+    }
+    ready.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+}
+
+PasswordVerifier::Stats PasswordVerifier::getStats() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    Stats snapshot = stats;
+    snapshot.queueDepth = jobs.size();
+    snapshot.cached = cache.size();
+    return snapshot;
+}
+
+void PasswordVerifier::run() {
+    std::unique_lock<std::mutex> lock(mtx);
+    while (true) {
+        ready.wait(lock, [this]() { return stopping || !jobs.empty(); });
+        if (jobs.empty()) break; // Stopping with nothing left to do
+        std::function<void()> job = std::move(jobs.front());
+        jobs.pop_front();
+        lock.unlock();
+        job();
+        lock.lock();
+    }
+}
+
+// Cache helpers run with mtx held
+
+bool PasswordVerifier::cacheLookup(const std::string& key) {
+    std::unordered_map<std::string, std::list<CacheEntry>::iterator>::iterator it = cacheIndex.find(key);
+    if (it == cacheIndex.end()) return false;
+    if (Clock::now() >= it->second->expires) {
+        cache.erase(it->second);
+        cacheIndex.erase(it);
+        return false;
+    }
+    cache.splice(cache.begin(), cache, it->second);
+    return true;
+}
+
+void PasswordVerifier::cacheInsert(const std::string& key) {
+    std::unordered_map<std::string, std::list<CacheEntry>::iterator>::iterator it = cacheIndex.find(key);
+    if (it != cacheIndex.end()) {
+        cache.erase(it->second);
+        cacheIndex.erase(it);
+    }
+    CacheEntry entry;
+    entry.key = key;
+    entry.expires = Clock::now() + config.cacheTtl;
+    cache.push_front(entry);
+    cacheIndex[key] = cache.begin();
+    while (cache.size() > config.cacheCapacity) {
+        cacheIndex.erase(cache.back().key);
+        cache.pop_back();
+    }
+}
+
+void PasswordVerifier::recordKdf(Clock::time_point start) {
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    stats.kdfRuns++;
+    stats.totalKdfMs += ms;
+    if (ms > stats.maxKdfMs) stats.maxKdfMs = ms;
+}
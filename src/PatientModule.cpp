@@ -8,11 +8,25 @@
 #include <iostream>
 #include <iomanip>
 #include <vector>
+#include <algorithm>
 #include <windows.h>
 #undef max
 
+namespace {
+    // Free slots offered by bookAppointment, and how far ahead it looks
+    const size_t SLOT_CHOICES = 8;
+    const int SLOT_SEARCH_DAYS = 14;
+
+    std::string doctorName(const std::vector<Doctor>& doctors, int doctorID) {
+        for (const Doctor& doctor : doctors) {
+            if (doctor.doctorID == doctorID) return doctor.doctorName;
+        }
+        return "Doctor #" + std::to_string(doctorID);
+    }
+}
+
 // OOP: Constructor calls base class constructor
-PatientModule::PatientModule(ConsoleUtils& c, DatabaseManager& d, UserSession& s)
+PatientModule::PatientModule(ConsoleUtils& c, StorageEngine& d, UserSession& s)
     : BaseModule(c, d, s) {}
 
 void PatientModule::registerPatient() {
@@ -255,7 +269,8 @@ void PatientModule::registerPatient() {
     
     console.showLoading("\n  Creating your account", 3);
     
-    if (db.registerPatient(name, phone, email, address, dob, gender, password)) {
+    std::optional<int> patientID = db.registerPatient(name, phone, email, address, dob, gender, password);
+    if (patientID) {
         console.setColor(GREEN);
         std::cout << "\n  +-----------------------------------------+" << std::endl;
         std::cout << "  |       REGISTRATION SUCCESSFUL!          |" << std::endl;
@@ -270,7 +285,7 @@ void PatientModule::registerPatient() {
         std::cout << "    - Password: (the one you created)" << std::endl;
         console.resetColor();
         
-        db.logActivity("Patient", db.getLastInsertId(), "Registration", "New patient registered");
+        db.logActivity("Patient", *patientID, "Registration", "New patient registered");
     } else {
         console.printError("Registration failed!");
         console.setColor(WHITE);
@@ -321,12 +336,16 @@ void PatientModule::bookAppointment() {
                   << std::setw(15) << doctors[i].specialty
                   << std::setw(10) << doctors[i].roomNo << std::endl;
     }
+    int anyDoctorChoice = (int)doctors.size() + 1;
+    console.setColor(DARK_GRAY);
+    std::cout << "  " << std::setw(5) << anyDoctorChoice << "Any doctor - earliest free slot in a specialty" << std::endl;
+    console.resetColor();
     
     std::cout << std::endl;
     console.setColor(YELLOW);
     std::cout << "  >> Select a doctor from the list above (or enter 0 to return):" << std::endl;
     console.resetColor();
-    int doctorChoice = console.getIntInput("     Enter number (0-" + std::to_string(doctors.size()) + "): ", 0, (int)doctors.size());
+    int doctorChoice = console.getIntInput("     Enter number (0-" + std::to_string(anyDoctorChoice) + "): ", 0, anyDoctorChoice);
     
     if (doctorChoice == 0) {
         console.printInfo("Booking cancelled. Returning to main menu.");
@@ -334,120 +353,169 @@ void PatientModule::bookAppointment() {
         return;
     }
     
-    int selectedDoctorID = doctors[doctorChoice - 1].doctorID;
-    
-    console.setColor(GREEN);
-    std::cout << "\n  [OK] Selected: " << doctors[doctorChoice - 1].doctorName << " (" << doctors[doctorChoice - 1].specialty << ")" << std::endl;
-    console.resetColor();
-    
-    std::cin.ignore(10000, '\n');
+    // Either one doctor, or a specialty whose available doctors all count
+    int selectedDoctorID = 0;
+    std::string specialty;
+    if (doctorChoice < anyDoctorChoice) {
+        selectedDoctorID = doctors[doctorChoice - 1].doctorID;
+        console.setColor(GREEN);
+        std::cout << "\n  [OK] Selected: " << doctors[doctorChoice - 1].doctorName << " (" << doctors[doctorChoice - 1].specialty << ")" << std::endl;
+        console.resetColor();
+    } else {
+        std::vector<std::string> specialties;
+        for (const Doctor& doctor : doctors) {
+            if (std::find(specialties.begin(), specialties.end(), doctor.specialty) == specialties.end()) {
+                specialties.push_back(doctor.specialty);
+            }
+        }
+        std::sort(specialties.begin(), specialties.end());
+        
+        std::cout << std::endl;
+        for (int i = 0; i < (int)specialties.size(); i++) {
+            std::cout << "  " << std::setw(5) << (i + 1) << specialties[i] << std::endl;
+        }
+        std::cout << std::endl;
+        console.setColor(YELLOW);
+        std::cout << "  >> Select a specialty (or enter 0 to return):" << std::endl;
+        console.resetColor();
+        int specialtyChoice = console.getIntInput("     Enter number (0-" + std::to_string(specialties.size()) + "): ",
+                                                  0, (int)specialties.size());
+        if (specialtyChoice == 0) {
+            console.printInfo("Booking cancelled. Returning to main menu.");
+            Sleep(1000);
+            return;
+        }
+        specialty = specialties[specialtyChoice - 1];
+        console.setColor(GREEN);
+        std::cout << "\n  [OK] Selected: any " << specialty << " doctor" << std::endl;
+        console.resetColor();
+    }
     
-    std::string date, time, reason;
+    Date date;
+    TimeOfDay time;
+    std::string reason;
     
-    // Step 2: Select Date
+    // Step 2: Duration (needed before free slots can be offered)
     std::cout << std::endl;
     console.setColor(DARK_GRAY);
     std::cout << "  ================================================" << std::endl;
-    std::cout << "  STEP 2 OF 4: SELECT DATE AND TIME" << std::endl;
+    std::cout << "  STEP 2 OF 4: APPOINTMENT DURATION" << std::endl;
     std::cout << "  ================================================" << std::endl;
     console.resetColor();
     
     std::cout << std::endl;
     console.setColor(YELLOW);
-    std::cout << "  >> Enter the date for your appointment:" << std::endl;
+    std::cout << "  >> Select expected appointment duration (in minutes):" << std::endl;
     console.setColor(DARK_GRAY);
-    std::cout << "     Format: YYYY-MM-DD (e.g., 2025-12-15)" << std::endl;
-    std::cout << "     Note: Cannot book past dates." << std::endl;
+    std::cout << "     15 minutes - Quick checkup, Prescription refill" << std::endl;
+    std::cout << "     30 minutes - Standard consultation, Follow-up" << std::endl;
+    std::cout << "     45 minutes - Detailed examination, Multiple concerns" << std::endl;
+    std::cout << "     60 minutes - Complex consultation, Procedure" << std::endl;
+    std::cout << "     0 - Return to main menu" << std::endl;
     console.resetColor();
     
+    int duration;
     do {
-        date = console.getStringInput("     Appointment Date (or press 0 to return): ");
-        
-        if (date == "0") {
+        duration = console.getIntInput("     Duration (15/30/45/60, or 0 to return): ", 0, 60);
+        if (duration == 0) {
             console.printInfo("Booking cancelled. Returning to main menu.");
             Sleep(1000);
             return;
         }
-        
-        if (date.empty()) {
-            console.printError("Date cannot be empty!");
-            continue;
-        }
-        
-        if (!console.isValidDate(date)) {
-            console.printError("Invalid format! Use YYYY-MM-DD");
-            date = "";
-        } else if (date < getCurrentDate()) {
-            console.printError("Cannot book past dates!");
-            date = "";
+        if (duration != 15 && duration != 30 && duration != 45 && duration != 60) {
+            console.printError("Invalid duration! Please select 15, 30, 45, or 60 minutes.");
         }
-    } while (date.empty() || !console.isValidDate(date));
+    } while (duration != 15 && duration != 30 && duration != 45 && duration != 60);
+    
+    // Step 3: Date and time, picked from the earliest free slots
+    std::cout << std::endl;
+    console.setColor(DARK_GRAY);
+    std::cout << "  ================================================" << std::endl;
+    std::cout << "  STEP 3 OF 4: SELECT DATE AND TIME" << std::endl;
+    std::cout << "  ================================================" << std::endl;
+    console.resetColor();
     
     std::cout << std::endl;
     console.setColor(YELLOW);
-    std::cout << "  >> Enter the time for your appointment:" << std::endl;
+    std::cout << "  >> Enter the earliest date that suits you:" << std::endl;
     console.setColor(DARK_GRAY);
-    std::cout << "     Format: HH:MM in 24-hour (e.g., 09:30 or 14:00)" << std::endl;
-    std::cout << "     Clinic hours: 08:00 - 17:00" << std::endl;
+    std::cout << "     Format: YYYY-MM-DD (e.g., 2025-12-15)" << std::endl;
+    std::cout << "     Note: Cannot book past dates." << std::endl;
     console.resetColor();
     
+    // Parsed once here; everything past this point works on Date/TimeOfDay
+    Date today = Date::today();
     do {
-        time = console.getStringInput("     Appointment Time (or press 0 to return): ");
+        std::string input = console.getStringInput("     From Date (or press 0 to return): ");
         
-        if (time == "0") {
+        if (input == "0") {
             console.printInfo("Booking cancelled. Returning to main menu.");
             Sleep(1000);
             return;
         }
         
-        if (time.empty()) {
-            console.printError("Time cannot be empty!");
+        if (input.empty()) {
+            console.printError("Date cannot be empty!");
             continue;
         }
         
-        if (!console.isValidTime(time)) {
-            console.printError("Invalid format! Use HH:MM (e.g., 10:30)");
-        } else {
-            // Validate clinic hours (08:00 - 17:00)
-            int hour = std::stoi(time.substr(0, 2));
-            if (hour < 8 || hour >= 17) {
-                console.printError("Clinic hours are 08:00 - 17:00. Please select a time within these hours.");
-                time = "";
-            }
+        date = console.isValidDate(input) ? Date::parse(input) : Date();
+        if (!date.isValid()) {
+            console.printError("Invalid format! Use YYYY-MM-DD");
+        } else if (date < today) {
+            console.printError("Cannot book past dates!");
+            date = Date();
         }
-    } while (time.empty() || !console.isValidTime(time));
+    } while (!date.isValid());
+    
+    TimeOfDay notBefore = date == today ? TimeOfDay::parse(getCurrentTime()) : TimeOfDay();
+    std::vector<DoctorSlotIndex::FreeSlot> slots = specialty.empty()
+        ? db.findFreeSlots(std::vector<int>(1, selectedDoctorID), date, notBefore, duration, SLOT_SEARCH_DAYS, SLOT_CHOICES)
+        : db.findFreeSlotsInSpecialty(specialty, date, notBefore, duration, SLOT_SEARCH_DAYS, SLOT_CHOICES);
+    
+    if (slots.empty()) {
+        console.printError("No free " + std::to_string(duration) + "-minute slots in the " +
+                           std::to_string(SLOT_SEARCH_DAYS) + " days from " + date.toString() + ".");
+        console.printInfo("Please try a later date.");
+        console.pauseScreen();
+        return;
+    }
     
-    // Step 3: Duration
     std::cout << std::endl;
-    console.setColor(DARK_GRAY);
-    std::cout << "  ================================================" << std::endl;
-    std::cout << "  STEP 3 OF 4: APPOINTMENT DURATION" << std::endl;
-    std::cout << "  ================================================" << std::endl;
+    console.setColor(DARK_CYAN);
+    std::cout << "  " << std::left
+              << std::setw(5) << "No."
+              << std::setw(13) << "Date"
+              << std::setw(8) << "Time"
+              << std::setw(25) << "Doctor" << std::endl;
+    std::cout << "  " << std::string(51, '-') << std::endl;
     console.resetColor();
+    for (int i = 0; i < (int)slots.size(); i++) {
+        std::cout << "  " << std::setw(5) << (i + 1)
+                  << std::setw(13) << slots[i].date
+                  << std::setw(8) << slots[i].time.shortString()
+                  << std::setw(25) << doctorName(doctors, slots[i].doctorID) << std::endl;
+    }
     
     std::cout << std::endl;
     console.setColor(YELLOW);
-    std::cout << "  >> Select expected appointment duration (in minutes):" << std::endl;
-    console.setColor(DARK_GRAY);
-    std::cout << "     15 minutes - Quick checkup, Prescription refill" << std::endl;
-    std::cout << "     30 minutes - Standard consultation, Follow-up" << std::endl;
-    std::cout << "     45 minutes - Detailed examination, Multiple concerns" << std::endl;
-    std::cout << "     60 minutes - Complex consultation, Procedure" << std::endl;
-    std::cout << "     0 - Return to main menu" << std::endl;
+    std::cout << "  >> Select a slot (or enter 0 to return):" << std::endl;
     console.resetColor();
+    int slotChoice = console.getIntInput("     Enter number (0-" + std::to_string(slots.size()) + "): ", 0, (int)slots.size());
     
-    int duration;
-    do {
-        duration = console.getIntInput("     Duration (15/30/45/60, or 0 to return): ", 0, 60);
-        if (duration == 0) {
-            console.printInfo("Booking cancelled. Returning to main menu.");
-            Sleep(1000);
-            return;
-        }
-        if (duration != 15 && duration != 30 && duration != 45 && duration != 60) {
-            console.printError("Invalid duration! Please select 15, 30, 45, or 60 minutes.");
-        }
-    } while (duration != 15 && duration != 30 && duration != 45 && duration != 60);
+    if (slotChoice == 0) {
+        console.printInfo("Booking cancelled. Returning to main menu.");
+        Sleep(1000);
+        return;
+    }
+    
+    selectedDoctorID = slots[slotChoice - 1].doctorID;
+    date = slots[slotChoice - 1].date;
+    time = slots[slotChoice - 1].time;
+    const Doctor* selectedDoctor = &doctors[0];
+    for (const Doctor& doctor : doctors) {
+        if (doctor.doctorID == selectedDoctorID) selectedDoctor = &doctor;
+    }
     
     // Calculate reason category based on duration
     std::string reasonCategory;
@@ -495,26 +563,28 @@ void PatientModule::bookAppointment() {
     double medicineFee = db.calculateMedicineFee(reason);
     double totalCost = consultationFee + medicineFee;
     
-    // Check daily limit
-    if (!db.checkPatientDailyLimit(session.userID, selectedDoctorID, date)) {
-        console.printError("You already have an appointment with this doctor on " + date);
+    console.showLoading("\n  Checking availability", 2);
+    
+    // Availability, the daily limit and the insert are one atomic call
+    StorageEngine::BookingResult booking = db.bookAppointmentAtomic(
+        session.userID, selectedDoctorID, date, time, reason, duration, consultationFee, medicineFee);
+    
+    if (booking.outcome == StorageEngine::BookingResult::DailyLimitReached) {
+        console.printError("You already have an appointment with this doctor on " + date.toString());
         console.printInfo("You can only book ONE appointment per doctor per day.");
         console.pauseScreen();
         return;
     }
     
-    console.showLoading("\n  Checking availability", 2);
-    
-    if (!db.checkDoctorAvailability(selectedDoctorID, date, time + ":00")) {
+    if (booking.outcome == StorageEngine::BookingResult::SlotTaken) {
         console.printError("This time slot is already booked!");
         console.printInfo("Please choose a different time.");
         console.pauseScreen();
         return;
     }
     
-    // Create appointment
-    if (db.createAppointment(session.userID, selectedDoctorID, date, time + ":00", reason, duration, consultationFee, medicineFee)) {
-        int appointmentID = db.getLastInsertId();
+    if (booking.outcome == StorageEngine::BookingResult::Booked) {
+        int appointmentID = booking.appointmentID;
         
         console.setColor(GREEN);
         std::cout << "\n  +-----------------------------------------+" << std::endl;
@@ -527,11 +597,11 @@ void PatientModule::bookAppointment() {
         std::cout << "  YOUR APPOINTMENT DETAILS:" << std::endl;
         std::cout << "  " << std::string(50, '-') << std::endl;
         std::cout << "  Appointment ID    : APT-" << appointmentID << std::endl;
-        std::cout << "  Doctor            : " << doctors[doctorChoice - 1].doctorName << std::endl;
-        std::cout << "  Specialty         : " << doctors[doctorChoice - 1].specialty << std::endl;
-        std::cout << "  Room              : " << doctors[doctorChoice - 1].roomNo << std::endl;
+        std::cout << "  Doctor            : " << selectedDoctor->doctorName << std::endl;
+        std::cout << "  Specialty         : " << selectedDoctor->specialty << std::endl;
+        std::cout << "  Room              : " << selectedDoctor->roomNo << std::endl;
         std::cout << "  Date              : " << date << std::endl;
-        std::cout << "  Time              : " << time << std::endl;
+        std::cout << "  Time              : " << time.shortString() << std::endl;
         std::cout << "  Duration          : " << duration << " minutes" << std::endl;
         std::cout << "  Category          : " << reasonCategory << std::endl;
         std::cout << "  Reason            : " << reason << std::endl;
@@ -554,7 +624,7 @@ void PatientModule::bookAppointment() {
         console.resetColor();
         
         db.logActivity("Patient", session.userID, "Book Appointment", 
-                      "Booked with Dr. " + doctors[doctorChoice - 1].doctorName);
+                      "Booked with Dr. " + selectedDoctor->doctorName);
     } else {
         console.printError("Failed to book appointment. Please try again.");
     }
@@ -599,10 +669,10 @@ void PatientModule::viewAppointments() {
     double totalMedicine = 0.0;
     
     for (const auto& apt : appointments) {
-        if (apt.status == "Confirmed") console.setColor(GREEN);
-        else if (apt.status == "Pending") console.setColor(YELLOW);
-        else if (apt.status == "Cancelled") console.setColor(RED);
-        else if (apt.status == "Completed") console.setColor(CYAN);
+        if (apt.status == AppointmentStatus::Confirmed) console.setColor(GREEN);
+        else if (apt.status == AppointmentStatus::Pending) console.setColor(YELLOW);
+        else if (apt.status == AppointmentStatus::Cancelled) console.setColor(RED);
+        else if (apt.status == AppointmentStatus::Completed) console.setColor(CYAN);
         else console.resetColor();
         
         std::string doctorName = apt.doctorName.length() > 14 ? 
@@ -611,12 +681,12 @@ void PatientModule::viewAppointments() {
         std::cout << "  " << std::setw(5) << apt.appointmentID
                   << std::setw(16) << doctorName
                   << std::setw(11) << apt.appointmentDate
-                  << std::setw(6) << apt.appointmentTime.substr(0, 5)
+                  << std::setw(6) << apt.appointmentTime.shortString()
                   << std::setw(9) << (std::to_string(apt.duration) + "m")
                   << std::setw(9) << ("RM" + std::to_string((int)apt.totalCost))
                   << std::setw(11) << apt.status << std::endl;
         
-        if (apt.status != "Cancelled") {
+        if (apt.status != AppointmentStatus::Cancelled) {
             totalAmount += apt.totalCost;
             totalConsultation += apt.consultationFee;
             totalMedicine += apt.medicineFee;
@@ -652,7 +722,7 @@ void PatientModule::cancelAppointment() {
     
     std::vector<Appointment> cancelable;
     for (const auto& apt : appointments) {
-        if (apt.status == "Pending" || apt.status == "Confirmed") {
+        if (apt.status == AppointmentStatus::Pending || apt.status == AppointmentStatus::Confirmed) {
             cancelable.push_back(apt);
         }
     }
@@ -685,7 +755,7 @@ void PatientModule::cancelAppointment() {
                   << std::setw(8) << cancelable[i].appointmentID
                   << std::setw(20) << cancelable[i].doctorName
                   << std::setw(12) << cancelable[i].appointmentDate
-                  << std::setw(10) << cancelable[i].appointmentTime.substr(0, 5) << std::endl;
+                  << std::setw(10) << cancelable[i].appointmentTime.shortString() << std::endl;
     }
     
     std::cout << std::endl;
@@ -707,7 +777,7 @@ void PatientModule::cancelAppointment() {
     std::cout << "  +-----------------------------------+" << std::endl;
     std::cout << "  | Doctor : " << std::left << std::setw(25) << cancelable[choice - 1].doctorName << "|" << std::endl;
     std::cout << "  | Date   : " << std::left << std::setw(25) << cancelable[choice - 1].appointmentDate << "|" << std::endl;
-    std::cout << "  | Time   : " << std::left << std::setw(25) << cancelable[choice - 1].appointmentTime.substr(0, 5) << "|" << std::endl;
+    std::cout << "  | Time   : " << std::left << std::setw(25) << cancelable[choice - 1].appointmentTime.shortString() << "|" << std::endl;
     std::cout << "  +-----------------------------------+" << std::endl;
     console.resetColor();
     
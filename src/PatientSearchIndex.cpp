@@ -0,0 +1,450 @@
+// ============================================================
+// PatientSearchIndex.cpp - In-Memory Trigram Index for Patient Search
+// Hospital Appointment Booking System
+// ============================================================
+
+#include "../include/PatientSearchIndex.h"
+#include <algorithm>
+#include <cctype>
+#include <string_view>
+
+namespace {
+    // Joins the fields of one slot; grams spanning it are never indexed and a
+    // query cannot contain it, so matches never straddle two fields
+    const char FIELD_SEPARATOR = '\x1f';
+
+    double elapsedMs(PatientSearchIndex::Clock::time_point since) {
+        return std::chrono::duration<double, std::milli>(PatientSearchIndex::Clock::now() - since).count();
+    }
+
+    char lowerAscii(char c) {
+        return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+
+    std::string lowered(const std::string& text) {
+        std::string out(text);
+        std::transform(out.begin(), out.end(), out.begin(), lowerAscii);
+        return out;
+    }
+
+    std::string searchableText(const PatientSearchIndex::Entry& entry) {
+        return lowered(entry.name) + FIELD_SEPARATOR + lowered(entry.email) + FIELD_SEPARATOR + lowered(entry.phone);
+    }
+
+    uint32_t gramKey(const char* p) {
+        return (uint32_t(uint8_t(p[0])) << 16) | (uint32_t(uint8_t(p[1])) << 8) | uint32_t(uint8_t(p[2]));
+    }
+
+    // Distinct grams of text, skipping any that cross a field boundary
+    std::vector<uint32_t> gramsOf(std::string_view text) {
+        std::vector<uint32_t> grams;
+        if (text.size() < 3) return grams;
+        grams.reserve(text.size() - 2);
+        for (size_t i = 0; i + 3 <= text.size(); i++) {
+            if (text[i] == FIELD_SEPARATOR || text[i + 1] == FIELD_SEPARATOR || text[i + 2] == FIELD_SEPARATOR) {
+                continue;
+            }
+            grams.push_back(gramKey(text.data() + i));
+        }
+        std::sort(grams.begin(), grams.end());
+        grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+        return grams;
+    }
+
+    // Prefix as complete() matches it: a prefix with a letter is lowercased
+    // and left-trimmed; one without is a phone number, reduced to its digits
+    std::string normalizedPrefix(const std::string& prefix) {
+        bool hasLetter = std::any_of(prefix.begin(), prefix.end(),
+                                     [](char c) { return std::isalpha(static_cast<unsigned char>(c)) != 0; });
+        std::string out;
+        for (char c : prefix) {
+            if (hasLetter) {
+                if (!out.empty() || c != ' ') out += lowerAscii(c);
+            } else if (c >= '0' && c <= '9') {
+                out += c;
+            }
+        }
+        return out;
+    }
+
+    // First position at or after from holding a value >= target. Doubling the
+    // step first keeps dense lists near-linear and sparse ones logarithmic.
+    size_t gallop(const std::vector<uint32_t>& list, size_t from, uint32_t target) {
+        size_t low = from, high = from, step = 1;
+        while (high < list.size() && list[high] < target) {
+            low = high + 1;
+            high += step;
+            step <<= 1;
+        }
+        return std::lower_bound(list.begin() + low, list.begin() + std::min(high, list.size()), target) - list.begin();
+    }
+}
+
+struct PatientSearchIndex::Table {
+    // A prefix key is a name suffix starting at a word, or the phone digits,
+    // addressed in place inside text
+    struct PrefixKey {
+        uint32_t begin;
+        uint32_t end;
+        uint32_t slot;
+    };
+
+    std::string text;                 // Per slot: lowercased "name<US>email<US>phone<US>phone digits"
+    std::vector<uint32_t> offsets;    // Slot i spans [offsets[i], offsets[i + 1])
+    std::vector<uint32_t> digitsAt;   // Start of slot i's phone digits
+    std::vector<int> patientIDs;      // By slot; 0 once the slot is retired
+    std::unordered_map<int, uint32_t> slotOf;
+    std::unordered_map<uint32_t, std::vector<uint32_t>> postings; // Gram -> ascending slots
+    std::vector<PrefixKey> prefixes;  // Sorted by key text, then slot
+    std::vector<PrefixKey> recent;    // Keys added since the last merge into prefixes, also sorted
+    size_t retired;
+    bool bulk;                        // Loading: keys are appended unsorted until finishBulk()
+
+    Table() : offsets(1, 0), retired(0), bulk(false) {}
+
+    // The name/email/phone part that substring search looks at
+    std::string_view slotText(uint32_t slot) const {
+        return std::string_view(text.data() + offsets[slot], digitsAt[slot] - 1 - offsets[slot]);
+    }
+
+    std::string_view keyText(const PrefixKey& key) const {
+        return std::string_view(text.data() + key.begin, key.end - key.begin);
+    }
+
+    bool keyLess(const PrefixKey& a, const PrefixKey& b) const {
+        int order = keyText(a).compare(keyText(b));
+        return order != 0 ? order < 0 : a.slot < b.slot;
+    }
+
+    void add(int patientID, const std::string& searchable) {
+        std::unordered_map<int, uint32_t>::iterator existing = slotOf.find(patientID);
+        if (existing != slotOf.end()) retire(existing);
+
+        uint32_t slot = static_cast<uint32_t>(patientIDs.size());
+        uint32_t begin = static_cast<uint32_t>(text.size());
+        text += searchable;
+        text += FIELD_SEPARATOR;
+        uint32_t digits = static_cast<uint32_t>(text.size());
+        for (size_t i = searchable.rfind(FIELD_SEPARATOR) + 1; i < searchable.size(); i++) {
+            if (searchable[i] >= '0' && searchable[i] <= '9') text += searchable[i];
+        }
+        offsets.push_back(static_cast<uint32_t>(text.size()));
+        digitsAt.push_back(digits);
+        patientIDs.push_back(patientID);
+        slotOf[patientID] = slot;
+        for (uint32_t gram : gramsOf(searchable)) {
+            postings[gram].push_back(slot); // New slots are always the largest
+        }
+
+        uint32_t nameEnd = begin + static_cast<uint32_t>(searchable.find(FIELD_SEPARATOR));
+        for (uint32_t i = begin; i < nameEnd; i++) {
+            if (text[i] != ' ' && (i == begin || text[i - 1] == ' ')) addKey(PrefixKey{ i, nameEnd, slot });
+        }
+        if (digits < offsets.back()) addKey(PrefixKey{ digits, offsets.back(), slot });
+    }
+
+    // Keeping prefixes itself sorted would move the whole array per key;
+    // recent stays small and is folded in with one linear merge when full
+    void addKey(const PrefixKey& key) {
+        if (bulk) {
+            prefixes.push_back(key);
+            return;
+        }
+        recent.insert(std::upper_bound(recent.begin(), recent.end(), key,
+                                       [this](const PrefixKey& a, const PrefixKey& b) { return keyLess(a, b); }),
+                      key);
+        if (recent.size() >= 1024) {
+            std::vector<PrefixKey> merged;
+            merged.reserve(prefixes.size() + recent.size());
+            std::merge(prefixes.begin(), prefixes.end(), recent.begin(), recent.end(), std::back_inserter(merged),
+                       [this](const PrefixKey& a, const PrefixKey& b) { return keyLess(a, b); });
+            prefixes.swap(merged);
+            recent.clear();
+        }
+    }
+
+    void finishBulk() {
+        std::sort(prefixes.begin(), prefixes.end(),
+                  [this](const PrefixKey& a, const PrefixKey& b) { return keyLess(a, b); });
+        for (auto& posting : postings) {
+            posting.second.shrink_to_fit(); // Growth slack would otherwise be a third of the index
+        }
+        bulk = false;
+    }
+
+    bool remove(int patientID) {
+        std::unordered_map<int, uint32_t>::iterator it = slotOf.find(patientID);
+        if (it == slotOf.end()) return false;
+        retire(it);
+        return true;
+    }
+
+    void retire(std::unordered_map<int, uint32_t>::iterator it) {
+        patientIDs[it->second] = 0; // Posting entries stay until compaction; search skips them
+        slotOf.erase(it);
+        retired++;
+    }
+
+    // Rebuild without retired slots
+    void compact() {
+        Table fresh;
+        fresh.bulk = true;
+        fresh.text.reserve(text.size());
+        fresh.patientIDs.reserve(slotOf.size());
+        for (uint32_t slot = 0; slot < patientIDs.size(); slot++) {
+            if (patientIDs[slot] != 0) {
+                fresh.add(patientIDs[slot], std::string(slotText(slot)));
+            }
+        }
+        fresh.finishBulk();
+        *this = std::move(fresh);
+    }
+
+    void scan(const std::string& query, std::vector<int>& ids) const {
+        for (uint32_t slot = 0; slot < patientIDs.size(); slot++) {
+            if (patientIDs[slot] != 0 && slotText(slot).find(query) != std::string_view::npos) {
+                ids.push_back(patientIDs[slot]);
+            }
+        }
+    }
+
+    // False when the query was answered by scan() instead of the postings
+    bool collect(const std::string& query, std::vector<int>& ids) const {
+        std::vector<uint32_t> grams = gramsOf(query);
+        if (grams.empty()) {
+            scan(query, ids);
+            return false;
+        }
+
+        std::vector<const std::vector<uint32_t>*> lists;
+        lists.reserve(grams.size());
+        for (uint32_t gram : grams) {
+            std::unordered_map<uint32_t, std::vector<uint32_t>>::const_iterator it = postings.find(gram);
+            if (it == postings.end()) return true; // Some gram occurs nowhere
+            lists.push_back(&it->second);
+        }
+        std::sort(lists.begin(), lists.end(),
+                  [](const std::vector<uint32_t>* a, const std::vector<uint32_t>* b) { return a->size() < b->size(); });
+        if (lists[0]->size() > patientIDs.size() / 4) {
+            // Even the rarest gram is everywhere; merging lists that long
+            // costs more than reading the text once
+            scan(query, ids);
+            return false;
+        }
+
+        // Walk the shortest list and binary-search the rest from where the
+        // previous candidate left off; all lists are ascending
+        std::vector<size_t> cursor(lists.size(), 0);
+        for (uint32_t slot : *lists[0]) {
+            bool everywhere = true;
+            for (size_t k = 1; k < lists.size() && everywhere; k++) {
+                const std::vector<uint32_t>& list = *lists[k];
+                cursor[k] = gallop(list, cursor[k], slot);
+                if (cursor[k] == list.size()) return true; // No later slot can be in every list
+                everywhere = list[cursor[k]] == slot;
+            }
+            // Sharing every gram does not guarantee they are adjacent
+            if (everywhere && patientIDs[slot] != 0 && slotText(slot).find(query) != std::string_view::npos) {
+                ids.push_back(patientIDs[slot]);
+            }
+        }
+        return true;
+    }
+
+    // Walks prefixes and recent together in key order from the first key
+    // >= prefix, stopping at the first key that no longer starts with it
+    void complete(const std::string& prefix, size_t limit, std::vector<int>& ids) const {
+        auto before = [this](const PrefixKey& key, const std::string& value) { return keyText(key) < value; };
+        std::vector<PrefixKey>::const_iterator a = std::lower_bound(prefixes.begin(), prefixes.end(), prefix, before);
+        std::vector<PrefixKey>::const_iterator b = std::lower_bound(recent.begin(), recent.end(), prefix, before);
+        auto extends = [this, &prefix](const PrefixKey& key) { return keyText(key).substr(0, prefix.size()) == prefix; };
+        bool moreA = a != prefixes.end() && extends(*a);
+        bool moreB = b != recent.end() && extends(*b);
+        while ((moreA || moreB) && ids.size() < limit) {
+            uint32_t slot;
+            if (moreA && (!moreB || keyLess(*a, *b))) {
+                slot = (a++)->slot;
+                moreA = a != prefixes.end() && extends(*a);
+            } else {
+                slot = (b++)->slot;
+                moreB = b != recent.end() && extends(*b);
+            }
+            int patientID = patientIDs[slot];
+            // A patient reached through two of its words is listed once
+            if (patientID != 0 && std::find(ids.begin(), ids.end(), patientID) == ids.end()) {
+                ids.push_back(patientID);
+            }
+        }
+    }
+
+    size_t postingCount() const {
+        size_t count = 0;
+        for (const auto& posting : postings) count += posting.second.size();
+        return count;
+    }
+
+    size_t memoryBytes() const {
+        size_t bytes = text.capacity() + (offsets.capacity() + digitsAt.capacity()) * sizeof(uint32_t) +
+                       patientIDs.capacity() * sizeof(int) + (prefixes.capacity() + recent.capacity()) * sizeof(PrefixKey);
+        bytes += slotOf.size() * (sizeof(int) + sizeof(uint32_t) + 2 * sizeof(void*)) + slotOf.bucket_count() * sizeof(void*);
+        bytes += postings.bucket_count() * sizeof(void*);
+        for (const auto& posting : postings) {
+            bytes += sizeof(posting) + 2 * sizeof(void*) + posting.second.capacity() * sizeof(uint32_t);
+        }
+        return bytes;
+    }
+};
+
+PatientSearchIndex::PatientSearchIndex(Loader l, const Config& c)
+    : loader(std::move(l)), config(c), loading(false), version(0) {}
+
+PatientSearchIndex::~PatientSearchIndex() {}
+
+std::vector<int> PatientSearchIndex::search(const std::string& query) {
+    ensureLoaded();
+
+    std::vector<int> ids;
+    std::string needle = lowered(query);
+    std::lock_guard<std::mutex> lock(mtx);
+    if (!table) return ids; // Invalidated between loading and getting here
+    Clock::time_point start = Clock::now();
+    bool indexed = table->collect(needle, ids);
+    double us = elapsedMs(start) * 1000.0;
+    stats.searches++;
+    if (!indexed) stats.scans++;
+    stats.totalSearchUs += us;
+    if (us > stats.maxSearchUs) stats.maxSearchUs = us;
+    return ids;
+}
+
+std::vector<int> PatientSearchIndex::complete(const std::string& prefix, size_t limit) {
+    std::vector<int> ids;
+    std::string normalized = normalizedPrefix(prefix);
+    if (normalized.empty() || limit == 0) return ids;
+    ensureLoaded();
+
+    std::lock_guard<std::mutex> lock(mtx);
+    if (!table) return ids;
+    Clock::time_point start = Clock::now();
+    table->complete(normalized, limit, ids);
+    stats.completions++;
+    stats.totalCompleteUs += elapsedMs(start) * 1000.0;
+    return ids;
+}
+
+bool PatientSearchIndex::matches(const std::string& query, const std::string& name,
+                                 const std::string& email, const std::string& phone) {
+    std::string needle = lowered(query);
+    return lowered(name).find(needle) != std::string::npos ||
+           lowered(email).find(needle) != std::string::npos ||
+           lowered(phone).find(needle) != std::string::npos;
+}
+
+void PatientSearchIndex::upsert(const Entry& entry) {
+    Change change;
+    change.entry = entry;
+    change.removed = false;
+    std::lock_guard<std::mutex> lock(mtx);
+    stats.upserts++;
+    if (loading) pending.push_back(change);
+    if (table) apply(*table, change);
+}
+
+void PatientSearchIndex::remove(int patientID) {
+    Change change;
+    change.entry.patientID = patientID;
+    change.removed = true;
+    std::lock_guard<std::mutex> lock(mtx);
+    stats.removals++;
+    if (loading) pending.push_back(change);
+    if (table) apply(*table, change);
+}
+
+void PatientSearchIndex::invalidate() {
+    std::lock_guard<std::mutex> lock(mtx);
+    version++;
+    table.reset();
+    stats.invalidations++;
+}
+
+PatientSearchIndex::Stats PatientSearchIndex::getStats() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    Stats snapshot = stats;
+    if (table) {
+        snapshot.patients = table->slotOf.size();
+        snapshot.retired = table->retired;
+        snapshot.trigrams = table->postings.size();
+        snapshot.postings = table->postingCount();
+        snapshot.prefixKeys = table->prefixes.size() + table->recent.size();
+        snapshot.memoryBytes = table->memoryBytes();
+    }
+    return snapshot;
+}
+
+void PatientSearchIndex::ensureLoaded() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (table && Clock::now() - loadedAt >= config.ttl) {
+            table.reset();
+            stats.expirations++;
+        }
+        if (table) return;
+    }
+
+    std::lock_guard<std::mutex> serial(loadMtx);
+    unsigned long long loadVersion;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (table) return; // Another caller finished loading while we waited
+        loading = true;
+        pending.clear();
+        loadVersion = version;
+    }
+
+    // The query and the build run without mtx, so searches of an existing
+    // table and incoming writes are not held up; writes are queued in pending
+    Clock::time_point start = Clock::now();
+    std::unique_ptr<Table> fresh(new Table());
+    fresh->bulk = true;
+    try {
+        std::vector<Entry> entries = loader();
+        fresh->patientIDs.reserve(entries.size());
+        for (const Entry& entry : entries) {
+            fresh->add(entry.patientID, searchableText(entry));
+        }
+        fresh->finishBulk();
+    }
+    catch (...) {
+        std::lock_guard<std::mutex> lock(mtx);
+        loading = false;
+        pending.clear();
+        throw;
+    }
+
+    std::lock_guard<std::mutex> lock(mtx);
+    for (const Change& change : pending) {
+        apply(*fresh, change);
+    }
+    stats.replayed += pending.size();
+    pending.clear();
+    loading = false;
+    stats.loads++;
+    stats.lastLoadMs = elapsedMs(start);
+    if (version == loadVersion) {
+        table = std::move(fresh);
+        loadedAt = Clock::now();
+    }
+}
+
+// Runs with mtx held
+void PatientSearchIndex::apply(Table& target, const Change& change) {
+    if (change.removed) {
+        target.remove(change.entry.patientID);
+    } else {
+        target.add(change.entry.patientID, searchableText(change.entry));
+    }
+    if (target.retired >= config.compactMinRetired && target.retired > target.slotOf.size()) {
+        target.compact();
+        stats.compactions++;
+    }
+}
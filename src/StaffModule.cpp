@@ -5,7 +5,7 @@
 
 #include "../include/StaffModule.h"
 #include "../include/Utilities.h"
-#include "../include/DatabaseManager.h"
+#include "../include/StorageEngine.h"
 #include <iostream>
 #include <iomanip>
 #include <vector>
@@ -14,72 +14,98 @@
 #undef max
 
 // OOP: Constructor calls base class constructor
-StaffModule::StaffModule(ConsoleUtils& c, DatabaseManager& d, UserSession& s)
+StaffModule::StaffModule(ConsoleUtils& c, StorageEngine& d, UserSession& s)
     : BaseModule(c, d, s) {}
 
 void StaffModule::viewAllAppointments() {
-    console.clearScreen();
-    console.printHeader("ALL APPOINTMENTS");
-    
-    std::vector<Appointment> appointments = db.getAllAppointments();
+    const int pageSize = 20;
     
-    if (appointments.empty()) {
-        console.printInfo("No appointments in the system.");
-        console.pauseScreen();
-        return;
-    }
+    // Start cursor of every page shown so far, so [P] can step back
+    // without re-reading from the beginning
+    std::vector<StorageEngine::AppointmentCursor> pageStarts(1);
+    StorageEngine::AppointmentSummary counts = db.getAppointmentSummary();
     
-    console.setColor(WHITE);
-    std::cout << "\n  Showing all appointments in the system.\n" << std::endl;
-    console.resetColor();
-    
-    console.setColor(DARK_CYAN);
-    std::cout << "  " << std::left 
-              << std::setw(5) << "ID"
-              << std::setw(16) << "Patient"
-              << std::setw(16) << "Doctor"
-              << std::setw(11) << "Date"
-              << std::setw(7) << "Time"
-              << std::setw(8) << "Cost"
-              << std::setw(11) << "Status" << std::endl;
-    std::cout << "  " << std::string(74, '-') << std::endl;
-    console.resetColor();
-    
-    int pending = 0, confirmed = 0, completed = 0, cancelled = 0;
-    double totalRevenue = 0.0;
-    
-    for (const auto& apt : appointments) {
-        if (apt.status == "Confirmed") { console.setColor(GREEN); confirmed++; }
-        else if (apt.status == "Pending") { console.setColor(YELLOW); pending++; }
-        else if (apt.status == "Completed") { console.setColor(CYAN); completed++; totalRevenue += apt.totalCost; }
-        else if (apt.status == "Cancelled") { console.setColor(RED); cancelled++; }
-        else console.resetColor();
+    while (true) {
+        console.clearScreen();
+        console.printHeader("ALL APPOINTMENTS");
+        
+        StorageEngine::AppointmentPage page = db.getAppointmentsPage(pageStarts.back(), pageSize);
+        
+        if (page.appointments.empty() && pageStarts.size() == 1) {
+            console.printInfo("No appointments in the system.");
+            console.pauseScreen();
+            return;
+        }
+        
+        console.setColor(WHITE);
+        std::cout << "\n  Page " << pageStarts.size() << " - newest appointments first.\n" << std::endl;
+        console.resetColor();
         
-        std::string pName = apt.patientName.length() > 14 ? 
-            apt.patientName.substr(0, 11) + "..." : apt.patientName;
-        std::string dName = apt.doctorName.length() > 14 ? 
-            apt.doctorName.substr(0, 11) + "..." : apt.doctorName;
+        console.setColor(DARK_CYAN);
+        std::cout << "  " << std::left 
+                  << std::setw(5) << "ID"
+                  << std::setw(16) << "Patient"
+                  << std::setw(16) << "Doctor"
+                  << std::setw(11) << "Date"
+                  << std::setw(7) << "Time"
+                  << std::setw(8) << "Cost"
+                  << std::setw(11) << "Status" << std::endl;
+        std::cout << "  " << std::string(74, '-') << std::endl;
+        console.resetColor();
         
-        std::cout << "  " << std::setw(5) << apt.appointmentID
-                  << std::setw(16) << pName
-                  << std::setw(16) << dName
-                  << std::setw(11) << apt.appointmentDate
-                  << std::setw(7) << apt.appointmentTime.substr(0, 5)
-                  << std::setw(8) << ("RM" + std::to_string((int)apt.totalCost))
-                  << std::setw(11) << apt.status << std::endl;
+        for (const auto& apt : page.appointments) {
+            if (apt.status == AppointmentStatus::Confirmed) console.setColor(GREEN);
+            else if (apt.status == AppointmentStatus::Pending) console.setColor(YELLOW);
+            else if (apt.status == AppointmentStatus::Completed) console.setColor(CYAN);
+            else if (apt.status == AppointmentStatus::Cancelled) console.setColor(RED);
+            else console.resetColor();
+            
+            std::string pName = apt.patientName.length() > 14 ? 
+                apt.patientName.substr(0, 11) + "..." : apt.patientName;
+            std::string dName = apt.doctorName.length() > 14 ? 
+                apt.doctorName.substr(0, 11) + "..." : apt.doctorName;
+            
+            std::cout << "  " << std::setw(5) << apt.appointmentID
+                      << std::setw(16) << pName
+                      << std::setw(16) << dName
+                      << std::setw(11) << apt.appointmentDate
+                      << std::setw(7) << apt.appointmentTime.shortString()
+                      << std::setw(8) << ("RM" + std::to_string((int)apt.totalCost))
+                      << std::setw(11) << apt.status << std::endl;
+        }
+        console.resetColor();
+        
+        // Totals cover every appointment, not just this page
+        std::cout << "\n  " << std::string(74, '-') << std::endl;
+        std::cout << "  SUMMARY: ";
+        console.setColor(YELLOW); std::cout << counts.pending << " Pending  ";
+        console.setColor(GREEN); std::cout << counts.confirmed << " Confirmed  ";
+        console.setColor(CYAN); std::cout << counts.completed << " Completed  ";
+        console.setColor(RED); std::cout << counts.cancelled << " Cancelled";
+        console.resetColor();
+        std::cout << "\n  Total Revenue (Completed): RM " << std::fixed << std::setprecision(2)
+                  << counts.completedRevenue << std::endl;
+        
+        std::cout << std::endl;
+        console.setColor(YELLOW);
+        std::cout << "  >> ";
+        if (page.hasMore) std::cout << "[N] Next page  ";
+        if (pageStarts.size() > 1) std::cout << "[P] Previous page  ";
+        std::cout << "[0] Back" << std::endl;
+        console.resetColor();
+        std::string choice = console.getStringInput("     Choice: ");
+        
+        if ((choice == "N" || choice == "n") && page.hasMore) {
+            pageStarts.push_back(page.next);
+        } else if ((choice == "P" || choice == "p") && pageStarts.size() > 1) {
+            pageStarts.pop_back();
+        } else if (choice == "0") {
+            return;
+        } else {
+            console.printError("Invalid choice!");
+            Sleep(800);
+        }
     }
-    console.resetColor();
-    
-    std::cout << "\n  " << std::string(74, '-') << std::endl;
-    std::cout << "  SUMMARY: ";
-    console.setColor(YELLOW); std::cout << pending << " Pending  ";
-    console.setColor(GREEN); std::cout << confirmed << " Confirmed  ";
-    console.setColor(CYAN); std::cout << completed << " Completed  ";
-    console.setColor(RED); std::cout << cancelled << " Cancelled";
-    console.resetColor();
-    std::cout << "\n  Total Revenue (Completed): RM " << std::fixed << std::setprecision(2) << totalRevenue << std::endl;
-    
-    console.pauseScreen();
 }
 
 void StaffModule::approveAppointment() {
@@ -119,7 +145,7 @@ void StaffModule::approveAppointment() {
                   << std::setw(18) << pending[i].patientName
                   << std::setw(18) << pending[i].doctorName
                   << std::setw(11) << pending[i].appointmentDate
-                  << std::setw(8) << pending[i].appointmentTime.substr(0, 5) << std::endl;
+                  << std::setw(8) << pending[i].appointmentTime.shortString() << std::endl;
     }
     
     std::cout << std::endl;
@@ -138,7 +164,7 @@ void StaffModule::approveAppointment() {
     std::cout << "  Patient          : " << selected.patientName << std::endl;
     std::cout << "  Doctor           : " << selected.doctorName << std::endl;
     std::cout << "  Date             : " << selected.appointmentDate << std::endl;
-    std::cout << "  Time             : " << selected.appointmentTime.substr(0, 5) << std::endl;
+    std::cout << "  Time             : " << selected.appointmentTime.shortString() << std::endl;
     std::cout << "  Duration         : " << selected.duration << " minutes" << std::endl;
     std::cout << "  Reason           : " << selected.reason << std::endl;
     std::cout << "  " << std::string(40, '-') << std::endl;
@@ -168,7 +194,7 @@ void StaffModule::approveAppointment() {
     int action = console.getIntInput("  Your action: ", 1, 3);
     
     if (action == 1) {
-        if (db.updateAppointmentStatus(selected.appointmentID, "Confirmed")) {
+        if (db.updateAppointmentStatus(selected.appointmentID, selected.status, AppointmentStatus::Confirmed)) {
             console.printSuccess("Appointment APPROVED!");
             console.setColor(WHITE);
             std::cout << "\n  Patient will be notified of confirmation." << std::endl;
@@ -179,7 +205,7 @@ void StaffModule::approveAppointment() {
             console.printError("Failed to approve appointment.");
         }
     } else if (action == 2) {
-        if (db.updateAppointmentStatus(selected.appointmentID, "Cancelled")) {
+        if (db.updateAppointmentStatus(selected.appointmentID, selected.status, AppointmentStatus::Cancelled)) {
             console.printWarning("Appointment REJECTED.");
             db.logActivity("Staff", session.userID, "Reject Appointment", 
                           "ID: " + std::to_string(selected.appointmentID));
@@ -197,8 +223,6 @@ void StaffModule::searchPatient() {
     console.clearScreen();
     console.printHeader("SEARCH PATIENT");
     
-    std::cin.ignore(10000, '\n');
-    
     console.setColor(WHITE);
     std::cout << "\n  Search for patients by name, email, or phone." << std::endl;
     std::cout << "  Enter partial or full text to search.\n" << std::endl;
@@ -215,7 +239,7 @@ void StaffModule::searchPatient() {
     std::cout << "  (Enter 0 to return to menu)\n" << std::endl;
     console.resetColor();
     
-    std::string search = console.getStringInput("  Enter search term: ");
+    std::string search = getPatientSearchInput("  Enter search term: ");
     
     // Check if user wants to return
     if (search == "0") {
@@ -322,10 +346,10 @@ void StaffModule::searchPatient() {
             std::cout << "  Status        : ";
             console.resetColor();
             
-            if (apt.status == "Completed") console.setColor(GREEN);
-            else if (apt.status == "Confirmed") console.setColor(CYAN);
-            else if (apt.status == "Pending") console.setColor(YELLOW);
-            else if (apt.status == "Cancelled") console.setColor(RED);
+            if (apt.status == AppointmentStatus::Completed) console.setColor(GREEN);
+            else if (apt.status == AppointmentStatus::Confirmed) console.setColor(CYAN);
+            else if (apt.status == AppointmentStatus::Pending) console.setColor(YELLOW);
+            else if (apt.status == AppointmentStatus::Cancelled) console.setColor(RED);
             std::cout << apt.status << std::endl;
             console.resetColor();
             
@@ -345,7 +369,7 @@ void StaffModule::searchPatient() {
         int completedCount = 0;
         double totalRevenue = 0.0;
         for (const auto& apt : patientAppointments) {
-            if (apt.status == "Completed") {
+            if (apt.status == AppointmentStatus::Completed) {
                 completedCount++;
                 totalRevenue += apt.totalCost;
             }
@@ -0,0 +1,40 @@
+// ============================================================
+// StatementCache.cpp - Per-Connection Prepared Statement LRU Cache
+// Hospital Appointment Booking System
+// ============================================================
+
+#include "../include/StatementCache.h"
+
+StatementCache::StatementCache(size_t cap, Counters* c)
+    : capacity(cap == 0 ? 1 : cap), counters(c) {}
+
+sql::PreparedStatement* StatementCache::prepare(sql::Connection& connection, const std::string& sql) {
+    auto found = index.find(sql);
+    if (found != index.end()) {
+        entries.splice(entries.begin(), entries, found->second);
+        if (counters) counters->hits++;
+        sql::PreparedStatement* statement = entries.front().statement.get();
+        statement->clearParameters();
+        return statement;
+    }
+
+    if (counters) counters->misses++;
+    std::unique_ptr<sql::PreparedStatement> statement(connection.prepareStatement(sql));
+
+    entries.push_front(Entry());
+    entries.front().sql = sql;
+    entries.front().statement = std::move(statement);
+    index[sql] = entries.begin();
+
+    if (entries.size() > capacity) {
+        index.erase(entries.back().sql);
+        entries.pop_back();
+        if (counters) counters->evictions++;
+    }
+    return entries.front().statement.get();
+}
+
+void StatementCache::clear() {
+    index.clear();
+    entries.clear();
+}
@@ -4,16 +4,12 @@
 // ============================================================
 
 #include "../include/Utilities.h"
+#include "../include/DateTime.h"
 #include <ctime>
 #include <sstream>
 
 std::string getCurrentDate() {
-    time_t now = time(0);
-    struct tm tstruct;
-    char buf[11];
-    localtime_s(&tstruct, &now);
-    strftime(buf, sizeof(buf), "%Y-%m-%d", &tstruct);
-    return std::string(buf);
+    return Date::today().toString();
 }
 
 std::string getCurrentTime() {
@@ -5,18 +5,24 @@
 
 #include "../include/ConsoleUtils.h"
 #include "../include/DatabaseManager.h"
+#include "../include/InMemoryStorage.h"
 #include "../include/Models.h"
 #include "../include/AuthModule.h"
 #include "../include/PatientModule.h"
 #include "../include/DoctorModule.h"
 #include "../include/StaffModule.h"
 #include "../include/AdminModule.h"
+#include "../include/CommandLineTools.h"
 #include <iostream>
+#include <cstdlib>
+#include <string>
 #include <windows.h>
 
 // Global instances
 ConsoleUtils console;
-DatabaseManager db;
+DatabaseManager mysqlStorage;
+InMemoryStorage memoryStorage;
+StorageEngine* storage = &mysqlStorage; // --memory switches to memoryStorage
 UserSession currentSession;
 
 void displayMainMenu() {
@@ -64,7 +70,62 @@ void displayMainMenu() {
     console.resetColor();
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    // --memory: run on the sample data of database_setup.sql held in this
+    // process instead of MySQL; the remaining arguments work as usual
+    if (argc > 1 && std::string(argv[1]) == "--memory") {
+        memoryStorage.seedDemoData();
+        storage = &memoryStorage;
+        argv[1] = argv[0];
+        argv++;
+        argc--;
+    }
+    if (argc > 1) {
+        std::string command = argv[1];
+        if (command == "--check-indexes") return runIndexCheck(*storage);
+        if (command == "--bench-row-mapping") {
+            return runRowMappingBenchmark(*storage, argc > 2 ? std::atoi(argv[2]) : 100000);
+        }
+        if (command == "--verify-rollups") return runRollupCheck(*storage, false);
+        if (command == "--rebuild-rollups") return runRollupCheck(*storage, true);
+        if (command == "--migrate-passwords") return runPasswordMigration(*storage);
+        if (command == "--bench-passwords") {
+            return runPasswordBenchmark(argc > 2 ? std::atoi(argv[2]) : 32);
+        }
+        if (command == "--bench-patient-search") {
+            return runPatientSearchBenchmark(argc > 2 ? std::atoi(argv[2]) : 1000000);
+        }
+        if (command == "--import-appointments" && argc > 2) {
+            return runAppointmentImport(*storage, argv[2], argc > 3 ? std::atoi(argv[3]) : 0);
+        }
+        if (command == "--export-appointments" && argc > 4) return runAppointmentExport(*storage, argc, argv);
+        if (command == "--bench-medicine-fee") {
+            return runMedicineFeeBenchmark(argc > 2 ? std::atoi(argv[2]) : 1000000);
+        }
+        if (command == "--bench-free-slots") {
+            return runFreeSlotBenchmark(argc > 2 ? std::atoi(argv[2]) : 200);
+        }
+        if (command == "--bench-columns") {
+            return runColumnBenchmark(argc > 2 ? std::atoll(argv[2]) : 10000000);
+        }
+        if (command == "--bench-records") {
+            return runRecordBenchmark(argc > 2 ? std::atoi(argv[2]) : 1000000);
+        }
+        if (command == "--bench-storage") {
+            return runStorageBenchmark(mysqlStorage, memoryStorage, argc > 2 ? std::atoi(argv[2]) : 200);
+        }
+        
+        std::cerr << "Unknown option: " << command << std::endl;
+        std::cerr << "Usage: " << argv[0] << " [--memory] [--check-indexes | --bench-row-mapping [rows] | "
+                  << "--verify-rollups | --rebuild-rollups | --migrate-passwords | --bench-passwords [logins] | "
+                  << "--bench-patient-search [patients] | --bench-free-slots [doctors] | --bench-medicine-fee [reasons] | "
+                  << "--bench-columns [rows] | --bench-records [rows] | --bench-storage [calls] | "
+                  << "--import-appointments <file.csv> [chunk rows] | "
+                  << "--export-appointments <from> <to> <file> [csv|ndjson] [--direct] [--fsync]]"
+                  << std::endl;
+        return 2;
+    }
+    
     // Set console to UTF-8
     SetConsoleOutputCP(65001);
     SetConsoleCP(65001);
@@ -72,7 +133,7 @@ int main() {
     // Initialize database connection
     console.showLoading("Connecting to database", 2);
     
-    if (!db.connect()) {
+    if (!storage->connect()) {
         console.setColor(RED);
         std::cout << "\n  +------------------------------------------+" << std::endl;
         std::cout << "  |      DATABASE CONNECTION FAILED!         |" << std::endl;
@@ -95,11 +156,11 @@ int main() {
     Sleep(1000);
     
     // Initialize modules
-    AuthModule auth(console, db, currentSession);
-    PatientModule patientModule(console, db, currentSession);
-    DoctorModule doctorModule(console, db, currentSession);
-    StaffModule staffModule(console, db, currentSession);
-    AdminModule adminModule(console, db, currentSession);
+    AuthModule auth(console, *storage, currentSession);
+    PatientModule patientModule(console, *storage, currentSession);
+    DoctorModule doctorModule(console, *storage, currentSession);
+    StaffModule staffModule(console, *storage, currentSession);
+    AdminModule adminModule(console, *storage, currentSession);
     
     // Main application loop
     while (true) {
@@ -154,7 +215,7 @@ int main() {
                 
                 std::cout << "\n\n";
                 Sleep(2000);
-                db.disconnect();
+                storage->disconnect();
                 return 0;
         }
     }